@@ -0,0 +1 @@
+int main(){printf("fails=%d\n",g_fail);}
@@ -0,0 +1,49 @@
+# Print the live performance counters published by the runtime (see performance_counters.h).
+param([int]$IntervalMs = 500)
+
+$Metrics = @("WaitFrame", "BeginFrame", "AppCpu", "AppGpu", "PrecompositionGpu", "Submit",
+	"PoseAge", "PredictionHorizon", "RuntimeLatency", "CompositorLatency")
+$Size = 240
+
+try {
+	$File = [System.IO.MemoryMappedFiles.MemoryMappedFile]::OpenExisting("VirtualDesktopOpenXR.PerformanceCounters",
+		[System.IO.MemoryMappedFiles.MemoryMappedFileRights]::Read)
+} catch {
+	Write-Host "No application is running with the Virtual Desktop OpenXR runtime."
+	Exit 1
+}
+$View = $File.CreateViewAccessor(0, $Size, [System.IO.MemoryMappedFiles.MemoryMappedFileAccess]::Read)
+if ($View.ReadUInt32(0) -ne 0x43504456 -or $View.ReadUInt32(4) -ne 2 -or $View.ReadUInt32(8) -ne $Size) {
+	Write-Host "Unsupported version of the performance counters."
+	Exit 1
+}
+
+$Snapshot = New-Object byte[] ($Size - 24)
+while ($true) {
+	# Sequence lock: retry while the writer is updating the snapshot.
+	do {
+		$Sequence = $View.ReadUInt64(16)
+		[void]$View.ReadArray(24, $Snapshot, 0, $Snapshot.Length)
+		[System.Threading.Thread]::MemoryBarrier()
+	} while (($Sequence -band 1) -or $View.ReadUInt64(16) -ne $Sequence)
+
+	Clear-Host
+	Write-Host ("Frame {0}  {1} FPS  ASW {2}  period {3:F0}us (measured {4:F0}us)  running start {5:F0}us  depth {6}" -f
+		[BitConverter]::ToUInt64($Snapshot, 0),
+		[BitConverter]::ToUInt32($Snapshot, 32),
+		[bool][BitConverter]::ToUInt32($Snapshot, 36),
+		[BitConverter]::ToSingle($Snapshot, 40),
+		[BitConverter]::ToSingle($Snapshot, 44),
+		[BitConverter]::ToSingle($Snapshot, 48),
+		[BitConverter]::ToUInt32($Snapshot, 52))
+	Write-Host ("{0} frames, {1} discarded" -f [BitConverter]::ToUInt64($Snapshot, 16), [BitConverter]::ToUInt64($Snapshot, 24))
+	for ($i = 0; $i -lt $Metrics.Length; $i++) {
+		$Offset = 56 + $i * 16
+		Write-Host ("{0,-17} last={1,6:F0}us p50={2,6:F0}us p90={3,6:F0}us p99={4,6:F0}us" -f $Metrics[$i],
+			[BitConverter]::ToSingle($Snapshot, $Offset),
+			[BitConverter]::ToSingle($Snapshot, $Offset + 4),
+			[BitConverter]::ToSingle($Snapshot, $Offset + 8),
+			[BitConverter]::ToSingle($Snapshot, $Offset + 12))
+	}
+	Start-Sleep -Milliseconds $IntervalMs
+}
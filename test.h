@@ -0,0 +1,10 @@
+#pragma once
+namespace virtualdesktop_openxr::test{}
+inline int g_fail=0;
+#define CAT2(a,b) a##b
+#define CAT(a,b) CAT2(a,b)
+struct Reg{Reg(void(*f)(),const char*n){f();printf("%s done\n",n);}};
+#define TEST_CASE(n) static void CAT(t,__LINE__)(); static Reg CAT(r,__LINE__)(CAT(t,__LINE__),n); static void CAT(t,__LINE__)()
+#define CHECK(x) do{if(!(x)){g_fail++;printf("FAIL %d %s\n",__LINE__,#x);}}while(0)
+#define REQUIRE CHECK
+#define CHECK_NEAR(a,b,e) CHECK(std::abs((a)-(b))<=(e))
@@ -0,0 +1,465 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+
+    // The components of the Touch controller that the random bindings use, and how to read them from the input state.
+    enum class Source { Button, Touch, IndexTrigger, HandTrigger, Thumbstick, ThumbstickX, ThumbstickY };
+
+    constexpr uint32_t BooleanBit = 1 << 0;
+    constexpr uint32_t FloatBit = 1 << 1;
+    constexpr uint32_t Vector2fBit = 1 << 2;
+
+    struct Component {
+        const char* path;
+        Source source;
+        uint32_t mask[2]; // For Button and Touch, or the click of the thumbstick. 0 when the side does not have it.
+        uint32_t actionTypes;
+    };
+
+    const Component k_components[] = {
+        {"/input/x/click", Source::Button, {ovrButton_X, 0}, BooleanBit | FloatBit},
+        {"/input/y/touch", Source::Touch, {ovrTouch_Y, 0}, BooleanBit | FloatBit},
+        {"/input/a/click", Source::Button, {0, ovrButton_A}, BooleanBit | FloatBit},
+        {"/input/b/touch", Source::Touch, {0, ovrTouch_B}, BooleanBit | FloatBit},
+        {"/input/trigger/value", Source::IndexTrigger, {1, 1}, BooleanBit | FloatBit},
+        {"/input/squeeze/value", Source::HandTrigger, {1, 1}, BooleanBit | FloatBit},
+        {"/input/trigger/touch",
+         Source::Touch,
+         {ovrTouch_LIndexTrigger, ovrTouch_RIndexTrigger},
+         BooleanBit | FloatBit},
+        {"/input/thumbstick/click", Source::Button, {ovrButton_LThumb, ovrButton_RThumb}, BooleanBit | FloatBit},
+        {"/input/thumbstick", Source::Thumbstick, {ovrButton_LThumb, ovrButton_RThumb}, BooleanBit | Vector2fBit},
+        {"/input/thumbstick/x", Source::ThumbstickX, {1, 1}, FloatBit},
+        {"/input/thumbstick/y", Source::ThumbstickY, {1, 1}, FloatBit},
+    };
+
+    uint32_t ActionTypeBit(XrActionType type) {
+        return type == XR_ACTION_TYPE_BOOLEAN_INPUT ? BooleanBit : type == XR_ACTION_TYPE_FLOAT_INPUT ? FloatBit : Vector2fBit;
+    }
+
+    struct Binding {
+        uint32_t side;
+        const Component* component;
+    };
+
+    struct ReferenceState {
+        bool isActive{false};
+        bool boolValue{false};
+        float floatValue{0};
+        XrVector2f vector2fValue{0, 0};
+    };
+
+    // The evaluation of one action, as the runtime did it per action before it flattened all the bindings into one
+    // table. The controllers of both sides are active.
+    ReferenceState EvaluateReference(const ovrInputState& inputState,
+                                     XrActionType type,
+                                     const std::vector<Binding>& bindings,
+                                     std::optional<uint32_t> subactionSide) {
+        ReferenceState state;
+        float longestLength = 0.f;
+        state.floatValue = -std::numeric_limits<float>::infinity();
+        for (const auto& binding : bindings) {
+            if (subactionSide && binding.side != *subactionSide) {
+                continue;
+            }
+
+            const uint32_t side = binding.side;
+            const Component& component = *binding.component;
+            switch (type) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+                // Per spec, the combined state is the OR of all values.
+                bool value = false;
+                switch (component.source) {
+                case Source::Button:
+                case Source::Thumbstick:
+                    value = inputState.Buttons & component.mask[side];
+                    break;
+                case Source::Touch:
+                    value = inputState.Touches & component.mask[side];
+                    break;
+                case Source::IndexTrigger:
+                    value = inputState.IndexTrigger[side] > 0.95f;
+                    break;
+                case Source::HandTrigger:
+                    value = inputState.HandTrigger[side] > 0.95f;
+                    break;
+                default:
+                    continue;
+                }
+                state.isActive = true;
+                state.boolValue = state.boolValue || value;
+                break;
+            }
+
+            case XR_ACTION_TYPE_FLOAT_INPUT: {
+                // Per spec, the combined state is the absolute maximum of all values.
+                float value = 0.f;
+                switch (component.source) {
+                case Source::Button:
+                    value = inputState.Buttons & component.mask[side] ? 1.f : 0.f;
+                    break;
+                case Source::Touch:
+                    value = inputState.Touches & component.mask[side] ? 1.f : 0.f;
+                    break;
+                case Source::IndexTrigger:
+                    value = inputState.IndexTrigger[side];
+                    break;
+                case Source::HandTrigger:
+                    value = inputState.HandTrigger[side];
+                    break;
+                case Source::ThumbstickX:
+                    value = inputState.ThumbstickNoDeadzone[side].x;
+                    break;
+                case Source::ThumbstickY:
+                    value = inputState.ThumbstickNoDeadzone[side].y;
+                    break;
+                default:
+                    continue;
+                }
+                state.isActive = true;
+                state.floatValue = std::max(state.floatValue, value);
+                break;
+            }
+
+            case XR_ACTION_TYPE_VECTOR2F_INPUT: {
+                // Per spec, the combined state if the one of the vector with the longest length.
+                if (component.source != Source::Thumbstick) {
+                    continue;
+                }
+                const XrVector2f value{inputState.ThumbstickNoDeadzone[side].x, inputState.ThumbstickNoDeadzone[side].y};
+                const float length = sqrt(value.x * value.x + value.y * value.y);
+                if (!state.isActive || length >= longestLength) {
+                    state.vector2fValue = value;
+                    longestLength = length;
+                }
+                state.isActive = true;
+                break;
+            }
+
+            default:
+                break;
+            }
+        }
+        if (type != XR_ACTION_TYPE_FLOAT_INPUT || !state.isActive) {
+            state.floatValue = 0.f;
+        }
+        return state;
+    }
+
+    ovrInputState RandomInputState(std::mt19937& random) {
+        std::uniform_real_distribution<float> analog(0.f, 1.f);
+        std::uniform_real_distribution<float> axis(-1.f, 1.f);
+        ovrInputState inputState{};
+        inputState.Buttons = random();
+        inputState.Touches = random();
+        for (uint32_t side = 0; side < 2; side++) {
+            // Exercise the float-to-boolean threshold.
+            inputState.IndexTrigger[side] = random() % 4 ? analog(random) : 0.95f;
+            inputState.HandTrigger[side] = random() % 4 ? analog(random) : 1.f;
+            inputState.ThumbstickNoDeadzone[side] = {axis(random), axis(random)};
+        }
+        return inputState;
+    }
+
+    struct TestAction {
+        XrActionSet actionSet;
+        XrAction action;
+        XrActionType type;
+        std::vector<Binding> bindings;
+    };
+
+    // A session with numActions random actions spread over numActionSets actionsets, each with 1 to 3 random bindings
+    // on the Touch controller, and subaction paths for both hands.
+    struct ActionsFixture {
+        ActionsFixture(uint32_t numActionSets, uint32_t numActions, uint32_t seed)
+            : instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME}), session(instance, UnpacedConfiguration()), random(seed) {
+            handPaths = {instance.stringToPath("/user/hand/left"), instance.stringToPath("/user/hand/right")};
+
+            for (uint32_t i = 0; i < numActionSets; i++) {
+                actionSets.push_back(CreateActionSet(instance, fmt::format("set_{}", i)));
+            }
+
+            const XrActionType types[] = {
+                XR_ACTION_TYPE_BOOLEAN_INPUT, XR_ACTION_TYPE_FLOAT_INPUT, XR_ACTION_TYPE_VECTOR2F_INPUT};
+            std::vector<std::pair<XrAction, std::string>> suggestedBindings;
+            for (uint32_t i = 0; i < numActions; i++) {
+                TestAction action{};
+                action.actionSet = actionSets[i % numActionSets];
+                action.type = types[random() % std::size(types)];
+                action.action = CreateAction(instance, action.actionSet, fmt::format("action_{}", i), action.type, handPaths);
+
+                const uint32_t numBindings = 1 + random() % 3;
+                while (action.bindings.size() < numBindings) {
+                    const Binding binding{(uint32_t)(random() % 2), &k_components[random() % std::size(k_components)]};
+                    if (!(binding.component->actionTypes & ActionTypeBit(action.type)) ||
+                        !binding.component->mask[binding.side] ||
+                        std::any_of(action.bindings.cbegin(), action.bindings.cend(), [&](const Binding& other) {
+                            return other.side == binding.side && other.component == binding.component;
+                        })) {
+                        continue;
+                    }
+                    action.bindings.push_back(binding);
+                    suggestedBindings.push_back(
+                        {action.action,
+                         fmt::format("/user/hand/{}{}", binding.side ? "right" : "left", binding.component->path)});
+                }
+                actions.push_back(std::move(action));
+            }
+            SuggestBindings(instance, "/interaction_profiles/oculus/touch_controller", suggestedBindings);
+            AttachActionSets(instance, session.handle(), actionSets);
+
+            for (const auto actionSet : actionSets) {
+                activeActionSets.push_back({actionSet, XR_NULL_PATH});
+            }
+
+            xrSyncActions = instance.get<PFN_xrSyncActions>("xrSyncActions");
+            xrGetActionStateBoolean = instance.get<PFN_xrGetActionStateBoolean>("xrGetActionStateBoolean");
+            xrGetActionStateFloat = instance.get<PFN_xrGetActionStateFloat>("xrGetActionStateFloat");
+            xrGetActionStateVector2f = instance.get<PFN_xrGetActionStateVector2f>("xrGetActionStateVector2f");
+
+            // Reach the focused state, where the actions are synced.
+            for (int i = 0; i < 3; i++) {
+                session.runFrame();
+            }
+        }
+
+        static standin::Configuration UnpacedConfiguration() {
+            standin::Configuration configuration;
+            configuration.paceFrames = false;
+            return configuration;
+        }
+
+        XrResult syncActions() {
+            XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+            syncInfo.countActiveActionSets = (uint32_t)activeActionSets.size();
+            syncInfo.activeActionSets = activeActionSets.data();
+            return xrSyncActions(session.handle(), &syncInfo);
+        }
+
+        // The state of an action, as returned by the matching xrGetActionState*() call.
+        struct RuntimeState {
+            ReferenceState value;
+            bool changedSinceLastSync{false};
+            XrTime lastChangeTime{0};
+        };
+
+        RuntimeState getActionState(const TestAction& action, std::optional<uint32_t> subactionSide) {
+            XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            getInfo.action = action.action;
+            getInfo.subactionPath = subactionSide ? handPaths[*subactionSide] : XR_NULL_PATH;
+
+            RuntimeState state;
+            switch (action.type) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT: {
+                XrActionStateBoolean booleanState{XR_TYPE_ACTION_STATE_BOOLEAN};
+                CHECK_XRCMD(xrGetActionStateBoolean(session.handle(), &getInfo, &booleanState));
+                state.value.isActive = booleanState.isActive;
+                state.value.boolValue = booleanState.currentState;
+                state.changedSinceLastSync = booleanState.changedSinceLastSync;
+                state.lastChangeTime = booleanState.lastChangeTime;
+                break;
+            }
+            case XR_ACTION_TYPE_FLOAT_INPUT: {
+                XrActionStateFloat floatState{XR_TYPE_ACTION_STATE_FLOAT};
+                CHECK_XRCMD(xrGetActionStateFloat(session.handle(), &getInfo, &floatState));
+                state.value.isActive = floatState.isActive;
+                state.value.floatValue = floatState.currentState;
+                state.changedSinceLastSync = floatState.changedSinceLastSync;
+                state.lastChangeTime = floatState.lastChangeTime;
+                break;
+            }
+            default: {
+                XrActionStateVector2f vector2fState{XR_TYPE_ACTION_STATE_VECTOR2F};
+                CHECK_XRCMD(xrGetActionStateVector2f(session.handle(), &getInfo, &vector2fState));
+                state.value.isActive = vector2fState.isActive;
+                state.value.vector2fValue = vector2fState.currentState;
+                state.changedSinceLastSync = vector2fState.changedSinceLastSync;
+                state.lastChangeTime = vector2fState.lastChangeTime;
+                break;
+            }
+            }
+            return state;
+        }
+
+        TestInstance instance;
+        TestSession session;
+        std::mt19937 random;
+        std::vector<XrPath> handPaths;
+        std::vector<XrActionSet> actionSets;
+        std::vector<XrActiveActionSet> activeActionSets;
+        std::vector<TestAction> actions;
+
+        PFN_xrSyncActions xrSyncActions{nullptr};
+        PFN_xrGetActionStateBoolean xrGetActionStateBoolean{nullptr};
+        PFN_xrGetActionStateFloat xrGetActionStateFloat{nullptr};
+        PFN_xrGetActionStateVector2f xrGetActionStateVector2f{nullptr};
+    };
+
+    bool operator==(const ReferenceState& a, const ReferenceState& b) {
+        return a.isActive == b.isActive && a.boolValue == b.boolValue && a.floatValue == b.floatValue &&
+               a.vector2fValue.x == b.vector2fValue.x && a.vector2fValue.y == b.vector2fValue.y;
+    }
+
+} // namespace
+
+TEST_CASE("action evaluation: one-pass table matches the per-action evaluation") {
+    ActionsFixture fixture(4, 200, 1234);
+
+    const std::optional<uint32_t> subactions[] = {std::nullopt, 0u, 1u};
+    std::map<std::pair<XrAction, int>, ReferenceState> previousStates;
+    for (int iteration = 0; iteration < 20; iteration++) {
+        const ovrInputState inputState = RandomInputState(fixture.random);
+        standin::SetInputState(inputState);
+        REQUIRE(fixture.syncActions() == XR_SUCCESS);
+
+        uint32_t numMismatches = 0;
+        for (const auto& action : fixture.actions) {
+            for (const auto& subaction : subactions) {
+                const ReferenceState expected = EvaluateReference(inputState, action.type, action.bindings, subaction);
+                const auto actual = fixture.getActionState(action, subaction);
+                if (!(actual.value == expected)) {
+                    numMismatches++;
+                }
+
+                // The first sync is a change from the initial (inactive) state.
+                const auto previous = previousStates.find({action.action, subaction ? (int)*subaction : -1});
+                if (previous != previousStates.cend()) {
+                    const bool changed = expected.isActive && !(expected == previous->second);
+                    CHECK(actual.changedSinceLastSync == changed);
+                }
+                previousStates[{action.action, subaction ? (int)*subaction : -1}] = expected;
+            }
+        }
+        CHECK(numMismatches == 0);
+    }
+}
+
+TEST_CASE("action evaluation: last change time only moves upon a change") {
+    ActionsFixture fixture(1, 30, 42);
+
+    ovrInputState inputState = RandomInputState(fixture.random);
+    standin::SetInputState(inputState);
+    REQUIRE(fixture.syncActions() == XR_SUCCESS);
+
+    std::vector<XrTime> lastChangeTimes;
+    for (const auto& action : fixture.actions) {
+        lastChangeTimes.push_back(fixture.getActionState(action, {}).lastChangeTime);
+    }
+
+    // The same input again: nothing changed.
+    REQUIRE(fixture.syncActions() == XR_SUCCESS);
+    for (size_t i = 0; i < fixture.actions.size(); i++) {
+        const auto state = fixture.getActionState(fixture.actions[i], {});
+        CHECK(!state.changedSinceLastSync);
+        CHECK(state.lastChangeTime == lastChangeTimes[i]);
+    }
+
+    // New input: the actions that changed have a later change time.
+    inputState = RandomInputState(fixture.random);
+    standin::SetInputState(inputState);
+    REQUIRE(fixture.syncActions() == XR_SUCCESS);
+    for (size_t i = 0; i < fixture.actions.size(); i++) {
+        const auto state = fixture.getActionState(fixture.actions[i], {});
+        if (state.changedSinceLastSync) {
+            CHECK(state.lastChangeTime > lastChangeTimes[i]);
+        } else {
+            CHECK(state.lastChangeTime == lastChangeTimes[i]);
+        }
+    }
+}
+
+TEST_CASE("action evaluation: cached bindings match a fresh resolve") {
+    ActionsFixture fixture(2, 40, 99);
+    const auto xrEnumerateBoundSourcesForAction =
+        fixture.instance.get<PFN_xrEnumerateBoundSourcesForAction>("xrEnumerateBoundSourcesForAction");
+
+    const auto getBoundSources = [&](XrAction action) {
+        XrBoundSourcesForActionEnumerateInfo enumerateInfo{XR_TYPE_BOUND_SOURCES_FOR_ACTION_ENUMERATE_INFO};
+        enumerateInfo.action = action;
+        uint32_t count = 0;
+        CHECK_XRCMD(xrEnumerateBoundSourcesForAction(fixture.session.handle(), &enumerateInfo, 0, &count, nullptr));
+        std::vector<XrPath> sources(count);
+        CHECK_XRCMD(xrEnumerateBoundSourcesForAction(
+            fixture.session.handle(), &enumerateInfo, count, &count, sources.data()));
+        return sources;
+    };
+
+    // The first sync resolved the bindings.
+    const std::optional<uint32_t> subactions[] = {std::nullopt, 0u, 1u};
+    std::vector<std::vector<XrPath>> freshSources;
+    for (const auto& action : fixture.actions) {
+        freshSources.push_back(getBoundSources(action.action));
+    }
+
+    // Changing the forced interaction profile rebinds the controllers. Only the Touch controller bindings were
+    // suggested, so the bindings are the same and come from the cache.
+    for (const int forcedInteractionProfile : {1, 0, 2, 0}) {
+        fixture.instance.setSetting("force_interaction_profile", forcedInteractionProfile);
+
+        const ovrInputState inputState = RandomInputState(fixture.random);
+        standin::SetInputState(inputState);
+        REQUIRE(fixture.syncActions() == XR_SUCCESS);
+
+        uint32_t numMismatches = 0;
+        for (size_t i = 0; i < fixture.actions.size(); i++) {
+            const auto& action = fixture.actions[i];
+            CHECK(getBoundSources(action.action) == freshSources[i]);
+            for (const auto& subaction : subactions) {
+                const ReferenceState expected = EvaluateReference(inputState, action.type, action.bindings, subaction);
+                if (!(fixture.getActionState(action, subaction).value == expected)) {
+                    numMismatches++;
+                }
+            }
+        }
+        CHECK(numMismatches == 0);
+    }
+}
+
+BENCHMARK("action evaluation: 200 actions in 4 actionsets") {
+    ActionsFixture fixture(4, 200, 1234);
+    const ovrInputState inputState = RandomInputState(fixture.random);
+    standin::SetInputState(inputState);
+
+    Measure("xrSyncActions", [&] { DoNotOptimize(fixture.syncActions()); });
+    Measure("xrSyncActions + xrGetActionState* for each action", [&] {
+        fixture.syncActions();
+        for (const auto& action : fixture.actions) {
+            DoNotOptimize(fixture.getActionState(action, {}));
+        }
+    });
+    Measure("per-action evaluation of the same bindings (test model)", [&] {
+        for (const auto& action : fixture.actions) {
+            for (uint32_t side = 0; side < 2; side++) {
+                DoNotOptimize(EvaluateReference(inputState, action.type, action.bindings, side));
+            }
+            DoNotOptimize(EvaluateReference(inputState, action.type, action.bindings, {}));
+        }
+    });
+}
@@ -0,0 +1,200 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    // Allocations are counted on the thread of the application only while it is inside the call being measured, and
+    // on every other thread (ie: the threads of the runtime) for the whole measurement.
+    std::atomic<bool> g_isCounting{false};
+    std::atomic<uint64_t> g_numAllocations{0};
+    thread_local bool t_isApplicationThread = false;
+    thread_local bool t_isInMeasuredCall = false;
+
+} // namespace
+
+namespace {
+
+    void CountAllocation() {
+        if (g_isCounting.load(std::memory_order_relaxed) && (!t_isApplicationThread || t_isInMeasuredCall)) {
+            g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void* Allocate(size_t size) noexcept {
+        CountAllocation();
+        return malloc(size ? size : 1);
+    }
+
+    void* AllocateAligned(size_t size, std::align_val_t alignment) noexcept {
+        CountAllocation();
+        return _aligned_malloc(size ? size : 1, (size_t)alignment);
+    }
+
+    void* CheckAllocation(void* pointer) {
+        if (!pointer) {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+
+} // namespace
+
+// Replacing the global allocation functions affects the whole test executable, including the runtime compiled into it.
+// Every replaceable form is replaced, so that no allocation escapes the count: the array, nothrow and over-aligned forms
+// (and the sized forms of the deallocation functions) would otherwise go to the CRT.
+void* operator new(size_t size) {
+    return CheckAllocation(Allocate(size));
+}
+
+void* operator new[](size_t size) {
+    return CheckAllocation(Allocate(size));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return CheckAllocation(AllocateAligned(size, alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return CheckAllocation(AllocateAligned(size, alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    _aligned_free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    _aligned_free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    _aligned_free(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+    _aligned_free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    _aligned_free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    _aligned_free(pointer);
+}
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+
+    // Run frames until the session is in its steady state, then count the allocations made by xrEndFrame() and by the
+    // submission thread over many frames.
+    uint64_t CountSteadyStateAllocations(const Settings& settings) {
+        TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME}, settings);
+        TestSession session(instance, {90.f, false, 3});
+        const uint64_t firstSubmission = standin::GetSubmittedFrameCount();
+        constexpr uint32_t numWarmUpFrames = 30;
+        constexpr uint32_t numFrames = 120;
+        for (uint32_t i = 0; i < numWarmUpFrames; i++) {
+            session.runFrame();
+        }
+
+        t_isApplicationThread = true;
+        g_numAllocations = 0;
+        g_isCounting = true;
+        for (uint32_t i = 0; i < numFrames; i++) {
+            const XrFrameState frameState = session.waitFrame();
+            session.beginFrame();
+            session.renderFrame(frameState.predictedDisplayTime);
+
+            t_isInMeasuredCall = true;
+            session.endFrame(frameState.predictedDisplayTime);
+            t_isInMeasuredCall = false;
+        }
+
+        // Let the submission thread catch up with the last frames.
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (standin::GetSubmittedFrameCount() < firstSubmission + numWarmUpFrames + numFrames &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        g_isCounting = false;
+        t_isApplicationThread = false;
+
+        return g_numAllocations;
+    }
+
+} // namespace
+
+TEST_CASE("allocations: xrEndFrame with synchronous submission") {
+    CHECK(CountSteadyStateAllocations({{"async_submission", 0}}) == 0);
+}
+
+TEST_CASE("allocations: xrEndFrame with asynchronous submission") {
+    for (int depth = 1; depth <= 3; depth++) {
+        CHECK(CountSteadyStateAllocations({{"async_submission_depth", depth}}) == 0);
+    }
+}
@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+
+    // The frames of a session run by the test, in the order the application submitted them.
+    struct AppFrame {
+        uint32_t imageIndex{0};
+        double endFrameTime{0};
+    };
+
+    // Wait for the submission thread to submit all the frames of the application.
+    bool WaitForSubmission(uint64_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (standin::GetSubmittedFrameCount() < count) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    // Run a session with the given submission settings. Upon each frame, check that the image handed to the
+    // application is not referenced by a frame still waiting in the submission queue.
+    std::vector<AppFrame> RunFrames(const Settings& settings,
+                                    const standin::Configuration& configuration,
+                                    uint32_t numFrames,
+                                    uint64_t& firstSubmission) {
+        TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME}, settings);
+        TestSession session(instance, configuration);
+
+        firstSubmission = standin::GetSubmittedFrameCount();
+        std::vector<AppFrame> frames;
+        frames.reserve(numFrames);
+        for (uint32_t i = 0; i < numFrames; i++) {
+            const XrFrameState frameState = session.waitFrame();
+            session.beginFrame();
+            const uint32_t imageIndex = session.renderFrame(frameState.predictedDisplayTime);
+
+            // The frames that were not submitted yet, as far as we know. More may have been submitted meanwhile.
+            const uint64_t numSubmitted = standin::GetSubmittedFrameCount() - firstSubmission;
+            for (uint64_t j = numSubmitted; j < frames.size(); j++) {
+                CHECK(frames[j].imageIndex != imageIndex);
+            }
+
+            frames.push_back({imageIndex, ovr_GetTimeInSeconds()});
+            session.endFrame(frameState.predictedDisplayTime);
+        }
+
+        CHECK(WaitForSubmission(firstSubmission + numFrames));
+        return frames;
+    }
+
+} // namespace
+
+TEST_CASE("async submission: queued frames present their own images") {
+    for (int depth = 1; depth <= 3; depth++) {
+        for (int swapchainLength = 3; swapchainLength <= 4; swapchainLength++) {
+            constexpr uint32_t numFrames = 60;
+            uint64_t firstSubmission = 0;
+            const std::vector<AppFrame> appFrames = RunFrames(
+                {{"async_submission_depth", depth}}, {90.f, false, swapchainLength}, numFrames, firstSubmission);
+
+            // Every frame must present the image the application rendered for it, even though the frames after it
+            // were already rendered when it was submitted.
+            const std::vector<standin::SubmittedFrame> submittedFrames = standin::GetSubmittedFrames();
+            REQUIRE(submittedFrames.size() >= numFrames);
+            for (uint32_t i = 0; i < numFrames; i++) {
+                const standin::SubmittedFrame& submitted = submittedFrames[submittedFrames.size() - numFrames + i];
+                REQUIRE(submitted.layerCount == 1);
+                CHECK(submitted.imageIndex[0] == (int)appFrames[i].imageIndex);
+            }
+        }
+    }
+}
+
+BENCHMARK("async submission: throughput and latency per depth") {
+    // Depth 0 is the synchronous submission.
+    for (int depth = 0; depth <= 3; depth++) {
+        Settings settings;
+        if (depth) {
+            settings["async_submission_depth"] = depth;
+        } else {
+            settings["async_submission"] = 0;
+        }
+
+        constexpr uint32_t numFrames = 180;
+        uint64_t firstSubmission = 0;
+        const std::vector<AppFrame> appFrames = RunFrames(settings, {90.f, true, 3}, numFrames, firstSubmission);
+        const std::vector<standin::SubmittedFrame> submittedFrames = standin::GetSubmittedFrames();
+        REQUIRE(submittedFrames.size() >= numFrames);
+
+        // The latency is from the application calling xrEndFrame() to the frame reaching the compositor.
+        std::vector<double> latencies;
+        for (uint32_t i = 0; i < numFrames; i++) {
+            const standin::SubmittedFrame& submitted = submittedFrames[submittedFrames.size() - numFrames + i];
+            latencies.push_back(submitted.submitTime - appFrames[i].endFrameTime);
+        }
+        std::sort(latencies.begin(), latencies.end());
+        const double elapsed = submittedFrames.back().submitTime -
+                               submittedFrames[submittedFrames.size() - numFrames].submitTime;
+
+        char label[64];
+        sprintf_s(label, "depth %d", depth);
+        printf("    %-56s %8.1f fps, latency p50=%.0fus p99=%.0fus\n",
+               label,
+               (numFrames - 1) / elapsed,
+               latencies[latencies.size() / 2] * 1e6,
+               latencies[latencies.size() * 99 / 100] * 1e6);
+    }
+}
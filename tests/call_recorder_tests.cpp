@@ -0,0 +1,456 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <framework/dispatch.h>
+#include <runtime.h>
+
+#include "call_replay.h"
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr;
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    const char* const k_threadNames[] = {"xrThread0", "xrThread1", "xrThread2", "xrThread3"};
+
+    // A recording file in the temporary directory, deleted when the test ends.
+    struct TemporaryRecording {
+        TemporaryRecording(const char* name)
+            : path(std::filesystem::temp_directory_path() /
+                   fmt::format("virtualdesktop-openxr-{}-{}.calls", name, GetCurrentProcessId())) {
+        }
+        ~TemporaryRecording() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+
+        const std::filesystem::path path;
+    };
+
+    // Record a session of the harness through the dispatch wrappers. Returns the handles the test needs to check.
+    struct RecordedSession {
+        XrSpace localSpace{XR_NULL_HANDLE};
+        XrPath path{XR_NULL_PATH};
+        XrTime locateTime{0};
+    };
+
+    RecordedSession RecordSession(const std::filesystem::path& path, uint32_t numFrames, bool paceFrames) {
+        REQUIRE(!callRecorder.isEnabled());
+        REQUIRE(callRecorder.open(path));
+        auto closeRecorder = MakeScopeGuard([] { callRecorder.close(); });
+
+        RecordedSession recorded;
+        TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME});
+        TestSession session(instance, {90.f, paceFrames});
+        for (uint32_t i = 0; i < numFrames; i++) {
+            session.runFrame();
+        }
+
+        recorded.localSpace = session.localSpace();
+        recorded.path = instance.stringToPath("/user/hand/left");
+        recorded.locateTime = 1'000'000'000;
+        XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+        CHECK_XRCMD(instance.get<PFN_xrLocateSpace>("xrLocateSpace")(
+            recorded.localSpace, recorded.localSpace, recorded.locateTime, &location));
+
+        return recorded;
+    }
+
+    const CallRecording::Call* FindCall(const CallRecording& recording, std::string_view name) {
+        for (const auto& call : recording.calls()) {
+            if (call.name == name) {
+                return &call;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t CountCalls(const CallRecording& recording, std::string_view name) {
+        return (size_t)std::count_if(
+            recording.calls().cbegin(), recording.calls().cend(), [&](const CallRecording::Call& call) {
+                return call.name == name;
+            });
+    }
+
+} // namespace
+
+TEST_CASE("call recorder: every call of concurrent threads is written once, in order") {
+    constexpr uint32_t k_numCalls = 20000;
+    TemporaryRecording file("threads");
+
+    {
+        CallRecorder recorder;
+        REQUIRE(recorder.open(file.path, 4 * 1024 * 1024));
+
+        std::vector<std::thread> threads;
+        for (uint16_t t = 0; t < std::size(k_threadNames); t++) {
+            threads.emplace_back([&recorder, t] {
+                for (uint32_t i = 0; i < k_numCalls; i++) {
+                    CallRecorder::Scope recordCall(recorder, t, k_threadNames[t]);
+                    if (recordCall.isEnabled()) {
+                        recordCall.addValue(i);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        recorder.close();
+        CHECK(recorder.numDropped() == 0);
+    }
+
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+    CHECK(recording.numDropped() == 0);
+    REQUIRE(recording.calls().size() == std::size(k_threadNames) * k_numCalls);
+
+    // Within each thread, the calls come back in the order they were made.
+    uint32_t nextValue[std::size(k_threadNames)]{};
+    for (const auto& call : recording.calls()) {
+        REQUIRE(call.id < std::size(k_threadNames));
+        CHECK(call.name == k_threadNames[call.id]);
+        REQUIRE(call.arguments.size() == 1);
+        CHECK(call.arguments[0].as<uint32_t>() == nextValue[call.id]);
+        nextValue[call.id]++;
+    }
+}
+
+TEST_CASE("call recorder: a full thread buffer drops calls instead of waiting") {
+    constexpr uint32_t k_numCalls = 1000;
+    TemporaryRecording file("full");
+
+    {
+        // Nothing is flushed before close(), so the buffer fills up after a few calls.
+        CallRecorder recorder;
+        REQUIRE(recorder.open(file.path, 4096, 1h));
+        for (uint32_t i = 0; i < k_numCalls; i++) {
+            CallRecorder::Scope recordCall(recorder, 0, "xrFull");
+            if (recordCall.isEnabled()) {
+                recordCall.addValue(i);
+            }
+        }
+        recorder.close();
+        CHECK(recorder.numDropped() > 0);
+    }
+
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+    REQUIRE(!recording.calls().empty());
+    CHECK(recording.calls().size() + recording.numDropped() == k_numCalls);
+
+    // The calls that fit are the first ones.
+    for (uint32_t i = 0; i < recording.calls().size(); i++) {
+        CHECK(recording.calls()[i].arguments[0].as<uint32_t>() == i);
+    }
+}
+
+TEST_CASE("call recorder: a thread keeps its buffer from one recording to the next") {
+    constexpr uint32_t k_numRecordings = 3;
+    TemporaryRecording file("reuse");
+
+    CallRecorder recorder;
+    for (uint32_t i = 0; i < k_numRecordings; i++) {
+        // A smaller buffer than the previous recording replaces the buffer of the thread.
+        REQUIRE(recorder.open(file.path, i < 2 ? 4096 : 1024));
+        for (uint32_t j = 0; j <= i; j++) {
+            CallRecorder::Scope recordCall(recorder, 0, "xrReuse");
+            if (recordCall.isEnabled()) {
+                recordCall.addValue(i);
+            }
+        }
+        recorder.close();
+        CHECK(recorder.numThreadBuffers() == 1);
+
+        // Each recording only holds its own calls.
+        CallRecording recording;
+        REQUIRE(recording.load(file.path));
+        REQUIRE(recording.calls().size() == i + 1);
+        for (const auto& call : recording.calls()) {
+            CHECK(call.arguments[0].as<uint32_t>() == i);
+        }
+    }
+}
+
+TEST_CASE("call recorder: the threads beyond the buffer limit have their calls dropped") {
+    constexpr uint32_t k_numThreads = CallRecorder::k_maxThreadBuffers + 8;
+    TemporaryRecording file("limit");
+
+    {
+        CallRecorder recorder;
+        REQUIRE(recorder.open(file.path, 4096));
+
+        // The threads are alive together, so that each has its own id.
+        std::atomic<uint32_t> numRecorded{0};
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < k_numThreads; t++) {
+            threads.emplace_back([&] {
+                {
+                    CallRecorder::Scope recordCall(recorder, 0, "xrLimit");
+                }
+                numRecorded++;
+                while (numRecorded.load() < k_numThreads) {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        recorder.close();
+        CHECK(recorder.numThreadBuffers() == CallRecorder::k_maxThreadBuffers);
+        CHECK(recorder.numDropped() == k_numThreads - CallRecorder::k_maxThreadBuffers);
+    }
+
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+    CHECK(recording.calls().size() == CallRecorder::k_maxThreadBuffers);
+    CHECK(recording.numDropped() == k_numThreads - CallRecorder::k_maxThreadBuffers);
+}
+
+TEST_CASE("call recorder: destroying the instance closes the recording") {
+    TemporaryRecording file("destroy");
+    REQUIRE(!callRecorder.isEnabled());
+    REQUIRE(callRecorder.open(file.path));
+    auto closeRecorder = MakeScopeGuard([] { callRecorder.close(); });
+
+    {
+        TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME});
+        CHECK(callRecorder.isEnabled());
+    }
+    CHECK(!callRecorder.isEnabled());
+
+    // The calls up to the destruction were written.
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+    CHECK(FindCall(recording, "xrCreateInstance"));
+}
+
+TEST_CASE("call recorder: arguments that do not fit are marked truncated") {
+    TemporaryRecording file("truncated");
+
+    XrInstance instance = XR_NULL_HANDLE;
+    XrEventDataBuffer eventData{XR_TYPE_EVENT_DATA_BUFFER};
+    {
+        CallRecorder recorder;
+        REQUIRE(recorder.open(file.path));
+        {
+            CallRecorder::Scope recordCall(recorder, 0, "xrPollEvent");
+            if (recordCall.isEnabled()) {
+                recordCall.addValue(instance);
+                recordCall.addOutput(&eventData);
+                recordCall.addString(nullptr);
+                recordCall.addArray();
+            }
+        }
+        recorder.close();
+    }
+
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+    REQUIRE(recording.calls().size() == 1);
+    const auto& arguments = recording.calls()[0].arguments;
+    REQUIRE(arguments.size() == 4);
+    CHECK(arguments[0].type == CallRecorder::ArgumentType::Value);
+    CHECK(arguments[1].type == CallRecorder::ArgumentType::Truncated);
+    CHECK(arguments[2].type == CallRecorder::ArgumentType::Null);
+    CHECK(arguments[3].type == CallRecorder::ArgumentType::Array);
+}
+
+TEST_CASE("call recorder: the dispatch wrappers record the arguments of the calls") {
+    constexpr uint32_t k_numFrames = 10;
+    TemporaryRecording file("arguments");
+    const RecordedSession recorded = RecordSession(file.path, k_numFrames, false);
+
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+    CHECK(recording.numDropped() == 0);
+
+    // Input structures with their next chain.
+    {
+        const auto call = FindCall(recording, "xrCreateSession");
+        REQUIRE(call);
+        REQUIRE(call->arguments.size() == 3);
+        CHECK(call->arguments[1].type == CallRecorder::ArgumentType::Input);
+        CHECK(call->arguments[1].nextChain == std::vector<XrStructureType>{XR_TYPE_GRAPHICS_BINDING_D3D11_KHR});
+    }
+
+    // Output handles, read back after the call.
+    {
+        const auto call = FindCall(recording, "xrCreateReferenceSpace");
+        REQUIRE(call);
+        REQUIRE(call->arguments.size() == 3);
+        const auto createInfo = call->arguments[1].as<XrReferenceSpaceCreateInfo>();
+        REQUIRE(createInfo);
+        CHECK(createInfo->referenceSpaceType == XR_REFERENCE_SPACE_TYPE_LOCAL);
+        CHECK(call->arguments[2].type == CallRecorder::ArgumentType::Output);
+        CHECK(call->arguments[2].as<XrSpace>() == recorded.localSpace);
+    }
+
+    // Strings and atoms.
+    {
+        const auto call = FindCall(recording, "xrStringToPath");
+        REQUIRE(call);
+        REQUIRE(call->arguments.size() == 3);
+        CHECK(call->arguments[1].asString() == "/user/hand/left");
+        CHECK(call->arguments[2].as<XrPath>() == recorded.path);
+    }
+
+    // Values, and arrays that are not followed.
+    {
+        const auto call = FindCall(recording, "xrLocateSpace");
+        REQUIRE(call);
+        REQUIRE(call->arguments.size() == 4);
+        CHECK(call->arguments[0].as<XrSpace>() == recorded.localSpace);
+        CHECK(call->arguments[2].as<XrTime>() == recorded.locateTime);
+        CHECK(call->arguments[3].as<XrSpaceLocation>().has_value());
+
+        const auto locateViews = FindCall(recording, "xrLocateViews");
+        REQUIRE(locateViews);
+        REQUIRE(locateViews->arguments.size() == 6);
+        CHECK(locateViews->arguments[5].type == CallRecorder::ArgumentType::Array);
+    }
+
+    // Each frame ends at the display time predicted for it.
+    REQUIRE(CountCalls(recording, "xrWaitFrame") == k_numFrames);
+    REQUIRE(CountCalls(recording, "xrEndFrame") == k_numFrames);
+    std::optional<XrTime> predictedDisplayTime;
+    for (const auto& call : recording.calls()) {
+        if (call.name == "xrWaitFrame") {
+            const auto frameState = call.arguments[2].as<XrFrameState>();
+            REQUIRE(frameState);
+            predictedDisplayTime = frameState->predictedDisplayTime;
+        } else if (call.name == "xrEndFrame") {
+            const auto endInfo = call.arguments[1].as<XrFrameEndInfo>();
+            REQUIRE(endInfo);
+            REQUIRE(predictedDisplayTime);
+            CHECK(endInfo->displayTime == *predictedDisplayTime);
+            CHECK(endInfo->layerCount == 1);
+        }
+    }
+}
+
+TEST_CASE("call recorder: a replay reproduces the frame loop of a recording") {
+    constexpr uint32_t k_numFrames = 60;
+    TemporaryRecording file("replay");
+    RecordSession(file.path, k_numFrames, true);
+
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+
+    TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME});
+    TestSession session(instance);
+    const uint64_t firstSubmission = standin::GetSubmittedFrameCount();
+    {
+        CallReplay replay(instance, session);
+        replay.run(recording);
+
+        for (const auto& entry : replay.costs()) {
+            CHECK(entry.second.numFailed == 0);
+        }
+        for (const char* name : {"xrWaitFrame",
+                                 "xrBeginFrame",
+                                 "xrLocateViews",
+                                 "xrAcquireSwapchainImage",
+                                 "xrWaitSwapchainImage",
+                                 "xrReleaseSwapchainImage",
+                                 "xrEndFrame"}) {
+            REQUIRE(replay.costs().count(name));
+            CHECK(replay.costs().at(name).numReplayed == k_numFrames);
+        }
+        CHECK(replay.costs().at("xrLocateSpace").numReplayed == 1);
+    }
+
+    // Every replayed frame reached the compositor with a layer.
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (standin::GetSubmittedFrameCount() < firstSubmission + k_numFrames &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    CHECK(standin::GetSubmittedFrameCount() == firstSubmission + k_numFrames);
+    for (const auto& frame : standin::GetSubmittedFrames()) {
+        CHECK(frame.layerCount == 1);
+    }
+}
+
+BENCHMARK("call recorder: per-call overhead") {
+    XrSpace space = XR_NULL_HANDLE;
+    XrTime time = 0;
+    XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+    const auto recordLocateSpace = [&](CallRecorder& recorder) {
+        CallRecorder::Scope recordCall(recorder, 0, "xrLocateSpace");
+        if (recordCall.isEnabled()) {
+            recordCall.addValue(space);
+            recordCall.addValue(space);
+            recordCall.addValue(time++);
+            recordCall.addOutput(&location);
+        }
+        DoNotOptimize(location);
+    };
+
+    CallRecorder recorder;
+    Measure("xrLocateSpace scope, recording off", [&] { recordLocateSpace(recorder); });
+
+    TemporaryRecording file("overhead");
+    REQUIRE(recorder.open(file.path));
+    Measure("xrLocateSpace scope, recording on", [&] { recordLocateSpace(recorder); });
+    recorder.close();
+    printf("    %llu calls dropped\n", recorder.numDropped());
+}
+
+BENCHMARK("call recorder: replay cost per entry point") {
+    constexpr uint32_t k_numFrames = 300;
+    TemporaryRecording file("replay-benchmark");
+    RecordSession(file.path, k_numFrames, true);
+
+    CallRecording recording;
+    REQUIRE(recording.load(file.path));
+
+    TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME});
+    TestSession session(instance);
+    CallReplay replay(instance, session);
+    replay.run(recording);
+
+    for (const auto& [name, cost] : replay.costs()) {
+        if (cost.numReplayed < k_numFrames) {
+            continue;
+        }
+        ReportMeasurement(fmt::format("{} (recorded)", name).c_str(),
+                          cost.recordedMicroseconds * 1000 / cost.numReplayed);
+        ReportMeasurement(fmt::format("{} (replayed)", name).c_str(),
+                          cost.replayedMicroseconds * 1000 / cost.numReplayed);
+    }
+
+    printf("    Not replayed (the cost of input is not measured):\n");
+    for (const auto& [name, cost] : replay.costs()) {
+        if (cost.numSkipped) {
+            printf("      %-54s %12u calls\n", name.c_str(), cost.numSkipped);
+        }
+    }
+}
@@ -0,0 +1,326 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "call_replay.h"
+#include "test.h"
+
+namespace {
+
+    using Argument = virtualdesktop_openxr::utils::CallRecording::Argument;
+
+    template <typename T>
+    uint64_t HandleValue(T handle) {
+        static_assert(sizeof(T) == sizeof(uint64_t));
+        uint64_t value;
+        memcpy(&value, &handle, sizeof(value));
+        return value;
+    }
+
+    // The recorded structure, with its chain removed since it points into the recorded process.
+    template <typename T>
+    std::optional<T> Structure(const Argument& argument) {
+        auto structure = argument.as<T>();
+        if (structure) {
+            structure->next = nullptr;
+        }
+        return structure;
+    }
+
+} // namespace
+
+namespace virtualdesktop_openxr::test {
+
+    CallReplay::CallReplay(const TestInstance& instance, const TestSession& session)
+        : m_instance(instance), m_session(session) {
+        m_handles[HandleValue(instance.handle())] = HandleValue(instance.handle());
+        m_handles[HandleValue(session.handle())] = HandleValue(session.handle());
+
+        m_xrPollEvent = instance.get<PFN_xrPollEvent>("xrPollEvent");
+        m_xrStringToPath = instance.get<PFN_xrStringToPath>("xrStringToPath");
+        m_xrCreateReferenceSpace = instance.get<PFN_xrCreateReferenceSpace>("xrCreateReferenceSpace");
+        m_xrDestroySpace = instance.get<PFN_xrDestroySpace>("xrDestroySpace");
+        m_xrLocateSpace = instance.get<PFN_xrLocateSpace>("xrLocateSpace");
+        m_xrLocateViews = instance.get<PFN_xrLocateViews>("xrLocateViews");
+        m_xrCreateSwapchain = instance.get<PFN_xrCreateSwapchain>("xrCreateSwapchain");
+        m_xrDestroySwapchain = instance.get<PFN_xrDestroySwapchain>("xrDestroySwapchain");
+        m_xrAcquireSwapchainImage = instance.get<PFN_xrAcquireSwapchainImage>("xrAcquireSwapchainImage");
+        m_xrWaitSwapchainImage = instance.get<PFN_xrWaitSwapchainImage>("xrWaitSwapchainImage");
+        m_xrReleaseSwapchainImage = instance.get<PFN_xrReleaseSwapchainImage>("xrReleaseSwapchainImage");
+        m_xrWaitFrame = instance.get<PFN_xrWaitFrame>("xrWaitFrame");
+        m_xrBeginFrame = instance.get<PFN_xrBeginFrame>("xrBeginFrame");
+        m_xrEndFrame = instance.get<PFN_xrEndFrame>("xrEndFrame");
+
+        // Views facing forward, until the replay locates them.
+        for (XrView& view : m_views) {
+            view.pose = xr::math::Pose::Identity();
+            view.fov = {-0.8f, 0.8f, 0.8f, -0.8f};
+        }
+    }
+
+    CallReplay::~CallReplay() {
+        for (const ReplayedSwapchain& swapchain : m_swapchains) {
+            m_xrDestroySwapchain(swapchain.handle);
+        }
+        for (XrSpace space : m_spaces) {
+            m_xrDestroySpace(space);
+        }
+    }
+
+    template <typename T>
+    std::optional<T> CallReplay::mapArgument(const Argument& argument) const {
+        const auto handle = argument.as<T>();
+        return handle ? mapHandle(*handle) : std::nullopt;
+    }
+
+    template <typename T>
+    std::optional<T> CallReplay::mapHandle(T handle) const {
+        if (handle == XR_NULL_HANDLE) {
+            return handle;
+        }
+
+        const auto it = m_handles.find(HandleValue(handle));
+        if (it == m_handles.cend()) {
+            return {};
+        }
+        T mappedHandle;
+        memcpy(&mappedHandle, &it->second, sizeof(mappedHandle));
+        return mappedHandle;
+    }
+
+    template <typename T>
+    void CallReplay::addHandle(const Argument& argument, T handle) {
+        const auto value = argument.as<uint64_t>();
+        if (value) {
+            m_handles[*value] = HandleValue(handle);
+        }
+    }
+
+    void CallReplay::run(const utils::CallRecording& recording, bool reproduceGaps) {
+        const double ticksPerMicrosecond = recording.header().ticksPerSecond / 1e6;
+
+        std::optional<int64_t> previousEndTicks;
+        auto previousEnd = std::chrono::steady_clock::now();
+        for (const auto& call : recording.calls()) {
+            if (reproduceGaps && previousEndTicks) {
+                const auto gap = std::chrono::duration<double, std::micro>(
+                    std::max<int64_t>(call.startTicks - *previousEndTicks, 0) / ticksPerMicrosecond);
+                const auto deadline =
+                    previousEnd + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                      std::min<std::chrono::duration<double, std::micro>>(gap, k_maxGap));
+                while (std::chrono::steady_clock::now() < deadline) {
+                    _mm_pause();
+                }
+            }
+
+            EntryPointCost& cost = m_costs[std::string(call.name)];
+            const auto start = std::chrono::steady_clock::now();
+            const std::optional<XrResult> result = replay(call);
+            previousEnd = std::chrono::steady_clock::now();
+            previousEndTicks = call.startTicks + call.durationTicks;
+
+            if (!result) {
+                cost.numSkipped++;
+                continue;
+            }
+            cost.numReplayed++;
+            if (XR_FAILED(*result) && XR_SUCCEEDED(call.result)) {
+                cost.numFailed++;
+            }
+            cost.recordedMicroseconds += call.durationTicks / ticksPerMicrosecond;
+            cost.replayedMicroseconds += std::chrono::duration<double, std::micro>(previousEnd - start).count();
+        }
+    }
+
+    std::optional<XrResult> CallReplay::replay(const utils::CallRecording::Call& call) {
+        const auto& arguments = call.arguments;
+        const auto session = !arguments.empty() ? mapArgument<XrSession>(arguments[0]) : std::nullopt;
+
+        if (call.name == "xrCreateInstance" && arguments.size() == 2) {
+            // The replay runs on the instance and session of the test.
+            addHandle(arguments[1], m_instance.handle());
+        } else if (call.name == "xrCreateSession" && arguments.size() == 3) {
+            addHandle(arguments[2], m_session.handle());
+        } else if (call.name == "xrPollEvent" && arguments.size() == 2) {
+            XrEventDataBuffer eventData{XR_TYPE_EVENT_DATA_BUFFER};
+            return m_xrPollEvent(m_instance.handle(), &eventData);
+        } else if (call.name == "xrStringToPath" && arguments.size() == 3) {
+            const auto pathString = arguments[1].asString();
+            if (pathString) {
+                XrPath path = XR_NULL_PATH;
+                return m_xrStringToPath(m_instance.handle(), std::string(*pathString).c_str(), &path);
+            }
+        } else if (call.name == "xrCreateReferenceSpace" && arguments.size() == 3 && session) {
+            const auto createInfo = Structure<XrReferenceSpaceCreateInfo>(arguments[1]);
+            if (createInfo) {
+                XrSpace space = XR_NULL_HANDLE;
+                const XrResult result = m_xrCreateReferenceSpace(*session, &*createInfo, &space);
+                if (XR_SUCCEEDED(result)) {
+                    m_spaces.push_back(space);
+                    addHandle(arguments[2], space);
+                }
+                return result;
+            }
+        } else if (call.name == "xrDestroySpace" && arguments.size() == 1) {
+            const auto space = mapArgument<XrSpace>(arguments[0]);
+            const auto it = space ? std::find(m_spaces.begin(), m_spaces.end(), *space) : m_spaces.end();
+            if (it != m_spaces.end()) {
+                m_spaces.erase(it);
+                return m_xrDestroySpace(*space);
+            }
+        } else if (call.name == "xrLocateSpace" && arguments.size() == 4) {
+            const auto space = mapArgument<XrSpace>(arguments[0]);
+            const auto baseSpace = mapArgument<XrSpace>(arguments[1]);
+            const auto time = arguments[2].as<XrTime>();
+            if (space && baseSpace && time) {
+                XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+                return m_xrLocateSpace(*space, *baseSpace, rebase(*time), &location);
+            }
+        } else if (call.name == "xrLocateViews" && arguments.size() == 6 && session) {
+            auto locateInfo = Structure<XrViewLocateInfo>(arguments[1]);
+            const auto viewCapacity = arguments[3].as<uint32_t>();
+            if (locateInfo && viewCapacity) {
+                const auto space = mapHandle(locateInfo->space);
+                if (space) {
+                    locateInfo->space = *space;
+                    locateInfo->displayTime = rebase(locateInfo->displayTime);
+                    XrViewState viewState{XR_TYPE_VIEW_STATE};
+                    uint32_t viewCount = 0;
+                    const uint32_t capacity = std::min(*viewCapacity, (uint32_t)std::size(m_views));
+                    return m_xrLocateViews(
+                        *session, &*locateInfo, &viewState, capacity, &viewCount, capacity ? m_views : nullptr);
+                }
+            }
+        } else if (call.name == "xrCreateSwapchain" && arguments.size() == 3 && session) {
+            const auto createInfo = Structure<XrSwapchainCreateInfo>(arguments[1]);
+            if (createInfo) {
+                XrSwapchain swapchain = XR_NULL_HANDLE;
+                const XrResult result = m_xrCreateSwapchain(*session, &*createInfo, &swapchain);
+                if (XR_SUCCEEDED(result)) {
+                    m_swapchains.push_back({swapchain, *createInfo});
+                    addHandle(arguments[2], swapchain);
+                }
+                return result;
+            }
+        } else if (call.name == "xrDestroySwapchain" && arguments.size() == 1) {
+            const auto swapchain = mapArgument<XrSwapchain>(arguments[0]);
+            const auto it = std::find_if(m_swapchains.begin(), m_swapchains.end(), [&](const ReplayedSwapchain& entry) {
+                return swapchain && entry.handle == *swapchain;
+            });
+            if (it != m_swapchains.end()) {
+                m_swapchains.erase(it);
+                if (m_lastReleasedSwapchain == *swapchain) {
+                    m_lastReleasedSwapchain = XR_NULL_HANDLE;
+                }
+                return m_xrDestroySwapchain(*swapchain);
+            }
+        } else if (call.name == "xrAcquireSwapchainImage" && arguments.size() == 3) {
+            const auto swapchain = mapArgument<XrSwapchain>(arguments[0]);
+            if (swapchain) {
+                uint32_t index = 0;
+                return m_xrAcquireSwapchainImage(*swapchain, nullptr, &index);
+            }
+        } else if (call.name == "xrWaitSwapchainImage" && arguments.size() == 2) {
+            const auto swapchain = mapArgument<XrSwapchain>(arguments[0]);
+            const auto waitInfo = Structure<XrSwapchainImageWaitInfo>(arguments[1]);
+            if (swapchain && waitInfo) {
+                return m_xrWaitSwapchainImage(*swapchain, &*waitInfo);
+            }
+        } else if (call.name == "xrReleaseSwapchainImage" && arguments.size() == 2) {
+            const auto swapchain = mapArgument<XrSwapchain>(arguments[0]);
+            if (swapchain) {
+                const XrResult result = m_xrReleaseSwapchainImage(*swapchain, nullptr);
+                const auto it =
+                    std::find_if(m_swapchains.begin(), m_swapchains.end(), [&](const ReplayedSwapchain& entry) {
+                        return entry.handle == *swapchain;
+                    });
+                if (XR_SUCCEEDED(result) && it != m_swapchains.end() &&
+                    (it->createInfo.usageFlags & XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT)) {
+                    m_lastReleasedSwapchain = *swapchain;
+                }
+                return result;
+            }
+        } else if (call.name == "xrWaitFrame" && arguments.size() == 3 && session) {
+            XrFrameState frameState{XR_TYPE_FRAME_STATE};
+            const XrResult result = m_xrWaitFrame(*session, nullptr, &frameState);
+            const auto recordedFrameState = arguments[2].as<XrFrameState>();
+            if (XR_SUCCEEDED(result) && recordedFrameState) {
+                m_timeOffset = frameState.predictedDisplayTime - recordedFrameState->predictedDisplayTime;
+            }
+            return result;
+        } else if (call.name == "xrBeginFrame" && arguments.size() == 2 && session) {
+            return m_xrBeginFrame(*session, nullptr);
+        } else if (call.name == "xrEndFrame" && arguments.size() == 2 && session) {
+            const auto endInfo = Structure<XrFrameEndInfo>(arguments[1]);
+            if (endInfo) {
+                return endFrame(*endInfo);
+            }
+        }
+
+        return {};
+    }
+
+    XrResult CallReplay::endFrame(const XrFrameEndInfo& recordedEndInfo) {
+        XrFrameEndInfo endInfo = recordedEndInfo;
+        endInfo.displayTime = rebase(recordedEndInfo.displayTime);
+        endInfo.layerCount = 0;
+        endInfo.layers = nullptr;
+
+        const auto swapchain =
+            std::find_if(m_swapchains.cbegin(), m_swapchains.cend(), [&](const ReplayedSwapchain& entry) {
+                return entry.handle == m_lastReleasedSwapchain;
+            });
+        if (recordedEndInfo.layerCount == 0 || swapchain == m_swapchains.cend()) {
+            return m_xrEndFrame(m_session.handle(), &endInfo);
+        }
+
+        // Each view covers the whole image, or a slice of it for a texture array.
+        XrCompositionLayerProjectionView projectionViews[xr::StereoView::Count];
+        for (uint32_t i = 0; i < xr::StereoView::Count; i++) {
+            projectionViews[i] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
+            projectionViews[i].pose = m_views[i].pose;
+            projectionViews[i].fov = m_views[i].fov;
+            projectionViews[i].subImage.swapchain = swapchain->handle;
+            projectionViews[i].subImage.imageRect = {
+                {0, 0}, {(int32_t)swapchain->createInfo.width, (int32_t)swapchain->createInfo.height}};
+            projectionViews[i].subImage.imageArrayIndex = swapchain->createInfo.arraySize > i ? i : 0;
+        }
+
+        XrCompositionLayerProjection projectionLayer{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+        projectionLayer.space = m_session.localSpace();
+        projectionLayer.viewCount = xr::StereoView::Count;
+        projectionLayer.views = projectionViews;
+        const XrCompositionLayerBaseHeader* layers[] = {
+            reinterpret_cast<const XrCompositionLayerBaseHeader*>(&projectionLayer)};
+        endInfo.layerCount = (uint32_t)std::size(layers);
+        endInfo.layers = layers;
+        const XrResult result = m_xrEndFrame(m_session.handle(), &endInfo);
+
+        // The next frame only submits a layer if it renders a new image.
+        m_lastReleasedSwapchain = XR_NULL_HANDLE;
+        return result;
+    }
+
+} // namespace virtualdesktop_openxr::test
@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "runtime_harness.h"
+
+namespace virtualdesktop_openxr::test {
+
+    // Replays the call stream of a recording made by utils::CallRecorder against a TestSession, to reproduce the load
+    // that an application put on the runtime and measure the cost of each entry point. The calls are issued from the
+    // calling thread in the order they started, and the time the application spent between two calls is reproduced
+    // with a busy wait. The handles of the recording are mapped: the instance and session to the TestInstance and
+    // TestSession, and the reference spaces and swapchains to new ones created from the recorded create infos. Times
+    // are rebased onto the frame timing of the session.
+    //
+    // Since only the top-level arguments are recorded, xrEndFrame() submits one projection layer with the swapchain
+    // released last and the views located last, instead of the recorded layers. The calls the driver does not know,
+    // and those with handles it did not map (eg: action spaces), are skipped. In particular, the action calls
+    // (xrSyncActions(), xrGetActionState*(), ...) are not replayed, since the recording lacks the action sets and
+    // bindings they depend on: the replay does not measure the cost of input.
+    class CallReplay {
+      public:
+        struct EntryPointCost {
+            uint32_t numReplayed{0};
+            uint32_t numSkipped{0};
+            uint32_t numFailed{0}; // Failed on replay but not on the recording.
+
+            // Total duration of the replayed calls, on the recording and on the replay.
+            double recordedMicroseconds{0};
+            double replayedMicroseconds{0};
+        };
+
+        CallReplay(const TestInstance& instance, const TestSession& session);
+        ~CallReplay();
+
+        void run(const utils::CallRecording& recording, bool reproduceGaps = true);
+
+        // By entry point name.
+        const std::map<std::string, EntryPointCost>& costs() const {
+            return m_costs;
+        }
+
+      private:
+        // Longer gaps, such as the loading of a level, are shortened to keep the replay short.
+        static constexpr std::chrono::milliseconds k_maxGap{100};
+
+        struct ReplayedSwapchain {
+            XrSwapchain handle{XR_NULL_HANDLE};
+            XrSwapchainCreateInfo createInfo{};
+        };
+
+        // Returns no value when the call is skipped.
+        std::optional<XrResult> replay(const utils::CallRecording::Call& call);
+
+        template <typename T>
+        std::optional<T> mapArgument(const utils::CallRecording::Argument& argument) const;
+        template <typename T>
+        std::optional<T> mapHandle(T handle) const;
+        template <typename T>
+        void addHandle(const utils::CallRecording::Argument& argument, T handle);
+
+        XrTime rebase(XrTime time) const {
+            return time ? time + m_timeOffset : time;
+        }
+
+        XrResult endFrame(const XrFrameEndInfo& recordedEndInfo);
+
+        const TestInstance& m_instance;
+        const TestSession& m_session;
+
+        std::map<uint64_t, uint64_t> m_handles;
+        std::vector<XrSpace> m_spaces;
+        std::vector<ReplayedSwapchain> m_swapchains;
+        XrSwapchain m_lastReleasedSwapchain{XR_NULL_HANDLE};
+        XrView m_views[xr::StereoView::Count]{{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+        XrTime m_timeOffset{0};
+
+        std::map<std::string, EntryPointCost> m_costs;
+
+        PFN_xrPollEvent m_xrPollEvent{nullptr};
+        PFN_xrStringToPath m_xrStringToPath{nullptr};
+        PFN_xrCreateReferenceSpace m_xrCreateReferenceSpace{nullptr};
+        PFN_xrDestroySpace m_xrDestroySpace{nullptr};
+        PFN_xrLocateSpace m_xrLocateSpace{nullptr};
+        PFN_xrLocateViews m_xrLocateViews{nullptr};
+        PFN_xrCreateSwapchain m_xrCreateSwapchain{nullptr};
+        PFN_xrDestroySwapchain m_xrDestroySwapchain{nullptr};
+        PFN_xrAcquireSwapchainImage m_xrAcquireSwapchainImage{nullptr};
+        PFN_xrWaitSwapchainImage m_xrWaitSwapchainImage{nullptr};
+        PFN_xrReleaseSwapchainImage m_xrReleaseSwapchainImage{nullptr};
+        PFN_xrWaitFrame m_xrWaitFrame{nullptr};
+        PFN_xrBeginFrame m_xrBeginFrame{nullptr};
+        PFN_xrEndFrame m_xrEndFrame{nullptr};
+    };
+
+} // namespace virtualdesktop_openxr::test
@@ -0,0 +1,228 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+
+    // A session with a grip pose action and a trigger action for both hands, and the action spaces of the grips. The
+    // readers use the same calls as an application locating its controllers from worker threads.
+    struct ContentionFixture {
+        ContentionFixture(const standin::Configuration& configuration)
+            : instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME}), session(instance, configuration) {
+            handPaths = {instance.stringToPath("/user/hand/left"), instance.stringToPath("/user/hand/right")};
+
+            actionSet = CreateActionSet(instance, "gameplay");
+            gripAction = CreateAction(instance, actionSet, "grip", XR_ACTION_TYPE_POSE_INPUT, handPaths);
+            triggerAction = CreateAction(instance, actionSet, "trigger", XR_ACTION_TYPE_BOOLEAN_INPUT, handPaths);
+            SuggestBindings(instance,
+                            "/interaction_profiles/oculus/touch_controller",
+                            {{gripAction, "/user/hand/left/input/grip/pose"},
+                             {gripAction, "/user/hand/right/input/grip/pose"},
+                             {triggerAction, "/user/hand/left/input/trigger/value"},
+                             {triggerAction, "/user/hand/right/input/trigger/value"}});
+            AttachActionSets(instance, session.handle(), {actionSet});
+
+            for (uint32_t side = 0; side < 2; side++) {
+                XrActionSpaceCreateInfo createInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+                createInfo.action = gripAction;
+                createInfo.subactionPath = handPaths[side];
+                createInfo.poseInActionSpace = xr::math::Pose::Identity();
+                CHECK_XRCMD(instance.get<PFN_xrCreateActionSpace>("xrCreateActionSpace")(
+                    session.handle(), &createInfo, &gripSpaces[side]));
+            }
+
+            xrSyncActions = instance.get<PFN_xrSyncActions>("xrSyncActions");
+            xrLocateSpace = instance.get<PFN_xrLocateSpace>("xrLocateSpace");
+            xrGetActionStateBoolean = instance.get<PFN_xrGetActionStateBoolean>("xrGetActionStateBoolean");
+            xrGetActionStatePose = instance.get<PFN_xrGetActionStatePose>("xrGetActionStatePose");
+
+            // Pull the trigger of both controllers, and reach the focused state, where the actions are synced.
+            ovrInputState inputState{};
+            inputState.IndexTrigger[0] = inputState.IndexTrigger[1] = 1.f;
+            standin::SetInputState(inputState);
+            for (int i = 0; i < 3; i++) {
+                session.runFrame();
+            }
+            displayTime = session.waitFrame().predictedDisplayTime;
+            session.beginFrame();
+            session.renderFrame(displayTime);
+            session.endFrame(displayTime);
+            REQUIRE(syncActions() == XR_SUCCESS);
+        }
+
+        XrResult syncActions() {
+            XrActiveActionSet activeActionSet{actionSet, XR_NULL_PATH};
+            XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+            syncInfo.countActiveActionSets = 1;
+            syncInfo.activeActionSets = &activeActionSet;
+            return xrSyncActions(session.handle(), &syncInfo);
+        }
+
+        // What a worker thread of the application does for one controller. Returns whether all calls succeeded and
+        // returned the expected state.
+        bool readController(uint32_t side) {
+            XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+            if (XR_FAILED(xrLocateSpace(gripSpaces[side], session.localSpace(), displayTime, &location)) ||
+                !(location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)) {
+                return false;
+            }
+
+            XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            getInfo.subactionPath = handPaths[side];
+            getInfo.action = triggerAction;
+            XrActionStateBoolean triggerState{XR_TYPE_ACTION_STATE_BOOLEAN};
+            if (XR_FAILED(xrGetActionStateBoolean(session.handle(), &getInfo, &triggerState)) ||
+                !triggerState.isActive || !triggerState.currentState) {
+                return false;
+            }
+
+            getInfo.action = gripAction;
+            XrActionStatePose gripState{XR_TYPE_ACTION_STATE_POSE};
+            if (XR_FAILED(xrGetActionStatePose(session.handle(), &getInfo, &gripState)) || !gripState.isActive) {
+                return false;
+            }
+
+            return true;
+        }
+
+        TestInstance instance;
+        TestSession session;
+        std::vector<XrPath> handPaths;
+        XrActionSet actionSet{XR_NULL_HANDLE};
+        XrAction gripAction{XR_NULL_HANDLE};
+        XrAction triggerAction{XR_NULL_HANDLE};
+        XrSpace gripSpaces[2]{};
+        XrTime displayTime{0};
+
+        PFN_xrSyncActions xrSyncActions{nullptr};
+        PFN_xrLocateSpace xrLocateSpace{nullptr};
+        PFN_xrGetActionStateBoolean xrGetActionStateBoolean{nullptr};
+        PFN_xrGetActionStatePose xrGetActionStatePose{nullptr};
+    };
+
+    // Run readers on worker threads for a fixed duration, optionally with a writer syncing the actions in a loop on
+    // another thread. Returns the average time of one read, as seen by each reader.
+    double MeasureReaders(ContentionFixture& fixture, uint32_t numReaders, bool withWriter) {
+        std::atomic<bool> stop{false};
+        std::atomic<uint32_t> numReady{0};
+        std::atomic<uint64_t> numReads{0};
+        std::atomic<uint32_t> numFailures{0};
+
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < numReaders; i++) {
+            threads.emplace_back([&, i] {
+                numReady++;
+                uint64_t count = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (!fixture.readController(i % 2)) {
+                        numFailures++;
+                    }
+                    count++;
+                }
+                numReads += count;
+            });
+        }
+        if (withWriter) {
+            threads.emplace_back([&] {
+                numReady++;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (XR_FAILED(fixture.syncActions())) {
+                        numFailures++;
+                    }
+                }
+            });
+        }
+
+        while (numReady < threads.size()) {
+            std::this_thread::yield();
+        }
+        const auto start = std::chrono::high_resolution_clock::now();
+        std::this_thread::sleep_for(250ms);
+        stop = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+        CHECK(numFailures == 0);
+        return elapsed.count() * numReaders / std::max(numReads.load(), (uint64_t)1);
+    }
+
+} // namespace
+
+TEST_CASE("contention: readers alongside the frame loop and xrSyncActions") {
+    standin::Configuration configuration;
+    configuration.paceFrames = false;
+    ContentionFixture fixture(configuration);
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> numFailures{0};
+    std::atomic<uint64_t> numReads{0};
+    std::vector<std::thread> readers;
+    for (uint32_t i = 0; i < 4; i++) {
+        readers.emplace_back([&, i] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (!fixture.readController(i % 2)) {
+                    numFailures++;
+                }
+                numReads++;
+            }
+        });
+    }
+
+    // The application thread keeps running frames and syncing the actions, which takes the exclusive lock.
+    for (int i = 0; i < 200; i++) {
+        const XrTime displayTime = fixture.session.waitFrame().predictedDisplayTime;
+        fixture.session.beginFrame();
+        CHECK(fixture.syncActions() == XR_SUCCESS);
+        fixture.session.renderFrame(displayTime);
+        fixture.session.endFrame(displayTime);
+    }
+
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    CHECK(numFailures == 0);
+    CHECK(numReads > 0);
+}
+
+BENCHMARK("contention: locate and get action states from worker threads") {
+    standin::Configuration configuration;
+    configuration.paceFrames = false;
+    ContentionFixture fixture(configuration);
+
+    Measure("1 thread, no contention", [&] { DoNotOptimize(fixture.readController(0)); });
+
+    for (uint32_t numReaders : {1u, 2u, 4u, 8u}) {
+        ReportMeasurement(fmt::format("{} readers", numReaders).c_str(), MeasureReaders(fixture, numReaders, false));
+        ReportMeasurement(fmt::format("{} readers + xrSyncActions writer", numReaders).c_str(),
+                          MeasureReaders(fixture, numReaders, true));
+    }
+}
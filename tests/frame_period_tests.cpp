@@ -0,0 +1,234 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    constexpr double IdealPeriod = 1 / 90.0;
+
+    // One application frame, as reported by the compositor once it was presented.
+    struct PresentedFrame {
+        int vsyncs;       // How many vsyncs since the previous application frame.
+        bool isAswActive; // Whether ASW was active when the frame was presented.
+    };
+
+    // A trace of presented frames, built from runs of identical frames.
+    std::vector<PresentedFrame> Trace(std::initializer_list<std::pair<uint32_t, PresentedFrame>> runs) {
+        std::vector<PresentedFrame> trace;
+        for (const auto& run : runs) {
+            trace.insert(trace.end(), run.first, run.second);
+        }
+        return trace;
+    }
+
+    // Replay a trace through the estimator the way the runtime does at every xrBeginFrame(): by passing the content of
+    // ovrPerfStats, which holds the most recent frames first, up to ovrMaxProvidedFrameStats of them. framesPerCall
+    // frames are presented between two calls (fewer for the last one), and the statistics overlap when it is smaller
+    // than the history.
+    // Returns the period reported to the application after each call.
+    std::vector<double> Replay(FramePeriodEstimator& estimator,
+                               const std::vector<PresentedFrame>& trace,
+                               uint32_t framesPerCall = 1,
+                               int firstAppFrameIndex = 1000,
+                               int firstVsyncIndex = 5000) {
+        struct Sample {
+            int appFrameIndex;
+            int hmdVsyncIndex;
+            bool isAswActive;
+        };
+        std::vector<Sample> presented;
+        int vsyncIndex = firstVsyncIndex;
+        for (size_t i = 0; i < trace.size(); i++) {
+            vsyncIndex += trace[i].vsyncs;
+            presented.push_back({firstAppFrameIndex + (int)i, vsyncIndex, trace[i].isAswActive});
+        }
+
+        std::vector<double> periods;
+        for (size_t end = 0; end < presented.size();) {
+            end = std::min(end + framesPerCall, presented.size());
+
+            ovrPerfStats stats{};
+            stats.FrameStatsCount = (int)std::min<size_t>(end, ovrMaxProvidedFrameStats);
+            for (int i = 0; i < stats.FrameStatsCount; i++) {
+                const Sample& sample = presented[end - 1 - i];
+                stats.FrameStats[i].AppFrameIndex = sample.appFrameIndex;
+                stats.FrameStats[i].HmdVsyncIndex = sample.hmdVsyncIndex;
+                stats.FrameStats[i].AswIsActive = sample.isAswActive;
+            }
+
+            for (int i = stats.FrameStatsCount - 1; i >= 0; i--) {
+                estimator.addSample(stats.FrameStats[i].AppFrameIndex,
+                                    stats.FrameStats[i].HmdVsyncIndex,
+                                    stats.FrameStats[i].AswIsActive);
+            }
+            periods.push_back(estimator.period());
+        }
+        return periods;
+    }
+
+    constexpr PresentedFrame FullRate{1, false};
+    constexpr PresentedFrame DroppedFrame{2, false};
+    constexpr PresentedFrame HalfRateAsw{2, true};
+
+} // namespace
+
+TEST_CASE("frame period: steady full rate") {
+    FramePeriodEstimator estimator;
+    estimator.reset(IdealPeriod);
+
+    const auto periods = Replay(estimator, Trace({{600, FullRate}}));
+    for (const double period : periods) {
+        CHECK(period == IdealPeriod);
+    }
+    CHECK(!estimator.isAswEngaged());
+    CHECK_NEAR(estimator.measuredPeriod(), IdealPeriod, 1e-9);
+}
+
+TEST_CASE("frame period: ASW engages after a few samples") {
+    FramePeriodEstimator estimator;
+    estimator.reset(IdealPeriod);
+
+    const auto periods = Replay(estimator, Trace({{100, FullRate}, {100, HalfRateAsw}}));
+    CHECK(periods[99] == IdealPeriod);
+    CHECK(periods[100] == IdealPeriod);
+    CHECK(periods[101] == IdealPeriod);
+    CHECK(periods[102] == IdealPeriod * 2);
+    CHECK(periods.back() == IdealPeriod * 2);
+    CHECK(estimator.isAswEngaged());
+    CHECK_NEAR(estimator.measuredPeriod(), IdealPeriod * 2, IdealPeriod * 0.01);
+}
+
+TEST_CASE("frame period: ASW disengages only once it stays off") {
+    FramePeriodEstimator estimator;
+    estimator.reset(IdealPeriod);
+
+    // Short dips of ASW do not bring back the full rate.
+    auto periods = Replay(estimator,
+                          Trace({{100, HalfRateAsw},
+                                 {29, FullRate},
+                                 {1, HalfRateAsw},
+                                 {29, FullRate},
+                                 {1, HalfRateAsw}}));
+    for (size_t i = 2; i < periods.size(); i++) {
+        CHECK(periods[i] == IdealPeriod * 2);
+    }
+
+    // But a long enough run does.
+    periods = Replay(estimator, Trace({{30, FullRate}, {10, FullRate}}), 1, 2000, 10000);
+    CHECK(periods[28] == IdealPeriod * 2);
+    CHECK(periods[29] == IdealPeriod);
+    CHECK(periods.back() == IdealPeriod);
+}
+
+TEST_CASE("frame period: flickering ASW does not engage") {
+    FramePeriodEstimator estimator;
+    estimator.reset(IdealPeriod);
+
+    std::vector<PresentedFrame> trace;
+    for (int i = 0; i < 100; i++) {
+        trace.push_back(i % 3 == 2 ? FullRate : HalfRateAsw);
+    }
+    const auto periods = Replay(estimator, trace);
+    for (const double period : periods) {
+        CHECK(period == IdealPeriod);
+    }
+}
+
+TEST_CASE("frame period: dropped frames without ASW") {
+    FramePeriodEstimator estimator;
+    estimator.reset(IdealPeriod);
+
+    // One frame in four takes two vsyncs: the measured period reflects it, but the period does not change.
+    std::vector<PresentedFrame> trace;
+    for (int i = 0; i < 400; i++) {
+        trace.push_back(i % 4 == 3 ? DroppedFrame : FullRate);
+    }
+    const auto periods = Replay(estimator, trace);
+    for (const double period : periods) {
+        CHECK(period == IdealPeriod);
+    }
+    CHECK_NEAR(estimator.measuredPeriod(), IdealPeriod * 1.25, IdealPeriod * 0.15);
+}
+
+TEST_CASE("frame period: sustained slow frames without ASW") {
+    FramePeriodEstimator estimator;
+    estimator.reset(IdealPeriod);
+
+    // The application only makes every third vsync, and ASW is off: the period follows, as a whole number of vsyncs.
+    constexpr PresentedFrame ThirdRate{3, false};
+    auto periods = Replay(estimator, Trace({{100, FullRate}, {100, ThirdRate}}));
+    CHECK(periods[100] == IdealPeriod);
+    for (size_t i = 150; i < periods.size(); i++) {
+        CHECK(periods[i] == IdealPeriod * 3);
+    }
+    CHECK(!estimator.isAswEngaged());
+
+    // The period never goes through values that are not a multiple of the vsync period on its way back.
+    periods = Replay(estimator, Trace({{100, FullRate}}), 1, 2000, 10000);
+    for (const double period : periods) {
+        const double vsyncs = period / IdealPeriod;
+        CHECK_NEAR(vsyncs, std::round(vsyncs), 1e-9);
+    }
+    CHECK(periods.back() == IdealPeriod);
+}
+
+TEST_CASE("frame period: overlapping statistics are only counted once") {
+    const auto trace = Trace({{50, FullRate}, {20, HalfRateAsw}, {40, FullRate}, {50, DroppedFrame}});
+
+    // The same trace, with the compositor returning its full history at every frame, or several new frames per call.
+    FramePeriodEstimator reference;
+    reference.reset(IdealPeriod);
+    Replay(reference, trace, ovrMaxProvidedFrameStats);
+
+    for (uint32_t framesPerCall = 1; framesPerCall <= ovrMaxProvidedFrameStats; framesPerCall++) {
+        FramePeriodEstimator estimator;
+        estimator.reset(IdealPeriod);
+        Replay(estimator, trace, framesPerCall);
+        CHECK(estimator.isAswEngaged() == reference.isAswEngaged());
+        CHECK(estimator.period() == reference.period());
+        CHECK(estimator.measuredPeriod() == reference.measuredPeriod());
+    }
+}
+
+TEST_CASE("frame period: reset") {
+    FramePeriodEstimator estimator;
+    estimator.reset(IdealPeriod);
+    Replay(estimator, Trace({{100, HalfRateAsw}}));
+    REQUIRE(estimator.isAswEngaged());
+
+    // A new session (or a new refresh rate) starts over, and the frame indices may start over too.
+    estimator.reset(1 / 120.0);
+    CHECK(!estimator.isAswEngaged());
+    CHECK(estimator.period() == 1 / 120.0);
+    CHECK(estimator.measuredPeriod() == 1 / 120.0);
+    Replay(estimator, Trace({{10, FullRate}}), 1, 0, 0);
+    CHECK(estimator.period() == 1 / 120.0);
+    CHECK_NEAR(estimator.measuredPeriod(), 1 / 120.0, 1e-9);
+}
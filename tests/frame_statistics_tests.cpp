@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    // The samples are derived from the raw output of the engine rather than with the standard distributions, whose
+    // implementations differ between standard libraries, so that the same samples are checked everywhere.
+    double Uniform(std::mt19937& random) {
+        return (random() + 0.5) / 4294967296.0;
+    }
+
+    double Normal(std::mt19937& random) {
+        const double u1 = Uniform(random);
+        const double u2 = Uniform(random);
+        return std::sqrt(-2 * std::log(u1)) * std::cos(2 * 3.14159265358979323846 * u2);
+    }
+
+    // The nearest-rank quantile of the samples, as the reference for the estimates.
+    double ReferenceQuantile(std::vector<double> samples, double quantile) {
+        std::sort(samples.begin(), samples.end());
+        return samples[std::min((size_t)(quantile * samples.size()), samples.size() - 1)];
+    }
+
+    // Feed the samples to an estimator of each quantile, and check the estimates against the sorted samples. The
+    // tolerance is relative to the spread of the samples, since P-square does not bound the error of a single estimate.
+    template <typename Distribution>
+    void CheckAgainstReference(Distribution distribution, uint32_t numSamples, double tolerance) {
+        std::mt19937 random(1);
+        std::vector<double> samples;
+        for (uint32_t i = 0; i < numSamples; i++) {
+            samples.push_back(distribution(random));
+        }
+        const auto [minSample, maxSample] = std::minmax_element(samples.cbegin(), samples.cend());
+        const double spread = *maxSample - *minSample;
+
+        for (const double quantile : {0.5, 0.9, 0.99}) {
+            QuantileEstimator estimator(quantile);
+            for (const double sample : samples) {
+                estimator.add(sample);
+            }
+            CHECK_NEAR(estimator.value(), ReferenceQuantile(samples, quantile), tolerance * spread);
+        }
+    }
+
+    FrameRecord MakeRecord(double endTime, uint64_t appCpuUs) {
+        FrameRecord record;
+        record.endTime = endTime;
+        record.set(FrameMetric::AppCpu, appCpuUs);
+        return record;
+    }
+
+} // namespace
+
+TEST_CASE("frame statistics: quantile estimates of a uniform distribution") {
+    CheckAgainstReference([](std::mt19937& random) { return 1000 + 1000 * Uniform(random); }, 10000, 0.01);
+}
+
+TEST_CASE("frame statistics: quantile estimates of a normal distribution") {
+    CheckAgainstReference([](std::mt19937& random) { return 5000 + 500 * Normal(random); }, 10000, 0.01);
+}
+
+TEST_CASE("frame statistics: quantile estimates of a long-tailed distribution") {
+    // Frame times are mostly steady, with occasional long frames.
+    CheckAgainstReference([](std::mt19937& random) { return std::exp(8 + 0.5 * Normal(random)); }, 10000, 0.02);
+}
+
+TEST_CASE("frame statistics: quantile estimates with fewer samples than markers") {
+    QuantileEstimator estimator(0.5);
+    CHECK(estimator.value() == 0);
+
+    const std::vector<double> samples = {300, 100, 400, 200};
+    std::vector<double> added;
+    for (const double sample : samples) {
+        estimator.add(sample);
+        added.push_back(sample);
+        CHECK(estimator.value() == ReferenceQuantile(added, 0.5));
+    }
+
+    estimator.reset();
+    CHECK(estimator.value() == 0);
+    estimator.add(42);
+    CHECK(estimator.value() == 42);
+}
+
+TEST_CASE("frame statistics: recent records and frame rate") {
+    FrameStatistics statistics;
+    constexpr double period = 1 / 90.0;
+    constexpr uint32_t numFrames = FrameStatistics::Capacity + 100;
+    for (uint32_t i = 0; i < numFrames; i++) {
+        FrameRecord record = MakeRecord(i * period, i);
+        record.discarded = i % 10 == 0;
+        statistics.record(record);
+    }
+
+    CHECK(statistics.numFrames() == numFrames);
+    CHECK(statistics.numDiscarded() == (numFrames + 9) / 10);
+    CHECK(statistics.size() == FrameStatistics::Capacity);
+    for (uint32_t age = 0; age < statistics.size(); age++) {
+        CHECK(statistics.recent(age).durationUs[(uint32_t)FrameMetric::AppCpu] == numFrames - 1 - age);
+    }
+    CHECK(statistics.framesPerSecond() == 90);
+
+    statistics.reset();
+    CHECK(statistics.numFrames() == 0);
+    CHECK(statistics.size() == 0);
+    CHECK(statistics.quantileUs(FrameMetric::AppCpu, FrameStatistics::P50) == 0);
+}
+
+TEST_CASE("frame statistics: percentiles cover the whole session") {
+    // More frames than the ring of recent records holds, with a shift of the frame times half-way. The percentiles
+    // include the frames that left the ring.
+    FrameStatistics statistics;
+    constexpr uint32_t numFrames = 4 * FrameStatistics::Capacity;
+    std::mt19937 random(1);
+    std::vector<double> samples;
+    for (uint32_t i = 0; i < numFrames; i++) {
+        samples.push_back(std::round((i < numFrames / 2 ? 2000 : 6000) + 100 * Normal(random)));
+        statistics.record(MakeRecord(i / 90.0, (uint64_t)samples.back()));
+    }
+
+    // Some metrics were never measured.
+    CHECK(statistics.quantileUs(FrameMetric::AppGpu, FrameStatistics::P50) == 0);
+
+    // The median is between the two halves, not within the recent frames.
+    const double p50 = statistics.quantileUs(FrameMetric::AppCpu, FrameStatistics::P50);
+    CHECK(p50 > 2000 && p50 < 6000);
+    CHECK_NEAR(statistics.quantileUs(FrameMetric::AppCpu, FrameStatistics::P90), ReferenceQuantile(samples, 0.9), 100);
+    CHECK_NEAR(
+        statistics.quantileUs(FrameMetric::AppCpu, FrameStatistics::P99), ReferenceQuantile(samples, 0.99), 100);
+}
@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    // A view of the performance counters published by the runtime, the way a monitoring tool would open it.
+    struct CountersView {
+        CountersView() {
+            *file.put() = OpenFileMapping(FILE_MAP_READ, FALSE, PerformanceCounters::k_name);
+            if (file) {
+                counters = reinterpret_cast<const PerformanceCounters*>(
+                    MapViewOfFile(file.get(), FILE_MAP_READ, 0, 0, sizeof(PerformanceCounters)));
+            }
+        }
+
+        ~CountersView() {
+            if (counters) {
+                UnmapViewOfFile(counters);
+            }
+        }
+
+        wil::unique_handle file;
+        const PerformanceCounters* counters{nullptr};
+    };
+
+    float LastUs(const PerformanceCounters::Snapshot& snapshot, FrameMetric metric) {
+        return snapshot.metrics[(uint32_t)metric].lastUs;
+    }
+
+    // Run frames and check that, for every frame recorded in the statistics, the pose age, the runtime latency and the
+    // compositor latency add up to the prediction horizon. Each of them is truncated to the microsecond.
+    void CheckLatencyBreakdown(const Settings& settings) {
+        TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME}, settings);
+        TestSession session(instance, {90.f, true, 3});
+        CountersView view;
+        REQUIRE(view.counters);
+
+        constexpr uint32_t numFrames = 60;
+        uint64_t lastNumFrames = 0;
+        uint32_t numChecked = 0;
+        for (uint32_t i = 0; i < numFrames; i++) {
+            session.runFrame();
+
+            PerformanceCounters::Snapshot snapshot;
+            REQUIRE(readPerformanceCounters(*view.counters, snapshot));
+            if (snapshot.numFrames == lastNumFrames) {
+                continue;
+            }
+            CHECK(snapshot.numFrames == lastNumFrames + 1);
+            lastNumFrames = snapshot.numFrames;
+
+            const float poseAge = LastUs(snapshot, FrameMetric::PoseAge);
+            const float runtimeLatency = LastUs(snapshot, FrameMetric::RuntimeLatency);
+            const float compositorLatency = LastUs(snapshot, FrameMetric::CompositorLatency);
+            const float horizon = LastUs(snapshot, FrameMetric::PredictionHorizon);
+            CHECK(runtimeLatency > 0);
+            CHECK(horizon > 0);
+            CHECK_NEAR(poseAge + runtimeLatency + compositorLatency, horizon, 3.f);
+            numChecked++;
+        }
+
+        // With asynchronous submission, a frame is only recorded once its slot in the submission queue is reused.
+        CHECK(numChecked + 3 >= numFrames);
+    }
+
+} // namespace
+
+TEST_CASE("latency breakdown: synchronous submission") {
+    CheckLatencyBreakdown({{"async_submission", 0}});
+}
+
+TEST_CASE("latency breakdown: asynchronous submission") {
+    for (int depth = 1; depth <= 3; depth++) {
+        CheckLatencyBreakdown({{"async_submission_depth", depth}});
+    }
+}
@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+
+    void CheckSameEyeFovLayer(const ovrLayerEyeFov& hit, const ovrLayerEyeFov& miss) {
+        CHECK(hit.Header.Type == miss.Header.Type);
+        CHECK(hit.Header.Flags == miss.Header.Flags);
+        for (int eye = 0; eye < ovrEye_Count; eye++) {
+            CHECK(hit.ColorTexture[eye] == miss.ColorTexture[eye]);
+            CHECK(!memcmp(&hit.Viewport[eye], &miss.Viewport[eye], sizeof(ovrRecti)));
+            CHECK(!memcmp(&hit.Fov[eye], &miss.Fov[eye], sizeof(ovrFovPort)));
+            CHECK(!memcmp(&hit.RenderPose[eye], &miss.RenderPose[eye], sizeof(ovrPosef)));
+        }
+    }
+
+} // namespace
+
+TEST_CASE("layer cache: a cache hit submits the same layers as a full translation") {
+    TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME}, {{"async_submission", 0}});
+    TestSession session(instance, {90.f, false, 3});
+
+    // A head pose that is not the identity, so that the render poses depend on it.
+    ovrPosef headPose{};
+    headPose.Orientation = {0.f, 0.38268343f, 0.f, 0.92387953f};
+    headPose.Position = {0.1f, 1.6f, -0.2f};
+    standin::SetDevicePose(ovrTrackedDevice_HMD, headPose);
+
+    // The first frame is translated fully, and the second frame has the same topology.
+    session.runFrame();
+    session.runFrame();
+    const standin::SubmittedFrame hit = standin::GetSubmittedFrames().back();
+
+    // Destroying any space invalidates the cache, so that the third frame, identical to the second, is translated
+    // fully again.
+    XrReferenceSpaceCreateInfo createInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+    createInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+    createInfo.poseInReferenceSpace.orientation.w = 1.f;
+    XrSpace space = XR_NULL_HANDLE;
+    CHECK_XRCMD(
+        instance.get<PFN_xrCreateReferenceSpace>("xrCreateReferenceSpace")(session.handle(), &createInfo, &space));
+    CHECK_XRCMD(instance.get<PFN_xrDestroySpace>("xrDestroySpace")(space));
+    session.runFrame();
+    const standin::SubmittedFrame miss = standin::GetSubmittedFrames().back();
+
+    REQUIRE(hit.layerCount == 1);
+    REQUIRE(miss.layerCount == 1);
+    REQUIRE(miss.layers[0].Header.Type == ovrLayerType_EyeFov);
+    CheckSameEyeFovLayer(hit.layers[0].EyeFov, miss.layers[0].EyeFov);
+
+    // Only the sample time is expected to differ, since it is the display time of each frame.
+    CHECK(hit.layers[0].EyeFov.SensorSampleTime < miss.layers[0].EyeFov.SensorSampleTime);
+}
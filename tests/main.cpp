@@ -0,0 +1,111 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "test.h"
+
+namespace virtualdesktop_openxr::test {
+
+    namespace {
+        std::atomic<uint32_t> g_numFailures = 0;
+        bool g_enforceTimingChecks = true;
+    } // namespace
+
+    std::vector<TestCase>& GetTestCases() {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    void ReportFailure(const char* file, int line, const char* expression) {
+        g_numFailures++;
+        fprintf(stderr, "    %s(%d): check failed: %s\n", file, line, expression);
+    }
+
+    void ReportTimingFailure(const char* file, int line, const char* expression) {
+        if (g_enforceTimingChecks) {
+            ReportFailure(file, line, expression);
+        } else {
+            fprintf(stderr, "    %s(%d): timing check failed (not enforced): %s\n", file, line, expression);
+        }
+    }
+
+} // namespace virtualdesktop_openxr::test
+
+using namespace virtualdesktop_openxr::test;
+
+// Usage: tests [--benchmark] [--no-timing-checks] [filter]
+// Runs all the test cases (or the benchmarks) whose name contains the filter.
+int main(int argc, char** argv) {
+    bool runBenchmarks = false;
+    std::string_view filter;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--benchmark") {
+            runBenchmarks = true;
+        } else if (arg == "--no-timing-checks") {
+            g_enforceTimingChecks = false;
+        } else {
+            filter = arg;
+        }
+    }
+
+    uint32_t numRun = 0;
+    uint32_t numFailed = 0;
+    uint32_t numSkipped = 0;
+    for (const auto& testCase : GetTestCases()) {
+        if (testCase.isBenchmark != runBenchmarks || std::string_view(testCase.name).find(filter) == std::string::npos) {
+            continue;
+        }
+
+        printf("[ RUN  ] %s\n", testCase.name);
+        fflush(stdout);
+
+        const uint32_t failuresBefore = g_numFailures;
+        bool skipped = false;
+        try {
+            testCase.function();
+        } catch (TestCaseAborted&) {
+        } catch (TestCaseSkipped& skip) {
+            printf("    skipped: %s\n", skip.reason.c_str());
+            skipped = true;
+        } catch (std::exception& exc) {
+            ReportFailure(__FILE__, __LINE__, exc.what());
+        }
+
+        numRun++;
+        if (skipped) {
+            numSkipped++;
+            printf("[ SKIP ] %s\n", testCase.name);
+        } else if (g_numFailures != failuresBefore) {
+            numFailed++;
+            printf("[ FAIL ] %s\n", testCase.name);
+        } else {
+            printf("[  OK  ] %s\n", testCase.name);
+        }
+        fflush(stdout);
+    }
+
+    printf("%u run, %u failed, %u skipped\n", numRun, numFailed, numSkipped);
+
+    return numFailed ? 1 : 0;
+}
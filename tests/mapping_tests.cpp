@@ -0,0 +1,170 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    // The components of the Valve Index controller, the largest of the interaction profiles.
+    constexpr const char* k_indexComponents[] = {
+        "/input/system/click",     "/input/system",           "/input/system/touch",   "/input/a/click",
+        "/input/a",                "/input/a/touch",          "/input/b/click",        "/input/b",
+        "/input/b/touch",          "/input/squeeze/click",    "/input/squeeze/value",  "/input/squeeze",
+        "/input/squeeze/force",    "/input/trigger/click",    "/input/trigger/value",  "/input/trigger",
+        "/input/trigger/touch",    "/input/thumbstick",       "/input/thumbstick/x",   "/input/thumbstick/y",
+        "/input/thumbstick/click", "/input/thumbstick/touch", "/input/trackpad",       "/input/trackpad/x",
+        "/input/trackpad/y",       "/input/trackpad/force",   "/input/trackpad/touch", "/input/grip/pose",
+        "/input/grip",             "/input/aim/pose",         "/input/aim",            "/output/haptic",
+    };
+
+    constexpr PerfectHashEntry<int> k_testEntries[] = {
+        {"/input/system/click", 0},     {"/input/system", 1},           {"/input/system/touch", 2},
+        {"/input/a/click", 3},          {"/input/a", 4},                {"/input/a/touch", 5},
+        {"/input/b/click", 6},          {"/input/b", 7},                {"/input/b/touch", 8},
+        {"/input/squeeze/click", 9},    {"/input/squeeze/value", 10},   {"/input/squeeze", 11},
+        {"/input/squeeze/force", 12},   {"/input/trigger/click", 13},   {"/input/trigger/value", 14},
+        {"/input/trigger", 15},         {"/input/trigger/touch", 16},   {"/input/thumbstick", 17},
+        {"/input/thumbstick/x", 18},    {"/input/thumbstick/y", 19},    {"/input/thumbstick/click", 20},
+        {"/input/thumbstick/touch", 21}, {"/input/trackpad", 22},       {"/input/trackpad/x", 23},
+        {"/input/trackpad/y", 24},      {"/input/trackpad/force", 25},  {"/input/trackpad/touch", 26},
+        {"/input/grip/pose", 27},       {"/input/grip", 28},            {"/input/aim/pose", 29},
+        {"/input/aim", 30},             {"/output/haptic", 31},
+    };
+    static_assert(std::size(k_testEntries) == std::size(k_indexComponents));
+
+    // Built at compile time, like the tables of the interaction profiles.
+    constexpr PerfectHashMap k_testMap(k_testEntries);
+
+    // The Index controller bindings for both hands, with an action of a matching type for each component.
+    struct IndexBindingsFixture {
+        IndexBindingsFixture() {
+            actionSet = CreateActionSet(instance, "gameplay");
+            for (size_t i = 0; i < std::size(k_indexComponents); i++) {
+                const std::string_view component = k_indexComponents[i];
+                const XrActionType type = component == "/output/haptic" ? XR_ACTION_TYPE_VIBRATION_OUTPUT
+                                          : component.find("/pose") != std::string_view::npos ||
+                                                  component == "/input/grip" || component == "/input/aim"
+                                              ? XR_ACTION_TYPE_POSE_INPUT
+                                              : XR_ACTION_TYPE_FLOAT_INPUT;
+                const XrAction action = CreateAction(instance, actionSet, fmt::format("component_{}", i), type);
+                for (const char* hand : {"left", "right"}) {
+                    bindings.push_back(
+                        {action, instance.stringToPath(fmt::format("/user/hand/{}{}", hand, component).c_str())});
+                }
+            }
+
+            xrSuggestInteractionProfileBindings =
+                instance.get<PFN_xrSuggestInteractionProfileBindings>("xrSuggestInteractionProfileBindings");
+        }
+
+        XrResult suggest(const char* interactionProfile, const std::vector<XrActionSuggestedBinding>& suggestedBindings) {
+            XrInteractionProfileSuggestedBinding suggestedBinding{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+            suggestedBinding.interactionProfile = instance.stringToPath(interactionProfile);
+            suggestedBinding.countSuggestedBindings = (uint32_t)suggestedBindings.size();
+            suggestedBinding.suggestedBindings = suggestedBindings.data();
+            return xrSuggestInteractionProfileBindings(instance.handle(), &suggestedBinding);
+        }
+
+        TestInstance instance;
+        XrActionSet actionSet{XR_NULL_HANDLE};
+        std::vector<XrActionSuggestedBinding> bindings;
+
+        PFN_xrSuggestInteractionProfileBindings xrSuggestInteractionProfileBindings{nullptr};
+    };
+
+} // namespace
+
+TEST_CASE("mappings: perfect hash finds every key") {
+    for (const auto& entry : k_testEntries) {
+        const int* const value = k_testMap.find(entry.key);
+        REQUIRE(value);
+        CHECK(*value == entry.value);
+    }
+
+    // Lookups through a view, as the interaction profiles table stores them, give the same results.
+    const PerfectHashView<int> view = k_testMap.view();
+    for (const auto& entry : k_testEntries) {
+        CHECK(view.find(entry.key) == k_testMap.find(entry.key));
+    }
+}
+
+TEST_CASE("mappings: perfect hash misses return nullptr") {
+    // Prefixes, extensions and near-misses of the keys, which may hash to an occupied slot.
+    for (const auto& entry : k_testEntries) {
+        const std::string key(entry.key);
+        CHECK(!k_testMap.find(key.substr(0, key.size() - 1)));
+        CHECK(!k_testMap.find(key + "/"));
+        CHECK(!k_testMap.find(key + "/value"));
+        CHECK(!k_testMap.find("/user/hand/left" + key));
+
+        std::string upper = key;
+        std::transform(upper.begin(), upper.end(), upper.begin(), [](char c) { return (char)std::toupper(c); });
+        CHECK(!k_testMap.find(upper));
+    }
+    CHECK(!k_testMap.find(""));
+    CHECK(!k_testMap.find("/"));
+    CHECK(!k_testMap.find("/input/menu/click"));
+
+    // An empty view (a profile without components) finds nothing.
+    CHECK(!PerfectHashView<int>{}.find("/input/system/click"));
+
+    // Many random strings.
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> character('a', 'z');
+    for (int i = 0; i < 10000; i++) {
+        std::string key = "/input/";
+        const size_t length = 1 + random() % 16;
+        for (size_t j = 0; j < length; j++) {
+            key += (char)character(random);
+        }
+        const int* const value = k_testMap.find(key);
+        CHECK(!value || k_testEntries[*value].key == key);
+    }
+}
+
+TEST_CASE("mappings: suggesting the Index controller bindings") {
+    IndexBindingsFixture fixture;
+
+    CHECK(fixture.suggest("/interaction_profiles/valve/index_controller", fixture.bindings) == XR_SUCCESS);
+
+    // A component of another controller, or an unknown profile, are refused.
+    auto bindings = fixture.bindings;
+    bindings.push_back({bindings[0].action, fixture.instance.stringToPath("/user/hand/left/input/menu/click")});
+    CHECK(fixture.suggest("/interaction_profiles/valve/index_controller", bindings) == XR_ERROR_PATH_UNSUPPORTED);
+    CHECK(fixture.suggest("/interaction_profiles/unknown/controller", fixture.bindings) == XR_ERROR_PATH_UNSUPPORTED);
+}
+
+BENCHMARK("mappings: suggesting the Index controller bindings") {
+    IndexBindingsFixture fixture;
+
+    Measure("xrSuggestInteractionProfileBindings (64 bindings)", [&] {
+        DoNotOptimize(fixture.suggest("/interaction_profiles/valve/index_controller", fixture.bindings));
+    });
+}
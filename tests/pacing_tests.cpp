@@ -0,0 +1,497 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    constexpr double VsyncPeriod = 1 / 90.0;
+    constexpr uint32_t MaxDepth = 3;
+
+    // The frame timing of the OVR compositor on a virtual clock: what ovr_WaitToBeginFrame(), ovr_EndFrame() and
+    // ovr_GetPerfStats() would do at a given time. A frame is latched at the first vsync after its submission. After
+    // missing a few frames, the compositor engages ASW and only latches a frame every other vsync, until the
+    // application makes it in time again for a while.
+    // The stand-in LibOVR does not engage ASW, so this model is kept for the tests of ASW transitions and of the
+    // pacing components on a deterministic clock. Frame rates and latencies are measured through the runtime, with
+    // RunSession() below.
+    class FakeCompositor {
+      public:
+        struct Frame {
+            int appFrameIndex;
+            int vsyncIndex;
+            bool isAswActive;
+        };
+
+        // The time ovr_WaitToBeginFrame() returns: once the previous frame was latched.
+        double waitToBeginFrame(double now) const {
+            return m_frames.empty() ? now : std::max(now, m_frames.back().vsyncIndex * VsyncPeriod);
+        }
+
+        void endFrame(int appFrameIndex, double now) {
+            int vsyncIndex = (int)std::floor(now / VsyncPeriod) + 1;
+            if (!m_frames.empty()) {
+                const int lastVsyncIndex = m_frames.back().vsyncIndex;
+                const bool isMissed = vsyncIndex > lastVsyncIndex + 1;
+                vsyncIndex = std::max(vsyncIndex, lastVsyncIndex + (m_isAswActive ? 2 : 1));
+
+                m_recentMisses[m_frames.size() % std::size(m_recentMisses)] = isMissed;
+                m_numOnTime = isMissed ? 0 : m_numOnTime + 1;
+                if (!m_isAswActive && std::count(std::begin(m_recentMisses), std::end(m_recentMisses), true) >= 3) {
+                    m_isAswActive = true;
+                } else if (m_isAswActive && m_numOnTime >= std::size(m_recentMisses)) {
+                    m_isAswActive = false;
+                }
+            }
+            m_frames.push_back({appFrameIndex, vsyncIndex, m_isAswActive});
+        }
+
+        // The frames latched by now, the most recent first.
+        ovrPerfStats getPerfStats(double now) const {
+            ovrPerfStats stats{};
+            for (auto it = m_frames.crbegin(); it != m_frames.crend(); ++it) {
+                if (stats.FrameStatsCount == ovrMaxProvidedFrameStats) {
+                    break;
+                }
+                if (it->vsyncIndex * VsyncPeriod > now) {
+                    continue;
+                }
+                ovrPerfStatsPerCompositorFrame& frame = stats.FrameStats[stats.FrameStatsCount++];
+                frame.AppFrameIndex = it->appFrameIndex;
+                frame.HmdVsyncIndex = it->vsyncIndex;
+                frame.AswIsActive = it->isAswActive;
+            }
+            return stats;
+        }
+
+        const std::vector<Frame>& frames() const {
+            return m_frames;
+        }
+
+      private:
+        std::vector<Frame> m_frames;
+        bool m_recentMisses[8]{};
+        uint32_t m_numOnTime{0};
+        bool m_isAswActive{false};
+    };
+
+    // The frame loop of the runtime on the virtual clock of the compositor. The pacing components are called in the
+    // same order as xrWaitFrame(), xrBeginFrame() and xrEndFrame() do. Depth 0 is the synchronous submission.
+    // Otherwise, the frames are handed over through the ring, and the submission thread consumes them once the virtual
+    // clock reaches their submission.
+    class PacingSimulation {
+      public:
+        PacingSimulation(uint32_t depth, uint32_t seed) : m_depth(depth), m_random(seed) {
+            m_estimator.reset(VsyncPeriod);
+            m_runningStart.setBounds(0.0005, 0.005);
+            m_runningStart.reset(0.002);
+            m_requestTimes.push_back(m_compositor.waitToBeginFrame(0));
+        }
+
+        // The application takes cpuTime() between waking up and xrEndFrame(), and the submission thread takes
+        // submissionTime() to submit a frame, on top of waiting for the compositor.
+        template <typename CpuTime, typename SubmissionTime>
+        void run(uint32_t numFrames, const CpuTime& cpuTime, const SubmissionTime& submissionTime) {
+            for (uint32_t i = 0; i < numFrames; i++) {
+                runFrame(std::max(cpuTime(m_random), 0.0), std::max(submissionTime(m_random), 0.0));
+            }
+        }
+
+        template <typename CpuTime>
+        void run(uint32_t numFrames, const CpuTime& cpuTime) {
+            run(numFrames, cpuTime, [](std::mt19937&) { return 0.0; });
+        }
+
+        struct Summary {
+            uint32_t numRepeatedVsyncs{0};
+            double framesPerSecond{0};
+
+            // From the application waking up to the frame being latched.
+            double latencyP50{0};
+            double latencyP99{0};
+        };
+
+        // The frames presented since the given frame.
+        Summary summarize(uint32_t firstFrame) const {
+            const auto& frames = m_compositor.frames();
+            Summary summary;
+            std::vector<double> latencies;
+            for (uint32_t i = firstFrame; i < frames.size(); i++) {
+                if (i > firstFrame && frames[i].vsyncIndex > frames[i - 1].vsyncIndex + 1) {
+                    summary.numRepeatedVsyncs++;
+                }
+                latencies.push_back(frames[i].vsyncIndex * VsyncPeriod - m_wakeTimes[i]);
+            }
+            summary.framesPerSecond = (frames.size() - firstFrame - 1) /
+                                      ((frames.back().vsyncIndex - frames[firstFrame].vsyncIndex) * VsyncPeriod);
+            std::sort(latencies.begin(), latencies.end());
+            summary.latencyP50 = latencies[latencies.size() / 2];
+            summary.latencyP99 = latencies[latencies.size() * 99 / 100];
+            return summary;
+        }
+
+        uint32_t numFrames() const {
+            return (uint32_t)m_wakeTimes.size();
+        }
+
+        uint64_t maxPending() const {
+            return m_maxPending;
+        }
+
+        const FramePeriodEstimator& estimator() const {
+            return m_estimator;
+        }
+
+        const RunningStartController& runningStart() const {
+            return m_runningStart;
+        }
+
+      private:
+        struct QueuedFrame {
+            int frameIndex;
+            double endFrameTime;
+        };
+
+        void runFrame(double cpuTime, double submissionTime) {
+            const int frameIndex = (int)m_wakeTimes.size();
+
+            // xrWaitFrame(): wait for the compositor, or for the submission thread to be ready for the frame. With
+            // running start, give up waiting for the submission thread ahead of the next frame boundary.
+            double wakeTime;
+            if (!m_depth) {
+                wakeTime = m_compositor.waitToBeginFrame(m_now);
+            } else {
+                if (m_lastCpuTime) {
+                    m_runningStart.onAppCpuTime(*m_lastCpuTime);
+                }
+                consume(m_now);
+                const double timeout =
+                    lastWaitToBeginFrameTime(m_now) + m_estimator.period() - m_runningStart.offset();
+                const double request = requestTime();
+                if (request <= m_now) {
+                    wakeTime = m_now;
+                } else if (request <= timeout) {
+                    wakeTime = request;
+                } else {
+                    const double lateness = timeout > m_now ? std::max(m_latenesses(m_random), 0.0) : 0.0;
+                    wakeTime = std::max(m_now, timeout) + lateness;
+                    m_runningStart.onWakeUp(wakeTime - timeout);
+                }
+            }
+            m_wakeTimes.push_back(wakeTime);
+
+            // xrBeginFrame(): update the frame period from the compositor statistics.
+            const ovrPerfStats stats = m_compositor.getPerfStats(wakeTime);
+            for (int i = stats.FrameStatsCount - 1; i >= 0; i--) {
+                m_estimator.addSample(stats.FrameStats[i].AppFrameIndex,
+                                      stats.FrameStats[i].HmdVsyncIndex,
+                                      stats.FrameStats[i].AswIsActive);
+            }
+            const double period = m_estimator.period();
+
+            double endFrameTime = wakeTime + cpuTime;
+            if (!m_depth) {
+                // xrEndFrame(): submit right away.
+                const double submitTime = endFrameTime + submissionTime;
+                m_compositor.endFrame(frameIndex, submitTime);
+                m_now = submitTime;
+                return;
+            }
+
+            // xrEndFrame(): wait for room in the queue, then hand the frame over.
+            endFrameTime = std::max(endFrameTime, requestTime());
+            m_runningStart.onFrameSubmitted(lastWaitToBeginFrameTime(endFrameTime) + period - endFrameTime);
+
+            consume(endFrameTime);
+            REQUIRE(m_ring.pending() < m_depth);
+            m_ring.producerSlot() = {frameIndex, endFrameTime};
+            m_ring.publish();
+            m_maxPending = std::max(m_maxPending, m_ring.pending());
+
+            // The submission thread submits the frame once the compositor is ready for it, then waits for the
+            // compositor again before requesting the next frame.
+            const double submitTime = std::max(m_requestTimes[frameIndex], endFrameTime) + submissionTime;
+            m_submitTimes.push_back(submitTime);
+            m_compositor.endFrame(frameIndex, submitTime);
+            m_requestTimes.push_back(m_compositor.waitToBeginFrame(submitTime));
+
+            m_lastCpuTime = endFrameTime - wakeTime;
+            m_now = endFrameTime;
+        }
+
+        // When the submission thread requests the frame that lets the next frame be published, per
+        // waitForRequest(depth - 1).
+        double requestTime() const {
+            const int request = (int)m_submitTimes.size() + 1 - (int)m_depth;
+            return request < 0 ? -std::numeric_limits<double>::infinity() : m_requestTimes[request];
+        }
+
+        double lastWaitToBeginFrameTime(double now) const {
+            for (auto it = m_requestTimes.crbegin(); it != m_requestTimes.crend(); ++it) {
+                if (*it <= now) {
+                    return *it;
+                }
+            }
+            return m_requestTimes.front();
+        }
+
+        // Run the submission thread up to the given time.
+        void consume(double now) {
+            while (m_numConsumed < m_submitTimes.size() && m_submitTimes[m_numConsumed] <= now) {
+                const QueuedFrame* const frame = m_ring.acquire();
+                REQUIRE(frame);
+                CHECK(frame->frameIndex == (int)m_numConsumed);
+                CHECK(frame->endFrameTime <= m_submitTimes[m_numConsumed]);
+                m_ring.release();
+                m_numConsumed++;
+            }
+        }
+
+        const uint32_t m_depth;
+        std::mt19937 m_random;
+        std::normal_distribution<double> m_latenesses{50e-6, 30e-6};
+
+        FakeCompositor m_compositor;
+        FramePeriodEstimator m_estimator;
+        RunningStartController m_runningStart;
+        SpscRing<QueuedFrame, MaxDepth> m_ring;
+
+        double m_now{0};
+        std::optional<double> m_lastCpuTime;
+        std::vector<double> m_wakeTimes;
+        std::vector<double> m_requestTimes;
+        std::vector<double> m_submitTimes;
+        size_t m_numConsumed{0};
+        uint64_t m_maxPending{0};
+    };
+
+    auto Normal(double mean, double deviation) {
+        return [=](std::mt19937& random) { return std::normal_distribution<double>(mean, deviation)(random); };
+    }
+
+    auto Uniform(double max) {
+        return [=](std::mt19937& random) { return std::uniform_real_distribution<double>(0, max)(random); };
+    }
+
+    struct SessionSummary {
+        uint32_t numRepeatedVsyncs{0};
+        double framesPerSecond{0};
+
+        // From the application waking up in xrWaitFrame() to the frame being presented.
+        double latencyP50{0};
+        double latencyP99{0};
+    };
+
+    // Run a session through the runtime, on the stand-in compositor, with an application that spends cpuTime between
+    // xrWaitFrame() returning and calling xrEndFrame(). Depth 0 is the synchronous submission. The frames after the
+    // warm-up are summarized.
+    SessionSummary RunSession(uint32_t depth,
+                              const standin::Configuration& configuration,
+                              double cpuTime,
+                              uint32_t numWarmUpFrames,
+                              uint32_t numFrames) {
+        const Settings settings =
+            depth ? Settings{{"async_submission_depth", (int)depth}} : Settings{{"async_submission", 0}};
+        TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME}, settings);
+        TestSession session(instance, configuration);
+        const uint64_t firstSubmission = standin::GetSubmittedFrameCount();
+
+        std::vector<double> wakeTimes;
+        for (uint32_t i = 0; i < numWarmUpFrames + numFrames; i++) {
+            const XrFrameState frameState = session.waitFrame();
+            const double wakeTime = ovr_GetTimeInSeconds();
+            if (i >= numWarmUpFrames) {
+                wakeTimes.push_back(wakeTime);
+            }
+            session.beginFrame();
+            session.renderFrame(frameState.predictedDisplayTime);
+            while (ovr_GetTimeInSeconds() < wakeTime + cpuTime) {
+                _mm_pause();
+            }
+            session.endFrame(frameState.predictedDisplayTime);
+        }
+
+        // Let the submission thread catch up with the last frames.
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (standin::GetSubmittedFrameCount() < firstSubmission + numWarmUpFrames + numFrames &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        const std::vector<standin::SubmittedFrame> submittedFrames = standin::GetSubmittedFrames();
+        REQUIRE(standin::GetSubmittedFrameCount() == firstSubmission + numWarmUpFrames + numFrames);
+        REQUIRE(submittedFrames.size() >= numFrames);
+
+        // The frames are submitted in the order of the application.
+        const standin::SubmittedFrame* const frames = submittedFrames.data() + submittedFrames.size() - numFrames;
+        const double period = 1.0 / configuration.refreshRate;
+        SessionSummary summary;
+        std::vector<double> latencies;
+        for (uint32_t i = 0; i < numFrames; i++) {
+            if (i > 0 && frames[i].presentTime - frames[i - 1].presentTime > 1.5 * period) {
+                summary.numRepeatedVsyncs++;
+            }
+            latencies.push_back(frames[i].presentTime - wakeTimes[i]);
+        }
+        summary.framesPerSecond = (numFrames - 1) / (frames[numFrames - 1].presentTime - frames[0].presentTime);
+        std::sort(latencies.begin(), latencies.end());
+        summary.latencyP50 = latencies[latencies.size() / 2];
+        summary.latencyP99 = latencies[latencies.size() * 99 / 100];
+        return summary;
+    }
+
+} // namespace
+
+TEST_CASE("pacing: light load is presented at every vsync") {
+    double lastLatency = 0;
+    for (uint32_t depth = 0; depth <= MaxDepth; depth++) {
+        PacingSimulation simulation(depth, 1);
+        simulation.run(100, Normal(0.004, 0.0003));
+        simulation.run(600, Normal(0.004, 0.0003));
+
+        const auto summary = simulation.summarize(100);
+        CHECK(summary.numRepeatedVsyncs == 0);
+        CHECK_NEAR(summary.framesPerSecond, 90.0, 0.1);
+        CHECK(!simulation.estimator().isAswEngaged());
+        CHECK(simulation.estimator().period() == VsyncPeriod);
+        CHECK(simulation.maxPending() <= depth);
+        if (depth) {
+            // Running start gives back the latency it does not need.
+            CHECK(simulation.runningStart().offset() < 0.001);
+        }
+
+        // Each frame queued ahead costs a period of latency.
+        if (depth >= 2) {
+            CHECK(summary.latencyP50 > lastLatency + VsyncPeriod / 2);
+        }
+        lastLatency = summary.latencyP50;
+    }
+}
+
+TEST_CASE("pacing: heavy load engages ASW") {
+    for (uint32_t depth = 0; depth <= 1; depth++) {
+        PacingSimulation simulation(depth, 2);
+        simulation.run(400, Normal(0.015, 0.0005));
+
+        CHECK(simulation.estimator().isAswEngaged());
+        CHECK(simulation.estimator().period() == 2 * VsyncPeriod);
+        CHECK_NEAR(simulation.estimator().measuredPeriod(), 2 * VsyncPeriod, 0.001);
+        CHECK(simulation.summarize(100).framesPerSecond < 50);
+    }
+}
+
+TEST_CASE("pacing: ASW disengages once the load drops for a while") {
+    for (uint32_t depth = 0; depth <= MaxDepth; depth++) {
+        PacingSimulation simulation(depth, 3);
+        simulation.run(200, Normal(0.004, 0.0003));
+        simulation.run(200, Normal(0.015, 0.0005));
+        REQUIRE(simulation.estimator().isAswEngaged());
+
+        // The compositor needs a few frames to disengage, and the estimator waits for it to stay off.
+        simulation.run(15, Normal(0.004, 0.0003));
+        CHECK(simulation.estimator().isAswEngaged());
+
+        simulation.run(85, Normal(0.004, 0.0003));
+        CHECK(!simulation.estimator().isAswEngaged());
+        CHECK(simulation.estimator().period() == VsyncPeriod);
+
+        const uint32_t firstFrame = simulation.numFrames();
+        simulation.run(100, Normal(0.004, 0.0003));
+        CHECK(simulation.summarize(firstFrame).numRepeatedVsyncs == 0);
+    }
+}
+
+TEST_CASE("pacing: a deeper queue absorbs the submission jitter") {
+    uint32_t repeatedVsyncs[MaxDepth + 1]{};
+    for (uint32_t depth = 0; depth <= MaxDepth; depth++) {
+        PacingSimulation simulation(depth, 4);
+        simulation.run(100, Normal(0.006, 0.0005), Uniform(0.006));
+        simulation.run(900, Normal(0.006, 0.0005), Uniform(0.006));
+        CHECK(simulation.maxPending() <= depth);
+        repeatedVsyncs[depth] = simulation.summarize(100).numRepeatedVsyncs;
+    }
+
+    CHECK(repeatedVsyncs[0] > 45);
+    CHECK(repeatedVsyncs[1] < repeatedVsyncs[0]);
+    CHECK(repeatedVsyncs[2] <= 9);
+    CHECK(repeatedVsyncs[3] <= 9);
+}
+
+TEST_CASE("pacing: light load is presented at every vsync through the runtime") {
+    double lastLatency = 0;
+    for (uint32_t depth = 0; depth <= MaxDepth; depth++) {
+        const auto summary = RunSession(depth, {90.f, true, 3}, 0.004, 30, 150);
+        CHECK_TIMING(summary.numRepeatedVsyncs <= 2);
+        CHECK_TIMING(std::abs(summary.framesPerSecond - 90.0) < 1.0);
+
+        // Each frame queued ahead costs a period of latency.
+        if (depth >= 2) {
+            CHECK_TIMING(summary.latencyP50 > lastLatency + VsyncPeriod / 2);
+        }
+        lastLatency = summary.latencyP50;
+    }
+}
+
+TEST_CASE("pacing: a deeper queue absorbs the submission jitter through the runtime") {
+    standin::Configuration configuration{90.f, true, 3};
+    configuration.submissionJitter = 0.006;
+
+    uint32_t repeatedVsyncs[MaxDepth + 1]{};
+    for (uint32_t depth = 0; depth <= MaxDepth; depth++) {
+        repeatedVsyncs[depth] = RunSession(depth, configuration, 0.006, 30, 200).numRepeatedVsyncs;
+    }
+
+    CHECK_TIMING(repeatedVsyncs[0] > 10);
+    CHECK_TIMING(repeatedVsyncs[MaxDepth] < repeatedVsyncs[0]);
+    CHECK_TIMING(repeatedVsyncs[MaxDepth] <= 4);
+}
+
+BENCHMARK("pacing: frame rate and latency per depth under submission jitter") {
+    for (const float refreshRate : standin::Configuration::k_refreshRates) {
+        for (const double jitter : {0.0, 0.003, 0.006}) {
+            for (uint32_t depth = 0; depth <= MaxDepth; depth++) {
+                standin::Configuration configuration{refreshRate, true, 3};
+                configuration.submissionJitter = jitter;
+                configuration.jitterSeed = 5;
+
+                // The application takes half of the frame period.
+                const auto summary = RunSession(depth, configuration, 0.5 / refreshRate, 30, 300);
+
+                char label[64];
+                sprintf_s(label, "%.0f Hz, jitter %.0fms, depth %u", refreshRate, jitter * 1e3, depth);
+                printf("    %-56s %5.1f fps, %4u repeated vsyncs, latency p50=%.1fms p99=%.1fms\n",
+                       label,
+                       summary.framesPerSecond,
+                       summary.numRepeatedVsyncs,
+                       summary.latencyP50 * 1e3,
+                       summary.latencyP99 * 1e3);
+            }
+        }
+    }
+}
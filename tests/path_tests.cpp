@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+
+    std::vector<std::string> MakePaths(size_t count) {
+        std::vector<std::string> paths;
+        paths.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            paths.push_back(fmt::format("/user/hand/{}/input/component_{}/value", i % 2 ? "left" : "right", i));
+        }
+        return paths;
+    }
+
+    // The interning scheme that the runtime used before: a map from XrPath to string, scanned linearly for lookups.
+    class LinearScanPaths {
+      public:
+        XrPath stringToPath(const std::string& path) {
+            for (const auto& entry : m_strings) {
+                if (entry.second == path) {
+                    return entry.first;
+                }
+            }
+            const XrPath newPath = (XrPath)(m_strings.size() + 1);
+            m_strings.insert_or_assign(newPath, path);
+            return newPath;
+        }
+
+      private:
+        std::map<XrPath, std::string> m_strings;
+    };
+
+} // namespace
+
+TEST_CASE("path: interning round-trip") {
+    TestInstance instance;
+
+    const auto paths = MakePaths(1000);
+    std::vector<XrPath> xrPaths;
+    for (const auto& path : paths) {
+        const XrPath xrPath = instance.stringToPath(path.c_str());
+        REQUIRE(xrPath != XR_NULL_PATH);
+        xrPaths.push_back(xrPath);
+    }
+
+    // Every string gets a distinct path, interning the same string again returns the same path, and the strings
+    // survive the growth of the storage.
+    CHECK(std::set<XrPath>(xrPaths.cbegin(), xrPaths.cend()).size() == paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        CHECK(instance.stringToPath(paths[i].c_str()) == xrPaths[i]);
+        CHECK(instance.pathToString(xrPaths[i]) == paths[i]);
+    }
+}
+
+TEST_CASE("path: invalid paths") {
+    TestInstance instance;
+    const auto xrStringToPath = instance.get<PFN_xrStringToPath>("xrStringToPath");
+    const auto xrPathToString = instance.get<PFN_xrPathToString>("xrPathToString");
+
+    XrPath path = XR_NULL_PATH;
+    CHECK(xrStringToPath(instance.handle(), "", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+    CHECK(xrStringToPath(instance.handle(), "user/hand/left", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+    CHECK(xrStringToPath(instance.handle(), "/user/hand/left/", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+    CHECK(xrStringToPath(instance.handle(), "/user//hand", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+    CHECK(xrStringToPath(instance.handle(), "/user/Hand", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+    CHECK(xrStringToPath(instance.handle(), "/user/..", &path) == XR_ERROR_PATH_FORMAT_INVALID);
+
+    // Paths that were never handed out are not valid.
+    char buffer[XR_MAX_PATH_LENGTH];
+    uint32_t count = 0;
+    CHECK(xrPathToString(instance.handle(), (XrPath)1000000, sizeof(buffer), &count, buffer) == XR_ERROR_PATH_INVALID);
+    CHECK(xrPathToString(instance.handle(), XR_NULL_PATH, sizeof(buffer), &count, buffer) == XR_ERROR_PATH_INVALID);
+}
+
+BENCHMARK("path: intern 10k paths") {
+    const auto paths = MakePaths(10000);
+
+    Measure("xrStringToPath (new paths)", [&] {
+        TestInstance instance;
+        for (const auto& path : paths) {
+            DoNotOptimize(instance.stringToPath(path.c_str()));
+        }
+    }, paths.size());
+
+    Measure("linear scan baseline (new paths)", [&] {
+        LinearScanPaths baseline;
+        for (const auto& path : paths) {
+            DoNotOptimize(baseline.stringToPath(path));
+        }
+    }, paths.size());
+
+    TestInstance instance;
+    LinearScanPaths baseline;
+    for (const auto& path : paths) {
+        instance.stringToPath(path.c_str());
+        baseline.stringToPath(path);
+    }
+
+    Measure("xrStringToPath (known paths)", [&] {
+        for (const auto& path : paths) {
+            DoNotOptimize(instance.stringToPath(path.c_str()));
+        }
+    }, paths.size());
+
+    Measure("linear scan baseline (known paths)", [&] {
+        for (const auto& path : paths) {
+            DoNotOptimize(baseline.stringToPath(path));
+        }
+    }, paths.size());
+}
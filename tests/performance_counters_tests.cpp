@@ -0,0 +1,189 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    // A snapshot whose every field is derived from the same value, so that a copy mixing two updates would be caught.
+    // The value stays below 2^24 so that it is exact in a float.
+    PerformanceCounters::Snapshot MakeSnapshot(uint32_t value) {
+        PerformanceCounters::Snapshot snapshot{};
+        snapshot.frameIndex = value;
+        snapshot.time = value;
+        snapshot.numFrames = value;
+        snapshot.numDiscardedFrames = value;
+        snapshot.framesPerSecond = value;
+        snapshot.isAsyncReprojectionEngaged = value;
+        snapshot.predictedFramePeriodUs = (float)value;
+        snapshot.measuredFramePeriodUs = (float)value;
+        snapshot.runningStartUs = (float)value;
+        snapshot.asyncSubmissionDepth = value;
+        for (auto& metric : snapshot.metrics) {
+            metric = {(float)value, (float)value, (float)value, (float)value};
+        }
+        return snapshot;
+    }
+
+    bool IsConsistent(const PerformanceCounters::Snapshot& snapshot) {
+        const PerformanceCounters::Snapshot expected = MakeSnapshot((uint32_t)snapshot.frameIndex);
+        return !memcmp(&snapshot, &expected, sizeof(snapshot));
+    }
+
+    // A view of the segment, the way a monitoring tool would open it.
+    struct ReaderView {
+        ReaderView() {
+            *file.put() = OpenFileMapping(FILE_MAP_WRITE, FALSE, PerformanceCounters::k_name);
+            if (file) {
+                counters = reinterpret_cast<PerformanceCounters*>(
+                    MapViewOfFile(file.get(), FILE_MAP_WRITE, 0, 0, sizeof(PerformanceCounters)));
+            }
+        }
+
+        ~ReaderView() {
+            if (counters) {
+                UnmapViewOfFile(counters);
+            }
+        }
+
+        wil::unique_handle file;
+        PerformanceCounters* counters{nullptr};
+    };
+
+    // Publish increasing values at the given period (0 to publish back-to-back), until stopped.
+    struct WriterThread {
+        WriterThread(PerformanceCountersWriter& writer, std::chrono::microseconds period)
+            : thread([&writer, period, this] {
+                  auto nextPublish = Clock::now();
+                  while (!stop.load(std::memory_order_relaxed)) {
+                      writer.publish(MakeSnapshot(++numPublished));
+                      nextPublish += period;
+                      while (Clock::now() < nextPublish) {
+                          _mm_pause();
+                      }
+                  }
+              }) {
+        }
+
+        ~WriterThread() {
+            stop = true;
+            thread.join();
+        }
+
+        std::atomic<bool> stop{false};
+        uint32_t numPublished{0};
+        std::thread thread;
+    };
+
+    // Read snapshots for the given duration while the writer publishes, and check that each copy is whole and that
+    // they never go back in time.
+    void ReadWhileWriting(std::chrono::microseconds writerPeriod,
+                          std::chrono::milliseconds duration,
+                          uint64_t minNewSnapshots) {
+        PerformanceCountersWriter writer;
+        REQUIRE(writer.open());
+        ReaderView reader;
+        REQUIRE(reader.counters);
+
+        CHECK(reader.counters->magic == PerformanceCounters::k_magic);
+        CHECK(reader.counters->version == PerformanceCounters::k_version);
+        CHECK(reader.counters->size == sizeof(PerformanceCounters));
+
+        uint64_t numReads = 0;
+        uint64_t numFailedReads = 0;
+        uint64_t numNewSnapshots = 0;
+        uint64_t numTornSnapshots = 0;
+        uint64_t numOutOfOrderSnapshots = 0;
+        uint64_t lastFrameIndex = 0;
+        {
+            WriterThread writerThread(writer, writerPeriod);
+            const auto end = Clock::now() + duration;
+            while (Clock::now() < end) {
+                PerformanceCounters::Snapshot snapshot;
+                numReads++;
+                if (!readPerformanceCounters(*reader.counters, snapshot)) {
+                    numFailedReads++;
+                    continue;
+                }
+                if (!IsConsistent(snapshot)) {
+                    numTornSnapshots++;
+                    continue;
+                }
+                if (snapshot.frameIndex < lastFrameIndex) {
+                    numOutOfOrderSnapshots++;
+                } else if (snapshot.frameIndex > lastFrameIndex) {
+                    numNewSnapshots++;
+                }
+                lastFrameIndex = snapshot.frameIndex;
+            }
+        }
+
+        CHECK(numTornSnapshots == 0);
+        CHECK(numOutOfOrderSnapshots == 0);
+        CHECK_TIMING(numNewSnapshots >= minNewSnapshots);
+
+        // At the pace of a frame loop, retries absorb the collisions with the writer: giving up should be rare.
+        if (writerPeriod.count()) {
+            CHECK_TIMING(numFailedReads * 100 <= numReads);
+        }
+    }
+
+} // namespace
+
+TEST_CASE("performance counters: snapshots are never torn with a 1 kHz writer") {
+    ReadWhileWriting(1000us, 500ms, 400);
+}
+
+TEST_CASE("performance counters: snapshots are never torn with a back-to-back writer") {
+    ReadWhileWriting(0us, 200ms, 1);
+}
+
+TEST_CASE("performance counters: recovering from a writer that died during an update") {
+    PerformanceCountersWriter writer;
+    REQUIRE(writer.open());
+    ReaderView reader;
+    REQUIRE(reader.counters);
+
+    writer.publish(MakeSnapshot(1));
+    PerformanceCounters::Snapshot snapshot;
+    REQUIRE(readPerformanceCounters(*reader.counters, snapshot));
+    CHECK(snapshot.frameIndex == 1);
+
+    // An odd sequence means an update is in progress: readers give up rather than returning a torn copy.
+    reader.counters->sequence.fetch_add(1);
+    CHECK(!readPerformanceCounters(*reader.counters, snapshot, 10));
+
+    // The next writer rounds the sequence down and publishes normally.
+    writer.publish(MakeSnapshot(2));
+    REQUIRE(readPerformanceCounters(*reader.counters, snapshot));
+    CHECK(snapshot.frameIndex == 2);
+    CHECK(IsConsistent(snapshot));
+}
@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    constexpr float Tolerance = 1e-4f;
+
+    XrPosef RandomPose(std::mt19937& rng, bool normalized = true) {
+        std::uniform_real_distribution<float> position(-5.f, 5.f);
+        std::uniform_real_distribution<float> component(-1.f, 1.f);
+
+        XrPosef pose;
+        pose.position = {position(rng), position(rng), position(rng)};
+        pose.orientation = {component(rng), component(rng), component(rng), component(rng)};
+        if (normalized) {
+            const float length = std::sqrt(pose.orientation.x * pose.orientation.x +
+                                           pose.orientation.y * pose.orientation.y +
+                                           pose.orientation.z * pose.orientation.z +
+                                           pose.orientation.w * pose.orientation.w);
+            pose.orientation.x /= length;
+            pose.orientation.y /= length;
+            pose.orientation.z /= length;
+            pose.orientation.w /= length;
+        }
+        return pose;
+    }
+
+    PoseBatch RandomBatch(std::mt19937& rng, size_t count) {
+        PoseBatch batch;
+        batch.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            batch.set(i, RandomPose(rng));
+        }
+        return batch;
+    }
+
+    bool IsNear(const XrPosef& a, const XrPosef& b) {
+        return std::abs(a.position.x - b.position.x) <= Tolerance &&
+               std::abs(a.position.y - b.position.y) <= Tolerance &&
+               std::abs(a.position.z - b.position.z) <= Tolerance &&
+               std::abs(a.orientation.x - b.orientation.x) <= Tolerance &&
+               std::abs(a.orientation.y - b.orientation.y) <= Tolerance &&
+               std::abs(a.orientation.z - b.orientation.z) <= Tolerance &&
+               std::abs(a.orientation.w - b.orientation.w) <= Tolerance;
+    }
+
+    // Sizes that exercise the padding of the last group of 4 lanes.
+    constexpr size_t BatchSizes[] = {1, 3, 4, 5, 17, 64};
+
+} // namespace
+
+TEST_CASE("pose_batch: reference matches xr::math::Pose") {
+    std::mt19937 rng(1234);
+    for (int i = 0; i < 1000; i++) {
+        const XrPosef a = RandomPose(rng);
+        const XrPosef b = RandomPose(rng);
+        CHECK(IsNear(pose_batch::reference::Multiply(a, b), xr::math::Pose::Multiply(a, b)));
+        CHECK(IsNear(pose_batch::reference::Invert(a), xr::math::Pose::Invert(a)));
+
+        const XrPosef c = RandomPose(rng, false /* normalized */);
+        CHECK(pose_batch::reference::IsNormalized(c.orientation) == xr::math::Quaternion::IsNormalized(c.orientation));
+    }
+}
+
+TEST_CASE("pose_batch: batched kernels match reference") {
+    std::mt19937 rng(5678);
+    for (const size_t count : BatchSizes) {
+        const PoseBatch a = RandomBatch(rng, count);
+        const PoseBatch b = RandomBatch(rng, count);
+        const XrPosef base = RandomPose(rng);
+
+        PoseBatch product;
+        pose_batch::Multiply(a, b, product);
+        PoseBatch productWithPose;
+        pose_batch::Multiply(a, base, productWithPose);
+        PoseBatch inverse;
+        pose_batch::Invert(a, inverse);
+        PoseBatch relative;
+        pose_batch::Relative(a, base, relative);
+
+        REQUIRE(product.size() == count);
+        REQUIRE(productWithPose.size() == count);
+        REQUIRE(inverse.size() == count);
+        REQUIRE(relative.size() == count);
+        for (size_t i = 0; i < count; i++) {
+            CHECK(IsNear(product.get(i), pose_batch::reference::Multiply(a.get(i), b.get(i))));
+            CHECK(IsNear(productWithPose.get(i), pose_batch::reference::Multiply(a.get(i), base)));
+            CHECK(IsNear(inverse.get(i), pose_batch::reference::Invert(a.get(i))));
+            CHECK(IsNear(relative.get(i),
+                         pose_batch::reference::Multiply(a.get(i), pose_batch::reference::Invert(base))));
+        }
+    }
+}
+
+TEST_CASE("pose_batch: output may alias input") {
+    std::mt19937 rng(42);
+    const PoseBatch a = RandomBatch(rng, 17);
+    const PoseBatch b = RandomBatch(rng, 17);
+
+    PoseBatch inPlace = a;
+    pose_batch::Multiply(inPlace, b, inPlace);
+    PoseBatch inverted = a;
+    pose_batch::Invert(inverted, inverted);
+    for (size_t i = 0; i < a.size(); i++) {
+        CHECK(IsNear(inPlace.get(i), pose_batch::reference::Multiply(a.get(i), b.get(i))));
+        CHECK(IsNear(inverted.get(i), pose_batch::reference::Invert(a.get(i))));
+    }
+}
+
+TEST_CASE("pose_batch: IsNormalized matches reference") {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> scale(0.9f, 1.1f);
+    for (const size_t count : BatchSizes) {
+        PoseBatch batch;
+        batch.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            // Mix of normalized quaternions and quaternions scaled around the tolerance.
+            XrPosef pose = RandomPose(rng);
+            if (i % 2) {
+                const float s = scale(rng);
+                pose.orientation = {
+                    pose.orientation.x * s, pose.orientation.y * s, pose.orientation.z * s, pose.orientation.w * s};
+            }
+            batch.set(i, pose);
+        }
+
+        std::vector<uint8_t> isNormalized(count);
+        const bool allNormalized = pose_batch::IsNormalized(batch, reinterpret_cast<bool*>(isNormalized.data()));
+
+        bool expectedAllNormalized = true;
+        for (size_t i = 0; i < count; i++) {
+            const bool expected = pose_batch::reference::IsNormalized(batch.get(i).orientation);
+            CHECK(!!isNormalized[i] == expected);
+            expectedAllNormalized = expectedAllNormalized && expected;
+        }
+        CHECK(allNormalized == expectedAllNormalized);
+    }
+}
+
+BENCHMARK("pose_batch: relative poses") {
+    std::mt19937 rng(7);
+    for (const size_t count : {4, 16, 64, 1024}) {
+        const PoseBatch a = RandomBatch(rng, count);
+        const XrPosef base = RandomPose(rng);
+        PoseBatch out;
+        out.resize(count);
+
+        Measure(fmt::format("pose_batch::Relative ({} poses)", count).c_str(), [&] {
+            pose_batch::Relative(a, base, out);
+            DoNotOptimize(out.px[0]);
+        }, count);
+
+        Measure(fmt::format("pose_batch::reference ({} poses)", count).c_str(), [&] {
+            const XrPosef invertedBase = pose_batch::reference::Invert(base);
+            for (size_t i = 0; i < count; i++) {
+                out.set(i, pose_batch::reference::Multiply(a.get(i), invertedBase));
+            }
+            DoNotOptimize(out.px[0]);
+        }, count);
+
+        Measure(fmt::format("xr::math::Pose ({} poses)", count).c_str(), [&] {
+            const XrPosef invertedBase = xr::math::Pose::Invert(base);
+            for (size_t i = 0; i < count; i++) {
+                out.set(i, xr::math::Pose::Multiply(a.get(i), invertedBase));
+            }
+            DoNotOptimize(out.px[0]);
+        }, count);
+    }
+}
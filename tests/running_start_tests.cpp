@@ -0,0 +1,194 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    constexpr double FramePeriod = 1 / 90.0;
+    constexpr double MinOffset = 0.0005;
+    constexpr double MaxOffset = 0.005;
+
+    // A headless model of the frame loop, calling the controller in the same order as the runtime: the CPU time of the
+    // previous frame and the wake-up at xrWaitFrame(), then the slack at xrEndFrame(). The application is woken up the
+    // running start before the frame boundary (plus some scheduling lateness), and its frame must reach the
+    // submission thread before the next boundary.
+    class FrameLoopSimulation {
+      public:
+        FrameLoopSimulation(uint32_t seed) : m_random(seed) {
+            m_controller.setBounds(MinOffset, MaxOffset);
+            m_controller.reset(0.002);
+        }
+
+        struct Result {
+            uint32_t numMissedFrames{0};
+            double minOffset{std::numeric_limits<double>::infinity()};
+            double maxOffset{0};
+        };
+
+        // Run frames whose CPU time follows a normal distribution.
+        Result run(uint32_t numFrames,
+                   double meanCpuTime,
+                   double cpuTimeDeviation,
+                   double meanLateness = 50e-6,
+                   double latenessDeviation = 30e-6) {
+            std::normal_distribution<double> cpuTimes(meanCpuTime, cpuTimeDeviation);
+            std::normal_distribution<double> latenesses(meanLateness, latenessDeviation);
+
+            Result result;
+            for (uint32_t i = 0; i < numFrames; i++) {
+                if (m_lastCpuTime) {
+                    m_controller.onAppCpuTime(*m_lastCpuTime);
+                }
+
+                const double lateness = std::max(latenesses(m_random), 0.0);
+                m_controller.onWakeUp(lateness);
+
+                const double cpuTime = std::max(cpuTimes(m_random), 0.0);
+                const double slack = FramePeriod + m_controller.offset() - lateness - cpuTime;
+                if (slack < 0) {
+                    result.numMissedFrames++;
+                }
+                m_controller.onFrameSubmitted(slack);
+                m_lastCpuTime = cpuTime;
+
+                result.minOffset = std::min(result.minOffset, m_controller.offset());
+                result.maxOffset = std::max(result.maxOffset, m_controller.offset());
+            }
+            return result;
+        }
+
+        RunningStartController& controller() {
+            return m_controller;
+        }
+
+      private:
+        RunningStartController m_controller;
+        std::mt19937 m_random;
+        std::optional<double> m_lastCpuTime;
+    };
+
+} // namespace
+
+TEST_CASE("running start: light load gives back the latency") {
+    FrameLoopSimulation simulation(1);
+    simulation.run(2000, 0.005, 0.0003);
+
+    const auto result = simulation.run(5000, 0.005, 0.0003);
+    CHECK(result.numMissedFrames == 0);
+    CHECK(result.maxOffset == MinOffset);
+}
+
+TEST_CASE("running start: heavy load is absorbed by the offset") {
+    // The CPU time is longer than the frame period, which only the running start can absorb.
+    FrameLoopSimulation simulation(2);
+    simulation.run(3000, FramePeriod + 0.002, 0.0002);
+
+    const auto result = simulation.run(10000, FramePeriod + 0.002, 0.0002);
+    CHECK(result.numMissedFrames <= 100);
+    CHECK(result.minOffset > 0.002);
+    CHECK(result.maxOffset <= MaxOffset);
+}
+
+TEST_CASE("running start: noisy load stays near the target miss rate") {
+    FrameLoopSimulation simulation(3);
+    simulation.run(3000, FramePeriod + 0.002, 0.0005);
+
+    const auto result = simulation.run(10000, FramePeriod + 0.002, 0.0005);
+    CHECK(result.numMissedFrames <= 400);
+    CHECK(result.maxOffset <= MaxOffset);
+}
+
+TEST_CASE("running start: recovers from a step in the load") {
+    FrameLoopSimulation simulation(4);
+    simulation.run(3000, 0.005, 0.0003);
+    CHECK(simulation.controller().offset() == MinOffset);
+
+    // Only a few frames are missed while the offset catches up with the new load.
+    const auto transition = simulation.run(500, FramePeriod + 0.002, 0.0002);
+    CHECK(transition.numMissedFrames <= 20);
+
+    const auto result = simulation.run(5000, FramePeriod + 0.002, 0.0002);
+    CHECK(result.numMissedFrames <= 50);
+}
+
+TEST_CASE("running start: overload pins the offset at its bound") {
+    FrameLoopSimulation simulation(5);
+    const auto result = simulation.run(1000, FramePeriod + 0.006, 0.0002);
+    CHECK(result.numMissedFrames == 1000);
+    CHECK(simulation.controller().numMissedFrames() == 1000);
+    CHECK(simulation.controller().offset() == MaxOffset);
+}
+
+TEST_CASE("running start: wake-up jitter is kept as margin") {
+    FrameLoopSimulation simulation(6);
+    simulation.run(3000, 0.005, 0.0003, 0.001, 0.0003);
+    CHECK_NEAR(simulation.controller().wakeUpJitter(), 0.001, 0.0002);
+    CHECK(simulation.controller().numMissedFrames() == 0);
+}
+
+TEST_CASE("running start: a spike of CPU time raises the offset right away") {
+    FrameLoopSimulation simulation(7);
+    simulation.run(3000, FramePeriod, 0.0001);
+
+    RunningStartController& controller = simulation.controller();
+    const double before = controller.offset();
+    controller.onAppCpuTime(FramePeriod + 0.003);
+    CHECK(controller.offset() > before);
+    CHECK(controller.offset() <= MaxOffset);
+}
+
+TEST_CASE("running start: bounds and reset") {
+    RunningStartController controller;
+    controller.setBounds(MinOffset, MaxOffset);
+    controller.reset(1.0);
+    CHECK(controller.offset() == MaxOffset);
+    controller.reset(0.0);
+    CHECK(controller.offset() == MinOffset);
+
+    // Narrowing the bounds moves the offset into them.
+    controller.reset(0.003);
+    controller.setBounds(0.001, 0.002);
+    CHECK(controller.offset() == 0.002);
+
+    // Inverted bounds collapse onto the maximum.
+    controller.setBounds(0.004, 0.001);
+    CHECK(controller.offset() == 0.001);
+
+    controller.setBounds(MinOffset, MaxOffset);
+    controller.onFrameSubmitted(-0.001);
+    controller.onWakeUp(0.001);
+    controller.onAppCpuTime(0.01);
+    CHECK(controller.numMissedFrames() == 1);
+    controller.reset(0.002);
+    CHECK(controller.numMissedFrames() == 0);
+    CHECK(controller.wakeUpJitter() == 0);
+    CHECK(controller.appCpuTime() == 0);
+    CHECK(controller.slackQuantile() == 0);
+}
@@ -0,0 +1,339 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <framework/dispatch.h>
+#include <runtime.h>
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace virtualdesktop_openxr::test {
+
+    class TestRuntime : public OpenXrRuntime {
+      public:
+        TestRuntime(const Settings& settings) : m_settings(settings) {
+            m_settings.emplace("use_oculus_runtime", 1);
+        }
+
+        void setSetting(const std::string& name, int value) {
+            m_settings.insert_or_assign(name, value);
+            refreshSettings();
+        }
+
+      protected:
+        std::optional<int> getSetting(const std::string& value) const override {
+            const auto it = m_settings.find(value);
+            if (it == m_settings.cend()) {
+                return {};
+            }
+            return it->second;
+        }
+
+      private:
+        Settings m_settings;
+    };
+
+    TestInstance::TestInstance(const std::vector<const char*>& extensions, const Settings& settings) {
+        auto runtime = std::make_unique<TestRuntime>(settings);
+        m_runtime = runtime.get();
+        SetInstance(std::move(runtime));
+
+        XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+        sprintf_s(createInfo.applicationInfo.applicationName, sizeof(createInfo.applicationInfo.applicationName), "tests");
+        sprintf_s(createInfo.applicationInfo.engineName, sizeof(createInfo.applicationInfo.engineName), "tests");
+        createInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+        createInfo.enabledExtensionCount = (uint32_t)extensions.size();
+        createInfo.enabledExtensionNames = extensions.data();
+
+        const auto xrCreateInstance = get<PFN_xrCreateInstance>("xrCreateInstance");
+        const XrResult result = xrCreateInstance(&createInfo, &m_instance);
+        if (XR_FAILED(result)) {
+            ResetInstance();
+            throw std::runtime_error(fmt::format("xrCreateInstance failed with {}", xr::ToCString(result)));
+        }
+
+        // Resolve the most frequently used functions once, so that they do not skew the benchmarks.
+        m_xrStringToPath = get<PFN_xrStringToPath>("xrStringToPath");
+        m_xrPathToString = get<PFN_xrPathToString>("xrPathToString");
+    }
+
+    TestInstance::~TestInstance() {
+        if (m_instance != XR_NULL_HANDLE) {
+            get<PFN_xrDestroyInstance>("xrDestroyInstance")(m_instance);
+        }
+    }
+
+    XrPath TestInstance::stringToPath(const char* path) const {
+        XrPath xrPath = XR_NULL_PATH;
+        m_xrStringToPath(m_instance, path, &xrPath);
+        return xrPath;
+    }
+
+    std::string TestInstance::pathToString(XrPath path) const {
+        char buffer[XR_MAX_PATH_LENGTH];
+        uint32_t count = 0;
+        if (XR_FAILED(m_xrPathToString(m_instance, path, sizeof(buffer), &count, buffer))) {
+            return {};
+        }
+        return buffer;
+    }
+
+    void TestInstance::setSetting(const std::string& name, int value) {
+        m_runtime->setSetting(name, value);
+    }
+
+    XrResult TestInstance::resolve(const char* name, PFN_xrVoidFunction* function) const {
+        return virtualdesktop_openxr::xrGetInstanceProcAddr(m_instance, name, function);
+    }
+
+    TestSession::TestSession(const TestInstance& instance, const standin::Configuration& configuration)
+        : m_instance(instance) {
+        standin::Configure(configuration);
+
+        XrSystemGetInfo getInfo{XR_TYPE_SYSTEM_GET_INFO};
+        getInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+        XrSystemId systemId = XR_NULL_SYSTEM_ID;
+        if (XR_FAILED(instance.get<PFN_xrGetSystem>("xrGetSystem")(instance.handle(), &getInfo, &systemId))) {
+            SKIP("No graphics adapter for the stand-in headset");
+        }
+
+        XrGraphicsRequirementsD3D11KHR requirements{XR_TYPE_GRAPHICS_REQUIREMENTS_D3D11_KHR};
+        CHECK_XRCMD(instance.get<PFN_xrGetD3D11GraphicsRequirementsKHR>("xrGetD3D11GraphicsRequirementsKHR")(
+            instance.handle(), systemId, &requirements));
+
+        // Create the application device on the adapter of the headset.
+        {
+            ComPtr<IDXGIFactory1> dxgiFactory;
+            CHECK_HRCMD(CreateDXGIFactory1(IID_PPV_ARGS(dxgiFactory.ReleaseAndGetAddressOf())));
+
+            ComPtr<IDXGIAdapter1> dxgiAdapter;
+            for (UINT adapterIndex = 0;; adapterIndex++) {
+                if (FAILED(dxgiFactory->EnumAdapters1(adapterIndex, dxgiAdapter.ReleaseAndGetAddressOf()))) {
+                    SKIP("Adapter of the stand-in headset not found");
+                }
+
+                DXGI_ADAPTER_DESC1 desc;
+                CHECK_HRCMD(dxgiAdapter->GetDesc1(&desc));
+                if (!memcmp(&desc.AdapterLuid, &requirements.adapterLuid, sizeof(LUID))) {
+                    break;
+                }
+            }
+
+            D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
+            if (FAILED(D3D11CreateDevice(dxgiAdapter.Get(),
+                                         D3D_DRIVER_TYPE_UNKNOWN,
+                                         nullptr,
+                                         0,
+                                         &featureLevel,
+                                         1,
+                                         D3D11_SDK_VERSION,
+                                         m_device.ReleaseAndGetAddressOf(),
+                                         nullptr,
+                                         nullptr))) {
+                SKIP("D3D11 is not available");
+            }
+        }
+
+        {
+            XrGraphicsBindingD3D11KHR d3dBindings{XR_TYPE_GRAPHICS_BINDING_D3D11_KHR};
+            d3dBindings.device = m_device.Get();
+            XrSessionCreateInfo createInfo{XR_TYPE_SESSION_CREATE_INFO};
+            createInfo.next = &d3dBindings;
+            createInfo.systemId = systemId;
+            CHECK_XRCMD(instance.get<PFN_xrCreateSession>("xrCreateSession")(instance.handle(), &createInfo, &m_session));
+        }
+
+        {
+            XrReferenceSpaceCreateInfo createInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+            createInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+            createInfo.poseInReferenceSpace = xr::math::Pose::Identity();
+            CHECK_XRCMD(instance.get<PFN_xrCreateReferenceSpace>("xrCreateReferenceSpace")(
+                m_session, &createInfo, &m_localSpace));
+        }
+
+        // Both eyes side by side in one image.
+        {
+            XrSwapchainCreateInfo createInfo{XR_TYPE_SWAPCHAIN_CREATE_INFO};
+            createInfo.usageFlags = XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT;
+            createInfo.format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+            createInfo.sampleCount = 1;
+            createInfo.width = m_eyeExtent.width * xr::StereoView::Count;
+            createInfo.height = m_eyeExtent.height;
+            createInfo.faceCount = 1;
+            createInfo.arraySize = 1;
+            createInfo.mipCount = 1;
+            CHECK_XRCMD(
+                instance.get<PFN_xrCreateSwapchain>("xrCreateSwapchain")(m_session, &createInfo, &m_swapchain));
+
+            // Import the images into the application device.
+            uint32_t count = 0;
+            const auto xrEnumerateSwapchainImages =
+                instance.get<PFN_xrEnumerateSwapchainImages>("xrEnumerateSwapchainImages");
+            CHECK_XRCMD(xrEnumerateSwapchainImages(m_swapchain, 0, &count, nullptr));
+            std::vector<XrSwapchainImageD3D11KHR> images(count, {XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR});
+            CHECK_XRCMD(xrEnumerateSwapchainImages(
+                m_swapchain, count, &count, reinterpret_cast<XrSwapchainImageBaseHeader*>(images.data())));
+        }
+
+        {
+            XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+            beginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+            CHECK_XRCMD(instance.get<PFN_xrBeginSession>("xrBeginSession")(m_session, &beginInfo));
+        }
+
+        // Resolve the functions of the frame loop once, so that they do not skew the benchmarks.
+        m_xrWaitFrame = instance.get<PFN_xrWaitFrame>("xrWaitFrame");
+        m_xrBeginFrame = instance.get<PFN_xrBeginFrame>("xrBeginFrame");
+        m_xrEndFrame = instance.get<PFN_xrEndFrame>("xrEndFrame");
+        m_xrLocateViews = instance.get<PFN_xrLocateViews>("xrLocateViews");
+        m_xrAcquireSwapchainImage = instance.get<PFN_xrAcquireSwapchainImage>("xrAcquireSwapchainImage");
+        m_xrWaitSwapchainImage = instance.get<PFN_xrWaitSwapchainImage>("xrWaitSwapchainImage");
+        m_xrReleaseSwapchainImage = instance.get<PFN_xrReleaseSwapchainImage>("xrReleaseSwapchainImage");
+    }
+
+    TestSession::~TestSession() {
+        if (m_swapchain != XR_NULL_HANDLE) {
+            m_instance.get<PFN_xrDestroySwapchain>("xrDestroySwapchain")(m_swapchain);
+        }
+        if (m_localSpace != XR_NULL_HANDLE) {
+            m_instance.get<PFN_xrDestroySpace>("xrDestroySpace")(m_localSpace);
+        }
+        if (m_session != XR_NULL_HANDLE) {
+            m_instance.get<PFN_xrDestroySession>("xrDestroySession")(m_session);
+        }
+    }
+
+    uint32_t TestSession::runFrame() {
+        const XrFrameState frameState = waitFrame();
+        beginFrame();
+        const uint32_t imageIndex = renderFrame(frameState.predictedDisplayTime);
+        endFrame(frameState.predictedDisplayTime);
+        return imageIndex;
+    }
+
+    XrFrameState TestSession::waitFrame() {
+        XrFrameState frameState{XR_TYPE_FRAME_STATE};
+        CHECK_XRCMD(m_xrWaitFrame(m_session, nullptr, &frameState));
+        return frameState;
+    }
+
+    void TestSession::beginFrame() {
+        CHECK_XRCMD(m_xrBeginFrame(m_session, nullptr));
+    }
+
+    uint32_t TestSession::renderFrame(XrTime displayTime) {
+        XrViewLocateInfo locateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+        locateInfo.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+        locateInfo.displayTime = displayTime;
+        locateInfo.space = m_localSpace;
+        XrViewState viewState{XR_TYPE_VIEW_STATE};
+        uint32_t viewCount = 0;
+        CHECK_XRCMD(m_xrLocateViews(m_session, &locateInfo, &viewState, xr::StereoView::Count, &viewCount, m_views));
+
+        uint32_t imageIndex = 0;
+        CHECK_XRCMD(m_xrAcquireSwapchainImage(m_swapchain, nullptr, &imageIndex));
+        XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
+        waitInfo.timeout = XR_INFINITE_DURATION;
+        CHECK_XRCMD(m_xrWaitSwapchainImage(m_swapchain, &waitInfo));
+        CHECK_XRCMD(m_xrReleaseSwapchainImage(m_swapchain, nullptr));
+
+        return imageIndex;
+    }
+
+    void TestSession::endFrame(XrTime displayTime) {
+        XrCompositionLayerProjectionView projectionViews[xr::StereoView::Count];
+        for (uint32_t i = 0; i < xr::StereoView::Count; i++) {
+            projectionViews[i] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
+            projectionViews[i].pose = m_views[i].pose;
+            projectionViews[i].fov = m_views[i].fov;
+            projectionViews[i].subImage.swapchain = m_swapchain;
+            projectionViews[i].subImage.imageRect = {{(int32_t)i * m_eyeExtent.width, 0}, m_eyeExtent};
+        }
+
+        XrCompositionLayerProjection projectionLayer{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+        projectionLayer.space = m_localSpace;
+        projectionLayer.viewCount = xr::StereoView::Count;
+        projectionLayer.views = projectionViews;
+        const XrCompositionLayerBaseHeader* layers[] = {
+            reinterpret_cast<const XrCompositionLayerBaseHeader*>(&projectionLayer)};
+
+        XrFrameEndInfo endInfo{XR_TYPE_FRAME_END_INFO};
+        endInfo.displayTime = displayTime;
+        endInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+        endInfo.layerCount = (uint32_t)std::size(layers);
+        endInfo.layers = layers;
+        CHECK_XRCMD(m_xrEndFrame(m_session, &endInfo));
+    }
+
+    XrActionSet CreateActionSet(const TestInstance& instance, const std::string& name, uint32_t priority) {
+        XrActionSetCreateInfo createInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+        sprintf_s(createInfo.actionSetName, sizeof(createInfo.actionSetName), "%s", name.c_str());
+        sprintf_s(createInfo.localizedActionSetName, sizeof(createInfo.localizedActionSetName), "%s", name.c_str());
+        createInfo.priority = priority;
+        XrActionSet actionSet = XR_NULL_HANDLE;
+        CHECK_XRCMD(
+            instance.get<PFN_xrCreateActionSet>("xrCreateActionSet")(instance.handle(), &createInfo, &actionSet));
+        return actionSet;
+    }
+
+    XrAction CreateAction(const TestInstance& instance,
+                          XrActionSet actionSet,
+                          const std::string& name,
+                          XrActionType type,
+                          const std::vector<XrPath>& subactionPaths) {
+        XrActionCreateInfo createInfo{XR_TYPE_ACTION_CREATE_INFO};
+        sprintf_s(createInfo.actionName, sizeof(createInfo.actionName), "%s", name.c_str());
+        sprintf_s(createInfo.localizedActionName, sizeof(createInfo.localizedActionName), "%s", name.c_str());
+        createInfo.actionType = type;
+        createInfo.countSubactionPaths = (uint32_t)subactionPaths.size();
+        createInfo.subactionPaths = subactionPaths.data();
+        XrAction action = XR_NULL_HANDLE;
+        CHECK_XRCMD(instance.get<PFN_xrCreateAction>("xrCreateAction")(actionSet, &createInfo, &action));
+        return action;
+    }
+
+    void SuggestBindings(const TestInstance& instance,
+                         const char* interactionProfile,
+                         const std::vector<std::pair<XrAction, std::string>>& bindings) {
+        std::vector<XrActionSuggestedBinding> suggestedBindings;
+        for (const auto& binding : bindings) {
+            suggestedBindings.push_back({binding.first, instance.stringToPath(binding.second.c_str())});
+        }
+
+        XrInteractionProfileSuggestedBinding suggestedBinding{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+        suggestedBinding.interactionProfile = instance.stringToPath(interactionProfile);
+        suggestedBinding.countSuggestedBindings = (uint32_t)suggestedBindings.size();
+        suggestedBinding.suggestedBindings = suggestedBindings.data();
+        CHECK_XRCMD(instance.get<PFN_xrSuggestInteractionProfileBindings>("xrSuggestInteractionProfileBindings")(
+            instance.handle(), &suggestedBinding));
+    }
+
+    void AttachActionSets(const TestInstance& instance, XrSession session, const std::vector<XrActionSet>& actionSets) {
+        XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+        attachInfo.countActionSets = (uint32_t)actionSets.size();
+        attachInfo.actionSets = actionSets.data();
+        CHECK_XRCMD(instance.get<PFN_xrAttachSessionActionSets>("xrAttachSessionActionSets")(session, &attachInfo));
+    }
+
+} // namespace virtualdesktop_openxr::test
@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "standin_ovr.h"
+
+namespace virtualdesktop_openxr::test {
+
+    // The settings that the runtime reads instead of the registry. Settings missing from the map are unset, except for
+    // use_oculus_runtime, which defaults to 1 to load the stand-in LibOVR. The few settings read by the constructor of
+    // OpenXrRuntime still come from the registry.
+    using Settings = std::map<std::string, int>;
+
+    class TestRuntime;
+
+    // An instance of the runtime, created directly through its xrGetInstanceProcAddr() rather than through the loader.
+    class TestInstance {
+      public:
+        TestInstance(const std::vector<const char*>& extensions = {}, const Settings& settings = {});
+        ~TestInstance();
+
+        XrInstance handle() const {
+            return m_instance;
+        }
+
+        template <typename T>
+        T get(const char* name) const {
+            PFN_xrVoidFunction function = nullptr;
+            if (XR_FAILED(resolve(name, &function))) {
+                throw std::runtime_error(fmt::format("Failed to resolve {}", name));
+            }
+            return reinterpret_cast<T>(function);
+        }
+
+        XrPath stringToPath(const char* path) const;
+        std::string pathToString(XrPath path) const;
+
+        // Change a setting while the instance is running, like a change in the registry would.
+        void setSetting(const std::string& name, int value);
+
+      private:
+        XrResult resolve(const char* name, PFN_xrVoidFunction* function) const;
+
+        TestRuntime* m_runtime{nullptr};
+        XrInstance m_instance{XR_NULL_HANDLE};
+        PFN_xrStringToPath m_xrStringToPath{nullptr};
+        PFN_xrPathToString m_xrPathToString{nullptr};
+    };
+
+    // A D3D11 session on the stand-in LibOVR, with a stereo swapchain and a LOCAL reference space. The instance must
+    // have been created with XR_KHR_D3D11_enable. Skips the test case when the machine has no graphics adapter.
+    class TestSession {
+      public:
+        TestSession(const TestInstance& instance, const standin::Configuration& configuration = {});
+        ~TestSession();
+
+        XrSession handle() const {
+            return m_session;
+        }
+
+        XrSpace localSpace() const {
+            return m_localSpace;
+        }
+
+        // Run one frame of a minimal application: wait, begin, locate the views, render nothing into the next
+        // swapchain image and submit it in a projection layer. Returns the index of the image submitted.
+        uint32_t runFrame();
+
+        // The same frame, in steps, for the tests that interleave their own work. endFrame() submits the image returned
+        // by renderFrame().
+        XrFrameState waitFrame();
+        void beginFrame();
+        uint32_t renderFrame(XrTime displayTime);
+        void endFrame(XrTime displayTime);
+
+      private:
+        const TestInstance& m_instance;
+        ComPtr<ID3D11Device> m_device;
+        XrSession m_session{XR_NULL_HANDLE};
+        XrSpace m_localSpace{XR_NULL_HANDLE};
+        XrSwapchain m_swapchain{XR_NULL_HANDLE};
+        XrView m_views[xr::StereoView::Count]{{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+        XrExtent2Di m_eyeExtent{256, 256};
+
+        PFN_xrWaitFrame m_xrWaitFrame{nullptr};
+        PFN_xrBeginFrame m_xrBeginFrame{nullptr};
+        PFN_xrEndFrame m_xrEndFrame{nullptr};
+        PFN_xrLocateViews m_xrLocateViews{nullptr};
+        PFN_xrAcquireSwapchainImage m_xrAcquireSwapchainImage{nullptr};
+        PFN_xrWaitSwapchainImage m_xrWaitSwapchainImage{nullptr};
+        PFN_xrReleaseSwapchainImage m_xrReleaseSwapchainImage{nullptr};
+    };
+
+    // Helpers to set up the action system. They throw upon failure.
+    XrActionSet CreateActionSet(const TestInstance& instance, const std::string& name, uint32_t priority = 0);
+    XrAction CreateAction(const TestInstance& instance,
+                          XrActionSet actionSet,
+                          const std::string& name,
+                          XrActionType type,
+                          const std::vector<XrPath>& subactionPaths = {});
+    void SuggestBindings(const TestInstance& instance,
+                         const char* interactionProfile,
+                         const std::vector<std::pair<XrAction, std::string>>& bindings);
+    void AttachActionSets(const TestInstance& instance, XrSession session, const std::vector<XrActionSet>& actionSets);
+
+} // namespace virtualdesktop_openxr::test
@@ -0,0 +1,272 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::utils;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    // A payload spanning a cache line, so that a slot read while being written would be caught.
+    struct Payload {
+        uint64_t sequence;
+        uint64_t check[7];
+
+        void fill(uint64_t value) {
+            sequence = value;
+            for (auto& word : check) {
+                word = ~value;
+            }
+        }
+
+        bool isConsistent(uint64_t expected) const {
+            return sequence == expected && std::all_of(std::cbegin(check), std::cend(check), [&](uint64_t word) {
+                       return word == ~expected;
+                   });
+        }
+    };
+
+    struct TimedPayload {
+        Clock::time_point publishTime;
+    };
+
+    // Give the other thread the time to go to sleep. Sleeping would take far longer than requested.
+    void SpinFor(std::chrono::microseconds duration) {
+        const auto end = Clock::now() + duration;
+        while (Clock::now() < end) {
+            _mm_pause();
+        }
+    }
+
+    // Print the mean and the 99th percentile of the latencies, in the format of Measure().
+    void ReportLatencies(const char* label, std::vector<double>& latencies) {
+        std::sort(latencies.begin(), latencies.end());
+        double total = 0;
+        for (const double latency : latencies) {
+            total += latency;
+        }
+        const double mean = total / latencies.size();
+        ReportMeasurement(fmt::format("{} (mean)", label).c_str(), mean);
+        ReportMeasurement(fmt::format("{} (p99)", label).c_str(), latencies[latencies.size() * 99 / 100]);
+    }
+
+} // namespace
+
+TEST_CASE("spsc ring: single-threaded sequencing") {
+    SpscRing<Payload, 3> ring;
+    ring.reset();
+    CHECK(ring.pending() == 0);
+    CHECK(ring.waitForRelease(0));
+
+    // Nobody requested anything yet: only the slots allowed ahead of the requests may be published.
+    const auto past = Clock::now() - 1s;
+    CHECK(!ring.waitForRequest(0, past));
+    CHECK(ring.waitForRequest(1, past));
+
+    for (uint64_t i = 0; i < 3; i++) {
+        REQUIRE(ring.waitForRelease(2, past));
+        ring.producerSlot().fill(i);
+        ring.publish();
+        CHECK(ring.pending() == i + 1);
+    }
+
+    // The ring is full.
+    CHECK(!ring.waitForRelease(2, past));
+
+    for (uint64_t i = 0; i < 3; i++) {
+        const Payload* const slot = ring.acquire();
+        REQUIRE(slot);
+        CHECK(slot->isConsistent(i));
+
+        // The request was counted when acquiring the slot: one more slot may now be ahead of the requests.
+        CHECK(ring.waitForRequest((uint32_t)(3 - i), past));
+        CHECK(!ring.waitForRequest((uint32_t)(2 - i), past));
+        ring.release();
+        CHECK(ring.pending() == 2 - i);
+    }
+    CHECK(ring.waitForRelease(0, past));
+}
+
+TEST_CASE("spsc ring: slots are handed over in order and intact") {
+    constexpr uint64_t NumItems = 200000;
+    SpscRing<Payload, 3> ring;
+    ring.reset();
+
+    uint64_t numBad = 0;
+    std::thread consumer([&] {
+        for (uint64_t i = 0; i < NumItems; i++) {
+            const Payload* const slot = ring.acquire();
+            if (!slot) {
+                numBad++;
+                break;
+            }
+            if (!slot->isConsistent(i)) {
+                numBad++;
+            }
+            ring.release();
+        }
+    });
+
+    for (uint64_t i = 0; i < NumItems; i++) {
+        CHECK(ring.waitForRelease(2));
+        ring.producerSlot().fill(i);
+        ring.publish();
+    }
+    consumer.join();
+
+    CHECK(numBad == 0);
+    CHECK(ring.pending() == 0);
+}
+
+TEST_CASE("spsc ring: the producer is paced on the requests") {
+    constexpr uint64_t NumItems = 2000;
+    SpscRing<Payload, 3> ring;
+    ring.reset();
+
+    // With no slot allowed ahead, the producer never publishes before the consumer asked for it.
+    std::atomic<uint64_t> numRequested = 0;
+    uint64_t numEarly = 0;
+    std::thread consumer([&] {
+        for (uint64_t i = 0; i < NumItems; i++) {
+            numRequested++;
+            if (ring.acquire()) {
+                ring.release();
+            }
+        }
+    });
+
+    for (uint64_t i = 0; i < NumItems; i++) {
+        CHECK(ring.waitForRequest(0));
+        if (numRequested.load() < i + 1) {
+            numEarly++;
+        }
+        CHECK(ring.waitForRelease(2));
+        ring.producerSlot().fill(i);
+        ring.publish();
+    }
+    consumer.join();
+
+    CHECK(numEarly == 0);
+}
+
+TEST_CASE("spsc ring: deadlines and closing") {
+    SpscRing<Payload, 2> ring;
+    ring.reset();
+
+    // Nothing will ever request a slot: the wait ends at the deadline.
+    const auto start = Clock::now();
+    CHECK(!ring.waitForRequest(0, start + 5ms));
+    CHECK(Clock::now() - start >= 5ms);
+
+    // Closing wakes up either side, and makes subsequent waits fail.
+    std::thread producer([&] { CHECK(!ring.waitForRequest(0)); });
+    std::this_thread::sleep_for(10ms);
+    ring.close();
+    producer.join();
+    CHECK(!ring.waitForRelease(2));
+
+    ring.reset();
+    std::thread consumer([&] { CHECK(ring.acquire() == nullptr); });
+    std::this_thread::sleep_for(10ms);
+    ring.close();
+    consumer.join();
+
+    // The ring is usable again after a reset.
+    ring.reset();
+    CHECK(ring.waitForRelease(0));
+    ring.producerSlot().fill(0);
+    ring.publish();
+    const Payload* const slot = ring.acquire();
+    REQUIRE(slot);
+    CHECK(slot->isConsistent(0));
+    ring.release();
+}
+
+BENCHMARK("spsc ring: handoff latency") {
+    constexpr uint32_t NumItems = 20000;
+    std::vector<double> latencies;
+    latencies.reserve(NumItems);
+
+    // The consumer is waiting for every item, like the submission thread waiting for the next frame.
+    {
+        SpscRing<TimedPayload, 3> ring;
+        ring.reset();
+        std::thread consumer([&] {
+            for (uint32_t i = 0; i < NumItems; i++) {
+                const TimedPayload* const slot = ring.acquire();
+                if (!slot) {
+                    break;
+                }
+                latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - slot->publishTime).count());
+                ring.release();
+            }
+        });
+        for (uint32_t i = 0; i < NumItems; i++) {
+            ring.waitForRequest(1);
+            ring.waitForRelease(0);
+            SpinFor(std::chrono::microseconds(20 + i % 20));
+            ring.producerSlot().publishTime = Clock::now();
+            ring.publish();
+        }
+        consumer.join();
+        ReportLatencies("SpscRing publish to acquire", latencies);
+    }
+
+    // The mutex and condition variable pair that the ring replaced, with the same pacing.
+    {
+        latencies.clear();
+        std::mutex mutex;
+        std::condition_variable condVar;
+        std::optional<TimedPayload> pending;
+        std::thread consumer([&] {
+            for (uint32_t i = 0; i < NumItems; i++) {
+                std::unique_lock lock(mutex);
+                condVar.wait(lock, [&] { return pending.has_value(); });
+                latencies.push_back(
+                    std::chrono::duration<double, std::nano>(Clock::now() - pending->publishTime).count());
+                pending.reset();
+                condVar.notify_all();
+            }
+        });
+        for (uint32_t i = 0; i < NumItems; i++) {
+            {
+                std::unique_lock lock(mutex);
+                condVar.wait(lock, [&] { return !pending.has_value(); });
+            }
+            SpinFor(std::chrono::microseconds(20 + i % 20));
+            {
+                std::unique_lock lock(mutex);
+                pending = TimedPayload{Clock::now()};
+            }
+            condVar.notify_all();
+        }
+        consumer.join();
+        ReportLatencies("mutex + condition variable", latencies);
+    }
+}
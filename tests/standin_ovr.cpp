@@ -0,0 +1,608 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <utils.h>
+
+#include "standin_ovr.h"
+
+// The opaque OVR handles, defined by LibOVR itself in the real runtime.
+struct ovrHmdStruct {
+    int unused;
+};
+
+struct ovrTextureSwapChainData {
+    ovrTextureSwapChainDesc desc{};
+    std::vector<ComPtr<ID3D11Texture2D>> images;
+    int currentIndex{0};
+    int lastCommittedIndex{-1};
+};
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test::standin;
+    using namespace virtualdesktop_openxr::utils;
+
+    constexpr size_t k_submittedFramesHistory = 1024;
+
+    // Per-frame recording uses fixed storage only, so that the stand-in does not show up in the allocation counts of
+    // the runtime's frame loop.
+    struct State {
+        std::mutex mutex;
+        Configuration configuration;
+
+        ovrHmdStruct session{};
+        bool sessionCreated{false};
+        LUID adapterLuid{};
+        double period{1.0 / 90};
+
+        long long lastWaitVsync{0};
+        long long lastWaitFrameIndex{0};
+        long long lastPresentedVsync{0};
+        std::mt19937 jitterRandom;
+
+        ovrInputState inputState{};
+        ovrPosef devicePoses[3]{};
+
+        SubmittedFrame submittedFrames[k_submittedFramesHistory];
+        uint64_t numSubmittedFrames{0};
+
+        // Newest first, like ovrPerfStats.
+        ovrPerfStatsPerCompositorFrame perfStats[ovrMaxProvidedFrameStats]{};
+        int numPerfStats{0};
+        bool anyPerfStatsDropped{false};
+    };
+
+    State& GetState() {
+        static State state;
+        return state;
+    }
+
+    double Now() {
+        static const double frequency = [] {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            return (double)frequency.QuadPart;
+        }();
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        return now.QuadPart / frequency;
+    }
+
+    // The simulated vsync number N happens at N * period.
+    long long VsyncIndex(const State& state, double time) {
+        return (long long)std::floor(time / state.period);
+    }
+
+    double VsyncTime(const State& state, long long index) {
+        return index * state.period;
+    }
+
+    void SleepUntil(double time) {
+        // Windows sleeps in increments of the timer resolution (up to 15.6ms) unless using a high resolution timer.
+        thread_local wil::unique_handle timer(
+            CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS));
+
+        while (true) {
+            const double remaining = time - Now();
+            if (remaining <= 0) {
+                break;
+            }
+
+            // Spin for the last fraction of a millisecond.
+            if (timer && remaining > 0.0005) {
+                LARGE_INTEGER dueTime;
+                dueTime.QuadPart = -(LONGLONG)((remaining - 0.0002) * 1e7);
+                SetWaitableTimer(timer.get(), &dueTime, 0, nullptr, nullptr, FALSE);
+                WaitForSingleObject(timer.get(), INFINITE);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    int DeviceIndex(ovrTrackedDeviceType device) {
+        switch (device) {
+        case ovrTrackedDevice_LTouch:
+            return 1;
+        case ovrTrackedDevice_RTouch:
+            return 2;
+        default:
+            return 0;
+        }
+    }
+
+    ovrPoseStatef MakePoseState(const ovrPosef& pose, double time) {
+        ovrPoseStatef state{};
+        state.ThePose = pose;
+        state.TimeInSeconds = time;
+        return state;
+    }
+
+    // The swapchain presented by a layer, for the layer types that the runtime submits.
+    size_t GetLayerSize(const ovrLayerHeader* layer) {
+        switch (layer->Type) {
+        case ovrLayerType_EyeFov:
+            return sizeof(ovrLayerEyeFov);
+        case ovrLayerType_EyeFovDepth:
+            return sizeof(ovrLayerEyeFovDepth);
+        case ovrLayerType_Quad:
+            return sizeof(ovrLayerQuad);
+        case ovrLayerType_Cylinder:
+            return sizeof(ovrLayerCylinder);
+        default:
+            return sizeof(ovrLayerHeader);
+        }
+    }
+
+    ovrTextureSwapChain GetLayerSwapchain(const ovrLayerHeader* layer) {
+        switch (layer->Type) {
+        case ovrLayerType_EyeFov:
+        case ovrLayerType_EyeFovDepth:
+            return reinterpret_cast<const ovrLayerEyeFov*>(layer)->ColorTexture[ovrEye_Left];
+        case ovrLayerType_Quad:
+            return reinterpret_cast<const ovrLayerQuad*>(layer)->ColorTexture;
+        case ovrLayerType_Cylinder:
+            return reinterpret_cast<const ovrLayerCylinder*>(layer)->ColorTexture;
+        default:
+            return nullptr;
+        }
+    }
+
+} // namespace
+
+namespace virtualdesktop_openxr::test::standin {
+
+    void Configure(const Configuration& configuration) {
+        State& state = GetState();
+        std::unique_lock lock(state.mutex);
+        state.configuration = configuration;
+    }
+
+    void SetInputState(const ovrInputState& inputState) {
+        State& state = GetState();
+        std::unique_lock lock(state.mutex);
+        state.inputState = inputState;
+    }
+
+    void SetDevicePose(ovrTrackedDeviceType device, const ovrPosef& pose) {
+        State& state = GetState();
+        std::unique_lock lock(state.mutex);
+        state.devicePoses[DeviceIndex(device)] = pose;
+    }
+
+    std::vector<SubmittedFrame> GetSubmittedFrames() {
+        State& state = GetState();
+        std::unique_lock lock(state.mutex);
+
+        const uint64_t count = std::min(state.numSubmittedFrames, (uint64_t)k_submittedFramesHistory);
+        std::vector<SubmittedFrame> frames;
+        frames.reserve(count);
+        for (uint64_t i = state.numSubmittedFrames - count; i < state.numSubmittedFrames; i++) {
+            frames.push_back(state.submittedFrames[i % k_submittedFramesHistory]);
+        }
+        return frames;
+    }
+
+    uint64_t GetSubmittedFrameCount() {
+        State& state = GetState();
+        std::unique_lock lock(state.mutex);
+        return state.numSubmittedFrames;
+    }
+
+} // namespace virtualdesktop_openxr::test::standin
+
+// Declared by the runtime, from our OVR_CAPIShim.c fork.
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_InitializeWithPathOverride(const ovrInitParams* inputParams, const wchar_t* overrideLibraryPath) {
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_Initialize(const ovrInitParams* params) {
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(void) ovr_Shutdown() {
+}
+
+OVR_PUBLIC_FUNCTION(const char*) ovr_GetVersionString() {
+    return "Stand-in " OVR_VERSION_STRING;
+}
+
+OVR_PUBLIC_FUNCTION(double) ovr_GetTimeInSeconds() {
+    return Now();
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_Create(ovrSession* pSession, ovrGraphicsLuid* pLuid) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    if (state.sessionCreated) {
+        return ovrError_Initialize;
+    }
+
+    // The "headset" is connected to the first adapter.
+    ComPtr<IDXGIFactory1> dxgiFactory;
+    ComPtr<IDXGIAdapter1> dxgiAdapter;
+    DXGI_ADAPTER_DESC1 desc;
+    if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(dxgiFactory.ReleaseAndGetAddressOf()))) ||
+        FAILED(dxgiFactory->EnumAdapters1(0, dxgiAdapter.ReleaseAndGetAddressOf())) ||
+        FAILED(dxgiAdapter->GetDesc1(&desc))) {
+        return ovrError_NoHmd;
+    }
+    state.adapterLuid = desc.AdapterLuid;
+    static_assert(sizeof(ovrGraphicsLuid) >= sizeof(LUID));
+    memcpy(pLuid, &state.adapterLuid, sizeof(LUID));
+
+    state.period = 1.0 / state.configuration.refreshRate;
+    state.lastWaitVsync = state.lastPresentedVsync = VsyncIndex(state, Now());
+    state.lastWaitFrameIndex = 0;
+    state.jitterRandom.seed(state.configuration.jitterSeed);
+    state.numSubmittedFrames = 0;
+    state.numPerfStats = 0;
+    state.anyPerfStatsDropped = false;
+    state.inputState = {};
+    for (auto& pose : state.devicePoses) {
+        pose = {};
+        pose.Orientation.w = 1.f;
+    }
+    state.devicePoses[1].Position = {-0.2f, -0.3f, -0.4f};
+    state.devicePoses[2].Position = {0.2f, -0.3f, -0.4f};
+
+    state.sessionCreated = true;
+    *pSession = &state.session;
+
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(void) ovr_Destroy(ovrSession session) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+    state.sessionCreated = false;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetSessionStatus(ovrSession session, ovrSessionStatus* sessionStatus) {
+    *sessionStatus = {};
+    sessionStatus->IsVisible = ovrTrue;
+    sessionStatus->HmdPresent = ovrTrue;
+    sessionStatus->HmdMounted = ovrTrue;
+    sessionStatus->HasInputFocus = ovrTrue;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrHmdDesc) ovr_GetHmdDesc(ovrSession session) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    ovrHmdDesc desc{};
+    desc.Type = ovrHmd_CV1;
+    sprintf_s(desc.ProductName, sizeof(desc.ProductName), "Stand-in HMD");
+    sprintf_s(desc.Manufacturer, sizeof(desc.Manufacturer), "Tests");
+    sprintf_s(desc.SerialNumber, sizeof(desc.SerialNumber), "STANDIN0001");
+    desc.VendorId = 0x2833;
+    desc.ProductId = 0x0031;
+    for (int eye = 0; eye < ovrEye_Count; eye++) {
+        desc.DefaultEyeFov[eye] = desc.MaxEyeFov[eye] = {1.f, 1.f, 1.f, 1.f};
+    }
+    desc.Resolution = {2880, 1600};
+    desc.DisplayRefreshRate = state.configuration.refreshRate;
+    return desc;
+}
+
+OVR_PUBLIC_FUNCTION(ovrEyeRenderDesc) ovr_GetRenderDesc(ovrSession session, ovrEyeType eyeType, ovrFovPort fov) {
+    ovrEyeRenderDesc desc{};
+    desc.Eye = eyeType;
+    desc.Fov = fov;
+    desc.DistortedViewport = {{eyeType == ovrEye_Left ? 0 : 1440, 0}, {1440, 1600}};
+    desc.PixelsPerTanAngleAtCenter = {720.f, 800.f};
+    desc.HmdToEyePose.Orientation.w = 1.f;
+    desc.HmdToEyePose.Position.x = eyeType == ovrEye_Left ? -0.032f : 0.032f;
+    return desc;
+}
+
+OVR_PUBLIC_FUNCTION(ovrSizei)
+ovr_GetFovTextureSize(ovrSession session, ovrEyeType eye, ovrFovPort fov, float pixelsPerDisplayPixel) {
+    return {(int)(720 * (fov.LeftTan + fov.RightTan) * pixelsPerDisplayPixel),
+            (int)(800 * (fov.UpTan + fov.DownTan) * pixelsPerDisplayPixel)};
+}
+
+OVR_PUBLIC_FUNCTION(float) ovr_GetFloat(ovrSession session, const char* propertyName, float defaultVal) {
+    return defaultVal;
+}
+
+OVR_PUBLIC_FUNCTION(ovrBool) ovr_SetFloat(ovrSession session, const char* propertyName, float value) {
+    return ovrTrue;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_SetTrackingOriginType(ovrSession session, ovrTrackingOrigin origin) {
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrTrackingState) ovr_GetTrackingState(ovrSession session, double absTime, ovrBool latencyMarker) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    ovrTrackingState trackingState{};
+    trackingState.HeadPose = MakePoseState(state.devicePoses[0], absTime);
+    trackingState.StatusFlags = ovrStatus_OrientationTracked | ovrStatus_PositionTracked;
+    for (int hand = 0; hand < ovrHand_Count; hand++) {
+        trackingState.HandPoses[hand] = MakePoseState(state.devicePoses[1 + hand], absTime);
+        trackingState.HandStatusFlags[hand] = ovrStatus_OrientationTracked | ovrStatus_PositionTracked;
+    }
+    trackingState.CalibratedOrigin.Orientation.w = 1.f;
+    return trackingState;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_GetDevicePoses(
+    ovrSession session, ovrTrackedDeviceType* deviceTypes, int deviceCount, double absTime, ovrPoseStatef* outDevicePoses) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    for (int i = 0; i < deviceCount; i++) {
+        outDevicePoses[i] = MakePoseState(state.devicePoses[DeviceIndex(deviceTypes[i])], absTime);
+    }
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_GetInputState(ovrSession session, ovrControllerType controllerType, ovrInputState* inputState) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    *inputState = state.inputState;
+    inputState->TimeInSeconds = Now();
+    inputState->ControllerType = controllerType;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_SetControllerVibration(ovrSession session, ovrControllerType controllerType, float frequency, float amplitude) {
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_GetFovStencil(ovrSession session, const ovrFovStencilDesc* fovStencilDesc, ovrFovStencilMeshBuffer* meshBuffer) {
+    return ovrError_Unsupported;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_CreateTextureSwapChainDX(ovrSession session,
+                             IUnknown* d3dPtr,
+                             const ovrTextureSwapChainDesc* desc,
+                             ovrTextureSwapChain* outTextureSwapChain) {
+    ComPtr<ID3D11Device> device;
+    if (!d3dPtr || FAILED(d3dPtr->QueryInterface(IID_PPV_ARGS(device.ReleaseAndGetAddressOf())))) {
+        return ovrError_InvalidParameter;
+    }
+
+    DXGI_FORMAT format = ovrToDxgiTextureFormat(desc->Format);
+    if (format == DXGI_FORMAT_UNKNOWN || desc->Type != ovrTexture_2D) {
+        return ovrError_InvalidParameter;
+    }
+    const bool isTypeless = desc->MiscFlags & ovrTextureMisc_DX_Typeless;
+    if (isTypeless) {
+        format = getTypelessFormat(format);
+    }
+
+    D3D11_TEXTURE2D_DESC textureDesc{};
+    textureDesc.Width = desc->Width;
+    textureDesc.Height = desc->Height;
+    textureDesc.MipLevels = desc->MipLevels;
+    textureDesc.ArraySize = desc->ArraySize;
+    textureDesc.Format = format;
+    textureDesc.SampleDesc.Count = desc->SampleCount;
+    textureDesc.Usage = D3D11_USAGE_DEFAULT;
+    if (isTypeless || !(desc->BindFlags & ovrTextureBind_DX_DepthStencil)) {
+        textureDesc.BindFlags |= D3D11_BIND_SHADER_RESOURCE;
+    }
+    if (desc->BindFlags & ovrTextureBind_DX_RenderTarget) {
+        textureDesc.BindFlags |= D3D11_BIND_RENDER_TARGET;
+    }
+    if (desc->BindFlags & ovrTextureBind_DX_DepthStencil) {
+        textureDesc.BindFlags |= D3D11_BIND_DEPTH_STENCIL;
+    }
+    if (desc->BindFlags & ovrTextureBind_DX_UnorderedAccess) {
+        textureDesc.BindFlags |= D3D11_BIND_UNORDERED_ACCESS;
+    }
+    // The runtime shares the images with the application device.
+    textureDesc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+
+    int length = 1;
+    if (!desc->StaticImage) {
+        State& state = GetState();
+        std::unique_lock lock(state.mutex);
+        length = state.configuration.swapchainLength;
+    }
+
+    auto swapchain = std::make_unique<ovrTextureSwapChainData>();
+    swapchain->desc = *desc;
+    for (int i = 0; i < length; i++) {
+        ComPtr<ID3D11Texture2D> texture;
+        if (FAILED(device->CreateTexture2D(&textureDesc, nullptr, texture.ReleaseAndGetAddressOf()))) {
+            return ovrError_MemoryAllocationFailure;
+        }
+        swapchain->images.push_back(texture);
+    }
+
+    *outTextureSwapChain = swapchain.release();
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_GetTextureSwapChainBufferDX(
+    ovrSession session, ovrTextureSwapChain chain, int index, IID iid, void** out_Buffer) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    if (index < 0) {
+        index = chain->currentIndex;
+    }
+    if (index >= (int)chain->images.size()) {
+        return ovrError_InvalidParameter;
+    }
+    return SUCCEEDED(chain->images[index]->QueryInterface(iid, out_Buffer)) ? ovrSuccess : ovrError_InvalidParameter;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_GetTextureSwapChainLength(ovrSession session, ovrTextureSwapChain chain, int* out_Length) {
+    *out_Length = (int)chain->images.size();
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_GetTextureSwapChainCurrentIndex(ovrSession session, ovrTextureSwapChain chain, int* out_Index) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+    *out_Index = chain->currentIndex;
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_CommitTextureSwapChain(ovrSession session, ovrTextureSwapChain chain) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+    chain->lastCommittedIndex = chain->currentIndex;
+    chain->currentIndex = (chain->currentIndex + 1) % (int)chain->images.size();
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(void) ovr_DestroyTextureSwapChain(ovrSession session, ovrTextureSwapChain chain) {
+    delete chain;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_CreateMirrorTextureDX(ovrSession session,
+                          IUnknown* d3dPtr,
+                          const ovrMirrorTextureDesc* desc,
+                          ovrMirrorTexture* outMirrorTexture) {
+    return ovrError_Unsupported;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_GetMirrorTextureBufferDX(ovrSession session, ovrMirrorTexture mirrorTexture, IID iid, void** out_Buffer) {
+    return ovrError_Unsupported;
+}
+
+OVR_PUBLIC_FUNCTION(void) ovr_DestroyMirrorTexture(ovrSession session, ovrMirrorTexture mirrorTexture) {
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_WaitToBeginFrame(ovrSession session, long long frameIndex) {
+    State& state = GetState();
+    double wakeUpTime = 0;
+    {
+        std::unique_lock lock(state.mutex);
+
+        // Start the frame at the next vsync, or right away after missing it.
+        const long long currentVsync = VsyncIndex(state, Now());
+        if (state.configuration.paceFrames) {
+            state.lastWaitVsync = std::max(state.lastWaitVsync + 1, currentVsync);
+            wakeUpTime = VsyncTime(state, state.lastWaitVsync);
+        } else {
+            state.lastWaitVsync = currentVsync;
+        }
+        state.lastWaitFrameIndex = frameIndex;
+    }
+
+    SleepUntil(wakeUpTime);
+
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_BeginFrame(ovrSession session, long long frameIndex) {
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult)
+ovr_EndFrame(ovrSession session,
+             long long frameIndex,
+             const ovrViewScaleDesc* viewScaleDesc,
+             ovrLayerHeader const* const* layerPtrList,
+             unsigned int layerCount) {
+    State& state = GetState();
+    double jitter = 0;
+    {
+        std::unique_lock lock(state.mutex);
+        if (state.configuration.submissionJitter > 0) {
+            std::uniform_real_distribution<double> jitters(0, state.configuration.submissionJitter);
+            jitter = jitters(state.jitterRandom);
+        }
+    }
+    SleepUntil(Now() + jitter);
+
+    std::unique_lock lock(state.mutex);
+
+    const double now = Now();
+
+    SubmittedFrame& frame = state.submittedFrames[state.numSubmittedFrames++ % k_submittedFramesHistory];
+    frame = {};
+    frame.frameIndex = frameIndex;
+    frame.submitTime = now;
+    frame.layerCount = std::min(layerCount, (unsigned int)ovrMaxLayerCount);
+    for (uint32_t i = 0; i < frame.layerCount; i++) {
+        if (layerPtrList[i]) {
+            memcpy(&frame.layers[i], layerPtrList[i], GetLayerSize(layerPtrList[i]));
+        }
+        frame.swapchain[i] = layerPtrList[i] ? GetLayerSwapchain(layerPtrList[i]) : nullptr;
+        frame.imageIndex[i] = frame.swapchain[i] ? frame.swapchain[i]->lastCommittedIndex : -1;
+    }
+
+    // The frame is presented at the first vsync after submission, and not twice on the same vsync.
+    state.lastPresentedVsync = std::max(state.lastPresentedVsync + 1, VsyncIndex(state, now) + 1);
+    frame.presentTime = VsyncTime(state, state.lastPresentedVsync);
+
+    if (state.numPerfStats == ovrMaxProvidedFrameStats) {
+        state.anyPerfStatsDropped = true;
+    }
+    state.numPerfStats = std::min(state.numPerfStats + 1, (int)ovrMaxProvidedFrameStats);
+    std::move_backward(std::begin(state.perfStats), std::end(state.perfStats) - 1, std::end(state.perfStats));
+    ovrPerfStatsPerCompositorFrame& stats = state.perfStats[0];
+    stats = {};
+    stats.HmdVsyncIndex = (int)state.lastPresentedVsync;
+    stats.AppFrameIndex = (int)frameIndex;
+    stats.CompositorFrameIndex = (int)state.lastPresentedVsync;
+    stats.AppMotionToPhotonLatency = (float)(VsyncTime(state, state.lastPresentedVsync) - now);
+
+    return ovrSuccess;
+}
+
+OVR_PUBLIC_FUNCTION(double) ovr_GetPredictedDisplayTime(ovrSession session, long long frameIndex) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    // Frames queued ahead of the last one that waited are displayed one period later each.
+    return VsyncTime(state, state.lastWaitVsync + 1 + std::max(frameIndex - state.lastWaitFrameIndex, 0ll));
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetPerfStats(ovrSession session, ovrPerfStats* outStats) {
+    State& state = GetState();
+    std::unique_lock lock(state.mutex);
+
+    *outStats = {};
+    std::copy_n(state.perfStats, state.numPerfStats, outStats->FrameStats);
+    outStats->FrameStatsCount = state.numPerfStats;
+    outStats->AnyFrameStatsDropped = state.anyPerfStatsDropped;
+    outStats->AdaptiveGpuPerformanceScale = 1.f;
+    state.numPerfStats = 0;
+    state.anyPerfStatsDropped = false;
+    return ovrSuccess;
+}
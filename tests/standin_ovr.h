@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::test::standin {
+
+    // The tests link this stand-in for LibOVR instead of OVR_CAPIShim.c, so that they can run sessions without a headset
+    // or the Virtual Desktop Streamer. It simulates a compositor with a fixed refresh rate on the first graphics adapter
+    // of the system, and records what the runtime submits to it.
+
+    struct Configuration {
+        // The refresh rates of the headsets that Virtual Desktop streams to.
+        static constexpr float k_refreshRates[] = {72.f, 90.f, 120.f};
+
+        float refreshRate{90.f};
+
+        // Whether ovr_WaitToBeginFrame() blocks until the next simulated vsync. Benchmarks of the runtime's own overhead
+        // turn it off.
+        bool paceFrames{true};
+
+        int swapchainLength{3};
+
+        // The longest that ovr_EndFrame() takes, like a busy compositor or streamer would: each call takes a random
+        // duration up to this one (in seconds). A frame is latched at the first vsync after ovr_EndFrame() returns.
+        double submissionJitter{0};
+        uint32_t jitterSeed{1};
+    };
+
+    // Takes effect for the next OVR session, ie: the next TestInstance that calls xrGetSystem().
+    void Configure(const Configuration& configuration);
+
+    // The controller state and the device poses reported to the runtime.
+    void SetInputState(const ovrInputState& state);
+    void SetDevicePose(ovrTrackedDeviceType device, const ovrPosef& pose);
+
+    // A frame submitted with ovr_EndFrame(), and the time of the vsync at which it is presented. For each layer, a copy
+    // of the layer, the swapchain of its (left) color texture, and the index of the image that the compositor presents:
+    // the image that was committed last.
+    struct SubmittedFrame {
+        long long frameIndex{0};
+        double submitTime{0};
+        double presentTime{0};
+        uint32_t layerCount{0};
+        ovrLayer_Union layers[ovrMaxLayerCount]{};
+        ovrTextureSwapChain swapchain[ovrMaxLayerCount]{};
+        int imageIndex[ovrMaxLayerCount]{};
+    };
+
+    // The most recent submitted frames of the current session, oldest first. Only a bounded history is kept.
+    std::vector<SubmittedFrame> GetSubmittedFrames();
+
+    // The number of ovr_EndFrame() calls in the current session.
+    uint64_t GetSubmittedFrameCount();
+
+} // namespace virtualdesktop_openxr::test::standin
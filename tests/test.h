@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::test {
+
+    // A minimal test runner. Test cases and benchmarks register themselves during static initialization and are run by
+    // main(). Benchmarks only run when requested on the command line, since their timings are meaningless in a Debug
+    // build.
+    struct TestCase {
+        const char* name;
+        void (*function)();
+        bool isBenchmark;
+    };
+
+    std::vector<TestCase>& GetTestCases();
+
+    struct TestCaseRegistration {
+        TestCaseRegistration(const char* name, void (*function)(), bool isBenchmark) {
+            GetTestCases().push_back({name, function, isBenchmark});
+        }
+    };
+
+    // Thrown by REQUIRE() to abandon the current test case after a failure.
+    struct TestCaseAborted {};
+
+    // Thrown by SKIP() when the machine cannot run the current test case (eg: no suitable graphics adapter).
+    struct TestCaseSkipped {
+        std::string reason;
+    };
+
+    // Thread-safe, so that checks may be done from worker threads.
+    void ReportFailure(const char* file, int line, const char* expression);
+
+    // Checks of wall-clock timings (throughput, deadlines, pacing) depend on the machine having cores to spare for the
+    // tests. On shared machines, such as CI runners, --no-timing-checks reports their failures without failing the
+    // test case.
+    void ReportTimingFailure(const char* file, int line, const char* expression);
+
+    // Keep the compiler from optimizing away a result that a benchmark does not otherwise use.
+    template <typename T>
+    inline void DoNotOptimize(const T& value) {
+        static const void* volatile sink;
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    // Print the result of a benchmark in the format of Measure().
+    inline void ReportMeasurement(const char* label, double nanosecondsPerOperation) {
+        printf("    %-56s %12.1f ns/op\n", label, nanosecondsPerOperation);
+    }
+
+    // Run the body of a benchmark repeatedly for at least minDuration, and print the average time of one operation.
+    // The body performs operationsPerCall operations each time it is invoked.
+    template <typename Body>
+    double Measure(const char* label,
+                   const Body& body,
+                   uint64_t operationsPerCall = 1,
+                   std::chrono::duration<double> minDuration = 250ms) {
+        // Warm up the caches and the branch predictors.
+        body();
+
+        // Read the clock at growing intervals, so that reading it does not dominate the timing of short operations.
+        uint64_t numCalls = 0;
+        uint64_t batchSize = 1;
+        const auto start = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::nano> elapsed{};
+        do {
+            for (uint64_t i = 0; i < batchSize; i++) {
+                body();
+            }
+            numCalls += batchSize;
+            batchSize = std::min(batchSize * 2, (uint64_t)1024);
+            elapsed = std::chrono::high_resolution_clock::now() - start;
+        } while (elapsed < minDuration);
+
+        const double nanosecondsPerOperation = elapsed.count() / (numCalls * operationsPerCall);
+        ReportMeasurement(label, nanosecondsPerOperation);
+        return nanosecondsPerOperation;
+    }
+
+} // namespace virtualdesktop_openxr::test
+
+#define TEST_CONCAT_IMPL(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_IMPL(a, b)
+
+#define TEST_REGISTER_IMPL(name, isBenchmark, function)                                                               \
+    static void function();                                                                                            \
+    static const virtualdesktop_openxr::test::TestCaseRegistration TEST_CONCAT(function, _Registration)(               \
+        name, function, isBenchmark);                                                                                  \
+    static void function()
+
+// Define a test case, which runs every time.
+#define TEST_CASE(name) TEST_REGISTER_IMPL(name, false, TEST_CONCAT(TestCase_, __LINE__))
+
+// Define a benchmark, which only runs with --benchmark.
+#define BENCHMARK(name) TEST_REGISTER_IMPL(name, true, TEST_CONCAT(Benchmark_, __LINE__))
+
+// Record a failure and continue. This replaces the CHECK() of XrError.h, which throws.
+#undef CHECK
+#define CHECK(expression)                                                                                              \
+    do {                                                                                                               \
+        if (!(expression)) {                                                                                           \
+            virtualdesktop_openxr::test::ReportFailure(__FILE__, __LINE__, #expression);                               \
+        }                                                                                                              \
+    } while (false)
+
+// Record a failure of a wall-clock timing check, unless these checks are not enforced.
+#define CHECK_TIMING(expression)                                                                                       \
+    do {                                                                                                               \
+        if (!(expression)) {                                                                                           \
+            virtualdesktop_openxr::test::ReportTimingFailure(__FILE__, __LINE__, #expression);                         \
+        }                                                                                                              \
+    } while (false)
+
+// Record a failure and abandon the test case.
+#define REQUIRE(expression)                                                                                            \
+    do {                                                                                                               \
+        if (!(expression)) {                                                                                           \
+            virtualdesktop_openxr::test::ReportFailure(__FILE__, __LINE__, #expression);                               \
+            throw virtualdesktop_openxr::test::TestCaseAborted{};                                                      \
+        }                                                                                                              \
+    } while (false)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK(std::abs((a) - (b)) <= (tolerance))
+
+#define SKIP(reason) throw virtualdesktop_openxr::test::TestCaseSkipped{reason}
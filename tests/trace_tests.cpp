@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <log.h>
+
+#include "runtime_harness.h"
+#include "test.h"
+
+namespace {
+
+    using namespace virtualdesktop_openxr::test;
+    using namespace virtualdesktop_openxr::log;
+
+    int g_numEvaluations = 0;
+
+    int CountEvaluation() {
+        return ++g_numEvaluations;
+    }
+
+    // Register the provider like the DLL does when it is loaded. Nothing listens to it during the tests, which is the
+    // situation of nearly every user.
+    struct TraceProviderRegistration {
+        TraceProviderRegistration() {
+            TraceLoggingRegister(g_traceProvider);
+        }
+        ~TraceProviderRegistration() {
+            TraceLoggingUnregister(g_traceProvider);
+        }
+    };
+
+} // namespace
+
+TEST_CASE("trace: formatting on the stack") {
+    CHECK(std::string_view(ToTraceString(XrPosef{{0.f, 0.f, 0.f, 1.f}, {1.f, -2.f, 0.5f}}).c_str()) ==
+          "p: (1.000, -2.000, 0.500), o:(0.000, 0.000, 0.000, 1.000)");
+    CHECK(std::string_view(ToTraceString(ovrPosef{{0.f, 0.f, 0.f, 1.f}, {1.f, -2.f, 0.5f}}).c_str()) ==
+          "p: (1.000, -2.000, 0.500), o:(0.000, 0.000, 0.000, 1.000)");
+    CHECK(std::string_view(ToTraceString(XrVector3f{0.25f, 0.f, -1.f}).c_str()) == "(0.250, 0.000, -1.000)");
+    CHECK(std::string_view(ToTraceString(XrVector2f{0.25f, -1.f}).c_str()) == "(0.250, -1.000)");
+    CHECK(std::string_view(ToTraceString(XrFovf{-0.5f, 0.5f, 0.75f, -0.75f}).c_str()) ==
+          "(l:-0.500, r:0.500, u:0.750, d:-0.750)");
+    CHECK(std::string_view(ToTraceString(XrRect2Di{{0, 16}, {256, 128}}).c_str()) == "x:0, y:16 w:256 h:128");
+
+    // Values that do not fit are truncated, not overflowed.
+    const float huge = std::numeric_limits<float>::max();
+    const auto str = ToTraceString(XrPosef{{huge, huge, huge, huge}, {huge, huge, huge}});
+    CHECK(strlen(str.c_str()) < sizeof(str.buffer));
+}
+
+TEST_CASE("trace: arguments are not evaluated while nobody listens") {
+    TraceProviderRegistration registration;
+    REQUIRE(!IsTraceEnabled());
+
+    g_numEvaluations = 0;
+    for (int i = 0; i < 10; i++) {
+        TraceLoggingWriteIfEnabled(g_traceProvider, "Test", TLArg(CountEvaluation(), "Count"));
+    }
+    CHECK(g_numEvaluations == 0);
+}
+
+BENCHMARK("trace: per-call overhead with tracing off") {
+    TraceProviderRegistration registration;
+    if (IsTraceEnabled()) {
+        SKIP("A trace session is listening");
+    }
+
+    const XrPosef pose{{0.1f, 0.2f, 0.3f, 0.9f}, {1.f, -2.f, 0.5f}};
+    Measure("xr::ToString(pose) (before)", [&] { DoNotOptimize(xr::ToString(pose)); });
+    Measure("ToTraceString(pose)", [&] { DoNotOptimize(ToTraceString(pose)); });
+    Measure("TraceLoggingWriteIfEnabled with a pose", [&] {
+        TraceLoggingWriteIfEnabled(g_traceProvider, "Benchmark", TLArg(ToTraceString(pose).c_str(), "Pose"));
+    });
+
+    TestInstance instance({XR_KHR_D3D11_ENABLE_EXTENSION_NAME});
+    TestSession session(instance);
+
+    XrSpace viewSpace = XR_NULL_HANDLE;
+    XrReferenceSpaceCreateInfo createInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+    createInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+    createInfo.poseInReferenceSpace = xr::math::Pose::Identity();
+    CHECK_XRCMD(instance.get<PFN_xrCreateReferenceSpace>("xrCreateReferenceSpace")(
+        session.handle(), &createInfo, &viewSpace));
+
+    const XrFrameState frameState = session.waitFrame();
+    const auto xrLocateSpace = instance.get<PFN_xrLocateSpace>("xrLocateSpace");
+    const auto xrLocateViews = instance.get<PFN_xrLocateViews>("xrLocateViews");
+
+    const auto locateSpace = [&] {
+        XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+        DoNotOptimize(xrLocateSpace(viewSpace, session.localSpace(), frameState.predictedDisplayTime, &location));
+        return location;
+    };
+    const auto locateViews = [&](XrView* views) {
+        XrViewLocateInfo locateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+        locateInfo.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+        locateInfo.displayTime = frameState.predictedDisplayTime;
+        locateInfo.space = session.localSpace();
+        XrViewState viewState{XR_TYPE_VIEW_STATE};
+        uint32_t viewCount = 0;
+        DoNotOptimize(
+            xrLocateViews(session.handle(), &locateInfo, &viewState, xr::StereoView::Count, &viewCount, views));
+    };
+
+    // The runtime can no longer be built with the previous trace arguments, so the "before" figures add back the
+    // xr::ToString() calls that these functions made on every call: the HMD pose state (pose and two velocities) when
+    // locating the view space, then the located pose, or the pose and FOV of each view.
+    const ovrPoseStatef hmdState{};
+    const auto formatHmdPoseState = [&] {
+        DoNotOptimize(xr::ToString(hmdState.ThePose));
+        DoNotOptimize(xr::ToString(hmdState.AngularVelocity));
+        DoNotOptimize(xr::ToString(hmdState.LinearVelocity));
+    };
+    Measure("xrLocateSpace (before)", [&] {
+        const XrSpaceLocation location = locateSpace();
+        formatHmdPoseState();
+        DoNotOptimize(xr::ToString(location.pose));
+    });
+    Measure("xrLocateSpace", [&] { locateSpace(); });
+    Measure("xrLocateViews (before)", [&] {
+        XrView views[xr::StereoView::Count]{{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+        locateViews(views);
+        formatHmdPoseState();
+        for (const auto& view : views) {
+            DoNotOptimize(xr::ToString(view.pose));
+            DoNotOptimize(xr::ToString(view.fov));
+        }
+    });
+    Measure("xrLocateViews", [&] {
+        XrView views[xr::StereoView::Count]{{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+        locateViews(views);
+    });
+
+    session.beginFrame();
+    session.renderFrame(frameState.predictedDisplayTime);
+    session.endFrame(frameState.predictedDisplayTime);
+    instance.get<PFN_xrDestroySpace>("xrDestroySpace")(viewSpace);
+}
@@ -0,0 +1 @@
+#include "/root/repo/virtualdesktop-openxr/frame_period.h"
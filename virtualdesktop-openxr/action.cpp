@@ -80,6 +80,18 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
+        // Most paths are already known, and can be looked up without blocking other readers.
+        {
+            std::shared_lock lock(m_actionsAndSpacesMutex);
+
+            const auto it = m_pathIndex.find(pathString);
+            if (it != m_pathIndex.cend()) {
+                *path = it->second;
+                TraceLoggingWrite(g_traceProvider, "xrStringToPath", TLArg(*path, "Path"));
+                return XR_SUCCESS;
+            }
+        }
+
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
         *path = stringToPath(pathString, true /* validate */);
@@ -105,14 +117,13 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
-        const auto it = m_strings.find(path);
-        if (it == m_strings.cend()) {
+        if (!isKnownPath(path)) {
             return XR_ERROR_PATH_INVALID;
         }
 
-        const auto& str = it->second;
+        const auto& str = getXrPath(path);
         if (bufferCapacityInput && bufferCapacityInput < str.length()) {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
@@ -163,29 +174,26 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
-        for (const auto& entry : m_actionSets) {
-            const ActionSet& xrActionSet = *(ActionSet*)entry;
-
+        XrResult result = XR_SUCCESS;
+        m_actionSets.forEach([&](XrActionSet, const ActionSet& xrActionSet) {
             if (xrActionSet.name == name) {
-                return XR_ERROR_NAME_DUPLICATED;
-            }
-            if (xrActionSet.localizedName == localizedName) {
-                return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
+                result = XR_ERROR_NAME_DUPLICATED;
+            } else if (xrActionSet.localizedName == localizedName) {
+                result = XR_ERROR_LOCALIZED_NAME_DUPLICATED;
             }
+        });
+        if (XR_FAILED(result)) {
+            return result;
         }
 
         // CONFORMANCE: We do not support the notion of priority. TODO: Sort actionSources by priority.
 
-        // Create the internal struct.
-        ActionSet& xrActionSet = *new ActionSet;
+        // Create the internal struct. The handle table maintains the list of known actionsets for validation.
+        *actionSet = m_actionSets.emplace();
+        ActionSet& xrActionSet = *m_actionSets.get(*actionSet);
         xrActionSet.name = name;
         xrActionSet.localizedName = localizedName;
 
-        *actionSet = (XrActionSet)&xrActionSet;
-
-        // Maintain a list of known actionsets for validation.
-        m_actionSets.insert(*actionSet);
-
         TraceLoggingWrite(g_traceProvider, "xrCreateActionSet", TLXArg(*actionSet, "ActionSet"));
 
         return XR_SUCCESS;
@@ -197,15 +205,22 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_actionSets.count(actionSet)) {
+        if (!m_actionSets.contains(actionSet)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        ActionSet* xrActionSet = (ActionSet*)actionSet;
+        // Destroying an actionset implicitly destroys its actions.
+        m_actions.forEach([&](XrAction, Action& xrAction) {
+            if (xrAction.actionSet == actionSet) {
+                xrAction.destroyed = true;
+            }
+        });
 
-        delete xrActionSet;
         m_actionSets.erase(actionSet);
         m_activeActionSets.erase(actionSet);
+        invalidateResolvedBindings();
+        m_actionEvaluationTableDirty = true;
+        publishActionStates({});
 
         return XR_SUCCESS;
     }
@@ -240,7 +255,7 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_actionSets.count(actionSet)) {
+        if (!m_actionSets.contains(actionSet)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -262,19 +277,20 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_LOCALIZED_NAME_INVALID;
         }
 
-        for (const auto& entry : m_actions) {
-            const Action& xrAction = *(Action*)entry;
-
-            if (xrAction.actionSet != actionSet) {
-                continue;
+        XrResult result = XR_SUCCESS;
+        m_actions.forEach([&](XrAction, const Action& xrAction) {
+            if (xrAction.destroyed || xrAction.actionSet != actionSet) {
+                return;
             }
 
             if (xrAction.name == name) {
-                return XR_ERROR_NAME_DUPLICATED;
-            }
-            if (xrAction.localizedName == localizedName) {
-                return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
+                result = XR_ERROR_NAME_DUPLICATED;
+            } else if (xrAction.localizedName == localizedName) {
+                result = XR_ERROR_LOCALIZED_NAME_DUPLICATED;
             }
+        });
+        if (XR_FAILED(result)) {
+            return result;
         }
 
         for (uint32_t i = 0; i < createInfo->countSubactionPaths; i++) {
@@ -285,8 +301,9 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        // Create the internal struct.
-        Action& xrAction = *new Action;
+        // Create the internal struct. The handle table maintains the list of known actions for validation.
+        *action = m_actions.emplace();
+        Action& xrAction = *m_actions.get(*action);
         xrAction.type = createInfo->actionType;
         xrAction.name = name;
         xrAction.localizedName = localizedName;
@@ -295,12 +312,6 @@ namespace virtualdesktop_openxr {
             xrAction.subactionPaths.insert(createInfo->subactionPaths[i]);
         }
 
-        *action = (XrAction)&xrAction;
-
-        // Maintain a list of known actions for validation.
-        m_actions.insert(*action);
-        m_actionsForCleanup.insert(*action);
-
         TraceLoggingWrite(g_traceProvider, "xrCreateAction", TLXArg(*action, "Action"));
 
         return XR_SUCCESS;
@@ -312,13 +323,17 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_actions.count(action)) {
+        Action* const xrAction = getAction(action);
+        if (!xrAction) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        // We do not delete the action as it might still be used internally (eg: referenced by action spaces).
-
-        m_actions.erase(action);
+        // We do not delete the action as it might still be used internally (eg: referenced by action spaces). It will
+        // be deleted with the instance.
+        xrAction->destroyed = true;
+        invalidateResolvedBindings();
+        m_actionEvaluationTableDirty = true;
+        publishActionStates({});
 
         return XR_SUCCESS;
     }
@@ -359,15 +374,15 @@ namespace virtualdesktop_openxr {
         const std::string& interactionProfile = getXrPath(suggestedBindings->interactionProfile);
         if (interactionProfile != "/interaction_profiles/ext/eye_gaze_interaction") {
             // Set up to use the controller mappings when a controller is rebinding.
-            const auto checkValidPathIt = m_controllerValidPathsTable.find(interactionProfile);
-            if (checkValidPathIt == m_controllerValidPathsTable.cend()) {
+            const InteractionProfile* const profile = getInteractionProfile(interactionProfile);
+            if (!profile) {
                 return XR_ERROR_PATH_UNSUPPORTED;
             }
 
             std::vector<XrActionSuggestedBinding> bindings;
             for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++) {
                 const std::string& path = getXrPath(suggestedBindings->suggestedBindings[i].binding);
-                if (getActionSide(path, true) < 0 || !checkValidPathIt->second(path)) {
+                if (getActionSide(path, true) < 0 || !isValidInteractionProfilePath(*profile, path)) {
                     return XR_ERROR_PATH_UNSUPPORTED;
                 }
 
@@ -375,6 +390,7 @@ namespace virtualdesktop_openxr {
             }
 
             m_suggestedBindings.insert_or_assign(getXrPath(suggestedBindings->interactionProfile), bindings);
+            invalidateResolvedBindings();
         } else {
             // Only allow this if the extension is enabled.
             if (!has_XR_EXT_eye_gaze_interaction) {
@@ -388,12 +404,18 @@ namespace virtualdesktop_openxr {
                     return XR_ERROR_PATH_UNSUPPORTED;
                 }
 
-                Action& xrAction = *(Action*)suggestedBindings->suggestedBindings[i].action;
+                Action* const xrAction = getAction(suggestedBindings->suggestedBindings[i].action);
+                if (!xrAction) {
+                    return XR_ERROR_HANDLE_INVALID;
+                }
 
                 ActionSource source{};
                 source.realPath = path;
-                xrAction.actionSources.insert_or_assign(path, source);
+                xrAction->actionSources.insert_or_assign(path, source);
+                updateActionBindings(*xrAction);
             }
+            m_spaces.forEach([&](XrSpace, Space& xrSpace) { updateSpaceTarget(xrSpace); });
+            m_actionEvaluationTableDirty = true;
         }
 
         return XR_SUCCESS;
@@ -427,7 +449,7 @@ namespace virtualdesktop_openxr {
         }
 
         for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
-            if (!m_actionSets.count(attachInfo->actionSets[i])) {
+            if (!m_actionSets.contains(attachInfo->actionSets[i])) {
                 return XR_ERROR_HANDLE_INVALID;
             }
         }
@@ -435,16 +457,20 @@ namespace virtualdesktop_openxr {
         for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
             m_activeActionSets.insert(attachInfo->actionSets[i]);
 
-            ActionSet& xrActionSet = *(ActionSet*)attachInfo->actionSets[i];
+            ActionSet& xrActionSet = *m_actionSets.get(attachInfo->actionSets[i]);
 
             // Identify all valid subaction paths for the actionset.
-            for (const auto& entry : m_actions) {
-                const Action& xrAction = *(Action*)entry;
-
-                xrActionSet.subactionPaths.insert(xrAction.subactionPaths.begin(), xrAction.subactionPaths.end());
-            }
+            m_actions.forEach([&](XrAction, const Action& xrAction) {
+                if (!xrAction.destroyed) {
+                    xrActionSet.subactionPaths.insert(xrAction.subactionPaths.begin(), xrAction.subactionPaths.end());
+                }
+            });
         }
 
+        // Publish the initial (inactive) state of the actions.
+        m_actionEvaluationTableDirty = true;
+        publishActionStates(m_activeActionSets);
+
         return XR_SUCCESS;
     }
 
@@ -501,87 +527,41 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        TraceLoggingWrite(g_traceProvider,
-                          "xrGetActionStateBoolean",
-                          TLXArg(session, "Session"),
-                          TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
-
-        if (!m_sessionCreated || session != (XrSession)1) {
-            return XR_ERROR_HANDLE_INVALID;
-        }
-
-        std::unique_lock lock(m_actionsAndSpacesMutex);
-
-        if (!m_actions.count(getInfo->action)) {
-            return XR_ERROR_HANDLE_INVALID;
-        }
-
-        Action& xrAction = *(Action*)getInfo->action;
-
-        if (xrAction.type != XR_ACTION_TYPE_BOOLEAN_INPUT) {
-            return XR_ERROR_ACTION_TYPE_MISMATCH;
-        }
-
-        if (!m_activeActionSets.count(xrAction.actionSet)) {
-            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
-        }
-
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
-                return XR_ERROR_PATH_INVALID;
-            }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
-                return XR_ERROR_PATH_UNSUPPORTED;
-            }
-        }
-
-        std::optional<bool> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.buttonMap != nullptr || value.floatValue != nullptr;
+        if (TraceLoggingProviderEnabled(g_traceProvider, 0, 0)) {
+            // The query itself does not take the lock, only the tracing does.
+            std::shared_lock lock(m_actionsAndSpacesMutex);
             TraceLoggingWrite(g_traceProvider,
                               "xrGetActionStateBoolean",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side]) {
-                    // Per spec, the combined state is the OR of all values.
-                    if (value.buttonMap) {
-                        combinedState = combinedState.value_or(false) || *value.buttonMap & value.buttonType;
-                    } else if (value.floatValue) {
-                        combinedState = combinedState.value_or(false) || value.floatValue[side] > 0.95f;
-                    }
+                              TLXArg(session, "Session"),
+                              TLXArg(getInfo->action, "Action"),
+                              TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+            if (const auto bindings = getActionBindings(getInfo->action, getInfo->subactionPath)) {
+                for (const auto& binding : *bindings) {
+                    TraceLoggingWrite(g_traceProvider,
+                                      "xrGetActionStateBoolean",
+                                      TLArg(binding.fullPath, "ActionSourcePath"),
+                                      TLArg(!!(binding.buttonMap || binding.floatValue), "Bound"));
                 }
             }
         }
 
-        state->isActive = combinedState ? XR_TRUE : XR_FALSE;
-        if (combinedState) {
-            state->currentState = combinedState.value();
-            state->changedSinceLastSync = !!state->currentState != xrAction.lastBoolValue[subActionSide];
+        if (!m_sessionCreated || session != (XrSession)1) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
 
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-            state->lastChangeTime = state->changedSinceLastSync
-                                        ? ovrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
-                                        : xrAction.lastBoolValueChangedTime[subActionSide];
-        } else {
-            state->currentState = state->changedSinceLastSync = XR_FALSE;
-            state->lastChangeTime = 0;
+        ActionState actionState{};
+        if (!getActionState(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_BOOLEAN_INPUT, actionState)) {
+            const XrResult result =
+                checkActionStateQuery(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_BOOLEAN_INPUT);
+            if (XR_FAILED(result)) {
+                return result;
+            }
         }
 
-        xrAction.lastBoolValue[subActionSide] = state->currentState;
-        xrAction.lastBoolValueChangedTime[subActionSide] = state->lastChangeTime;
+        state->isActive = actionState.isActive ? XR_TRUE : XR_FALSE;
+        state->currentState = actionState.boolValue ? XR_TRUE : XR_FALSE;
+        state->changedSinceLastSync = actionState.changedSinceLastSync ? XR_TRUE : XR_FALSE;
+        state->lastChangeTime = actionState.lastChangeTime;
 
         TraceLoggingWrite(g_traceProvider,
                           "xrGetActionStateBoolean",
@@ -601,96 +581,44 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        TraceLoggingWrite(g_traceProvider,
-                          "xrGetActionStateFloat",
-                          TLXArg(session, "Session"),
-                          TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
-
-        if (!m_sessionCreated || session != (XrSession)1) {
-            return XR_ERROR_HANDLE_INVALID;
-        }
-
-        std::unique_lock lock(m_actionsAndSpacesMutex);
-
-        if (!m_actions.count(getInfo->action)) {
-            return XR_ERROR_HANDLE_INVALID;
-        }
-
-        Action& xrAction = *(Action*)getInfo->action;
-
-        if (xrAction.type != XR_ACTION_TYPE_FLOAT_INPUT) {
-            return XR_ERROR_ACTION_TYPE_MISMATCH;
-        }
-
-        if (!m_activeActionSets.count(xrAction.actionSet)) {
-            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
-        }
-
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
-                return XR_ERROR_PATH_INVALID;
-            }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
-                return XR_ERROR_PATH_UNSUPPORTED;
-            }
-        }
-
-        std::optional<float> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.floatValue != nullptr ||
-                                 (value.vector2fValue != nullptr && value.vector2fIndex >= 0) ||
-                                 value.buttonMap != nullptr;
+        if (TraceLoggingProviderEnabled(g_traceProvider, 0, 0)) {
+            // The query itself does not take the lock, only the tracing does.
+            std::shared_lock lock(m_actionsAndSpacesMutex);
             TraceLoggingWrite(g_traceProvider,
                               "xrGetActionStateFloat",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side]) {
-                    // Per spec, the combined state is the absolute maximum of all values.
-                    if (value.floatValue) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 value.floatValue[side]);
-                    } else if (value.buttonMap) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 *value.buttonMap & value.buttonType ? 1.f : 0.f);
-                    } else if (value.vector2fValue) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 value.vector2fIndex == 0 ? value.vector2fValue[side].x
-                                                                          : value.vector2fValue[side].y);
-                    }
+                              TLXArg(session, "Session"),
+                              TLXArg(getInfo->action, "Action"),
+                              TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+            if (const auto bindings = getActionBindings(getInfo->action, getInfo->subactionPath)) {
+                for (const auto& binding : *bindings) {
+                    TraceLoggingWrite(g_traceProvider,
+                                      "xrGetActionStateFloat",
+                                      TLArg(binding.fullPath, "ActionSourcePath"),
+                                      TLArg(!!(binding.floatValue ||
+                                               (binding.vector2fValue && binding.vector2fIndex >= 0) ||
+                                               binding.buttonMap),
+                                            "Bound"));
                 }
             }
         }
 
-        state->isActive = combinedState ? XR_TRUE : XR_FALSE;
-        if (combinedState) {
-            state->currentState = combinedState.value();
-            state->changedSinceLastSync = state->currentState != xrAction.lastFloatValue[subActionSide];
+        if (!m_sessionCreated || session != (XrSession)1) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
 
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-            state->lastChangeTime = state->changedSinceLastSync
-                                        ? ovrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
-                                        : xrAction.lastFloatValueChangedTime[subActionSide];
-        } else {
-            state->currentState = 0.0f;
-            state->changedSinceLastSync = XR_FALSE;
-            state->lastChangeTime = 0;
+        ActionState actionState{};
+        if (!getActionState(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_FLOAT_INPUT, actionState)) {
+            const XrResult result =
+                checkActionStateQuery(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_FLOAT_INPUT);
+            if (XR_FAILED(result)) {
+                return result;
+            }
         }
 
-        xrAction.lastFloatValue[subActionSide] = state->currentState;
-        xrAction.lastFloatValueChangedTime[subActionSide] = state->lastChangeTime;
+        state->isActive = actionState.isActive ? XR_TRUE : XR_FALSE;
+        state->currentState = actionState.floatValue;
+        state->changedSinceLastSync = actionState.changedSinceLastSync ? XR_TRUE : XR_FALSE;
+        state->lastChangeTime = actionState.lastChangeTime;
 
         TraceLoggingWrite(g_traceProvider,
                           "xrGetActionStateFloat",
@@ -710,101 +638,48 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        TraceLoggingWrite(g_traceProvider,
-                          "xrGetActionStateVector2f",
-                          TLXArg(session, "Session"),
-                          TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
-
-        if (!m_sessionCreated || session != (XrSession)1) {
-            return XR_ERROR_HANDLE_INVALID;
-        }
-
-        std::unique_lock lock(m_actionsAndSpacesMutex);
-
-        if (!m_actions.count(getInfo->action)) {
-            return XR_ERROR_HANDLE_INVALID;
-        }
-
-        Action& xrAction = *(Action*)getInfo->action;
-
-        if (xrAction.type != XR_ACTION_TYPE_VECTOR2F_INPUT) {
-            return XR_ERROR_ACTION_TYPE_MISMATCH;
-        }
-
-        if (!m_activeActionSets.count(xrAction.actionSet)) {
-            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
-        }
-
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
-                return XR_ERROR_PATH_INVALID;
-            }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
-                return XR_ERROR_PATH_UNSUPPORTED;
-            }
-        }
-
-        std::optional<XrVector2f> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.vector2fValue != nullptr;
+        if (TraceLoggingProviderEnabled(g_traceProvider, 0, 0)) {
+            // The query itself does not take the lock, only the tracing does.
+            std::shared_lock lock(m_actionsAndSpacesMutex);
             TraceLoggingWrite(g_traceProvider,
                               "xrGetActionStateVector2f",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side] && value.vector2fValue) {
-                    // Per spec, the combined state if the one of the vector with the longest length.
-                    const float l1 = combinedState ? sqrt(combinedState.value().x * combinedState.value().x +
-                                                          combinedState.value().y * combinedState.value().y)
-                                                   : 0.f;
-                    const XrVector2f vector2fValue = {value.vector2fValue[side].x, value.vector2fValue[side].y};
-                    const float l2 = sqrt(vector2fValue.x * vector2fValue.x + vector2fValue.y * vector2fValue.y);
-                    if (l2 >= l1) {
-                        combinedState = vector2fValue;
-                    }
+                              TLXArg(session, "Session"),
+                              TLXArg(getInfo->action, "Action"),
+                              TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+            if (const auto bindings = getActionBindings(getInfo->action, getInfo->subactionPath)) {
+                for (const auto& binding : *bindings) {
+                    TraceLoggingWrite(g_traceProvider,
+                                      "xrGetActionStateVector2f",
+                                      TLArg(binding.fullPath, "ActionSourcePath"),
+                                      TLArg(!!(binding.vector2fValue), "Bound"));
                 }
             }
         }
 
-        state->isActive = combinedState ? XR_TRUE : XR_FALSE;
-        if (combinedState) {
-            state->currentState = combinedState.value();
-
-            state->changedSinceLastSync = state->currentState.x != xrAction.lastVector2fValue[subActionSide].x ||
-                                          state->currentState.y != xrAction.lastVector2fValue[subActionSide].y;
+        if (!m_sessionCreated || session != (XrSession)1) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
 
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-            state->lastChangeTime = state->changedSinceLastSync
-                                        ? ovrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
-                                        : xrAction.lastVector2fValueChangedTime[subActionSide];
-        } else {
-            state->currentState = {0.0f, 0.0f};
-            state->changedSinceLastSync = XR_FALSE;
-            state->lastChangeTime = 0;
+        ActionState actionState{};
+        if (!getActionState(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_VECTOR2F_INPUT, actionState)) {
+            const XrResult result =
+                checkActionStateQuery(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_VECTOR2F_INPUT);
+            if (XR_FAILED(result)) {
+                return result;
+            }
         }
 
-        xrAction.lastVector2fValue[subActionSide] = state->currentState;
-        xrAction.lastVector2fValueChangedTime[subActionSide] = state->lastChangeTime;
+        state->isActive = actionState.isActive ? XR_TRUE : XR_FALSE;
+        state->currentState = actionState.vector2fValue;
+        state->changedSinceLastSync = actionState.changedSinceLastSync ? XR_TRUE : XR_FALSE;
+        state->lastChangeTime = actionState.lastChangeTime;
 
-        TraceLoggingWrite(
-            g_traceProvider,
-            "xrGetActionStateVector2f",
-            TLArg(!!state->isActive, "Active"),
-            TLArg(fmt::format("{}, {}", state->currentState.x, state->currentState.y).c_str(), "CurrentState"),
-            TLArg(!!state->changedSinceLastSync, "ChangedSinceLastSync"),
-            TLArg(state->lastChangeTime, "LastChangeTime"));
+        TraceLoggingWriteIfEnabled(g_traceProvider,
+                                   "xrGetActionStateVector2f",
+                                   TLArg(!!state->isActive, "Active"),
+                                   TLArg(ToTraceString(state->currentState).c_str(), "CurrentState"),
+                                   TLArg(!!state->changedSinceLastSync, "ChangedSinceLastSync"),
+                                   TLArg(state->lastChangeTime, "LastChangeTime"));
 
         return XR_SUCCESS;
     }
@@ -817,66 +692,36 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        TraceLoggingWrite(g_traceProvider,
-                          "xrGetActionStatePose",
-                          TLXArg(session, "Session"),
-                          TLXArg(getInfo->action, "Action"),
-                          TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
-
-        if (!m_sessionCreated || session != (XrSession)1) {
-            return XR_ERROR_HANDLE_INVALID;
+        if (TraceLoggingProviderEnabled(g_traceProvider, 0, 0)) {
+            // The query itself does not take the lock, only the tracing does.
+            std::shared_lock lock(m_actionsAndSpacesMutex);
+            TraceLoggingWrite(g_traceProvider,
+                              "xrGetActionStatePose",
+                              TLXArg(session, "Session"),
+                              TLXArg(getInfo->action, "Action"),
+                              TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
+            if (const auto bindings = getActionBindings(getInfo->action, getInfo->subactionPath)) {
+                for (const auto& binding : *bindings) {
+                    TraceLoggingWrite(
+                        g_traceProvider, "xrGetActionStatePose", TLArg(binding.fullPath, "ActionSourcePath"));
+                }
+            }
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
-
-        if (!m_actions.count(getInfo->action)) {
+        if (!m_sessionCreated || session != (XrSession)1) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)getInfo->action;
-
-        if (xrAction.type != XR_ACTION_TYPE_POSE_INPUT) {
-            return XR_ERROR_ACTION_TYPE_MISMATCH;
-        }
-
-        if (!m_activeActionSets.count(xrAction.actionSet)) {
-            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
-        }
-
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
-                return XR_ERROR_PATH_INVALID;
-            }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
-                return XR_ERROR_PATH_UNSUPPORTED;
+        ActionState actionState{};
+        if (!getActionState(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_POSE_INPUT, actionState)) {
+            const XrResult result =
+                checkActionStateQuery(getInfo->action, getInfo->subactionPath, XR_ACTION_TYPE_POSE_INPUT);
+            if (XR_FAILED(result)) {
+                return result;
             }
         }
 
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            TraceLoggingWrite(g_traceProvider, "xrGetActionStatePose", TLArg(fullPath.c_str(), "ActionSourcePath"));
-
-            // We only support hands paths and eye tracker, not gamepad etc.
-            if (!isActionEyeTracker(fullPath)) {
-                const int side = getActionSide(fullPath);
-                if (side >= 0) {
-                    state->isActive = m_isControllerActive[side] ? XR_TRUE : XR_FALSE;
-
-                    // Per spec we must consistently pick one source. We pick the first one.
-                    break;
-                }
-            } else {
-                state->isActive = (m_eyeTrackingType != EyeTracking::None) ? XR_TRUE : XR_FALSE;
-
-                // Per spec we must consistently pick one source. We pick the first one.
-                break;
-            }
-        }
+        state->isActive = actionState.isActive ? XR_TRUE : XR_FALSE;
 
         TraceLoggingWrite(g_traceProvider, "xrGetActionStatePose", TLArg(!!state->isActive, "Active"));
 
@@ -913,7 +758,7 @@ namespace virtualdesktop_openxr {
             if (syncInfo->activeActionSets[i].subactionPath == XR_NULL_PATH) {
                 doSide[0] = doSide[1] = true;
             } else {
-                const ActionSet& xrActionSet = *(ActionSet*)syncInfo->activeActionSets[i].actionSet;
+                const ActionSet& xrActionSet = *m_actionSets.get(syncInfo->activeActionSets[i].actionSet);
 
                 if (!xrActionSet.subactionPaths.count(syncInfo->activeActionSets[i].subactionPath)) {
                     return XR_ERROR_PATH_UNSUPPORTED;
@@ -937,7 +782,7 @@ namespace virtualdesktop_openxr {
                 continue;
             }
 
-            TraceLoggingWrite(
+            TraceLoggingWriteIfEnabled(
                 g_traceProvider,
                 "OVR_InputState",
                 TLArg(side == 0 ? "Left" : "Right", "Side"),
@@ -947,10 +792,7 @@ namespace virtualdesktop_openxr {
                       "Touches"),
                 TLArg(m_cachedInputState.IndexTrigger[side], "IndexTrigger"),
                 TLArg(m_cachedInputState.HandTrigger[side], "HandTrigger"),
-                TLArg(
-                    fmt::format("{}, {}", m_cachedInputState.Thumbstick[side].x, m_cachedInputState.Thumbstick[side].y)
-                        .c_str(),
-                    "Joystick"));
+                TLArg(ToTraceString(m_cachedInputState.Thumbstick[side]).c_str(), "Joystick"));
 
             // Look for changes in controller/interaction profiles.
             const auto lastControllerType = m_cachedControllerType[side];
@@ -975,12 +817,17 @@ namespace virtualdesktop_openxr {
         m_lastForcedInteractionProfile = m_forcedInteractionProfile;
 
         // Propagate the input state to the entire action state.
+        std::set<XrActionSet> syncedActionSets;
         for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
-            ActionSet& xrActionSet = *(ActionSet*)syncInfo->activeActionSets[i].actionSet;
+            ActionSet& xrActionSet = *m_actionSets.get(syncInfo->activeActionSets[i].actionSet);
 
             xrActionSet.cachedInputState = m_cachedInputState;
+            syncedActionSets.insert(syncInfo->activeActionSets[i].actionSet);
         }
 
+        // Evaluate the actions once, for all the subsequent calls to xrGetActionState*().
+        publishActionStates(syncedActionSets);
+
         return XR_SUCCESS;
     }
 
@@ -1006,33 +853,43 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_actions.count(enumerateInfo->action)) {
+        Action* const action = getAction(enumerateInfo->action);
+        if (!action) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)enumerateInfo->action;
+        Action& xrAction = *action;
 
         if (!m_activeActionSets.count(xrAction.actionSet)) {
             return XR_ERROR_ACTIONSET_NOT_ATTACHED;
         }
 
-        if (sourceCapacityInput && sourceCapacityInput < xrAction.actionSources.size()) {
+        const std::map<std::string, ActionSource>* const allSources[] = {
+            &xrAction.actionSources, &xrAction.controllerSources[0], &xrAction.controllerSources[1]};
+        size_t sourceCount = 0;
+        for (const auto* sources : allSources) {
+            sourceCount += sources->size();
+        }
+
+        if (sourceCapacityInput && sourceCapacityInput < sourceCount) {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
 
-        *sourceCountOutput = (uint32_t)xrAction.actionSources.size();
+        *sourceCountOutput = (uint32_t)sourceCount;
         TraceLoggingWrite(
             g_traceProvider, "xrEnumerateBoundSourcesForAction", TLArg(*sourceCountOutput, "SourceCountOutput"));
 
         if (sourceCapacityInput && sources) {
             uint32_t i = 0;
-            for (const auto& source : xrAction.actionSources) {
-                sources[i] = stringToPath(source.second.realPath.c_str());
-                TraceLoggingWrite(g_traceProvider,
-                                  "xrEnumerateBoundSourcesForAction",
-                                  TLArg(source.first.c_str(), "Source"),
-                                  TLArg(sources[i], "Path"));
-                i++;
+            for (const auto* actionSources : allSources) {
+                for (const auto& source : *actionSources) {
+                    sources[i] = stringToPath(source.second.realPath.c_str());
+                    TraceLoggingWrite(g_traceProvider,
+                                      "xrEnumerateBoundSourcesForAction",
+                                      TLArg(source.first.c_str(), "Source"),
+                                      TLArg(sources[i], "Path"));
+                    i++;
+                }
             }
         }
 
@@ -1156,13 +1013,14 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_actions.count(hapticActionInfo->action)) {
+        Action* const action = getAction(hapticActionInfo->action);
+        if (!action) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)hapticActionInfo->action;
+        Action& xrAction = *action;
 
         if (xrAction.type != XR_ACTION_TYPE_VIBRATION_OUTPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
@@ -1177,7 +1035,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (hapticActionInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(hapticActionInfo->subactionPath) == m_strings.cend()) {
+            if (!isKnownPath(hapticActionInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(hapticActionInfo->subactionPath)) {
@@ -1185,19 +1043,12 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        const std::string& subActionPath = getXrPath(hapticActionInfo->subactionPath);
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const bool isOutput = endsWith(fullPath, "/output/haptic");
-            TraceLoggingWrite(g_traceProvider, "xrApplyHapticFeedback", TLArg(fullPath.c_str(), "ActionSourcePath"));
+        for (const auto& binding : xrAction.bindings[(size_t)getBindingSlot(hapticActionInfo->subactionPath)]) {
+            TraceLoggingWrite(g_traceProvider, "xrApplyHapticFeedback", TLArg(binding.fullPath, "ActionSourcePath"));
 
             // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isOutput && side >= 0) {
+            const int side = binding.side;
+            if (binding.isHapticOutput && side >= 0) {
                 const XrHapticBaseHeader* entry = reinterpret_cast<const XrHapticBaseHeader*>(hapticFeedback);
                 while (entry) {
                     if (entry->type == XR_TYPE_HAPTIC_VIBRATION) {
@@ -1245,13 +1096,14 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_actions.count(hapticActionInfo->action)) {
+        Action* const action = getAction(hapticActionInfo->action);
+        if (!action) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)hapticActionInfo->action;
+        Action& xrAction = *action;
 
         if (xrAction.type != XR_ACTION_TYPE_VIBRATION_OUTPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
@@ -1262,7 +1114,7 @@ namespace virtualdesktop_openxr {
         }
 
         if (hapticActionInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(hapticActionInfo->subactionPath) == m_strings.cend()) {
+            if (!isKnownPath(hapticActionInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(hapticActionInfo->subactionPath)) {
@@ -1270,19 +1122,12 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        const std::string& subActionPath = getXrPath(hapticActionInfo->subactionPath);
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const bool isOutput = endsWith(fullPath, "/output/haptic");
-            TraceLoggingWrite(g_traceProvider, "xrStopHapticFeedback", TLArg(fullPath.c_str(), "ActionSourcePath"));
+        for (const auto& binding : xrAction.bindings[(size_t)getBindingSlot(hapticActionInfo->subactionPath)]) {
+            TraceLoggingWrite(g_traceProvider, "xrStopHapticFeedback", TLArg(binding.fullPath, "ActionSourcePath"));
 
             // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isOutput && side >= 0) {
+            const int side = binding.side;
+            if (binding.isHapticOutput && side >= 0) {
                 // Nothing to do here.
             }
         }
@@ -1302,17 +1147,17 @@ namespace virtualdesktop_openxr {
         XrPosef gripPose = Pose::Identity();
         XrPosef aimPose = Pose::Identity();
 
-        // Remove all old bindings for this controller.
-        for (const auto& action : m_actions) {
-            Action& xrAction = *(Action*)action;
-
-            for (auto it = xrAction.actionSources.begin(); it != xrAction.actionSources.end();) {
-                if (getActionSide(it->first) == side) {
-                    it = xrAction.actionSources.erase(it);
-                } else {
-                    it++;
+        // Remove all old bindings for this controller. When they came from the cache, give them back to it.
+        if (m_appliedResolvedBindings[side]) {
+            for (auto& [action, sources] : *m_appliedResolvedBindings[side]) {
+                Action* const xrAction = getAction(action);
+                if (xrAction) {
+                    std::swap(xrAction->controllerSources[side], sources);
                 }
             }
+            m_appliedResolvedBindings[side] = nullptr;
+        } else {
+            m_actions.forEach([&](XrAction, Action& xrAction) { xrAction.controllerSources[side].clear(); });
         }
 
         if (!m_cachedControllerType[side].empty()) {
@@ -1366,67 +1211,34 @@ namespace virtualdesktop_openxr {
                 }
             }
 
-            // Map all possible actions sources for this controller.
+            // Map all possible actions sources for this controller. The result only depends on the interaction
+            // profiles and on the suggested bindings, so we can reuse it when the same controller comes back. The
+            // sources are swapped into the actions, and nothing is copied.
             if (bindings != m_suggestedBindings.cend()) {
-                const auto& mapping = m_controllerMappingTable
-                                          .find(std::make_pair(actualInteractionProfile, preferredInteractionProfile))
-                                          ->second;
-                for (const auto& binding : bindings->second) {
-                    if (!m_actions.count(binding.action)) {
-                        continue;
-                    }
-
-                    const auto& sourcePath = getXrPath(binding.binding);
-                    if (getActionSide(sourcePath) != side) {
-                        continue;
-                    }
-
-                    Action& xrAction = *(Action*)binding.action;
-
-                    // Map to the OVR input state.
-                    ActionSource newSource{};
-                    if (mapping(xrAction, binding.binding, newSource)) {
-                        // Avoid duplicates.
-                        bool duplicated = false;
-                        for (const auto& source : xrAction.actionSources) {
-                            if (source.second.realPath == newSource.realPath) {
-                                duplicated = true;
-                                break;
-                            }
-                        }
+                const ResolvedBindingsKey key{preferredInteractionProfile, actualInteractionProfile, side};
+                auto resolved = m_resolvedBindings.find(key);
+                const bool isCached = resolved != m_resolvedBindings.end();
+                if (!isCached) {
+                    resolved = m_resolvedBindings
+                                   .emplace(key, resolveActionSources(bindings->second, actualInteractionProfile, side))
+                                   .first;
+                }
 
-                        if (!duplicated) {
-                            TraceLoggingWrite(g_traceProvider,
-                                              "xrSyncActions_MapActionSource",
-                                              TLXArg(binding.action, "Action"),
-                                              TLXArg(xrAction.actionSet, "ActionSet"),
-                                              TLArg(sourcePath.c_str(), "ActionPath"),
-                                              TLArg(newSource.realPath.c_str(), "SourcePath"),
-                                              TLArg(!!newSource.buttonMap, "IsButton"),
-                                              TLArg(!!newSource.floatValue, "IsFloat"),
-                                              TLArg(!!newSource.vector2fValue, "IsVector2"));
-
-                            // Relocate the pointers to the copy of the input state within the actionset.
-                            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-                            const auto relocatePointer = [&](void* pointer) {
-                                if (!pointer) {
-                                    return (uint8_t*)nullptr;
-                                }
-
-                                uint8_t* p = (uint8_t*)pointer;
-                                uint8_t* oldBase = (uint8_t*)&m_cachedInputState;
-                                uint8_t* newBase = (uint8_t*)&xrActionSet.cachedInputState;
-
-                                return newBase + (p - oldBase);
-                            };
-                            newSource.buttonMap = (uint32_t*)relocatePointer((void*)newSource.buttonMap);
-                            newSource.floatValue = (float*)relocatePointer((void*)newSource.floatValue);
-                            newSource.vector2fValue = (ovrVector2f*)relocatePointer((void*)newSource.vector2fValue);
-
-                            xrAction.actionSources.insert_or_assign(sourcePath, newSource);
-                        }
+                size_t numSources = 0;
+                for (auto& [action, sources] : resolved->second) {
+                    Action* const xrAction = getAction(action);
+                    if (xrAction) {
+                        numSources += sources.size();
+                        std::swap(xrAction->controllerSources[side], sources);
                     }
                 }
+                m_appliedResolvedBindings[side] = &resolved->second;
+
+                TraceLoggingWrite(g_traceProvider,
+                                  "xrSyncActions_ResolvedBindings",
+                                  TLArg(side == 0 ? "Left" : "Right", "Side"),
+                                  TLArg(isCached, "Cached"),
+                                  TLArg(numSources, "Sources"));
             }
         }
 
@@ -1465,35 +1277,197 @@ namespace virtualdesktop_openxr {
         m_currentInteractionProfileDirty =
             m_currentInteractionProfileDirty ||
             (m_currentInteractionProfile[side] != prevInterationProfile && !m_activeActionSets.empty());
+
+        // Refresh the pre-resolved bindings to reflect the new action sources.
+        m_actions.forEach([&](XrAction, Action& xrAction) { updateActionBindings(xrAction); });
+        m_spaces.forEach([&](XrSpace, Space& xrSpace) { updateSpaceTarget(xrSpace); });
+        m_actionEvaluationTableDirty = true;
     }
 
-    std::string OpenXrRuntime::getXrPath(XrPath path) const {
+    OpenXrRuntime::ResolvedBindings
+    OpenXrRuntime::resolveActionSources(const std::vector<XrActionSuggestedBinding>& bindings,
+                                        const std::string& interactionProfile,
+                                        int side) {
+        ResolvedBindings resolvedBindings;
+
+        // All interaction profiles are mapped onto the preferred (Touch controller) one.
+        const InteractionProfile* const profile = getInteractionProfile(interactionProfile);
+        if (!profile) {
+            return resolvedBindings;
+        }
+
+        for (const auto& binding : bindings) {
+            Action* const action = getAction(binding.action);
+            if (!action) {
+                continue;
+            }
+
+            const auto& sourcePath = getXrPath(binding.binding);
+            if (getActionSide(sourcePath) != side) {
+                continue;
+            }
+
+            const Action& xrAction = *action;
+
+            // Map to the OVR input state.
+            ActionSource newSource{};
+            if (!mapPathToTouchControllerInputState(*profile, xrAction, sourcePath, newSource)) {
+                continue;
+            }
+
+            // Avoid duplicates.
+            auto& resolvedSources = resolvedBindings[binding.action];
+            bool duplicated = false;
+            for (const auto& resolvedSource : resolvedSources) {
+                if (resolvedSource.second.realPath == newSource.realPath) {
+                    duplicated = true;
+                    break;
+                }
+            }
+            if (duplicated) {
+                continue;
+            }
+
+            TraceLoggingWrite(g_traceProvider,
+                              "xrSyncActions_MapActionSource",
+                              TLXArg(binding.action, "Action"),
+                              TLXArg(xrAction.actionSet, "ActionSet"),
+                              TLArg(sourcePath.c_str(), "ActionPath"),
+                              TLArg(newSource.realPath.c_str(), "SourcePath"),
+                              TLArg(!!newSource.buttonMap, "IsButton"),
+                              TLArg(!!newSource.floatValue, "IsFloat"),
+                              TLArg(!!newSource.vector2fValue, "IsVector2"));
+
+            // Relocate the pointers to the copy of the input state within the actionset.
+            const ActionSet& xrActionSet = *m_actionSets.get(xrAction.actionSet);
+            const auto relocatePointer = [&](void* pointer) {
+                if (!pointer) {
+                    return (uint8_t*)nullptr;
+                }
+
+                uint8_t* p = (uint8_t*)pointer;
+                uint8_t* oldBase = (uint8_t*)&m_cachedInputState;
+                uint8_t* newBase = (uint8_t*)&xrActionSet.cachedInputState;
+
+                return newBase + (p - oldBase);
+            };
+            newSource.buttonMap = (uint32_t*)relocatePointer((void*)newSource.buttonMap);
+            newSource.floatValue = (float*)relocatePointer((void*)newSource.floatValue);
+            newSource.vector2fValue = (ovrVector2f*)relocatePointer((void*)newSource.vector2fValue);
+
+            resolvedSources.try_emplace(sourcePath, std::move(newSource));
+        }
+
+        return resolvedBindings;
+    }
+
+    void OpenXrRuntime::invalidateResolvedBindings() {
+        // The actions keep the sources currently swapped in, until the next rebindControllerActions() drops them.
+        m_resolvedBindings.clear();
+        m_appliedResolvedBindings[0] = m_appliedResolvedBindings[1] = nullptr;
+    }
+
+    const std::string& OpenXrRuntime::getXrPath(XrPath path) const {
+        static const std::string k_nullPath;
+        static const std::string k_unknownPath = "<unknown>";
+
         if (path == XR_NULL_PATH) {
-            return "";
+            return k_nullPath;
         }
 
-        const auto it = m_strings.find(path);
-        if (it == m_strings.cend()) {
-            return "<unknown>";
+        if (!isKnownPath(path)) {
+            return k_unknownPath;
         }
 
-        return it->second;
+        // XrPath values are 1-based indices into the interning storage.
+        return m_strings[(size_t)path - 1];
     }
 
     XrPath OpenXrRuntime::stringToPath(const std::string& path, bool validate) {
-        for (auto entry : m_strings) {
-            if (entry.second == path) {
-                return entry.first;
-            }
+        const auto it = m_pathIndex.find(path);
+        if (it != m_pathIndex.cend()) {
+            return it->second;
         }
 
         if (path.length() >= XR_MAX_PATH_LENGTH || !validatePath(path)) {
             return XR_NULL_PATH;
         }
 
-        m_stringIndex++;
-        m_strings.insert_or_assign(m_stringIndex, path);
-        return (XrPath)m_stringIndex;
+        // The storage is a deque, so that existing elements are never moved and the views held by the index remain
+        // valid.
+        const std::string& interned = m_strings.emplace_back(path);
+        const XrPath newPath = (XrPath)m_strings.size();
+        m_pathIndex.insert_or_assign(std::string_view(interned), newPath);
+
+        return newPath;
+    }
+
+    bool OpenXrRuntime::isKnownPath(XrPath path) const {
+        return path != XR_NULL_PATH && path <= (XrPath)m_strings.size();
+    }
+
+    OpenXrRuntime::Action* OpenXrRuntime::getAction(XrAction action) {
+        Action* const xrAction = m_actions.get(action);
+        return xrAction && !xrAction->destroyed ? xrAction : nullptr;
+    }
+
+    void OpenXrRuntime::updateActionBindings(Action& xrAction) const {
+        for (auto& bindings : xrAction.bindings) {
+            bindings.clear();
+        }
+
+        for (const auto* sources :
+             {&xrAction.actionSources, &xrAction.controllerSources[0], &xrAction.controllerSources[1]}) {
+            for (const auto& source : *sources) {
+                const std::string& fullPath = source.first;
+
+                ActionBinding binding{};
+                binding.floatValue = source.second.floatValue;
+                binding.vector2fValue = source.second.vector2fValue;
+                binding.vector2fIndex = source.second.vector2fIndex;
+                binding.buttonMap = source.second.buttonMap;
+                binding.buttonType = source.second.buttonType;
+                binding.side = getActionSide(fullPath);
+                binding.isEyeTracker = isActionEyeTracker(fullPath);
+                binding.isGripPose = endsWith(fullPath, "/input/grip/pose");
+                binding.isAimPose = endsWith(fullPath, "/input/aim/pose");
+                binding.isHapticOutput = endsWith(fullPath, "/output/haptic");
+                binding.fullPath = fullPath.c_str();
+
+                // A NULL subaction path matches all sources.
+                xrAction.bindings[(size_t)BindingSlot::Any].push_back(binding);
+                if (binding.side == 0) {
+                    xrAction.bindings[(size_t)BindingSlot::Left].push_back(binding);
+                } else if (binding.side == 1) {
+                    xrAction.bindings[(size_t)BindingSlot::Right].push_back(binding);
+                } else if (startsWith(fullPath, "/user/eyes_ext")) {
+                    xrAction.bindings[(size_t)BindingSlot::Eyes].push_back(binding);
+                }
+            }
+        }
+    }
+
+    const std::vector<OpenXrRuntime::ActionBinding>* OpenXrRuntime::getActionBindings(XrAction action,
+                                                                                     XrPath subactionPath) {
+        const Action* const xrAction = getAction(action);
+        if (!xrAction) {
+            return nullptr;
+        }
+        return &xrAction->bindings[(size_t)getBindingSlot(subactionPath)];
+    }
+
+    OpenXrRuntime::BindingSlot OpenXrRuntime::getBindingSlot(XrPath subactionPath) const {
+        if (subactionPath == XR_NULL_PATH) {
+            return BindingSlot::Any;
+        } else if (subactionPath == m_handSubactionPath[0]) {
+            return BindingSlot::Left;
+        } else if (subactionPath == m_handSubactionPath[1]) {
+            return BindingSlot::Right;
+        } else if (subactionPath == m_eyesSubactionPath) {
+            return BindingSlot::Eyes;
+        }
+
+        return BindingSlot::Unbound;
     }
 
     int OpenXrRuntime::getActionSide(const std::string& fullPath, bool allowExtraPaths) const {
@@ -1513,4 +1487,313 @@ namespace virtualdesktop_openxr {
         return fullPath == "/user/eyes_ext/input/gaze_ext/pose" || fullPath == "/user/eyes_ext/input/gaze_ext";
     }
 
+    void OpenXrRuntime::publishActionStates(const std::set<XrActionSet>& syncedActionSets) {
+        const ActionStateSnapshot* const previous = m_actionStates.latest();
+
+        if (m_actionEvaluationTableDirty) {
+            buildActionEvaluationTable();
+        }
+
+        auto snapshot = std::make_unique<ActionStateSnapshot>();
+        snapshot->entries.resize(m_actions.capacity());
+
+        // Carry over the previous state of all actions. The ones from the actionsets being synced are re-evaluated
+        // below.
+        m_actions.forEach([&](XrAction action, const Action& xrAction) {
+            if (xrAction.destroyed || !m_activeActionSets.count(xrAction.actionSet)) {
+                return;
+            }
+
+            const uint32_t index = m_actions.indexOf(action);
+            ActionStateSnapshot::Entry& entry = snapshot->entries[index];
+            entry.action = action;
+            entry.type = xrAction.type;
+            entry.validSlots = 1u << (uint32_t)BindingSlot::Any;
+            for (const XrPath subactionPath : xrAction.subactionPaths) {
+                const BindingSlot slot = getBindingSlot(subactionPath);
+                if (slot != BindingSlot::Unbound) {
+                    entry.validSlots |= 1u << (uint32_t)slot;
+                }
+            }
+
+            if (previous && index < previous->entries.size() && previous->entries[index].action == action) {
+                std::copy(std::begin(previous->entries[index].state),
+                          std::end(previous->entries[index].state),
+                          std::begin(entry.state));
+            }
+
+            // Pose actions only report whether their source is active.
+            if (xrAction.type == XR_ACTION_TYPE_POSE_INPUT && syncedActionSets.count(xrAction.actionSet)) {
+                for (uint32_t slot = 0; slot < (uint32_t)std::size(entry.state); slot++) {
+                    entry.state[slot] = {};
+                    entry.state[slot].isActive = isPoseActionActive(xrAction, (BindingSlot)slot);
+                }
+            }
+        });
+
+        if (!syncedActionSets.empty()) {
+            evaluateActionStates(syncedActionSets, ovrTimeToXrTime(m_cachedInputState.TimeInSeconds), *snapshot);
+        }
+
+        m_actionStates.publish(std::move(snapshot));
+    }
+
+    void OpenXrRuntime::buildActionEvaluationTable() {
+        ActionEvaluationTable& table = m_actionEvaluationTable;
+        table = {};
+
+        m_actions.forEach([&](XrAction action, const Action& xrAction) {
+            if (xrAction.destroyed || (xrAction.type != XR_ACTION_TYPE_BOOLEAN_INPUT &&
+                                       xrAction.type != XR_ACTION_TYPE_FLOAT_INPUT &&
+                                       xrAction.type != XR_ACTION_TYPE_VECTOR2F_INPUT)) {
+                return;
+            }
+
+            // The action sources point within the copy of the input state held by the actionset.
+            const ActionSet* const xrActionSet = m_actionSets.get(xrAction.actionSet);
+            if (!xrActionSet) {
+                return;
+            }
+            const auto wordOffset = [&](const void* pointer) {
+                return (uint32_t)(((const uint8_t*)pointer - (const uint8_t*)&xrActionSet->cachedInputState) /
+                                  sizeof(uint32_t));
+            };
+
+            for (uint32_t slot = 0; slot < (uint32_t)BindingSlot::Unbound; slot++) {
+                ActionEvaluationTable::Output output{};
+                output.actionSet = xrAction.actionSet;
+                output.entry = m_actions.indexOf(action);
+                output.slot = slot;
+                output.type = xrAction.type;
+                output.firstTerm = (uint32_t)table.offsetX.size();
+
+                for (const auto& value : xrAction.bindings[slot]) {
+                    // We only support hands paths, not gamepad etc.
+                    const int side = value.side;
+                    if (side < 0) {
+                        continue;
+                    }
+
+                    uint32_t offsetX = 0;
+                    uint32_t offsetY = 0;
+                    uint32_t buttonMask = 0;
+                    float threshold = 0.5f;
+                    if (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT) {
+                        if (value.buttonMap) {
+                            offsetX = offsetY = wordOffset(value.buttonMap);
+                            buttonMask = value.buttonType;
+                        } else if (value.floatValue) {
+                            offsetX = offsetY = wordOffset(&value.floatValue[side]);
+                            threshold = 0.95f;
+                        } else {
+                            continue;
+                        }
+                    } else if (xrAction.type == XR_ACTION_TYPE_FLOAT_INPUT) {
+                        if (value.floatValue) {
+                            offsetX = offsetY = wordOffset(&value.floatValue[side]);
+                        } else if (value.buttonMap) {
+                            offsetX = offsetY = wordOffset(value.buttonMap);
+                            buttonMask = value.buttonType;
+                        } else if (value.vector2fValue && value.vector2fIndex >= 0) {
+                            offsetX = offsetY = wordOffset(value.vector2fIndex == 0 ? &value.vector2fValue[side].x
+                                                                                     : &value.vector2fValue[side].y);
+                        } else {
+                            continue;
+                        }
+                    } else {
+                        if (value.vector2fValue) {
+                            offsetX = wordOffset(&value.vector2fValue[side].x);
+                            offsetY = wordOffset(&value.vector2fValue[side].y);
+                        } else {
+                            continue;
+                        }
+                    }
+
+                    table.offsetX.push_back(offsetX);
+                    table.offsetY.push_back(offsetY);
+                    table.buttonMask.push_back(buttonMask);
+                    table.threshold.push_back(threshold);
+                    table.side.push_back((uint32_t)side);
+                }
+
+                output.termCount = (uint32_t)table.offsetX.size() - output.firstTerm;
+                table.outputs.push_back(output);
+            }
+        });
+
+        table.valueX.resize(table.offsetX.size());
+        table.valueY.resize(table.offsetX.size());
+        table.isActive.resize(table.offsetX.size());
+        m_actionEvaluationTableDirty = false;
+
+        TraceLoggingWrite(g_traceProvider,
+                          "ActionEvaluationTable",
+                          TLArg(table.offsetX.size(), "Terms"),
+                          TLArg(table.outputs.size(), "Outputs"));
+    }
+
+    void OpenXrRuntime::evaluateActionStates(const std::set<XrActionSet>& syncedActionSets,
+                                             XrTime syncTime,
+                                             ActionStateSnapshot& snapshot) {
+        ActionEvaluationTable& table = m_actionEvaluationTable;
+
+        // All the actionsets being synced hold a copy of the current input state, so we can read the values directly
+        // from it.
+        uint32_t words[sizeof(ovrInputState) / sizeof(uint32_t)];
+        memcpy(words, &m_cachedInputState, sizeof(words));
+        const uint32_t isControllerActive[2] = {m_isControllerActive[0], m_isControllerActive[1]};
+
+        // First pass: evaluate every term. There is no branch and no dependency between iterations.
+        const size_t numTerms = table.offsetX.size();
+        for (size_t i = 0; i < numTerms; i++) {
+            const uint32_t bitsX = words[table.offsetX[i]];
+            const uint32_t bitsY = words[table.offsetY[i]];
+            float x, y;
+            memcpy(&x, &bitsX, sizeof(x));
+            memcpy(&y, &bitsY, sizeof(y));
+            const float button = (bitsX & table.buttonMask[i]) ? 1.f : 0.f;
+            table.valueX[i] = table.buttonMask[i] ? button : x;
+            table.valueY[i] = y;
+            table.isActive[i] = isControllerActive[table.side[i]];
+        }
+
+        // Second pass: combine the terms of each action and detect the changes.
+        for (const auto& output : table.outputs) {
+            if (!syncedActionSets.count(output.actionSet)) {
+                continue;
+            }
+
+            ActionState& state = snapshot.entries[output.entry].state[output.slot];
+            const ActionState previousState = state;
+            state = {};
+
+            const uint32_t endTerm = output.firstTerm + output.termCount;
+            switch (output.type) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                // Per spec, the combined state is the OR of all values.
+                for (uint32_t i = output.firstTerm; i < endTerm; i++) {
+                    state.isActive = state.isActive || table.isActive[i];
+                    state.boolValue = state.boolValue || (table.isActive[i] && table.valueX[i] > table.threshold[i]);
+                }
+                state.changedSinceLastSync = state.isActive && state.boolValue != previousState.boolValue;
+                break;
+
+            case XR_ACTION_TYPE_FLOAT_INPUT:
+                // Per spec, the combined state is the absolute maximum of all values.
+                state.floatValue = -std::numeric_limits<float>::infinity();
+                for (uint32_t i = output.firstTerm; i < endTerm; i++) {
+                    if (table.isActive[i]) {
+                        state.isActive = true;
+                        state.floatValue = std::max(state.floatValue, table.valueX[i]);
+                    }
+                }
+                if (!state.isActive) {
+                    state.floatValue = 0.f;
+                }
+                state.changedSinceLastSync = state.isActive && state.floatValue != previousState.floatValue;
+                break;
+
+            case XR_ACTION_TYPE_VECTOR2F_INPUT: {
+                // Per spec, the combined state if the one of the vector with the longest length.
+                float longestLengthSquared = 0.f;
+                for (uint32_t i = output.firstTerm; i < endTerm; i++) {
+                    if (table.isActive[i]) {
+                        const float lengthSquared =
+                            table.valueX[i] * table.valueX[i] + table.valueY[i] * table.valueY[i];
+                        if (!state.isActive || lengthSquared >= longestLengthSquared) {
+                            state.vector2fValue = {table.valueX[i], table.valueY[i]};
+                            longestLengthSquared = lengthSquared;
+                        }
+                        state.isActive = true;
+                    }
+                }
+                state.changedSinceLastSync =
+                    state.isActive && (state.vector2fValue.x != previousState.vector2fValue.x ||
+                                       state.vector2fValue.y != previousState.vector2fValue.y);
+                break;
+            }
+
+            default:
+                break;
+            }
+
+            if (state.isActive) {
+                state.lastChangeTime = state.changedSinceLastSync ? syncTime : previousState.lastChangeTime;
+            }
+        }
+    }
+
+    bool OpenXrRuntime::isPoseActionActive(const Action& xrAction, BindingSlot slot) const {
+        for (const auto& binding : xrAction.bindings[(size_t)slot]) {
+            // We only support hands paths and eye tracker, not gamepad etc.
+            // Per spec we must consistently pick one source. We pick the first one.
+            if (!binding.isEyeTracker) {
+                if (binding.side >= 0) {
+                    return m_isControllerActive[binding.side];
+                }
+            } else {
+                return m_eyeTrackingType != EyeTracking::None;
+            }
+        }
+
+        return false;
+    }
+
+    bool OpenXrRuntime::getActionState(XrAction action,
+                                       XrPath subactionPath,
+                                       XrActionType type,
+                                       ActionState& state) const {
+        const auto snapshot = m_actionStates.read();
+        if (!snapshot.get()) {
+            return false;
+        }
+
+        const uint32_t index = m_actions.indexOf(action);
+        if (index >= snapshot->entries.size()) {
+            return false;
+        }
+
+        const ActionStateSnapshot::Entry& entry = snapshot->entries[index];
+        if (entry.action != action || entry.type != type) {
+            return false;
+        }
+
+        const BindingSlot slot = getBindingSlot(subactionPath);
+        if (slot == BindingSlot::Unbound || !(entry.validSlots & (1u << (uint32_t)slot))) {
+            return false;
+        }
+
+        state = entry.state[(size_t)slot];
+        return true;
+    }
+
+    XrResult OpenXrRuntime::checkActionStateQuery(XrAction action, XrPath subactionPath, XrActionType type) {
+        std::shared_lock lock(m_actionsAndSpacesMutex);
+
+        const Action* const xrAction = getAction(action);
+        if (!xrAction) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        if (xrAction->type != type) {
+            return XR_ERROR_ACTION_TYPE_MISMATCH;
+        }
+
+        if (!m_activeActionSets.count(xrAction->actionSet)) {
+            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+        }
+
+        if (subactionPath != XR_NULL_PATH) {
+            if (!isKnownPath(subactionPath)) {
+                return XR_ERROR_PATH_INVALID;
+            }
+            if (!xrAction->subactionPaths.count(subactionPath)) {
+                return XR_ERROR_PATH_UNSUPPORTED;
+            }
+        }
+
+        // This is a valid query, for a subaction path that can never be bound (eg: /user/head).
+        return XR_SUCCESS;
+    }
+
 } // namespace virtualdesktop_openxr
@@ -0,0 +1,716 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // An opt-in recorder of the OpenXR call stream, fed by the dispatch wrappers. Each call is written as a record with
+    // its entry point, thread, start time, duration, result and arguments. Each entry point is described by a name
+    // record before its first call, which keeps the call records compact. The file layout is:
+    //
+    //   FileHeader
+    //   then a sequence of records, each starting with a RecordType:
+    //     RecordType::Name: uint16_t id, uint16_t length, followed by length characters (not terminated)
+    //     RecordType::Call: CallRecord, followed by argumentsSize bytes of arguments
+    //     RecordType::Dropped: uint32_t threadId, uint32_t count of the calls lost because the thread's buffer was full
+    //       (threadId 0: because the thread had no buffer)
+    //
+    // The arguments hold one field per parameter of the entry point, in declaration order. A field is an ArgumentType,
+    // a uint16_t size, and size bytes:
+    //   Value: the parameter itself, for handles, scalars, enums and atoms.
+    //   String: the characters of a const char* parameter (not terminated).
+    //   Input: the structure that a const pointer points to, without following any of its pointers. It is followed by
+    //     one Next field holding the XrStructureType of each structure in its next chain.
+    //   Output: the structure or value that a non-const pointer points to, after the call succeeded.
+    //   Null: a null pointer. Unset: the output of a failed call. Array: the contents of arrays are not captured.
+    //   Truncated: the field did not fit in the k_maxArgumentsSize bytes of arguments of a call.
+    //
+    // Each thread writes its calls into its own buffer, and a background thread flushes the buffers to the file. A
+    // recording thread never waits for the file or for another thread: when its buffer is full, its calls are dropped
+    // and counted instead. A thread keeps its buffer from one recording to the next, and only the first
+    // k_maxThreadBuffers threads get one: the calls of the other threads are dropped. Calls still in flight when the
+    // recording is closed are not written. Records of different threads are interleaved in flush order, so sort the
+    // calls by start time to follow the stream (CallRecording does). Times are in QueryPerformanceCounter() ticks. When
+    // disabled, a call costs a few untaken branches.
+    class CallRecorder {
+      public:
+        static constexpr uint32_t k_version = 2;
+        static constexpr size_t k_maxEntryPoints = 512;
+        static constexpr size_t k_maxArgumentsSize = 1024;
+        static constexpr size_t k_defaultThreadBufferSize = 1024 * 1024;
+        static constexpr size_t k_maxThreadBuffers = 64;
+        static constexpr std::chrono::milliseconds k_defaultFlushPeriod{20};
+
+        struct FileHeader {
+            char magic[8]; // "VDXRCALL"
+            uint32_t version;
+            uint32_t processId;
+            int64_t ticksPerSecond;
+        };
+
+        enum class RecordType : uint8_t {
+            Name = 1,
+            Call = 2,
+            Dropped = 3,
+        };
+
+        enum class ArgumentType : uint8_t {
+            Value = 1,
+            String,
+            Input,
+            Next,
+            Output,
+            Null,
+            Unset,
+            Array,
+            Truncated,
+        };
+
+#pragma pack(push, 1)
+        struct CallRecord {
+            uint16_t id;
+            uint32_t threadId;
+            int64_t startTicks;
+            uint32_t durationTicks;
+            int32_t result;
+            uint16_t argumentsSize;
+        };
+
+        struct DroppedRecord {
+            uint32_t threadId;
+            uint32_t count;
+        };
+#pragma pack(pop)
+
+        // Measures one call, from construction to destruction, and captures its arguments. The id of the entry point is
+        // assigned by the generator of the dispatch wrappers and must be below k_maxEntryPoints.
+        class Scope {
+          public:
+            Scope(CallRecorder& recorder, uint16_t id, const char* name)
+                : m_recorder(recorder), m_id(id), m_name(name), m_isEnabled(recorder.isEnabled()) {
+                if (m_isEnabled) {
+                    QueryPerformanceCounter(&m_start);
+                }
+            }
+
+            ~Scope() {
+                if (m_isEnabled) {
+                    LARGE_INTEGER end;
+                    QueryPerformanceCounter(&end);
+                    for (uint32_t i = 0; i < m_numOutputs; i++) {
+                        captureOutput(m_outputs[i]);
+                    }
+                    m_recorder.record(m_id,
+                                      m_name,
+                                      m_start.QuadPart,
+                                      end.QuadPart - m_start.QuadPart,
+                                      m_result,
+                                      m_arguments,
+                                      m_argumentsSize);
+                }
+            }
+
+            // Whether the call is recorded. The arguments only need to be added when it is.
+            bool isEnabled() const {
+                return m_isEnabled;
+            }
+
+            void setResult(XrResult result) {
+                m_result = result;
+            }
+
+            template <typename T>
+            void addValue(const T& value) {
+                addField(ArgumentType::Value, &value, sizeof(value));
+            }
+
+            void addString(const char* string) {
+                if (!string) {
+                    addField(ArgumentType::Null, nullptr, 0);
+                    return;
+                }
+                addField(ArgumentType::String, string, strnlen(string, k_maxArgumentsSize));
+            }
+
+            template <typename T>
+            void addInput(const T* input) {
+                if (!input) {
+                    addField(ArgumentType::Null, nullptr, 0);
+                    return;
+                }
+                if (!addField(ArgumentType::Input, input, sizeof(T))) {
+                    return;
+                }
+                if constexpr (HasNextChain<T>::value) {
+                    for (auto entry = reinterpret_cast<const XrBaseInStructure*>(input->next); entry;
+                         entry = entry->next) {
+                        if (!addField(ArgumentType::Next, &entry->type, sizeof(entry->type))) {
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // The output is read back when the scope ends, after the call.
+            template <typename T>
+            void addOutput(T* output) {
+                if (!output) {
+                    addField(ArgumentType::Null, nullptr, 0);
+                    return;
+                }
+                const uint16_t offset = m_argumentsSize;
+                if (m_numOutputs == std::size(m_outputs)) {
+                    addField(ArgumentType::Truncated, nullptr, 0);
+                } else if (addField(ArgumentType::Unset, nullptr, sizeof(T))) {
+                    m_outputs[m_numOutputs++] = {offset, output, (uint16_t)sizeof(T)};
+                }
+            }
+
+            void addArray() {
+                addField(ArgumentType::Array, nullptr, 0);
+            }
+
+          private:
+            static constexpr size_t k_fieldHeaderSize = sizeof(ArgumentType) + sizeof(uint16_t);
+
+            // Room kept for the Truncated fields of the parameters that follow a field that did not fit.
+            static constexpr size_t k_reservedSize = 16 * k_fieldHeaderSize;
+
+            struct PendingOutput {
+                uint16_t offset;
+                const void* pointer;
+                uint16_t size;
+            };
+
+            template <typename T, typename = void>
+            struct HasNextChain : std::false_type {};
+            template <typename T>
+            struct HasNextChain<T, std::void_t<decltype(std::declval<T>().next)>> : std::true_type {};
+
+            // Returns false and writes a Truncated field instead when the field does not fit.
+            bool addField(ArgumentType type, const void* data, size_t size) {
+                if (m_argumentsSize + k_fieldHeaderSize + size > k_maxArgumentsSize - k_reservedSize) {
+                    if (m_argumentsSize + k_fieldHeaderSize <= k_maxArgumentsSize) {
+                        writeFieldHeader(ArgumentType::Truncated, 0);
+                    }
+                    return false;
+                }
+
+                writeFieldHeader(type, (uint16_t)size);
+                if (data) {
+                    memcpy(m_arguments + m_argumentsSize, data, size);
+                } else {
+                    memset(m_arguments + m_argumentsSize, 0, size);
+                }
+                m_argumentsSize += (uint16_t)size;
+                return true;
+            }
+
+            void writeFieldHeader(ArgumentType type, uint16_t size) {
+                m_arguments[m_argumentsSize] = (uint8_t)type;
+                memcpy(m_arguments + m_argumentsSize + sizeof(type), &size, sizeof(size));
+                m_argumentsSize += (uint16_t)k_fieldHeaderSize;
+            }
+
+            void captureOutput(const PendingOutput& output) {
+                if (XR_SUCCEEDED(m_result)) {
+                    m_arguments[output.offset] = (uint8_t)ArgumentType::Output;
+                    memcpy(m_arguments + output.offset + k_fieldHeaderSize, output.pointer, output.size);
+                }
+            }
+
+            CallRecorder& m_recorder;
+            const uint16_t m_id;
+            const char* const m_name;
+            const bool m_isEnabled;
+            LARGE_INTEGER m_start{};
+            XrResult m_result{XR_SUCCESS};
+
+            uint8_t m_arguments[k_maxArgumentsSize];
+            uint16_t m_argumentsSize{0};
+            PendingOutput m_outputs[4];
+            uint32_t m_numOutputs{0};
+        };
+
+        // The recording must be closed before the module is unloaded (see xrDestroyInstance()). Static destructors
+        // run under the loader lock, where joining a thread that needs the lock to exit would deadlock, so a recording
+        // still open here is abandoned: the flush thread is detached, and the calls it had not written are lost.
+        ~CallRecorder() {
+            m_enabled.store(false, std::memory_order_relaxed);
+            if (m_flushThread.joinable()) {
+                m_flushThread.detach();
+            }
+        }
+
+        // The size of the buffer of each thread is rounded up to a power of two.
+        bool open(const std::filesystem::path& path,
+                  size_t threadBufferSize = k_defaultThreadBufferSize,
+                  std::chrono::milliseconds flushPeriod = k_defaultFlushPeriod) {
+            std::unique_lock lock(m_mutex);
+
+            if (m_stream.is_open()) {
+                return true;
+            }
+
+            m_stream.open(path, std::ios_base::binary | std::ios_base::trunc);
+            if (!m_stream.is_open()) {
+                return false;
+            }
+
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            FileHeader header{{'V', 'D', 'X', 'R', 'C', 'A', 'L', 'L'}, k_version, GetCurrentProcessId()};
+            header.ticksPerSecond = frequency.QuadPart;
+            m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            m_threadBufferSize = 1;
+            while (m_threadBufferSize < threadBufferSize) {
+                m_threadBufferSize <<= 1;
+            }
+            m_flushPeriod = flushPeriod;
+            std::fill(std::begin(m_isNameWritten), std::end(m_isNameWritten), false);
+            m_numDropped.store(0, std::memory_order_relaxed);
+            m_numUnbufferedDropped.store(0, std::memory_order_relaxed);
+            m_numUnbufferedDroppedWritten = 0;
+
+            // A new generation makes every thread register its buffer again, which empties it. Generations are unique
+            // across recorders, since threads cache their buffer in a thread_local. The release publishes the settings
+            // above to the threads that register.
+            m_generation.store(s_nextGeneration.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_release);
+
+            m_stopFlushing = false;
+            m_flushThread = std::thread([this] { flushLoop(); });
+
+            m_enabled.store(true, std::memory_order_release);
+            return true;
+        }
+
+        void close() {
+            std::unique_lock lock(m_mutex);
+
+            m_enabled.store(false, std::memory_order_relaxed);
+            if (m_flushThread.joinable()) {
+                {
+                    std::unique_lock flushLock(m_flushMutex);
+                    m_stopFlushing = true;
+                }
+                m_flushCondition.notify_one();
+                m_flushThread.join();
+            }
+            if (m_stream.is_open()) {
+                m_stream.close();
+            }
+        }
+
+        bool isEnabled() const {
+            return m_enabled.load(std::memory_order_relaxed);
+        }
+
+        // The number of calls dropped and written so far in the current recording.
+        uint64_t numDropped() const {
+            return m_numDropped.load(std::memory_order_relaxed);
+        }
+
+        // The number of thread buffers allocated since the recorder was created.
+        size_t numThreadBuffers() {
+            std::unique_lock lock(m_buffersMutex);
+            return m_buffers.size();
+        }
+
+        void record(uint16_t id,
+                    const char* name,
+                    int64_t startTicks,
+                    int64_t durationTicks,
+                    XrResult result,
+                    const uint8_t* arguments,
+                    uint16_t argumentsSize) {
+            if (id >= k_maxEntryPoints) {
+                return;
+            }
+
+            ThreadBuffer* const buffer = getThreadBuffer();
+            if (!buffer) {
+                if (isEnabled()) {
+                    m_numUnbufferedDropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                return;
+            }
+
+            // Published to the flush thread by the release of the head below.
+            if (!m_names[id].load(std::memory_order_acquire)) {
+                m_names[id].store(name, std::memory_order_release);
+            }
+
+            CallRecord call{};
+            call.id = id;
+            call.threadId = GetCurrentThreadId();
+            call.startTicks = startTicks;
+            call.durationTicks = (uint32_t)std::min<int64_t>(durationTicks, UINT32_MAX);
+            call.result = result;
+            call.argumentsSize = argumentsSize;
+
+            const uint8_t type = (uint8_t)RecordType::Call;
+            const size_t recordSize = sizeof(type) + sizeof(call) + argumentsSize;
+            const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+            if (head + recordSize - buffer->tail.load(std::memory_order_acquire) > buffer->size) {
+                buffer->numDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            uint64_t position = buffer->write(head, &type, sizeof(type));
+            position = buffer->write(position, &call, sizeof(call));
+            position = buffer->write(position, arguments, argumentsSize);
+            buffer->head.store(position, std::memory_order_release);
+        }
+
+      private:
+        // The calls of one thread, from the thread to the flush thread.
+        struct ThreadBuffer {
+            ThreadBuffer(uint32_t threadId, uint32_t generation, size_t size)
+                : threadId(threadId), generation(generation), size(size), data(std::make_unique<uint8_t[]>(size)) {
+            }
+
+            uint64_t write(uint64_t position, const void* source, size_t count) {
+                const size_t offset = position & (size - 1);
+                const size_t first = std::min(count, size - offset);
+                memcpy(data.get() + offset, source, first);
+                memcpy(data.get(), static_cast<const uint8_t*>(source) + first, count - first);
+                return position + count;
+            }
+
+            uint64_t read(uint64_t position, void* destination, size_t count) const {
+                const size_t offset = position & (size - 1);
+                const size_t first = std::min(count, size - offset);
+                memcpy(destination, data.get() + offset, first);
+                memcpy(static_cast<uint8_t*>(destination) + first, data.get(), count - first);
+                return position + count;
+            }
+
+            const uint32_t threadId;
+            uint32_t generation; // Protected by m_buffersMutex.
+            const size_t size;
+            const std::unique_ptr<uint8_t[]> data;
+
+            alignas(64) std::atomic<uint64_t> head{0}; // Advanced by the recording thread.
+            alignas(64) std::atomic<uint64_t> tail{0}; // Advanced by the flush thread.
+            std::atomic<uint32_t> numDropped{0};
+            uint32_t numDroppedWritten{0}; // Only used by the flush thread.
+        };
+
+        ThreadBuffer* getThreadBuffer() {
+            struct CachedBuffer {
+                uint32_t generation{0};
+                ThreadBuffer* buffer{nullptr};
+            };
+            thread_local CachedBuffer t_cachedBuffer;
+
+            const uint32_t generation = m_generation.load(std::memory_order_acquire);
+            if (t_cachedBuffer.generation == generation) {
+                return t_cachedBuffer.buffer;
+            }
+
+            // First call of this thread in this recording. Another thread may still be writing into its buffer of a
+            // recording that is being closed, so only the thread itself takes its buffer over for the new recording.
+            std::unique_lock lock(m_buffersMutex);
+
+            const uint32_t threadId = GetCurrentThreadId();
+            ThreadBuffer* buffer = nullptr;
+            for (auto& entry : m_buffers) {
+                if (entry->threadId != threadId) {
+                    continue;
+                }
+                if (entry->generation != generation) {
+                    // Not read by the flush thread, which only takes the buffers of the current generation.
+                    if (entry->size != m_threadBufferSize) {
+                        entry = std::make_unique<ThreadBuffer>(threadId, generation, m_threadBufferSize);
+                    }
+                    entry->head.store(0, std::memory_order_relaxed);
+                    entry->tail.store(0, std::memory_order_relaxed);
+                    entry->numDropped.store(0, std::memory_order_relaxed);
+                    entry->numDroppedWritten = 0;
+                    entry->generation = generation;
+                }
+                buffer = entry.get();
+                break;
+            }
+            if (!buffer && m_buffers.size() < k_maxThreadBuffers) {
+                m_buffers.push_back(std::make_unique<ThreadBuffer>(threadId, generation, m_threadBufferSize));
+                buffer = m_buffers.back().get();
+            }
+
+            t_cachedBuffer = {generation, buffer};
+            return buffer;
+        }
+
+        void flushLoop() {
+            std::unique_lock lock(m_flushMutex);
+            while (true) {
+                const bool stop = m_flushCondition.wait_for(lock, m_flushPeriod, [&] { return m_stopFlushing; });
+                flush();
+                if (stop) {
+                    break;
+                }
+            }
+        }
+
+        void flush() {
+            const uint32_t generation = m_generation.load(std::memory_order_relaxed);
+            m_flushedBuffers.clear();
+            {
+                std::unique_lock lock(m_buffersMutex);
+                for (const auto& buffer : m_buffers) {
+                    if (buffer->generation == generation) {
+                        m_flushedBuffers.push_back(buffer.get());
+                    }
+                }
+            }
+
+            uint8_t record[sizeof(RecordType) + sizeof(CallRecord) + k_maxArgumentsSize];
+            for (ThreadBuffer* buffer : m_flushedBuffers) {
+                uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+                const uint64_t head = buffer->head.load(std::memory_order_acquire);
+                while (tail != head) {
+                    CallRecord call;
+                    buffer->read(tail + sizeof(RecordType), &call, sizeof(call));
+                    const size_t recordSize = sizeof(RecordType) + sizeof(call) + call.argumentsSize;
+                    buffer->read(tail, record, recordSize);
+                    tail += recordSize;
+
+                    if (!m_isNameWritten[call.id]) {
+                        writeName(call.id, m_names[call.id].load(std::memory_order_acquire));
+                        m_isNameWritten[call.id] = true;
+                    }
+                    m_stream.write(reinterpret_cast<const char*>(record), recordSize);
+                }
+                buffer->tail.store(tail, std::memory_order_release);
+
+                const uint32_t numDropped = buffer->numDropped.load(std::memory_order_relaxed);
+                if (numDropped != buffer->numDroppedWritten) {
+                    const DroppedRecord dropped{buffer->threadId, numDropped - buffer->numDroppedWritten};
+                    m_stream.put((char)RecordType::Dropped);
+                    m_stream.write(reinterpret_cast<const char*>(&dropped), sizeof(dropped));
+                    buffer->numDroppedWritten = numDropped;
+                    m_numDropped.fetch_add(dropped.count, std::memory_order_relaxed);
+                }
+            }
+
+            const uint64_t numUnbufferedDropped = m_numUnbufferedDropped.load(std::memory_order_relaxed);
+            if (numUnbufferedDropped != m_numUnbufferedDroppedWritten) {
+                const DroppedRecord dropped{0, (uint32_t)(numUnbufferedDropped - m_numUnbufferedDroppedWritten)};
+                m_stream.put((char)RecordType::Dropped);
+                m_stream.write(reinterpret_cast<const char*>(&dropped), sizeof(dropped));
+                m_numUnbufferedDroppedWritten = numUnbufferedDropped;
+                m_numDropped.fetch_add(dropped.count, std::memory_order_relaxed);
+            }
+            m_stream.flush();
+        }
+
+        void writeName(uint16_t id, const char* name) {
+            const uint16_t length = name ? (uint16_t)strlen(name) : 0;
+            m_stream.put((char)RecordType::Name);
+            m_stream.write(reinterpret_cast<const char*>(&id), sizeof(id));
+            m_stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            m_stream.write(name, length);
+        }
+
+        static inline std::atomic<uint32_t> s_nextGeneration{0};
+
+        std::atomic<bool> m_enabled{false};
+        std::mutex m_mutex;
+        std::ofstream m_stream;
+        size_t m_threadBufferSize{k_defaultThreadBufferSize};
+        std::chrono::milliseconds m_flushPeriod{k_defaultFlushPeriod};
+        std::atomic<uint32_t> m_generation{0};
+        std::atomic<const char*> m_names[k_maxEntryPoints]{};
+        std::atomic<uint64_t> m_numDropped{0};
+        std::atomic<uint64_t> m_numUnbufferedDropped{0}; // By the threads beyond k_maxThreadBuffers.
+
+        std::mutex m_buffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+        std::thread m_flushThread;
+        std::mutex m_flushMutex;
+        std::condition_variable m_flushCondition;
+        bool m_stopFlushing{false};
+        std::vector<ThreadBuffer*> m_flushedBuffers;
+        uint64_t m_numUnbufferedDroppedWritten{0};
+        bool m_isNameWritten[k_maxEntryPoints]{};
+    };
+
+    // Reads back a recording made by CallRecorder, for the replay tooling and the tests. A record cut short at the end
+    // of the file, as when reading a recording in progress, is ignored.
+    class CallRecording {
+      public:
+        using ArgumentType = CallRecorder::ArgumentType;
+
+        struct Argument {
+            ArgumentType type;
+            const uint8_t* data;
+            uint16_t size;
+            std::vector<XrStructureType> nextChain; // For Input arguments.
+
+            // The argument as a T, if it was captured (Value, Input or Output) with the size of a T. Pointers in a
+            // structure point into the recorded process and must not be followed.
+            template <typename T>
+            std::optional<T> as() const {
+                if ((type != ArgumentType::Value && type != ArgumentType::Input && type != ArgumentType::Output) ||
+                    size != sizeof(T)) {
+                    return {};
+                }
+                T value;
+                memcpy(&value, data, sizeof(T));
+                return value;
+            }
+
+            std::optional<std::string_view> asString() const {
+                if (type != ArgumentType::String) {
+                    return {};
+                }
+                return std::string_view(reinterpret_cast<const char*>(data), size);
+            }
+        };
+
+        struct Call {
+            uint16_t id;
+            std::string_view name;
+            uint32_t threadId;
+            int64_t startTicks;
+            uint32_t durationTicks;
+            XrResult result;
+            std::vector<Argument> arguments;
+        };
+
+        bool load(const std::filesystem::path& path) {
+            m_calls.clear();
+            m_names.clear();
+            m_numDropped = 0;
+
+            std::ifstream file(path, std::ios_base::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+            m_contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+            size_t offset = 0;
+            if (!read(offset, m_header) || memcmp(m_header.magic, "VDXRCALL", sizeof(m_header.magic)) ||
+                m_header.version != CallRecorder::k_version) {
+                return false;
+            }
+
+            uint8_t type;
+            while (read(offset, type)) {
+                if (type == (uint8_t)CallRecorder::RecordType::Name) {
+                    uint16_t id, length;
+                    if (!read(offset, id) || !read(offset, length) || offset + length > m_contents.size()) {
+                        break;
+                    }
+                    m_names[id].assign(reinterpret_cast<const char*>(m_contents.data() + offset), length);
+                    offset += length;
+                } else if (type == (uint8_t)CallRecorder::RecordType::Call) {
+                    CallRecorder::CallRecord record;
+                    if (!read(offset, record) || offset + record.argumentsSize > m_contents.size()) {
+                        break;
+                    }
+
+                    Call call{record.id,
+                              m_names[record.id],
+                              record.threadId,
+                              record.startTicks,
+                              record.durationTicks,
+                              (XrResult)record.result,
+                              {}};
+                    parseArguments(m_contents.data() + offset, record.argumentsSize, call.arguments);
+                    offset += record.argumentsSize;
+                    m_calls.push_back(std::move(call));
+                } else if (type == (uint8_t)CallRecorder::RecordType::Dropped) {
+                    CallRecorder::DroppedRecord dropped;
+                    if (!read(offset, dropped)) {
+                        break;
+                    }
+                    m_numDropped += dropped.count;
+                } else {
+                    return false;
+                }
+            }
+
+            std::stable_sort(m_calls.begin(), m_calls.end(), [](const Call& a, const Call& b) {
+                return a.startTicks < b.startTicks;
+            });
+            return true;
+        }
+
+        const CallRecorder::FileHeader& header() const {
+            return m_header;
+        }
+
+        // Sorted by start time.
+        const std::vector<Call>& calls() const {
+            return m_calls;
+        }
+
+        uint64_t numDropped() const {
+            return m_numDropped;
+        }
+
+      private:
+        template <typename T>
+        bool read(size_t& offset, T& value) const {
+            if (offset + sizeof(T) > m_contents.size()) {
+                return false;
+            }
+            memcpy(&value, m_contents.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        static void parseArguments(const uint8_t* data, size_t size, std::vector<Argument>& arguments) {
+            size_t offset = 0;
+            while (offset + sizeof(ArgumentType) + sizeof(uint16_t) <= size) {
+                const ArgumentType type = (ArgumentType)data[offset];
+                uint16_t fieldSize;
+                memcpy(&fieldSize, data + offset + sizeof(type), sizeof(fieldSize));
+                offset += sizeof(type) + sizeof(fieldSize);
+                if (offset + fieldSize > size) {
+                    break;
+                }
+
+                if (type == ArgumentType::Next) {
+                    if (!arguments.empty() && fieldSize == sizeof(XrStructureType)) {
+                        XrStructureType next;
+                        memcpy(&next, data + offset, sizeof(next));
+                        arguments.back().nextChain.push_back(next);
+                    }
+                } else {
+                    arguments.push_back({type, data + offset, fieldSize, {}});
+                }
+                offset += fieldSize;
+            }
+        }
+
+        std::vector<uint8_t> m_contents;
+        CallRecorder::FileHeader m_header{};
+        std::map<uint16_t, std::string> m_names;
+        std::vector<Call> m_calls;
+        uint64_t m_numDropped{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
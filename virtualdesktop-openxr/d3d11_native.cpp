@@ -446,21 +446,32 @@ namespace virtualdesktop_openxr {
         return XR_SUCCESS;
     }
 
-    // Prepare an OVR swapchain to be used by OVR.
-    void OpenXrRuntime::prepareAndCommitSwapchainImage(Swapchain& xrSwapchain,
-                                                       uint32_t layerIndex,
-                                                       uint32_t slice,
-                                                       XrCompositionLayerFlags compositionFlags,
-                                                       std::set<std::pair<ovrTextureSwapChain, uint32_t>>& committed) {
-        // If the texture was never used or already committed, do nothing.
-        if (xrSwapchain.slices[0].empty() || committed.count(std::make_pair(xrSwapchain.ovrSwapchain[0], slice))) {
+    // Prepare an OVR swapchain to be used by OVR. The commit is only recorded: it happens when the frame is submitted.
+    void OpenXrRuntime::prepareSwapchainImage(Swapchain& xrSwapchain,
+                                              uint32_t layerIndex,
+                                              uint32_t slice,
+                                              XrCompositionLayerFlags compositionFlags,
+                                              CommittedSwapchainImages& committed) {
+        // If the texture was never used, do nothing.
+        if (xrSwapchain.slices[0].empty()) {
             return;
         }
 
         ensureSwapchainSliceResources(xrSwapchain, slice);
 
-        int ovrDestIndex = -1;
-        CHECK_OVRCMD(ovr_GetTextureSwapChainCurrentIndex(m_ovrSession, xrSwapchain.ovrSwapchain[slice], &ovrDestIndex));
+        // If the texture was already committed with this frame, do nothing.
+        if (committed.contains(std::make_pair(&xrSwapchain, slice))) {
+            return;
+        }
+
+        // The commits of the frames still in the submission queue have not reached OVR yet, so we follow the index
+        // ourselves once we know it.
+        int& nextCommitIndex = xrSwapchain.nextCommitIndex[slice];
+        if (nextCommitIndex < 0) {
+            CHECK_OVRCMD(
+                ovr_GetTextureSwapChainCurrentIndex(m_ovrSession, xrSwapchain.ovrSwapchain[slice], &nextCommitIndex));
+        }
+        const int ovrDestIndex = nextCommitIndex;
         const int lastReleasedIndex = xrSwapchain.lastReleasedIndex;
 
         const bool needClearAlpha =
@@ -616,9 +627,9 @@ namespace virtualdesktop_openxr {
 
         xrSwapchain.lastProcessedIndex[slice] = lastReleasedIndex;
 
-        // Commit the texture to OVR.
-        CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.ovrSwapchain[slice]));
-        committed.insert(std::make_pair(xrSwapchain.ovrSwapchain[0], slice));
+        // Record the commit of the texture to OVR, which advances the current index.
+        committed.push_back(std::make_pair(&xrSwapchain, slice));
+        nextCommitIndex = (ovrDestIndex + 1) % (int)xrSwapchain.slices[slice].size();
     }
 
     void OpenXrRuntime::ensureSwapchainSliceResources(Swapchain& xrSwapchain, uint32_t slice) const {
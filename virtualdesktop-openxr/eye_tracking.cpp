@@ -84,10 +84,10 @@ namespace virtualdesktop_openxr {
                                   leftEyePose.orientation.w},
                     XrVector3f{leftEyePose.position.x, leftEyePose.position.y, leftEyePose.position.z})};
 
-            TraceLoggingWrite(g_traceProvider,
-                              "VirtualDesktopEyeTracker",
-                              TLArg(xr::ToString(eyeGaze[xr::StereoView::Left]).c_str(), "LeftGazePose"),
-                              TLArg(xr::ToString(eyeGaze[xr::StereoView::Right]).c_str(), "RightGazePose"));
+            TraceLoggingWriteIfEnabled(g_traceProvider,
+                                       "VirtualDesktopEyeTracker",
+                                       TLArg(ToTraceString(eyeGaze[xr::StereoView::Left]).c_str(), "LeftGazePose"),
+                                       TLArg(ToTraceString(eyeGaze[xr::StereoView::Right]).c_str(), "RightGazePose"));
 
             // Average the poses from both eyes.
             const auto gaze = xr::math::LoadXrPose(
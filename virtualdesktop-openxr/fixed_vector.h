@@ -0,0 +1,92 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // A vector with inline storage for up to Capacity elements, for containers that live on the frame submission path
+    // and whose size is bounded by the runtime limits (such as ovrMaxLayerCount). It never allocates.
+    // Elements must be default-constructible: the storage is a plain array, and clear() only resets the size.
+    template <typename T, size_t Capacity>
+    class FixedVector {
+      public:
+        void push_back(const T& value) {
+            if (m_size == Capacity) {
+                throw std::length_error("FixedVector capacity exceeded");
+            }
+            m_items[m_size++] = value;
+        }
+
+        void clear() {
+            m_size = 0;
+        }
+
+        bool contains(const T& value) const {
+            return std::find(begin(), end(), value) != end();
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        T* data() {
+            return m_items;
+        }
+
+        const T* data() const {
+            return m_items;
+        }
+
+        T& operator[](size_t index) {
+            return m_items[index];
+        }
+
+        const T& operator[](size_t index) const {
+            return m_items[index];
+        }
+
+        T* begin() {
+            return m_items;
+        }
+
+        T* end() {
+            return m_items + m_size;
+        }
+
+        const T* begin() const {
+            return m_items;
+        }
+
+        const T* end() const {
+            return m_items + m_size;
+        }
+
+      private:
+        T m_items[Capacity]{};
+        size_t m_size{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -73,14 +73,14 @@ namespace virtualdesktop_openxr {
         // Critical section.
         {
             CpuTimer waitTimer;
-            if (IsTraceEnabled()) {
-                waitTimer.start();
-            }
+            waitTimer.start();
 
             std::unique_lock lock(m_frameMutex);
 
             m_frameTimerApp.stop();
             m_lastCpuFrameTimeUs = m_frameTimerApp.query();
+            m_runningStart.setBounds(m_runningStartMinOffset, m_runningStartMaxOffset);
+            m_runningStart.onAppCpuTime(m_lastCpuFrameTimeUs / 1e6);
 
             TraceLoggingWrite(g_traceProvider,
                               "App_Statistics",
@@ -121,7 +121,8 @@ namespace virtualdesktop_openxr {
             }
 
             if (m_needStartAsyncSubmissionThread) {
-                m_terminateAsyncThread = false;
+                m_asyncSubmissionRing.reset();
+                m_numPublishedFrames = 0;
                 m_asyncSubmissionThread = std::thread([&]() { asyncSubmissionThread(); });
                 m_needStartAsyncSubmissionThread = false;
             }
@@ -140,29 +141,50 @@ namespace virtualdesktop_openxr {
                 TraceLoggingWrite(g_traceProvider, "AcquiredFrame", TLArg(ovrFrameId, "FrameId"));
             }
 
-            if (IsTraceEnabled()) {
-                waitTimer.stop();
-            }
+            waitTimer.stop();
+            const uint64_t waitDurationUs = waitTimer.query();
+            m_currentFrameRecord.set(FrameMetric::WaitFrame, waitDurationUs);
+
+            // Predictions made during the previous frame are now outdated.
+            invalidateDevicePoseCache();
 
             const double now = ovr_GetTimeInSeconds();
+            m_currentFrameRecord.waitFrameTime = now;
+
             double predictedDisplayTime = ovr_GetPredictedDisplayTime(m_ovrSession, ovrFrameId);
             TraceLoggingWrite(g_traceProvider,
                               "WaitFrame",
                               TLArg(now, "Now"),
                               TLArg(predictedDisplayTime, "PredictedDisplayTime"),
                               TLArg(predictedDisplayTime - now, "PhotonTime"),
-                              TLArg(waitTimer.query(), "WaitDurationUs"));
+                              TLArg(waitDurationUs, "WaitDurationUs"));
 
             // Setup the app frame for use and the next frame for this call.
             frameState->predictedDisplayTime = ovrTimeToXrTime(predictedDisplayTime);
 
-            // Workaround: during early calls, OVR times might violate OpenXR rules.
+            // Frames queued ahead of the submission thread reach the display later than the frame being paced by OVR.
+            // Keep the predictions one period apart, without running further ahead than the depth of the queue.
+            if (m_useAsyncSubmission && m_asyncSubmissionDepth > 1 && m_lastPredictedDisplayTime) {
+                const XrTime period = ovrTimeToXrTime(m_predictedFrameDuration);
+                frameState->predictedDisplayTime =
+                    std::clamp(m_lastPredictedDisplayTime + period,
+                               frameState->predictedDisplayTime,
+                               frameState->predictedDisplayTime + (m_asyncSubmissionDepth - 1) * period);
+            }
+
+            // Workaround: during early calls or after a stall, OVR might return a stale prediction that violates OpenXR
+            // rules. Extrapolate from our last prediction instead.
             if (frameState->predictedDisplayTime <= m_lastPredictedDisplayTime) {
-                frameState->predictedDisplayTime = m_lastPredictedDisplayTime + 1;
+                frameState->predictedDisplayTime =
+                    m_lastPredictedDisplayTime + ovrTimeToXrTime(m_predictedFrameDuration);
+                TraceLoggingWrite(g_traceProvider,
+                                  "WaitFrame_StalePrediction",
+                                  TLArg(predictedDisplayTime, "PredictedDisplayTime"),
+                                  TLArg(frameState->predictedDisplayTime, "ExtrapolatedDisplayTime"));
             }
             m_lastPredictedDisplayTime = frameState->predictedDisplayTime;
 
-            // We always use the native frame duration, regardless of Smart Smoothing.
+            // The period reflects ASW only once it has settled, see FramePeriodEstimator.
             frameState->predictedDisplayPeriod = ovrTimeToXrTime(m_predictedFrameDuration);
 
             m_frameTimerApp.start();
@@ -206,9 +228,7 @@ namespace virtualdesktop_openxr {
         // Critical section.
         {
             CpuTimer waitTimer;
-            if (IsTraceEnabled()) {
-                waitTimer.start();
-            }
+            waitTimer.start();
 
             std::unique_lock lock(m_frameMutex);
 
@@ -247,19 +267,24 @@ namespace virtualdesktop_openxr {
             // Therefore, we always advance m_frameBegun even upon discard.
             m_frameBegun = m_frameWaited;
 
-            if (IsTraceEnabled()) {
-                waitTimer.stop();
-            }
+            waitTimer.stop();
+            const uint64_t waitDurationUs = waitTimer.query();
+            m_currentFrameRecord.set(FrameMetric::BeginFrame, waitDurationUs);
+            m_currentFrameRecord.beginFrameTime = ovr_GetTimeInSeconds();
+            m_currentFrameRecord.discarded = m_currentFrameRecord.discarded || frameDiscarded;
 
             TraceLoggingWrite(g_traceProvider,
                               "BeginFrame",
                               TLArg(frameDiscarded, "FrameDiscarded"),
-                              TLArg(waitTimer.query(), "WaitDurationUs"));
+                              TLArg(waitDurationUs, "WaitDurationUs"));
 
             // Statistics for the previous frame.
             // Our principle is to always query() a timer before we start() it. This means that we get measurements
             // with k_numGpuTimers frames latency.
             m_lastGpuFrameTimeUs = m_gpuTimerApp[m_currentTimerIndex] ? m_gpuTimerApp[m_currentTimerIndex]->query() : 0;
+            if (m_gpuTimerApp[m_currentTimerIndex] && m_frameCompleted >= k_numGpuTimers) {
+                m_currentFrameRecord.set(FrameMetric::AppGpu, m_lastGpuFrameTimeUs);
+            }
 
             TraceLoggingWrite(g_traceProvider,
                               "App_Statistics",
@@ -287,19 +312,23 @@ namespace virtualdesktop_openxr {
                               TLArg(m_frameCompleted, "FrameCompleted"));
             m_frameCondVar.notify_all();
 
-            bool isAsyncReprojectionActive = false;
             ovrPerfStats stats{};
             if (OVR_SUCCESS(ovr_GetPerfStats(m_ovrSession, &stats))) {
-                isAsyncReprojectionActive = stats.FrameStatsCount > 0 && stats.FrameStats[0].AswIsActive;
-                TraceLoggingWrite(
-                    g_traceProvider, "OVR_AswStatus", TLArg(isAsyncReprojectionActive, "AsyncReprojectionActive"));
+                // The most recent statistics come first.
+                for (int i = stats.FrameStatsCount - 1; i >= 0; i--) {
+                    m_framePeriodEstimator.addSample(stats.FrameStats[i].AppFrameIndex,
+                                                     stats.FrameStats[i].HmdVsyncIndex,
+                                                     stats.FrameStats[i].AswIsActive);
+                }
+                TraceLoggingWrite(g_traceProvider,
+                                  "OVR_AswStatus",
+                                  TLArg(stats.FrameStatsCount > 0 && stats.FrameStats[0].AswIsActive,
+                                        "AsyncReprojectionActive"),
+                                  TLArg(m_framePeriodEstimator.isAswEngaged(), "AsyncReprojectionEngaged"),
+                                  TLArg(m_framePeriodEstimator.measuredPeriod() * 1e6, "MeasuredPeriodUs"));
             }
 
-            if (isAsyncReprojectionActive) {
-                m_predictedFrameDuration = m_idealFrameDuration * 2.f;
-            } else {
-                m_predictedFrameDuration = m_idealFrameDuration;
-            }
+            m_predictedFrameDuration = m_framePeriodEstimator.period();
         }
 
         return !frameDiscarded ? XR_SUCCESS : XR_FRAME_DISCARDED;
@@ -337,6 +366,8 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_LAYER_LIMIT_EXCEEDED;
         }
 
+        const double endFrameTime = ovr_GetTimeInSeconds();
+
         // Critical section.
         {
             std::unique_lock lock1(m_swapchainsMutex);
@@ -346,17 +377,44 @@ namespace virtualdesktop_openxr {
                 return XR_ERROR_CALL_ORDER_INVALID;
             }
 
+            CpuTimer submitTimer;
+            submitTimer.start();
+
             m_renderTimerApp.stop();
+            m_currentFrameRecord.set(FrameMetric::AppCpu, m_renderTimerApp.query(false));
             if (m_gpuTimerApp[m_currentTimerIndex]) {
                 m_gpuTimerApp[m_currentTimerIndex]->stop();
             }
 
-            // Make sure the previous frame finished submission.
+            // How old were the poses submitted by the app.
+            m_currentFrameRecord.endFrameTime = endFrameTime;
+            m_currentFrameRecord.displayTime = xrTimeToOvrTime(frameEndInfo->displayTime);
+            m_currentFrameRecord.viewsLocateTime = getViewsLocateTime(frameEndInfo->displayTime);
+            if (m_currentFrameRecord.viewsLocateTime) {
+                const double poseAge = endFrameTime - m_currentFrameRecord.viewsLocateTime;
+                const double horizon = m_currentFrameRecord.displayTime - m_currentFrameRecord.viewsLocateTime;
+                m_currentFrameRecord.set(FrameMetric::PoseAge, (uint64_t)(std::max(poseAge, 0.0) * 1e6));
+                m_currentFrameRecord.set(FrameMetric::PredictionHorizon, (uint64_t)(std::max(horizon, 0.0) * 1e6));
+            }
+
+            // Make sure there is room in the submission queue. The frames still queued hold their own layers and
+            // swapchain commits, so we do not need to wait for them to be submitted.
+            std::unique_lock submissionLock(m_submissionContextMutex, std::defer_lock);
             if (m_useAsyncSubmission) {
                 waitForAsyncSubmissionIdle();
 
-                // From this point, we know that the asynchronous thread is waiting, and we may use the submission
-                // context.
+                // The frame must reach the submission thread before the next frame boundary. With a deeper queue,
+                // the last boundary belongs to an older queued frame and not to this one, so there is nothing to
+                // measure.
+                if (m_asyncSubmissionDepth == 1) {
+                    const std::chrono::duration<double> slack =
+                        m_lastWaitToBeginFrameTime.load() + std::chrono::duration<double>(m_predictedFrameDuration) -
+                        std::chrono::high_resolution_clock::now();
+                    m_runningStart.onFrameSubmitted(slack.count());
+                }
+
+                // From this point, the asynchronous thread may only use the submission context in between our uses.
+                submissionLock.lock();
             }
 
             // Serializes the app work between D3D12/Vulkan and D3D11.
@@ -379,301 +437,360 @@ namespace virtualdesktop_openxr {
             });
 
             const auto lastPrecompositionTime = m_gpuTimerPrecomposition[m_currentTimerIndex]->query();
-            if (IsTraceEnabled()) {
-                m_gpuTimerPrecomposition[m_currentTimerIndex]->start();
+            if (m_frameCompleted >= k_numGpuTimers) {
+                m_currentFrameRecord.set(FrameMetric::PrecompositionGpu, lastPrecompositionTime);
             }
-
-            std::set<std::pair<ovrTextureSwapChain, uint32_t>> committedSwapchainImages;
+            m_gpuTimerPrecomposition[m_currentTimerIndex]->start();
 
             bool isProj0SRGB = false;
             bool isFirstProjectionLayer = true;
 
-            // Construct the list of layers.
-            std::vector<ovrLayer_Union> layersAllocator;
-            layersAllocator.reserve(frameEndInfo->layerCount + 1);
-            for (uint32_t i = 0; i < frameEndInfo->layerCount; i++) {
-                if (!frameEndInfo->layers[i]) {
-                    return XR_ERROR_LAYER_INVALID;
+            // The layer spaces cannot change while we are using them.
+            std::shared_lock lock3(m_actionsAndSpacesMutex);
+
+            // Construct the list of layers. They are written in place into the next slot for the asynchronous
+            // submission thread. When not using asynchronous submission, the slot is simply never published.
+            AsyncSubmissionSlot& frameLayers = m_asyncSubmissionRing.producerSlot();
+            if (m_useAsyncSubmission && frameLayers.hasRecord) {
+                // The frame that last used this slot was submitted, and its statistics are complete. Slots that were
+                // not used since the submission thread was started hold a frame of a previous session.
+                if (m_numPublishedFrames >= k_numAsyncSubmissionSlots) {
+                    recordFrameStatistics(frameLayers.record);
                 }
-
-                std::unique_lock lock3(m_actionsAndSpacesMutex);
-
-                if (!m_spaces.count(frameEndInfo->layers[i]->space)) {
-                    return XR_ERROR_HANDLE_INVALID;
+                frameLayers.hasRecord = false;
+            }
+            frameLayers.layerCount = 0;
+            frameLayers.committedSwapchainImages.clear();
+
+            // If the frame is not submitted, the swapchain images it prepared were never committed.
+            bool isSubmitted = false;
+            auto discardGuard = MakeScopeGuard([&] {
+                if (!isSubmitted) {
+                    discardSwapchainImages(frameLayers.committedSwapchainImages);
                 }
+            });
 
-                layersAllocator.push_back({});
-                auto* layer = &layersAllocator.back();
-                layer->Header.Flags = 0;
-
-                // OpenGL needs to flip the texture vertically, which OVR can conveniently do for us.
-                if (isOpenGLSession()) {
-                    layer->Header.Flags = ovrLayerFlag_TextureOriginAtBottomLeft;
+            // Reuse the translation of the previous frame when the topology of the layers did not change.
+            LayerTranslationCache& cache = m_layerTranslationCache;
+            LayerTopology topology[ovrMaxLayerCount];
+            const auto translationStart = std::chrono::high_resolution_clock::now();
+            const bool isCacheHit = getLayerTopology(*frameEndInfo, topology) && cache.isValid &&
+                                    cache.generation == m_layerTopologyGeneration &&
+                                    cache.layerCount == frameEndInfo->layerCount &&
+                                    !memcmp(cache.topology, topology, cache.layerCount * sizeof(LayerTopology));
+            if (isCacheHit) {
+                const XrResult result = patchCachedLayers(*frameEndInfo, frameLayers);
+                if (XR_FAILED(result)) {
+                    return result;
                 }
+                isProj0SRGB = cache.isProj0SRGB;
+            } else {
+                cache.isValid = false;
+                for (uint32_t i = 0; i < frameEndInfo->layerCount; i++) {
+                    if (!frameEndInfo->layers[i]) {
+                        return XR_ERROR_LAYER_INVALID;
+                    }
 
-                if (frameEndInfo->layers[i]->type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
-                    const XrCompositionLayerProjection* proj =
-                        reinterpret_cast<const XrCompositionLayerProjection*>(frameEndInfo->layers[i]);
-
-                    TraceLoggingWrite(g_traceProvider,
-                                      "xrEndFrame_Layer",
-                                      TLArg("Proj", "Type"),
-                                      TLArg(proj->layerFlags, "Flags"),
-                                      TLXArg(proj->space, "Space"));
-
-                    if (proj->viewCount != xr::StereoView::Count) {
-                        return XR_ERROR_VALIDATION_FAILURE;
+                    const Space* const xrLayerSpace = m_spaces.get(frameEndInfo->layers[i]->space);
+                    if (!xrLayerSpace) {
+                        return XR_ERROR_HANDLE_INVALID;
                     }
 
-                    // Make sure that we can use the EyeFov part of EyeFovDepth equivalently.
-                    static_assert(offsetof(decltype(layer->EyeFov), ColorTexture) ==
-                                  offsetof(decltype(layer->EyeFovDepth), ColorTexture));
-                    static_assert(offsetof(decltype(layer->EyeFov), Viewport) ==
-                                  offsetof(decltype(layer->EyeFovDepth), Viewport));
-                    static_assert(offsetof(decltype(layer->EyeFov), Fov) ==
-                                  offsetof(decltype(layer->EyeFovDepth), Fov));
-                    static_assert(offsetof(decltype(layer->EyeFov), RenderPose) ==
-                                  offsetof(decltype(layer->EyeFovDepth), RenderPose));
-                    static_assert(offsetof(decltype(layer->EyeFov), SensorSampleTime) ==
-                                  offsetof(decltype(layer->EyeFovDepth), SensorSampleTime));
-
-                    // Start without depth. We might change the type to ovrLayerType_EyeFovDepth further below.
-                    layer->Header.Type = ovrLayerType_EyeFov;
-
-                    for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
-                        TraceLoggingWrite(
-                            g_traceProvider,
-                            "xrEndFrame_View",
-                            TLArg("Proj", "Type"),
-                            TLArg(viewIndex, "ViewIndex"),
-                            TLXArg(proj->views[viewIndex].subImage.swapchain, "Swapchain"),
-                            TLArg(proj->views[viewIndex].subImage.imageArrayIndex, "ImageArrayIndex"),
-                            TLArg(xr::ToString(proj->views[viewIndex].subImage.imageRect).c_str(), "ImageRect"),
-                            TLArg(xr::ToString(proj->views[viewIndex].pose).c_str(), "Pose"),
-                            TLArg(xr::ToString(proj->views[viewIndex].fov).c_str(), "Fov"));
-
-                        if (!Quaternion::IsNormalized(proj->views[viewIndex].pose.orientation)) {
-                            return XR_ERROR_POSE_INVALID;
-                        }
+                    auto* layer = &frameLayers.layers[frameLayers.layerCount++];
+                    *layer = {};
+                    layer->Header.Flags = 0;
 
-                        if (!m_swapchains.count(proj->views[viewIndex].subImage.swapchain)) {
-                            return XR_ERROR_HANDLE_INVALID;
-                        }
+                    LayerTranslationCache::Sources& sources = cache.sources[i];
+                    sources = {};
+                    sources.space = xrLayerSpace;
+
+                    // OpenGL needs to flip the texture vertically, which OVR can conveniently do for us.
+                    if (isOpenGLSession()) {
+                        layer->Header.Flags = ovrLayerFlag_TextureOriginAtBottomLeft;
+                    }
 
-                        Swapchain& xrSwapchain = *(Swapchain*)proj->views[viewIndex].subImage.swapchain;
+                    if (frameEndInfo->layers[i]->type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
+                        const XrCompositionLayerProjection* proj =
+                            reinterpret_cast<const XrCompositionLayerProjection*>(frameEndInfo->layers[i]);
 
-                        if (xrSwapchain.lastReleasedIndex == -1) {
-                            return XR_ERROR_LAYER_INVALID;
-                        }
+                        TraceLoggingWrite(g_traceProvider,
+                                          "xrEndFrame_Layer",
+                                          TLArg("Proj", "Type"),
+                                          TLArg(proj->layerFlags, "Flags"),
+                                          TLXArg(proj->space, "Space"));
 
-                        if (proj->views[viewIndex].subImage.imageArrayIndex >= xrSwapchain.xrDesc.arraySize) {
+                        if (proj->viewCount != xr::StereoView::Count) {
                             return XR_ERROR_VALIDATION_FAILURE;
                         }
 
-                        if (isFirstProjectionLayer) {
-                            isProj0SRGB = isSRGBFormat(xrSwapchain.dxgiFormatForSubmission);
-                        }
-
-                        // Fill out color buffer information.
-                        prepareAndCommitSwapchainImage(xrSwapchain,
-                                                       i,
-                                                       proj->views[viewIndex].subImage.imageArrayIndex,
-                                                       frameEndInfo->layers[i]->layerFlags,
-                                                       committedSwapchainImages);
-                        layer->EyeFov.ColorTexture[viewIndex] =
-                            xrSwapchain.ovrSwapchain[proj->views[viewIndex].subImage.imageArrayIndex];
-
-                        if (!isValidSwapchainRect(xrSwapchain.ovrDesc, proj->views[viewIndex].subImage.imageRect)) {
-                            return XR_ERROR_SWAPCHAIN_RECT_INVALID;
-                        }
-                        layer->EyeFov.Viewport[viewIndex].Pos.x = proj->views[viewIndex].subImage.imageRect.offset.x;
-                        layer->EyeFov.Viewport[viewIndex].Pos.y = proj->views[viewIndex].subImage.imageRect.offset.y;
-                        layer->EyeFov.Viewport[viewIndex].Size.w =
-                            proj->views[viewIndex].subImage.imageRect.extent.width;
-                        layer->EyeFov.Viewport[viewIndex].Size.h =
-                            proj->views[viewIndex].subImage.imageRect.extent.height;
-
-                        // Fill out pose and FOV information.
-                        XrPosef layerPose;
-                        locateSpace(*(Space*)proj->space, *m_originSpace, frameEndInfo->displayTime, layerPose);
-                        layer->EyeFov.RenderPose[viewIndex] =
-                            xrPoseToOvrPose(Pose::Multiply(proj->views[viewIndex].pose, layerPose));
-
-                        XrFovf fov = proj->views[viewIndex].fov;
-                        layer->EyeFov.Fov[viewIndex].DownTan = -tan(fov.angleDown);
-                        layer->EyeFov.Fov[viewIndex].UpTan = tan(fov.angleUp);
-                        layer->EyeFov.Fov[viewIndex].LeftTan = -tan(fov.angleLeft);
-                        layer->EyeFov.Fov[viewIndex].RightTan = tan(fov.angleRight);
-
-                        // In the case of OpenXR, we expect the app to use the predictedDisplayTime to query the
-                        // head pose, and pass that same time as displayTime.
-                        layer->EyeFov.SensorSampleTime = xrTimeToOvrTime(frameEndInfo->displayTime);
-
-                        // Submit depth.
-                        if (has_XR_KHR_composition_layer_depth) {
-                            const XrBaseInStructure* entry =
-                                reinterpret_cast<const XrBaseInStructure*>(proj->views[viewIndex].next);
-                            while (entry) {
-                                if (entry->type == XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR) {
-                                    const XrCompositionLayerDepthInfoKHR* depth =
-                                        reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(entry);
-
-                                    layer->Header.Type = ovrLayerType_EyeFovDepth;
-
-                                    TraceLoggingWrite(
-                                        g_traceProvider,
-                                        "xrEndFrame_View",
-                                        TLArg("Depth", "Type"),
-                                        TLArg(viewIndex, "ViewIndex"),
-                                        TLXArg(depth->subImage.swapchain, "Swapchain"),
-                                        TLArg(depth->subImage.imageArrayIndex, "ImageArrayIndex"),
-                                        TLArg(xr::ToString(depth->subImage.imageRect).c_str(), "ImageRect"),
-                                        TLArg(depth->nearZ, "Near"),
-                                        TLArg(depth->farZ, "Far"),
-                                        TLArg(depth->minDepth, "MinDepth"),
-                                        TLArg(depth->maxDepth, "MaxDepth"));
-
-                                    if (!m_swapchains.count(depth->subImage.swapchain)) {
-                                        return XR_ERROR_HANDLE_INVALID;
-                                    }
+                        // Make sure that we can use the EyeFov part of EyeFovDepth equivalently.
+                        static_assert(offsetof(decltype(layer->EyeFov), ColorTexture) ==
+                                      offsetof(decltype(layer->EyeFovDepth), ColorTexture));
+                        static_assert(offsetof(decltype(layer->EyeFov), Viewport) ==
+                                      offsetof(decltype(layer->EyeFovDepth), Viewport));
+                        static_assert(offsetof(decltype(layer->EyeFov), Fov) ==
+                                      offsetof(decltype(layer->EyeFovDepth), Fov));
+                        static_assert(offsetof(decltype(layer->EyeFov), RenderPose) ==
+                                      offsetof(decltype(layer->EyeFovDepth), RenderPose));
+                        static_assert(offsetof(decltype(layer->EyeFov), SensorSampleTime) ==
+                                      offsetof(decltype(layer->EyeFovDepth), SensorSampleTime));
+
+                        // Start without depth. We might change the type to ovrLayerType_EyeFovDepth further below.
+                        layer->Header.Type = ovrLayerType_EyeFov;
+
+                        for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
+                            TraceLoggingWriteIfEnabled(
+                                g_traceProvider,
+                                "xrEndFrame_View",
+                                TLArg("Proj", "Type"),
+                                TLArg(viewIndex, "ViewIndex"),
+                                TLXArg(proj->views[viewIndex].subImage.swapchain, "Swapchain"),
+                                TLArg(proj->views[viewIndex].subImage.imageArrayIndex, "ImageArrayIndex"),
+                                TLArg(ToTraceString(proj->views[viewIndex].subImage.imageRect).c_str(), "ImageRect"),
+                                TLArg(ToTraceString(proj->views[viewIndex].pose).c_str(), "Pose"),
+                                TLArg(ToTraceString(proj->views[viewIndex].fov).c_str(), "Fov"));
+
+                            if (!Quaternion::IsNormalized(proj->views[viewIndex].pose.orientation)) {
+                                return XR_ERROR_POSE_INVALID;
+                            }
 
-                                    Swapchain& xrDepthSwapchain = *(Swapchain*)depth->subImage.swapchain;
+                            Swapchain* const xrSwapchainPtr =
+                                m_swapchains.get(proj->views[viewIndex].subImage.swapchain);
+                            if (!xrSwapchainPtr) {
+                                return XR_ERROR_HANDLE_INVALID;
+                            }
 
-                                    if (xrDepthSwapchain.lastReleasedIndex == -1) {
-                                        return XR_ERROR_LAYER_INVALID;
-                                    }
+                            Swapchain& xrSwapchain = *xrSwapchainPtr;
+                            sources.swapchain[viewIndex] = xrSwapchainPtr;
 
-                                    if (depth->subImage.imageArrayIndex >= xrDepthSwapchain.xrDesc.arraySize) {
-                                        return XR_ERROR_VALIDATION_FAILURE;
-                                    }
+                            if (xrSwapchain.lastReleasedIndex == -1) {
+                                return XR_ERROR_LAYER_INVALID;
+                            }
 
-                                    // Fill out depth buffer information.
-                                    prepareAndCommitSwapchainImage(xrDepthSwapchain,
-                                                                   i,
-                                                                   depth->subImage.imageArrayIndex,
-                                                                   0,
-                                                                   committedSwapchainImages);
-                                    layer->EyeFovDepth.DepthTexture[viewIndex] =
-                                        xrDepthSwapchain.ovrSwapchain[depth->subImage.imageArrayIndex];
-
-                                    if (!isValidSwapchainRect(xrDepthSwapchain.ovrDesc, depth->subImage.imageRect)) {
-                                        return XR_ERROR_SWAPCHAIN_RECT_INVALID;
-                                    }
+                            if (proj->views[viewIndex].subImage.imageArrayIndex >= xrSwapchain.xrDesc.arraySize) {
+                                return XR_ERROR_VALIDATION_FAILURE;
+                            }
 
-                                    // Fill out projection information.
-                                    layer->EyeFovDepth.ProjectionDesc.Projection22 =
-                                        depth->farZ / (depth->nearZ - depth->farZ);
-                                    layer->EyeFovDepth.ProjectionDesc.Projection23 =
-                                        (depth->farZ * depth->nearZ) / (depth->nearZ - depth->farZ);
-                                    layer->EyeFovDepth.ProjectionDesc.Projection32 = -1.f;
+                            if (isFirstProjectionLayer) {
+                                isProj0SRGB = isSRGBFormat(xrSwapchain.dxgiFormatForSubmission);
+                            }
 
-                                    break;
+                            // Fill out color buffer information.
+                            prepareSwapchainImage(xrSwapchain,
+                                                  i,
+                                                  proj->views[viewIndex].subImage.imageArrayIndex,
+                                                  frameEndInfo->layers[i]->layerFlags,
+                                                  frameLayers.committedSwapchainImages);
+                            layer->EyeFov.ColorTexture[viewIndex] =
+                                xrSwapchain.ovrSwapchain[proj->views[viewIndex].subImage.imageArrayIndex];
+
+                            const XrRect2Di& imageRect = proj->views[viewIndex].subImage.imageRect;
+                            if (!isValidSwapchainRect(xrSwapchain.ovrDesc, imageRect)) {
+                                return XR_ERROR_SWAPCHAIN_RECT_INVALID;
+                            }
+                            layer->EyeFov.Viewport[viewIndex].Pos.x = imageRect.offset.x;
+                            layer->EyeFov.Viewport[viewIndex].Pos.y = imageRect.offset.y;
+                            layer->EyeFov.Viewport[viewIndex].Size.w = imageRect.extent.width;
+                            layer->EyeFov.Viewport[viewIndex].Size.h = imageRect.extent.height;
+
+                            // Fill out pose and FOV information.
+                            XrPosef layerPose;
+                            locateSpace(*xrLayerSpace, *m_originSpace, frameEndInfo->displayTime, layerPose);
+                            layer->EyeFov.RenderPose[viewIndex] =
+                                xrPoseToOvrPose(Pose::Multiply(proj->views[viewIndex].pose, layerPose));
+
+                            sources.fov[viewIndex] = proj->views[viewIndex].fov;
+                            layer->EyeFov.Fov[viewIndex] = xrFovToOvrFovPort(sources.fov[viewIndex]);
+
+                            // In the case of OpenXR, we expect the app to use the predictedDisplayTime to query the
+                            // head pose, and pass that same time as displayTime.
+                            layer->EyeFov.SensorSampleTime = xrTimeToOvrTime(frameEndInfo->displayTime);
+
+                            // Submit depth.
+                            if (has_XR_KHR_composition_layer_depth) {
+                                const XrBaseInStructure* entry =
+                                    reinterpret_cast<const XrBaseInStructure*>(proj->views[viewIndex].next);
+                                while (entry) {
+                                    if (entry->type == XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR) {
+                                        const XrCompositionLayerDepthInfoKHR* depth =
+                                            reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(entry);
+
+                                        layer->Header.Type = ovrLayerType_EyeFovDepth;
+
+                                        TraceLoggingWriteIfEnabled(
+                                            g_traceProvider,
+                                            "xrEndFrame_View",
+                                            TLArg("Depth", "Type"),
+                                            TLArg(viewIndex, "ViewIndex"),
+                                            TLXArg(depth->subImage.swapchain, "Swapchain"),
+                                            TLArg(depth->subImage.imageArrayIndex, "ImageArrayIndex"),
+                                            TLArg(ToTraceString(depth->subImage.imageRect).c_str(), "ImageRect"),
+                                            TLArg(depth->nearZ, "Near"),
+                                            TLArg(depth->farZ, "Far"),
+                                            TLArg(depth->minDepth, "MinDepth"),
+                                            TLArg(depth->maxDepth, "MaxDepth"));
+
+                                        Swapchain* const xrDepthSwapchainPtr =
+                                            m_swapchains.get(depth->subImage.swapchain);
+                                        if (!xrDepthSwapchainPtr) {
+                                            return XR_ERROR_HANDLE_INVALID;
+                                        }
+
+                                        Swapchain& xrDepthSwapchain = *xrDepthSwapchainPtr;
+                                        sources.depthSwapchain[viewIndex] = xrDepthSwapchainPtr;
+
+                                        if (xrDepthSwapchain.lastReleasedIndex == -1) {
+                                            return XR_ERROR_LAYER_INVALID;
+                                        }
+
+                                        if (depth->subImage.imageArrayIndex >= xrDepthSwapchain.xrDesc.arraySize) {
+                                            return XR_ERROR_VALIDATION_FAILURE;
+                                        }
+
+                                        // Fill out depth buffer information.
+                                        prepareSwapchainImage(xrDepthSwapchain,
+                                                              i,
+                                                              depth->subImage.imageArrayIndex,
+                                                              0,
+                                                              frameLayers.committedSwapchainImages);
+                                        layer->EyeFovDepth.DepthTexture[viewIndex] =
+                                            xrDepthSwapchain.ovrSwapchain[depth->subImage.imageArrayIndex];
+
+                                        if (!isValidSwapchainRect(xrDepthSwapchain.ovrDesc,
+                                                                  depth->subImage.imageRect)) {
+                                            return XR_ERROR_SWAPCHAIN_RECT_INVALID;
+                                        }
+
+                                        // Fill out projection information.
+                                        layer->EyeFovDepth.ProjectionDesc.Projection22 =
+                                            depth->farZ / (depth->nearZ - depth->farZ);
+                                        layer->EyeFovDepth.ProjectionDesc.Projection23 =
+                                            (depth->farZ * depth->nearZ) / (depth->nearZ - depth->farZ);
+                                        layer->EyeFovDepth.ProjectionDesc.Projection32 = -1.f;
+
+                                        break;
+                                    }
+                                    entry = entry->next;
                                 }
-                                entry = entry->next;
                             }
                         }
-                    }
-
-                    isFirstProjectionLayer = false;
-
-                } else if (frameEndInfo->layers[i]->type == XR_TYPE_COMPOSITION_LAYER_QUAD) {
-                    const XrCompositionLayerQuad* quad =
-                        reinterpret_cast<const XrCompositionLayerQuad*>(frameEndInfo->layers[i]);
-
-                    TraceLoggingWrite(g_traceProvider,
-                                      "xrEndFrame_Layer",
-                                      TLArg("Quad", "Type"),
-                                      TLArg(quad->layerFlags, "Flags"),
-                                      TLXArg(quad->space, "Space"));
-                    TraceLoggingWrite(g_traceProvider,
-                                      "xrEndFrame_View",
-                                      TLArg("Quad", "Type"),
-                                      TLXArg(quad->subImage.swapchain, "Swapchain"),
-                                      TLArg(quad->subImage.imageArrayIndex, "ImageArrayIndex"),
-                                      TLArg(xr::ToString(quad->subImage.imageRect).c_str(), "ImageRect"),
-                                      TLArg(xr::ToString(quad->pose).c_str(), "Pose"),
-                                      TLArg(quad->size.width, "Width"),
-                                      TLArg(quad->size.height, "Height"),
-                                      TLArg(xr::ToCString(quad->eyeVisibility), "EyeVisibility"));
-
-                    layer->Header.Type = ovrLayerType_Quad;
-
-                    if (!Quaternion::IsNormalized(quad->pose.orientation)) {
-                        return XR_ERROR_POSE_INVALID;
-                    }
-
-                    if (!m_swapchains.count(quad->subImage.swapchain)) {
-                        return XR_ERROR_HANDLE_INVALID;
-                    }
 
-                    Swapchain& xrSwapchain = *(Swapchain*)quad->subImage.swapchain;
+                        isFirstProjectionLayer = false;
+
+                    } else if (frameEndInfo->layers[i]->type == XR_TYPE_COMPOSITION_LAYER_QUAD) {
+                        const XrCompositionLayerQuad* quad =
+                            reinterpret_cast<const XrCompositionLayerQuad*>(frameEndInfo->layers[i]);
+
+                        TraceLoggingWrite(g_traceProvider,
+                                          "xrEndFrame_Layer",
+                                          TLArg("Quad", "Type"),
+                                          TLArg(quad->layerFlags, "Flags"),
+                                          TLXArg(quad->space, "Space"));
+                        TraceLoggingWriteIfEnabled(g_traceProvider,
+                                                   "xrEndFrame_View",
+                                                   TLArg("Quad", "Type"),
+                                                   TLXArg(quad->subImage.swapchain, "Swapchain"),
+                                                   TLArg(quad->subImage.imageArrayIndex, "ImageArrayIndex"),
+                                                   TLArg(ToTraceString(quad->subImage.imageRect).c_str(), "ImageRect"),
+                                                   TLArg(ToTraceString(quad->pose).c_str(), "Pose"),
+                                                   TLArg(quad->size.width, "Width"),
+                                                   TLArg(quad->size.height, "Height"),
+                                                   TLArg(xr::ToCString(quad->eyeVisibility), "EyeVisibility"));
+
+                        layer->Header.Type = ovrLayerType_Quad;
+
+                        if (!Quaternion::IsNormalized(quad->pose.orientation)) {
+                            return XR_ERROR_POSE_INVALID;
+                        }
 
-                    if (xrSwapchain.lastReleasedIndex == -1) {
-                        return XR_ERROR_LAYER_INVALID;
-                    }
+                        Swapchain* const xrSwapchainPtr = m_swapchains.get(quad->subImage.swapchain);
+                        if (!xrSwapchainPtr) {
+                            return XR_ERROR_HANDLE_INVALID;
+                        }
 
-                    // CONFORMANCE: We ignore eyeVisibility, since there is no equivalent in the OVR compositor.
-                    // We cannot achieve conformance for this particular (but uncommon) API usage.
+                        Swapchain& xrSwapchain = *xrSwapchainPtr;
+                        sources.swapchain[0] = xrSwapchainPtr;
 
-                    if (quad->subImage.imageArrayIndex >= xrSwapchain.xrDesc.arraySize) {
-                        return XR_ERROR_VALIDATION_FAILURE;
-                    }
+                        if (xrSwapchain.lastReleasedIndex == -1) {
+                            return XR_ERROR_LAYER_INVALID;
+                        }
 
-                    // Fill out color buffer information.
-                    prepareAndCommitSwapchainImage(xrSwapchain,
-                                                   i,
-                                                   quad->subImage.imageArrayIndex,
-                                                   frameEndInfo->layers[i]->layerFlags,
-                                                   committedSwapchainImages);
-                    layer->Quad.ColorTexture = xrSwapchain.ovrSwapchain[quad->subImage.imageArrayIndex];
+                        // CONFORMANCE: We ignore eyeVisibility, since there is no equivalent in the OVR compositor.
+                        // We cannot achieve conformance for this particular (but uncommon) API usage.
 
-                    if (!isValidSwapchainRect(xrSwapchain.ovrDesc, quad->subImage.imageRect)) {
-                        return XR_ERROR_SWAPCHAIN_RECT_INVALID;
-                    }
-                    layer->Quad.Viewport.Pos.x = quad->subImage.imageRect.offset.x;
-                    layer->Quad.Viewport.Pos.y = quad->subImage.imageRect.offset.y;
-                    layer->Quad.Viewport.Size.w = quad->subImage.imageRect.extent.width;
-                    layer->Quad.Viewport.Size.h = quad->subImage.imageRect.extent.height;
+                        if (quad->subImage.imageArrayIndex >= xrSwapchain.xrDesc.arraySize) {
+                            return XR_ERROR_VALIDATION_FAILURE;
+                        }
 
-                    if (!m_spaces.count(quad->space)) {
-                        return XR_ERROR_HANDLE_INVALID;
-                    }
-                    Space& xrSpace = *(Space*)quad->space;
+                        // Fill out color buffer information.
+                        prepareSwapchainImage(xrSwapchain,
+                                              i,
+                                              quad->subImage.imageArrayIndex,
+                                              frameEndInfo->layers[i]->layerFlags,
+                                              frameLayers.committedSwapchainImages);
+                        layer->Quad.ColorTexture = xrSwapchain.ovrSwapchain[quad->subImage.imageArrayIndex];
+
+                        if (!isValidSwapchainRect(xrSwapchain.ovrDesc, quad->subImage.imageRect)) {
+                            return XR_ERROR_SWAPCHAIN_RECT_INVALID;
+                        }
+                        layer->Quad.Viewport.Pos.x = quad->subImage.imageRect.offset.x;
+                        layer->Quad.Viewport.Pos.y = quad->subImage.imageRect.offset.y;
+                        layer->Quad.Viewport.Size.w = quad->subImage.imageRect.extent.width;
+                        layer->Quad.Viewport.Size.h = quad->subImage.imageRect.extent.height;
+
+                        const Space& xrSpace = *xrLayerSpace;
+
+                        // Fill out pose and quad information.
+                        if (xrSpace.referenceType != XR_REFERENCE_SPACE_TYPE_VIEW) {
+                            XrPosef layerPose;
+                            locateSpace(xrSpace, *m_originSpace, frameEndInfo->displayTime, layerPose);
+                            layer->Quad.QuadPoseCenter = xrPoseToOvrPose(Pose::Multiply(quad->pose, layerPose));
+                        } else {
+                            layer->Quad.QuadPoseCenter =
+                                xrPoseToOvrPose(Pose::Multiply(quad->pose, xrSpace.poseInSpace));
+                            layer->Header.Flags |= ovrLayerFlag_HeadLocked;
+                        }
 
-                    // Fill out pose and quad information.
-                    if (xrSpace.referenceType != XR_REFERENCE_SPACE_TYPE_VIEW) {
-                        XrPosef layerPose;
-                        locateSpace(*(Space*)quad->space, *m_originSpace, frameEndInfo->displayTime, layerPose);
-                        layer->Quad.QuadPoseCenter = xrPoseToOvrPose(Pose::Multiply(quad->pose, layerPose));
+                        layer->Quad.QuadSize.x = quad->size.width;
+                        layer->Quad.QuadSize.y = quad->size.height;
                     } else {
-                        layer->Quad.QuadPoseCenter = xrPoseToOvrPose(Pose::Multiply(quad->pose, xrSpace.poseInSpace));
-                        layer->Header.Flags |= ovrLayerFlag_HeadLocked;
+                        return XR_ERROR_LAYER_INVALID;
                     }
-
-                    layer->Quad.QuadSize.x = quad->size.width;
-                    layer->Quad.QuadSize.y = quad->size.height;
-                } else {
-                    return XR_ERROR_LAYER_INVALID;
                 }
-            }
 
-            // Add a dummy layer so we can still call ovr_endFrame() for timing purposes.
-            if (layersAllocator.empty()) {
-                layersAllocator.push_back({});
-                layersAllocator.back().Header.Type = ovrLayerType_Disabled;
+                // Remember this translation for the next frame.
+                cache.isValid = true;
+                cache.generation = m_layerTopologyGeneration;
+                cache.layerCount = frameLayers.layerCount;
+                cache.isProj0SRGB = isProj0SRGB;
+                memcpy(cache.topology, topology, cache.layerCount * sizeof(LayerTopology));
+                memcpy(cache.layers, frameLayers.layers, cache.layerCount * sizeof(ovrLayer_Union));
             }
 
-            if (IsTraceEnabled()) {
-                m_gpuTimerPrecomposition[m_currentTimerIndex]->stop();
+            // Smooth the translation times, to estimate the time saved by the cache.
+            {
+                const std::chrono::duration<double, std::micro> translationTime =
+                    std::chrono::high_resolution_clock::now() - translationStart;
+                double& averageTime = isCacheHit ? cache.hitTimeUs : cache.missTimeUs;
+                averageTime += 0.1 * (translationTime.count() - averageTime);
+                (isCacheHit ? cache.numHits : cache.numMisses)++;
+
+                TraceLoggingWrite(g_traceProvider,
+                                  "xrEndFrame_LayerCache",
+                                  TLArg(isCacheHit, "Hit"),
+                                  TLArg(translationTime.count(), "TranslationUs"),
+                                  TLArg((double)cache.numHits / (cache.numHits + cache.numMisses), "HitRate"),
+                                  TLArg(cache.missTimeUs - cache.hitTimeUs, "SavedUs"));
             }
 
-            // Update the FPS counter.
-            const auto now = ovr_GetTimeInSeconds();
-            m_frameTimes.push_back(now);
-            while (now - m_frameTimes.front() >= 1.0) {
-                m_frameTimes.pop_front();
+            // Add a dummy layer so we can still call ovr_endFrame() for timing purposes.
+            if (!frameLayers.layerCount) {
+                frameLayers.layers[frameLayers.layerCount++] = {};
+                frameLayers.layers[0].Header.Type = ovrLayerType_Disabled;
             }
 
+            m_gpuTimerPrecomposition[m_currentTimerIndex]->stop();
+
             // Inform Virtual Desktop of the measure application GPU work duration.
             // Ignore return code since this is a non-standard option.
             ovr_SetFloat(m_ovrSession, "AppGpuTime", m_lastGpuFrameTimeUs / 1e6f);
@@ -681,30 +798,38 @@ namespace virtualdesktop_openxr {
             // Submit the layers to OVR.
             const long long ovrFrameId = m_frameBegun - 1;
             if (!m_useAsyncSubmission) {
-                std::vector<ovrLayerHeader*> layers;
-                for (auto& layer : layersAllocator) {
-                    layers.push_back(&layer.Header);
-
-                    if (layers.size() == ovrMaxLayerCount) {
-                        ErrorLog("Too many layers in this frame (%u)\n", layersAllocator.size());
-                        break;
-                    }
+                const ovrLayerHeader* layers[ovrMaxLayerCount];
+                for (uint32_t i = 0; i < frameLayers.layerCount; i++) {
+                    layers[i] = &frameLayers.layers[i].Header;
                 }
 
                 TraceLocalActivity(endFrame);
                 TraceLoggingWriteStart(endFrame,
                                        "OVR_EndFrame",
                                        TLArg(ovrFrameId, "FrameId"),
-                                       TLArg(layers.size(), "NumLayers"),
-                                       TLArg(m_frameTimes.size(), "Fps"),
+                                       TLArg(frameLayers.layerCount, "NumLayers"),
+                                       TLArg(m_frameStatistics.framesPerSecond(), "Fps"),
                                        TLArg(lastPrecompositionTime, "LastPrecompositionTimeUs"));
                 ovrViewScaleDesc scaleDesc{};
                 scaleDesc.HmdToEyePose[xr::StereoView::Left] = m_cachedEyeInfo[xr::StereoView::Left].HmdToEyePose;
                 scaleDesc.HmdToEyePose[xr::StereoView::Right] = m_cachedEyeInfo[xr::StereoView::Right].HmdToEyePose;
                 scaleDesc.HmdSpaceToWorldScaleInMeters = 1.f;
-                CHECK_OVRCMD(
-                    ovr_EndFrame(m_ovrSession, ovrFrameId, &scaleDesc, layers.data(), (unsigned int)layers.size()));
+                isSubmitted = true;
+                commitSwapchainImages(frameLayers.committedSwapchainImages);
+                CHECK_OVRCMD(ovr_EndFrame(m_ovrSession, ovrFrameId, &scaleDesc, layers, frameLayers.layerCount));
                 TraceLoggingWriteStop(endFrame, "OVR_EndFrame");
+
+                const double submitTime = ovr_GetTimeInSeconds();
+                const double runtimeLatency = submitTime - endFrameTime;
+                const double compositorLatency = m_currentFrameRecord.displayTime - submitTime;
+                TraceLoggingWrite(g_traceProvider,
+                                  "SubmissionLatency",
+                                  TLArg(ovrFrameId, "FrameId"),
+                                  TLArg(runtimeLatency * 1e6, "RuntimeLatencyUs"),
+                                  TLArg(compositorLatency * 1e6, "CompositorLatencyUs"));
+                m_currentFrameRecord.set(FrameMetric::RuntimeLatency, (uint64_t)(std::max(runtimeLatency, 0.0) * 1e6));
+                m_currentFrameRecord.set(FrameMetric::CompositorLatency,
+                                         (uint64_t)(std::max(compositorLatency, 0.0) * 1e6));
             }
 
             // Defer initialization of mirror window resources until they are first needed.
@@ -724,21 +849,45 @@ namespace virtualdesktop_openxr {
                 m_ovrSubmissionContext->Flush();
             }
 
+            // Record the frame statistics. With asynchronous submission, they are only complete once the frame was
+            // submitted: the frame carries them to the submission thread.
+            submitTimer.stop();
+            m_currentFrameRecord.set(FrameMetric::Submit, submitTimer.query());
+            m_currentFrameRecord.endTime = ovr_GetTimeInSeconds();
+            TraceLoggingWrite(g_traceProvider,
+                              "Frame_Latency",
+                              TLArg(ovrFrameId, "FrameId"),
+                              TLArg(m_currentFrameRecord.waitFrameTime, "WaitFrameTime"),
+                              TLArg(m_currentFrameRecord.beginFrameTime, "BeginFrameTime"),
+                              TLArg(m_currentFrameRecord.endFrameTime, "EndFrameTime"),
+                              TLArg(m_currentFrameRecord.viewsLocateTime, "ViewsLocateTime"),
+                              TLArg(m_currentFrameRecord.displayTime, "DisplayTime"),
+                              TLArg(m_currentFrameRecord.durationUs[(uint32_t)FrameMetric::PoseAge], "PoseAgeUs"),
+                              TLArg(m_currentFrameRecord.durationUs[(uint32_t)FrameMetric::PredictionHorizon],
+                                    "PredictionHorizonUs"));
+
             if (m_useAsyncSubmission) {
                 TraceLoggingWrite(g_traceProvider,
                                   "SubmitLayers",
                                   TLArg(ovrFrameId, "FrameId"),
-                                  TLArg(m_frameTimes.size(), "Fps"),
+                                  TLArg(m_asyncSubmissionDepth, "Depth"),
+                                  TLArg(m_frameStatistics.framesPerSecond(), "Fps"),
                                   TLArg(lastPrecompositionTime, "LastPrecompositionTimeUs"));
 
-                std::unique_lock lock(m_asyncSubmissionMutex);
-                m_layersForAsyncSubmission = layersAllocator;
-
-                m_asyncSubmissionCondVar.notify_all();
+                frameLayers.frameId = ovrFrameId;
+                frameLayers.publishTime = std::chrono::high_resolution_clock::now();
+                frameLayers.record = m_currentFrameRecord;
+                frameLayers.hasRecord = true;
+                isSubmitted = true;
+                m_asyncSubmissionRing.publish();
+                m_numPublishedFrames++;
 
-                // From this point, we know that the asynchronous thread may be executing, and we shall not use the
-                // submission context.
+                // From this point, we shall not use the submission context.
+                submissionLock.unlock();
+            } else {
+                recordFrameStatistics(m_currentFrameRecord);
             }
+            m_currentFrameRecord = {};
 
             m_frameCompleted = m_frameBegun;
             updateSessionState();
@@ -765,9 +914,10 @@ namespace virtualdesktop_openxr {
 
         SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
 
-        std::optional<long long> lastWaitedFrameId;
+        // With frames queued ahead of us, m_frameCompleted may be past the frame we submit next. Follow the identifiers
+        // of the frames we receive instead.
+        long long ovrFrameId = m_frameCompleted;
         while (true) {
-            const long long ovrFrameId = m_frameCompleted;
             {
                 TraceLocalActivity(waitToBeginFrame);
                 TraceLoggingWriteStart(waitToBeginFrame, "OVR_WaitToBeginFrame", TLArg(ovrFrameId, "FrameId"));
@@ -792,43 +942,60 @@ namespace virtualdesktop_openxr {
                 TraceLoggingWriteStop(beginFrame, "OVR_BeginFrame");
             }
 
-            {
-                std::unique_lock lock(m_asyncSubmissionMutex);
-
-                // Mark us as ready to accept a new frame.
-                m_layersForAsyncSubmission.clear();
-                m_asyncSubmissionCondVar.notify_all();
-
-                // Wait for the frame.
-                m_asyncSubmissionCondVar.wait(
-                    lock, [&] { return m_terminateAsyncThread || !m_layersForAsyncSubmission.empty(); });
-            }
-            if (m_terminateAsyncThread) {
+            // Mark us as ready to accept a new frame, and wait for it.
+            const AsyncSubmissionSlot* const frameLayers = m_asyncSubmissionRing.acquire();
+            if (!frameLayers) {
                 break;
             }
 
             {
-                std::vector<ovrLayerHeader*> layers;
-                for (auto& layer : m_layersForAsyncSubmission) {
-                    layers.push_back(&layer.Header);
-
-                    if (layers.size() == ovrMaxLayerCount) {
-                        ErrorLog("Too many layers in this frame (%u)\n", m_layersForAsyncSubmission.size());
-                        break;
-                    }
+                const ovrLayerHeader* layers[ovrMaxLayerCount];
+                for (uint32_t i = 0; i < frameLayers->layerCount; i++) {
+                    layers[i] = &frameLayers->layers[i].Header;
                 }
 
+                const std::chrono::duration<double> handoff =
+                    std::chrono::high_resolution_clock::now() - frameLayers->publishTime;
+
                 TraceLocalActivity(endFrame);
-                TraceLoggingWriteStart(
-                    endFrame, "OVR_EndFrame", TLArg(ovrFrameId, "FrameId"), TLArg(layers.size(), "NumLayers"));
+                TraceLoggingWriteStart(endFrame,
+                                       "OVR_EndFrame",
+                                       TLArg(ovrFrameId, "FrameId"),
+                                       TLArg(frameLayers->frameId, "AppFrameId"),
+                                       TLArg(frameLayers->layerCount, "NumLayers"),
+                                       TLArg(handoff.count() * 1e6, "HandoffUs"),
+                                       TLArg(m_asyncSubmissionRing.pending(), "QueuedFrames"));
                 ovrViewScaleDesc scaleDesc{};
                 scaleDesc.HmdToEyePose[xr::StereoView::Left] = m_cachedEyeInfo[xr::StereoView::Left].HmdToEyePose;
                 scaleDesc.HmdToEyePose[xr::StereoView::Right] = m_cachedEyeInfo[xr::StereoView::Right].HmdToEyePose;
                 scaleDesc.HmdSpaceToWorldScaleInMeters = 1.f;
-                CHECK_OVRCMD(
-                    ovr_EndFrame(m_ovrSession, ovrFrameId, &scaleDesc, layers.data(), (unsigned int)layers.size()));
+                {
+                    // The swapchain images of this frame were only prepared by xrEndFrame(), commit them now that
+                    // the previous frames were submitted.
+                    std::unique_lock lock(m_submissionContextMutex);
+                    commitSwapchainImages(frameLayers->committedSwapchainImages);
+                    CHECK_OVRCMD(
+                        ovr_EndFrame(m_ovrSession, ovrFrameId, &scaleDesc, layers, frameLayers->layerCount));
+                }
                 TraceLoggingWriteStop(endFrame, "OVR_EndFrame");
+
+                // Complete the statistics of the frame. They are recorded by the xrEndFrame() that reuses the slot.
+                FrameRecord& record = frameLayers->record;
+                const double submitTime = ovr_GetTimeInSeconds();
+                const double runtimeLatency = submitTime - record.endFrameTime;
+                const double compositorLatency = record.displayTime - submitTime;
+                TraceLoggingWrite(g_traceProvider,
+                                  "SubmissionLatency",
+                                  TLArg(frameLayers->frameId, "FrameId"),
+                                  TLArg(runtimeLatency * 1e6, "RuntimeLatencyUs"),
+                                  TLArg(compositorLatency * 1e6, "CompositorLatencyUs"));
+                record.set(FrameMetric::RuntimeLatency, (uint64_t)(std::max(runtimeLatency, 0.0) * 1e6));
+                record.set(FrameMetric::CompositorLatency, (uint64_t)(std::max(compositorLatency, 0.0) * 1e6));
             }
+            ovrFrameId = frameLayers->frameId + 1;
+
+            // The layers were submitted, and their slot may be reused.
+            m_asyncSubmissionRing.release();
         }
 
         TraceLoggingWriteStop(local, "AsyncSubmissionThread");
@@ -838,22 +1005,352 @@ namespace virtualdesktop_openxr {
         TraceLocalActivity(waitToBeginFrame);
         TraceLoggingWriteStart(waitToBeginFrame, "WaitForAsyncSubmissionIdle", TLArg(doRunningStart, "DoRunningStart"));
 
-        std::unique_lock lock(m_asyncSubmissionMutex);
-
         bool wokeUpEarly = false;
+        const double runningStart = m_runningStart.offset();
         if (doRunningStart) {
-            constexpr double RunningStart = 0.002;
             const auto timeout =
-                m_lastWaitToBeginFrameTime + std::chrono::duration<double>(m_predictedFrameDuration - RunningStart);
+                m_lastWaitToBeginFrameTime.load() +
+                std::chrono::duration<double>(m_predictedFrameDuration - runningStart);
 
-            wokeUpEarly =
-                !m_asyncSubmissionCondVar.wait_until(lock, timeout, [&] { return m_layersForAsyncSubmission.empty(); });
+            wokeUpEarly = !m_asyncSubmissionRing.waitForRequest(m_asyncSubmissionDepth - 1, timeout);
+            if (wokeUpEarly) {
+                const std::chrono::duration<double> lateness = std::chrono::high_resolution_clock::now() - timeout;
+                m_runningStart.onWakeUp(lateness.count());
+            }
         } else {
-            m_asyncSubmissionCondVar.wait(lock, [&] { return m_layersForAsyncSubmission.empty(); });
+            m_asyncSubmissionRing.waitForRequest(m_asyncSubmissionDepth - 1);
+        }
+
+        TraceLoggingWriteStop(waitToBeginFrame,
+                              "WaitForAsyncSubmissionIdle",
+                              TLArg(wokeUpEarly, "WokeUpForRunningStart"),
+                              TLArg(runningStart * 1e6, "RunningStartUs"),
+                              TLArg(m_runningStart.slackQuantile() * 1e6, "SlackQuantileUs"),
+                              TLArg(m_runningStart.wakeUpJitter() * 1e6, "WakeUpJitterUs"),
+                              TLArg(m_runningStart.appCpuTime() * 1e6, "AppCpuTimeUs"),
+                              TLArg(m_runningStart.numMissedFrames(), "MissedFrames"));
+    }
+
+    void OpenXrRuntime::waitForAsyncSubmissionDrained() {
+        TraceLocalActivity(waitDrained);
+        TraceLoggingWriteStart(waitDrained, "WaitForAsyncSubmissionDrained");
+
+        m_asyncSubmissionRing.waitForRelease(0);
+
+        TraceLoggingWriteStop(waitDrained, "WaitForAsyncSubmissionDrained");
+    }
+
+    void OpenXrRuntime::commitSwapchainImages(const CommittedSwapchainImages& committedSwapchainImages) {
+        for (const auto& [xrSwapchain, slice] : committedSwapchainImages) {
+            CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain->ovrSwapchain[slice]));
+        }
+    }
+
+    // Give back the images that were prepared for a frame that is not going to be submitted.
+    void OpenXrRuntime::discardSwapchainImages(const CommittedSwapchainImages& committedSwapchainImages) {
+        for (const auto& [xrSwapchain, slice] : committedSwapchainImages) {
+            int& nextCommitIndex = xrSwapchain->nextCommitIndex[slice];
+            const int length = (int)xrSwapchain->slices[slice].size();
+            nextCommitIndex = (nextCommitIndex + length - 1) % length;
+        }
+    }
+
+    void OpenXrRuntime::logFrameStatistics() const {
+        if (!m_frameStatistics.numFrames()) {
+            return;
+        }
+
+        Log("Frame statistics over the session: %llu frames, %llu discarded\n",
+            m_frameStatistics.numFrames(),
+            m_frameStatistics.numDiscarded());
+
+        static const char* const metricNames[] = {
+            "WaitFrame",
+            "BeginFrame",
+            "AppCpu",
+            "AppGpu",
+            "PrecompositionGpu",
+            "Submit",
+            "PoseAge",
+            "PredictionHorizon",
+            "RuntimeLatency",
+            "CompositorLatency"};
+        static_assert(std::size(metricNames) == (size_t)FrameMetric::Count);
+        for (uint32_t i = 0; i < (uint32_t)FrameMetric::Count; i++) {
+            const FrameMetric metric = (FrameMetric)i;
+            Log("  %-17s p50=%.0fus p90=%.0fus p99=%.0fus\n",
+                metricNames[i],
+                m_frameStatistics.quantileUs(metric, FrameStatistics::P50),
+                m_frameStatistics.quantileUs(metric, FrameStatistics::P90),
+                m_frameStatistics.quantileUs(metric, FrameStatistics::P99));
+        }
+
+        for (uint32_t depth = 0; depth <= k_maxAsyncSubmissionDepth; depth++) {
+            const ConfigurationStatistics& statistics = m_submissionDepthStatistics[depth];
+            if (!statistics.numFrames()) {
+                continue;
+            }
+
+            char name[16] = "synchronous";
+            if (depth) {
+                sprintf_s(name, "depth %u", depth);
+            }
+            Log("  Submission %-11s %llu frames, %.1f fps, RuntimeLatency p50=%.0fus p99=%.0fus, PredictionHorizon "
+                "p50=%.0fus p99=%.0fus\n",
+                name,
+                statistics.numFrames(),
+                statistics.framesPerSecond(),
+                statistics.p50Us(FrameMetric::RuntimeLatency),
+                statistics.p99Us(FrameMetric::RuntimeLatency),
+                statistics.p50Us(FrameMetric::PredictionHorizon),
+                statistics.p99Us(FrameMetric::PredictionHorizon));
         }
+    }
 
-        TraceLoggingWriteStop(
-            waitToBeginFrame, "WaitForAsyncSubmissionIdle", TLArg(wokeUpEarly, "WokeUpForRunningStart"));
+    // Add the record of a completed frame to the statistics.
+    void OpenXrRuntime::recordFrameStatistics(const FrameRecord& record) {
+        m_frameStatistics.record(record);
+        m_submissionDepthStatistics[m_useAsyncSubmission ? m_asyncSubmissionDepth : 0].record(
+            record, m_lastFrameEndTime ? record.endTime - m_lastFrameEndTime : 0);
+        m_lastFrameEndTime = record.endTime;
+        publishPerformanceCounters(record);
+    }
+
+    // Called once per frame, after the frame record was added to the statistics.
+    void OpenXrRuntime::publishPerformanceCounters(const FrameRecord& record) {
+        if (!m_performanceCounters.isOpen()) {
+            return;
+        }
+
+        PerformanceCounters::Snapshot snapshot{};
+        snapshot.frameIndex = m_frameBegun;
+        snapshot.time = record.endTime;
+        snapshot.numFrames = m_frameStatistics.numFrames();
+        snapshot.numDiscardedFrames = m_frameStatistics.numDiscarded();
+        snapshot.framesPerSecond = m_frameStatistics.framesPerSecond();
+        snapshot.isAsyncReprojectionEngaged = m_framePeriodEstimator.isAswEngaged();
+        snapshot.predictedFramePeriodUs = (float)(m_predictedFrameDuration * 1e6);
+        snapshot.measuredFramePeriodUs = (float)(m_framePeriodEstimator.measuredPeriod() * 1e6);
+        snapshot.runningStartUs = m_useRunningStart ? (float)(m_runningStart.offset() * 1e6) : 0.f;
+        snapshot.asyncSubmissionDepth = m_useAsyncSubmission ? m_asyncSubmissionDepth : 0;
+        for (uint32_t i = 0; i < (uint32_t)FrameMetric::Count; i++) {
+            const FrameMetric metric = (FrameMetric)i;
+            PerformanceCounters::Metric& counter = snapshot.metrics[i];
+            counter.lastUs = (float)record.durationUs[i];
+            counter.p50Us = (float)m_frameStatistics.quantileUs(metric, FrameStatistics::P50);
+            counter.p90Us = (float)m_frameStatistics.quantileUs(metric, FrameStatistics::P90);
+            counter.p99Us = (float)m_frameStatistics.quantileUs(metric, FrameStatistics::P99);
+        }
+
+        m_performanceCounters.publish(snapshot);
+    }
+
+    // Describe the topology of each layer, for comparison with the previous frame. Returns false when a layer cannot be
+    // described: it will then go through (and fail) the full validation.
+    bool OpenXrRuntime::getLayerTopology(const XrFrameEndInfo& frameEndInfo, LayerTopology* topology) const {
+        for (uint32_t i = 0; i < frameEndInfo.layerCount; i++) {
+            const XrCompositionLayerBaseHeader* const baseLayer = frameEndInfo.layers[i];
+            if (!baseLayer) {
+                return false;
+            }
+
+            LayerTopology& layerTopology = topology[i];
+            memset(&layerTopology, 0, sizeof(layerTopology));
+            layerTopology.type = baseLayer->type;
+            layerTopology.layerFlags = baseLayer->layerFlags;
+            layerTopology.space = baseLayer->space;
+
+            if (baseLayer->type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
+                const XrCompositionLayerProjection* proj =
+                    reinterpret_cast<const XrCompositionLayerProjection*>(baseLayer);
+                if (proj->viewCount != xr::StereoView::Count) {
+                    return false;
+                }
+
+                for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
+                    const XrSwapchainSubImage& subImage = proj->views[viewIndex].subImage;
+                    layerTopology.swapchain[viewIndex] = subImage.swapchain;
+                    layerTopology.imageArrayIndex[viewIndex] = subImage.imageArrayIndex;
+                    layerTopology.imageRect[viewIndex] = subImage.imageRect;
+
+                    if (has_XR_KHR_composition_layer_depth) {
+                        const XrBaseInStructure* entry =
+                            reinterpret_cast<const XrBaseInStructure*>(proj->views[viewIndex].next);
+                        while (entry) {
+                            if (entry->type == XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR) {
+                                const XrCompositionLayerDepthInfoKHR* depth =
+                                    reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(entry);
+                                layerTopology.depthSwapchain[viewIndex] = depth->subImage.swapchain;
+                                layerTopology.depthImageArrayIndex[viewIndex] = depth->subImage.imageArrayIndex;
+                                layerTopology.depthImageRect[viewIndex] = depth->subImage.imageRect;
+                                layerTopology.nearZ[viewIndex] = depth->nearZ;
+                                layerTopology.farZ[viewIndex] = depth->farZ;
+                                break;
+                            }
+                            entry = entry->next;
+                        }
+                    }
+                }
+            } else if (baseLayer->type == XR_TYPE_COMPOSITION_LAYER_QUAD) {
+                const XrCompositionLayerQuad* quad = reinterpret_cast<const XrCompositionLayerQuad*>(baseLayer);
+                layerTopology.swapchain[0] = quad->subImage.swapchain;
+                layerTopology.imageArrayIndex[0] = quad->subImage.imageArrayIndex;
+                layerTopology.imageRect[0] = quad->subImage.imageRect;
+                layerTopology.quadSize = quad->size;
+            } else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Patch the layers translated during the previous frame with the values that change every frame. The topology is
+    // identical to the previous frame, and so is the outcome of its validation.
+    XrResult OpenXrRuntime::patchCachedLayers(const XrFrameEndInfo& frameEndInfo, AsyncSubmissionSlot& frameLayers) {
+        LayerTranslationCache& cache = m_layerTranslationCache;
+        for (uint32_t i = 0; i < cache.layerCount; i++) {
+            const LayerTopology& topology = cache.topology[i];
+            LayerTranslationCache::Sources& sources = cache.sources[i];
+            ovrLayer_Union& layer = frameLayers.layers[i];
+            layer = cache.layers[i];
+
+            if (topology.type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
+                const XrCompositionLayerProjection* proj =
+                    reinterpret_cast<const XrCompositionLayerProjection*>(frameEndInfo.layers[i]);
+
+                TraceLoggingWrite(g_traceProvider,
+                                  "xrEndFrame_Layer",
+                                  TLArg("Proj", "Type"),
+                                  TLArg(proj->layerFlags, "Flags"),
+                                  TLXArg(proj->space, "Space"));
+
+                XrPosef layerPose;
+                locateSpace(*sources.space, *m_originSpace, frameEndInfo.displayTime, layerPose);
+
+                for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
+                    const XrCompositionLayerProjectionView& view = proj->views[viewIndex];
+                    TraceLoggingWriteIfEnabled(g_traceProvider,
+                                               "xrEndFrame_View",
+                                               TLArg("Proj", "Type"),
+                                               TLArg(viewIndex, "ViewIndex"),
+                                               TLXArg(view.subImage.swapchain, "Swapchain"),
+                                               TLArg(view.subImage.imageArrayIndex, "ImageArrayIndex"),
+                                               TLArg(ToTraceString(view.subImage.imageRect).c_str(), "ImageRect"),
+                                               TLArg(ToTraceString(view.pose).c_str(), "Pose"),
+                                               TLArg(ToTraceString(view.fov).c_str(), "Fov"));
+                    if (sources.depthSwapchain[viewIndex] && TraceLoggingProviderEnabled(g_traceProvider, 0, 0)) {
+                        traceCachedDepthInfo(view, viewIndex);
+                    }
+
+                    if (!Quaternion::IsNormalized(view.pose.orientation)) {
+                        return XR_ERROR_POSE_INVALID;
+                    }
+
+                    Swapchain& xrSwapchain = *sources.swapchain[viewIndex];
+                    if (xrSwapchain.lastReleasedIndex == -1) {
+                        return XR_ERROR_LAYER_INVALID;
+                    }
+                    prepareSwapchainImage(xrSwapchain,
+                                          i,
+                                          topology.imageArrayIndex[viewIndex],
+                                          topology.layerFlags,
+                                          frameLayers.committedSwapchainImages);
+
+                    layer.EyeFov.RenderPose[viewIndex] = xrPoseToOvrPose(Pose::Multiply(view.pose, layerPose));
+
+                    // The FOVs rarely change, only recompute the tangents when they do.
+                    if (memcmp(&view.fov, &sources.fov[viewIndex], sizeof(XrFovf))) {
+                        sources.fov[viewIndex] = view.fov;
+                        cache.layers[i].EyeFov.Fov[viewIndex] = xrFovToOvrFovPort(view.fov);
+                        layer.EyeFov.Fov[viewIndex] = cache.layers[i].EyeFov.Fov[viewIndex];
+                    }
+
+                    if (sources.depthSwapchain[viewIndex]) {
+                        Swapchain& xrDepthSwapchain = *sources.depthSwapchain[viewIndex];
+                        if (xrDepthSwapchain.lastReleasedIndex == -1) {
+                            return XR_ERROR_LAYER_INVALID;
+                        }
+                        prepareSwapchainImage(xrDepthSwapchain,
+                                              i,
+                                              topology.depthImageArrayIndex[viewIndex],
+                                              0,
+                                              frameLayers.committedSwapchainImages);
+                    }
+                }
+
+                layer.EyeFov.SensorSampleTime = xrTimeToOvrTime(frameEndInfo.displayTime);
+            } else {
+                const XrCompositionLayerQuad* quad =
+                    reinterpret_cast<const XrCompositionLayerQuad*>(frameEndInfo.layers[i]);
+
+                TraceLoggingWrite(g_traceProvider,
+                                  "xrEndFrame_Layer",
+                                  TLArg("Quad", "Type"),
+                                  TLArg(quad->layerFlags, "Flags"),
+                                  TLXArg(quad->space, "Space"));
+                TraceLoggingWriteIfEnabled(g_traceProvider,
+                                           "xrEndFrame_View",
+                                           TLArg("Quad", "Type"),
+                                           TLXArg(quad->subImage.swapchain, "Swapchain"),
+                                           TLArg(quad->subImage.imageArrayIndex, "ImageArrayIndex"),
+                                           TLArg(ToTraceString(quad->subImage.imageRect).c_str(), "ImageRect"),
+                                           TLArg(ToTraceString(quad->pose).c_str(), "Pose"),
+                                           TLArg(quad->size.width, "Width"),
+                                           TLArg(quad->size.height, "Height"),
+                                           TLArg(xr::ToCString(quad->eyeVisibility), "EyeVisibility"));
+
+                if (!Quaternion::IsNormalized(quad->pose.orientation)) {
+                    return XR_ERROR_POSE_INVALID;
+                }
+
+                Swapchain& xrSwapchain = *sources.swapchain[0];
+                if (xrSwapchain.lastReleasedIndex == -1) {
+                    return XR_ERROR_LAYER_INVALID;
+                }
+                prepareSwapchainImage(xrSwapchain,
+                                      i,
+                                      topology.imageArrayIndex[0],
+                                      topology.layerFlags,
+                                      frameLayers.committedSwapchainImages);
+
+                if (sources.space->referenceType != XR_REFERENCE_SPACE_TYPE_VIEW) {
+                    XrPosef layerPose;
+                    locateSpace(*sources.space, *m_originSpace, frameEndInfo.displayTime, layerPose);
+                    layer.Quad.QuadPoseCenter = xrPoseToOvrPose(Pose::Multiply(quad->pose, layerPose));
+                } else {
+                    layer.Quad.QuadPoseCenter = xrPoseToOvrPose(Pose::Multiply(quad->pose, sources.space->poseInSpace));
+                }
+            }
+
+            frameLayers.layerCount++;
+        }
+
+        return XR_SUCCESS;
+    }
+
+    // The depth information is not needed to patch a cached layer, only look it up for tracing.
+    void OpenXrRuntime::traceCachedDepthInfo(const XrCompositionLayerProjectionView& view, uint32_t viewIndex) const {
+        const XrBaseInStructure* entry = reinterpret_cast<const XrBaseInStructure*>(view.next);
+        while (entry) {
+            if (entry->type == XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR) {
+                const XrCompositionLayerDepthInfoKHR* depth =
+                    reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(entry);
+                TraceLoggingWrite(g_traceProvider,
+                                  "xrEndFrame_View",
+                                  TLArg("Depth", "Type"),
+                                  TLArg(viewIndex, "ViewIndex"),
+                                  TLXArg(depth->subImage.swapchain, "Swapchain"),
+                                  TLArg(depth->subImage.imageArrayIndex, "ImageArrayIndex"),
+                                  TLArg(ToTraceString(depth->subImage.imageRect).c_str(), "ImageRect"),
+                                  TLArg(depth->nearZ, "Near"),
+                                  TLArg(depth->farZ, "Far"),
+                                  TLArg(depth->minDepth, "MinDepth"),
+                                  TLArg(depth->maxDepth, "MaxDepth"));
+                break;
+            }
+            entry = entry->next;
+        }
     }
 
 } // namespace virtualdesktop_openxr
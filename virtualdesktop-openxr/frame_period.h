@@ -0,0 +1,115 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // Estimates the period at which the application frames are presented, from the compositor statistics.
+    // The interval between presented frames is smoothed, and quantized to a whole number of vsyncs. Asynchronous
+    // reprojection (ASW) halves the application frame rate, and its state is taken into account as soon as the
+    // compositor reports it. Both are filtered with hysteresis, so that the predicted period does not jump back and forth
+    // with every sample, which would upset applications that derive their simulation step from it.
+    // It has no dependency on the runtime, so that it can be replayed from recorded statistics. Not thread-safe.
+    class FramePeriodEstimator {
+      public:
+        void reset(double idealPeriod) {
+            m_idealPeriod = idealPeriod;
+            m_vsyncsPerFrame = 1;
+            m_quantizedVsyncsPerFrame = 1;
+            m_isAswEngaged = false;
+            m_aswSamples = 0;
+            m_lastAppFrameIndex.reset();
+            m_lastVsyncIndex = 0;
+        }
+
+        // One sample of compositor frame statistics. Samples already seen are ignored, so the entire history returned
+        // by the compositor can be passed every time, from the oldest to the most recent.
+        void addSample(int appFrameIndex, int hmdVsyncIndex, bool isAswActive) {
+            if (m_lastAppFrameIndex && appFrameIndex <= m_lastAppFrameIndex.value()) {
+                return;
+            }
+
+            if (m_lastAppFrameIndex) {
+                const double vsyncsPerFrame = std::max(hmdVsyncIndex - m_lastVsyncIndex, 1) /
+                                              (double)(appFrameIndex - m_lastAppFrameIndex.value());
+                m_vsyncsPerFrame += k_smoothing * (vsyncsPerFrame - m_vsyncsPerFrame);
+
+                // Only move to another multiple of the vsync period once the smoothed interval is clearly closer to it.
+                while (m_vsyncsPerFrame > m_quantizedVsyncsPerFrame + k_quantizationHysteresis &&
+                       m_quantizedVsyncsPerFrame < k_maxVsyncsPerFrame) {
+                    m_quantizedVsyncsPerFrame++;
+                }
+                while (m_vsyncsPerFrame < m_quantizedVsyncsPerFrame - k_quantizationHysteresis &&
+                       m_quantizedVsyncsPerFrame > 1) {
+                    m_quantizedVsyncsPerFrame--;
+                }
+            }
+            m_lastAppFrameIndex = appFrameIndex;
+            m_lastVsyncIndex = hmdVsyncIndex;
+
+            // Count the consecutive samples disagreeing with the current state.
+            if (isAswActive != m_isAswEngaged) {
+                m_aswSamples++;
+                if (m_aswSamples >= (m_isAswEngaged ? k_aswDisengageSamples : k_aswEngageSamples)) {
+                    m_isAswEngaged = isAswActive;
+                    m_aswSamples = 0;
+                }
+            } else {
+                m_aswSamples = 0;
+            }
+        }
+
+        // The period to report to the application: a whole number of vsyncs.
+        double period() const {
+            return m_idealPeriod * std::max(m_isAswEngaged ? 2u : 1u, m_quantizedVsyncsPerFrame);
+        }
+
+        // The smoothed interval between two presented application frames.
+        double measuredPeriod() const {
+            return m_idealPeriod * m_vsyncsPerFrame;
+        }
+
+        bool isAswEngaged() const {
+            return m_isAswEngaged;
+        }
+
+      private:
+        // ASW engages quickly, but must be off for a while before we report the full rate again.
+        static constexpr uint32_t k_aswEngageSamples = 3;
+        static constexpr uint32_t k_aswDisengageSamples = 30;
+        static constexpr double k_smoothing = 0.1;
+
+        // How far from the current multiple of the vsync period the smoothed interval must go to switch to the next one
+        // (past the midpoint between the two, for hysteresis).
+        static constexpr double k_quantizationHysteresis = 0.75;
+        static constexpr uint32_t k_maxVsyncsPerFrame = 4;
+
+        double m_idealPeriod{0};
+        double m_vsyncsPerFrame{1};
+        uint32_t m_quantizedVsyncsPerFrame{1};
+        bool m_isAswEngaged{false};
+        uint32_t m_aswSamples{0};
+        std::optional<int> m_lastAppFrameIndex;
+        int m_lastVsyncIndex{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
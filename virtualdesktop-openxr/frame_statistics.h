@@ -0,0 +1,263 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // An incremental estimator of one quantile of a stream of samples, with constant memory and time per sample.
+    // This is the P-square algorithm (Jain & Chlamtac, 1985): 5 markers track the minimum, the maximum, the quantile
+    // and two intermediate quantiles, and their heights are adjusted with a piecewise-parabolic interpolation.
+    class QuantileEstimator {
+      public:
+        explicit QuantileEstimator(double quantile = 0.5) : m_quantile(quantile) {
+        }
+
+        void reset() {
+            m_count = 0;
+        }
+
+        void add(double sample) {
+            if (m_count < k_numMarkers) {
+                m_heights[m_count++] = sample;
+                if (m_count == k_numMarkers) {
+                    std::sort(m_heights, m_heights + k_numMarkers);
+                    for (uint32_t i = 0; i < k_numMarkers; i++) {
+                        m_positions[i] = i + 1.0;
+                    }
+                    const double p = m_quantile;
+                    const double desired[k_numMarkers] = {1, 1 + 2 * p, 1 + 4 * p, 3 + 2 * p, 5};
+                    const double increments[k_numMarkers] = {0, p / 2, p, (1 + p) / 2, 1};
+                    std::copy(desired, desired + k_numMarkers, m_desiredPositions);
+                    std::copy(increments, increments + k_numMarkers, m_increments);
+                }
+                return;
+            }
+            m_count++;
+
+            // Find the cell containing the sample, extending the extreme markers if needed.
+            uint32_t cell;
+            if (sample < m_heights[0]) {
+                m_heights[0] = sample;
+                cell = 0;
+            } else if (sample >= m_heights[k_numMarkers - 1]) {
+                m_heights[k_numMarkers - 1] = sample;
+                cell = k_numMarkers - 2;
+            } else {
+                cell = 0;
+                while (sample >= m_heights[cell + 1]) {
+                    cell++;
+                }
+            }
+
+            for (uint32_t i = cell + 1; i < k_numMarkers; i++) {
+                m_positions[i]++;
+            }
+            for (uint32_t i = 0; i < k_numMarkers; i++) {
+                m_desiredPositions[i] += m_increments[i];
+            }
+
+            // Move the middle markers towards their desired positions.
+            for (uint32_t i = 1; i < k_numMarkers - 1; i++) {
+                const double offset = m_desiredPositions[i] - m_positions[i];
+                if ((offset >= 1 && m_positions[i + 1] - m_positions[i] > 1) ||
+                    (offset <= -1 && m_positions[i - 1] - m_positions[i] < -1)) {
+                    const int direction = offset > 0 ? 1 : -1;
+                    const double height = parabolic(i, direction);
+                    if (m_heights[i - 1] < height && height < m_heights[i + 1]) {
+                        m_heights[i] = height;
+                    } else {
+                        m_heights[i] = linear(i, direction);
+                    }
+                    m_positions[i] += direction;
+                }
+            }
+        }
+
+        double value() const {
+            if (m_count >= k_numMarkers) {
+                return m_heights[2];
+            }
+            if (!m_count) {
+                return 0;
+            }
+
+            // Not enough samples for the markers yet: use the nearest rank.
+            double sorted[k_numMarkers];
+            std::copy(m_heights, m_heights + m_count, sorted);
+            std::sort(sorted, sorted + m_count);
+            return sorted[std::min((uint32_t)(m_quantile * m_count), m_count - 1)];
+        }
+
+      private:
+        static constexpr uint32_t k_numMarkers = 5;
+
+        double parabolic(uint32_t i, int direction) const {
+            const double d = direction;
+            const double* const n = m_positions;
+            const double* const q = m_heights;
+            return q[i] + d / (n[i + 1] - n[i - 1]) *
+                              ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                               (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+        }
+
+        double linear(uint32_t i, int direction) const {
+            return m_heights[i] + direction * (m_heights[i + direction] - m_heights[i]) /
+                                      (m_positions[i + direction] - m_positions[i]);
+        }
+
+        double m_quantile;
+        uint32_t m_count{0};
+        double m_heights[k_numMarkers]{};
+        double m_positions[k_numMarkers]{};
+        double m_desiredPositions[k_numMarkers]{};
+        double m_increments[k_numMarkers]{};
+    };
+
+    enum class FrameMetric : uint32_t {
+        WaitFrame = 0,
+        BeginFrame,
+        AppCpu,
+        AppGpu,
+        PrecompositionGpu,
+        Submit,
+
+        // The motion-to-photon latency breakdown. The prediction horizon, from the xrLocateViews() call that produced
+        // the submitted poses to the display time, is the sum of the pose age (until xrEndFrame()), the runtime latency
+        // (until the layers are handed to OVR) and the compositor latency (until the display time). With asynchronous
+        // submission, a frame is only recorded once it was submitted, which is a few frames later.
+        PoseAge,
+        PredictionHorizon,
+        RuntimeLatency,
+        CompositorLatency,
+
+        Count
+    };
+
+    // The timings of one frame, in microseconds. Metrics that could not be measured are left out of the mask.
+    // Timestamps are in OVR time (seconds), and 0 when unknown.
+    struct FrameRecord {
+        double waitFrameTime{0};
+        double beginFrameTime{0};
+        double endFrameTime{0};
+        double viewsLocateTime{0};
+        double displayTime{0};
+        double endTime{0};
+        bool discarded{false};
+        uint32_t measuredMetrics{0};
+        uint64_t durationUs[(uint32_t)FrameMetric::Count]{};
+
+        void set(FrameMetric metric, uint64_t value) {
+            durationUs[(uint32_t)metric] = value;
+            measuredMetrics |= 1u << (uint32_t)metric;
+        }
+
+        bool isMeasured(FrameMetric metric) const {
+            return measuredMetrics & (1u << (uint32_t)metric);
+        }
+    };
+
+    // A fixed-capacity ring of the most recent frame records, with running p50/p90/p99 estimates for each metric.
+    // Recording is O(1) and never allocates, and everything can be queried in-process without a trace session.
+    // The ring only serves the recent records and the frame rate: the percentiles are estimated over every frame
+    // recorded since the last reset (ie: the whole session), including the frames that left the ring.
+    // Not thread-safe.
+    class FrameStatistics {
+      public:
+        static constexpr uint32_t Capacity = 512;
+
+        enum Quantile : uint32_t { P50 = 0, P90, P99, QuantileCount };
+
+        FrameStatistics() {
+            for (auto& estimators : m_estimators) {
+                estimators[P50] = QuantileEstimator(0.5);
+                estimators[P90] = QuantileEstimator(0.9);
+                estimators[P99] = QuantileEstimator(0.99);
+            }
+        }
+
+        void reset() {
+            m_numRecords = m_oneSecondTail = m_numDiscarded = 0;
+            for (auto& estimators : m_estimators) {
+                for (auto& estimator : estimators) {
+                    estimator.reset();
+                }
+            }
+        }
+
+        void record(const FrameRecord& record) {
+            m_records[m_numRecords % Capacity] = record;
+            m_numRecords++;
+
+            if (record.discarded) {
+                m_numDiscarded++;
+            }
+            for (uint32_t i = 0; i < (uint32_t)FrameMetric::Count; i++) {
+                if (record.isMeasured((FrameMetric)i)) {
+                    for (auto& estimator : m_estimators[i]) {
+                        estimator.add((double)record.durationUs[i]);
+                    }
+                }
+            }
+
+            // Keep track of the oldest record within the last second, for the frame rate.
+            m_oneSecondTail = std::max(m_oneSecondTail, m_numRecords > Capacity ? m_numRecords - Capacity : 0);
+            while (record.endTime - m_records[m_oneSecondTail % Capacity].endTime >= 1.0) {
+                m_oneSecondTail++;
+            }
+        }
+
+        // The number of frames completed during the last second (as of the most recent record).
+        uint32_t framesPerSecond() const {
+            return (uint32_t)(m_numRecords - m_oneSecondTail);
+        }
+
+        // The most recent records, with an age of 0 for the latest. The age must be less than size().
+        const FrameRecord& recent(uint32_t age) const {
+            return m_records[(m_numRecords - 1 - age) % Capacity];
+        }
+
+        uint32_t size() const {
+            return (uint32_t)std::min<uint64_t>(m_numRecords, Capacity);
+        }
+
+        uint64_t numFrames() const {
+            return m_numRecords;
+        }
+
+        uint64_t numDiscarded() const {
+            return m_numDiscarded;
+        }
+
+        // The estimate over the whole session, 0 if the metric was never measured.
+        double quantileUs(FrameMetric metric, Quantile quantile) const {
+            return m_estimators[(uint32_t)metric][quantile].value();
+        }
+
+      private:
+        FrameRecord m_records[Capacity];
+        uint64_t m_numRecords{0};
+        uint64_t m_oneSecondTail{0};
+        uint64_t m_numDiscarded{0};
+        QuantileEstimator m_estimators[(uint32_t)FrameMetric::Count][QuantileCount];
+    };
+
+} // namespace virtualdesktop_openxr::utils
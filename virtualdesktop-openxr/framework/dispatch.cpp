@@ -45,6 +45,9 @@ namespace RUNTIME_NAMESPACE {
             result = RUNTIME_NAMESPACE::GetInstance()->xrDestroyInstance(instance);
             if (XR_SUCCEEDED(result)) {
                 RUNTIME_NAMESPACE::ResetInstance();
+
+                // The loader may unload the runtime after this, and the recorder cannot be closed from its destructor.
+                RUNTIME_NAMESPACE::callRecorder.close();
             }
         } catch (std::exception& exc) {
             TraceLoggingWriteTagged(local, "xrDestroyInstance_Error", TLArg(exc.what(), "Error"));
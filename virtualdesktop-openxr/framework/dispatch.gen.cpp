@@ -41,6 +41,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateInstanceExtensionProperties(const char* layerName, uint32_t propertyCapacityInput, uint32_t* propertyCountOutput, XrExtensionProperties* properties) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateInstanceExtensionProperties");
+		CallRecorder::Scope recordCall(callRecorder, 0, "xrEnumerateInstanceExtensionProperties");
+		if (recordCall.isEnabled()) {
+			recordCall.addString(layerName);
+			recordCall.addValue(propertyCapacityInput);
+			recordCall.addOutput(propertyCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -50,6 +57,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateInstanceExtensionProperties: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateInstanceExtensionProperties", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -62,6 +70,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateInstance(const XrInstanceCreateInfo* createInfo, XrInstance* instance) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateInstance");
+		CallRecorder::Scope recordCall(callRecorder, 1, "xrCreateInstance");
+		if (recordCall.isEnabled()) {
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(instance);
+		}
 
 		XrResult result;
 		try {
@@ -71,6 +84,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateInstance: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateInstance", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -83,6 +97,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrPollEvent(XrInstance instance, XrEventDataBuffer* eventData) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrPollEvent");
+		CallRecorder::Scope recordCall(callRecorder, 2, "xrPollEvent");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addOutput(eventData);
+		}
 
 		XrResult result;
 		try {
@@ -92,6 +111,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrPollEvent: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrPollEvent", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -104,6 +124,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrResultToString(XrInstance instance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE]) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrResultToString");
+		CallRecorder::Scope recordCall(callRecorder, 3, "xrResultToString");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(value);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -113,6 +139,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrResultToString: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrResultToString", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -125,6 +152,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrStructureTypeToString(XrInstance instance, XrStructureType value, char buffer[XR_MAX_STRUCTURE_NAME_SIZE]) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrStructureTypeToString");
+		CallRecorder::Scope recordCall(callRecorder, 4, "xrStructureTypeToString");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(value);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -134,6 +167,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrStructureTypeToString: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrStructureTypeToString", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -146,6 +180,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetSystem(XrInstance instance, const XrSystemGetInfo* getInfo, XrSystemId* systemId) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetSystem");
+		CallRecorder::Scope recordCall(callRecorder, 5, "xrGetSystem");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(getInfo);
+			recordCall.addOutput(systemId);
+		}
 
 		XrResult result;
 		try {
@@ -155,6 +195,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetSystem: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetSystem", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -167,6 +208,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetSystemProperties(XrInstance instance, XrSystemId systemId, XrSystemProperties* properties) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetSystemProperties");
+		CallRecorder::Scope recordCall(callRecorder, 6, "xrGetSystemProperties");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addOutput(properties);
+		}
 
 		XrResult result;
 		try {
@@ -176,6 +223,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetSystemProperties: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetSystemProperties", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -188,6 +236,15 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateEnvironmentBlendModes(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t environmentBlendModeCapacityInput, uint32_t* environmentBlendModeCountOutput, XrEnvironmentBlendMode* environmentBlendModes) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateEnvironmentBlendModes");
+		CallRecorder::Scope recordCall(callRecorder, 7, "xrEnumerateEnvironmentBlendModes");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addValue(viewConfigurationType);
+			recordCall.addValue(environmentBlendModeCapacityInput);
+			recordCall.addOutput(environmentBlendModeCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -197,6 +254,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateEnvironmentBlendModes: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateEnvironmentBlendModes", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -209,6 +267,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateSession(XrInstance instance, const XrSessionCreateInfo* createInfo, XrSession* session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateSession");
+		CallRecorder::Scope recordCall(callRecorder, 8, "xrCreateSession");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(session);
+		}
 
 		XrResult result;
 		try {
@@ -218,6 +282,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateSession: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -230,6 +295,10 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroySession(XrSession session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroySession");
+		CallRecorder::Scope recordCall(callRecorder, 9, "xrDestroySession");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+		}
 
 		XrResult result;
 		try {
@@ -239,6 +308,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrDestroySession: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrDestroySession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -251,6 +321,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateReferenceSpaces(XrSession session, uint32_t spaceCapacityInput, uint32_t* spaceCountOutput, XrReferenceSpaceType* spaces) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateReferenceSpaces");
+		CallRecorder::Scope recordCall(callRecorder, 10, "xrEnumerateReferenceSpaces");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addValue(spaceCapacityInput);
+			recordCall.addOutput(spaceCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -260,6 +337,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateReferenceSpaces: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateReferenceSpaces", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -272,6 +350,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo* createInfo, XrSpace* space) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateReferenceSpace");
+		CallRecorder::Scope recordCall(callRecorder, 11, "xrCreateReferenceSpace");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(space);
+		}
 
 		XrResult result;
 		try {
@@ -281,6 +365,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateReferenceSpace: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateReferenceSpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -293,6 +378,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetReferenceSpaceBoundsRect(XrSession session, XrReferenceSpaceType referenceSpaceType, XrExtent2Df* bounds) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetReferenceSpaceBoundsRect");
+		CallRecorder::Scope recordCall(callRecorder, 12, "xrGetReferenceSpaceBoundsRect");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addValue(referenceSpaceType);
+			recordCall.addOutput(bounds);
+		}
 
 		XrResult result;
 		try {
@@ -302,6 +393,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetReferenceSpaceBoundsRect: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetReferenceSpaceBoundsRect", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -314,6 +406,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateActionSpace(XrSession session, const XrActionSpaceCreateInfo* createInfo, XrSpace* space) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateActionSpace");
+		CallRecorder::Scope recordCall(callRecorder, 13, "xrCreateActionSpace");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(space);
+		}
 
 		XrResult result;
 		try {
@@ -323,6 +421,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateActionSpace: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateActionSpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -335,6 +434,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateSpace");
+		CallRecorder::Scope recordCall(callRecorder, 14, "xrLocateSpace");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(space);
+			recordCall.addValue(baseSpace);
+			recordCall.addValue(time);
+			recordCall.addOutput(location);
+		}
 
 		XrResult result;
 		try {
@@ -344,6 +450,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrLocateSpace: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrLocateSpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -356,6 +463,10 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroySpace(XrSpace space) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroySpace");
+		CallRecorder::Scope recordCall(callRecorder, 15, "xrDestroySpace");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(space);
+		}
 
 		XrResult result;
 		try {
@@ -365,6 +476,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrDestroySpace: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrDestroySpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -377,6 +489,14 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateViewConfigurations(XrInstance instance, XrSystemId systemId, uint32_t viewConfigurationTypeCapacityInput, uint32_t* viewConfigurationTypeCountOutput, XrViewConfigurationType* viewConfigurationTypes) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateViewConfigurations");
+		CallRecorder::Scope recordCall(callRecorder, 16, "xrEnumerateViewConfigurations");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addValue(viewConfigurationTypeCapacityInput);
+			recordCall.addOutput(viewConfigurationTypeCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -386,6 +506,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateViewConfigurations: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateViewConfigurations", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -398,6 +519,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetViewConfigurationProperties(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, XrViewConfigurationProperties* configurationProperties) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetViewConfigurationProperties");
+		CallRecorder::Scope recordCall(callRecorder, 17, "xrGetViewConfigurationProperties");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addValue(viewConfigurationType);
+			recordCall.addOutput(configurationProperties);
+		}
 
 		XrResult result;
 		try {
@@ -407,6 +535,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetViewConfigurationProperties: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetViewConfigurationProperties", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -419,6 +548,15 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateViewConfigurationViews(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t viewCapacityInput, uint32_t* viewCountOutput, XrViewConfigurationView* views) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateViewConfigurationViews");
+		CallRecorder::Scope recordCall(callRecorder, 18, "xrEnumerateViewConfigurationViews");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addValue(viewConfigurationType);
+			recordCall.addValue(viewCapacityInput);
+			recordCall.addOutput(viewCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -428,6 +566,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateViewConfigurationViews: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateViewConfigurationViews", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -440,6 +579,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateSwapchainFormats(XrSession session, uint32_t formatCapacityInput, uint32_t* formatCountOutput, int64_t* formats) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateSwapchainFormats");
+		CallRecorder::Scope recordCall(callRecorder, 19, "xrEnumerateSwapchainFormats");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addValue(formatCapacityInput);
+			recordCall.addOutput(formatCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -449,6 +595,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateSwapchainFormats: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateSwapchainFormats", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -461,6 +608,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateSwapchain(XrSession session, const XrSwapchainCreateInfo* createInfo, XrSwapchain* swapchain) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateSwapchain");
+		CallRecorder::Scope recordCall(callRecorder, 20, "xrCreateSwapchain");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(swapchain);
+		}
 
 		XrResult result;
 		try {
@@ -470,6 +623,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateSwapchain: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateSwapchain", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -482,6 +636,10 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroySwapchain(XrSwapchain swapchain) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroySwapchain");
+		CallRecorder::Scope recordCall(callRecorder, 21, "xrDestroySwapchain");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(swapchain);
+		}
 
 		XrResult result;
 		try {
@@ -491,6 +649,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrDestroySwapchain: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrDestroySwapchain", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -503,6 +662,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateSwapchainImages(XrSwapchain swapchain, uint32_t imageCapacityInput, uint32_t* imageCountOutput, XrSwapchainImageBaseHeader* images) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateSwapchainImages");
+		CallRecorder::Scope recordCall(callRecorder, 22, "xrEnumerateSwapchainImages");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(swapchain);
+			recordCall.addValue(imageCapacityInput);
+			recordCall.addOutput(imageCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -512,6 +678,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateSwapchainImages: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateSwapchainImages", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -524,6 +691,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrAcquireSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageAcquireInfo* acquireInfo, uint32_t* index) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrAcquireSwapchainImage");
+		CallRecorder::Scope recordCall(callRecorder, 23, "xrAcquireSwapchainImage");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(swapchain);
+			recordCall.addInput(acquireInfo);
+			recordCall.addOutput(index);
+		}
 
 		XrResult result;
 		try {
@@ -533,6 +706,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrAcquireSwapchainImage: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrAcquireSwapchainImage", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -545,6 +719,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrWaitSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageWaitInfo* waitInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrWaitSwapchainImage");
+		CallRecorder::Scope recordCall(callRecorder, 24, "xrWaitSwapchainImage");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(swapchain);
+			recordCall.addInput(waitInfo);
+		}
 
 		XrResult result;
 		try {
@@ -554,6 +733,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrWaitSwapchainImage: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrWaitSwapchainImage", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -566,6 +746,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrReleaseSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrReleaseSwapchainImage");
+		CallRecorder::Scope recordCall(callRecorder, 25, "xrReleaseSwapchainImage");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(swapchain);
+			recordCall.addInput(releaseInfo);
+		}
 
 		XrResult result;
 		try {
@@ -575,6 +760,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrReleaseSwapchainImage: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrReleaseSwapchainImage", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -587,6 +773,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrBeginSession(XrSession session, const XrSessionBeginInfo* beginInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrBeginSession");
+		CallRecorder::Scope recordCall(callRecorder, 26, "xrBeginSession");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(beginInfo);
+		}
 
 		XrResult result;
 		try {
@@ -596,6 +787,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrBeginSession: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrBeginSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -608,6 +800,10 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEndSession(XrSession session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEndSession");
+		CallRecorder::Scope recordCall(callRecorder, 27, "xrEndSession");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+		}
 
 		XrResult result;
 		try {
@@ -617,6 +813,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEndSession: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEndSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -629,6 +826,10 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrRequestExitSession(XrSession session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrRequestExitSession");
+		CallRecorder::Scope recordCall(callRecorder, 28, "xrRequestExitSession");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+		}
 
 		XrResult result;
 		try {
@@ -638,6 +839,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrRequestExitSession: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrRequestExitSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -650,6 +852,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrWaitFrame(XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrWaitFrame");
+		CallRecorder::Scope recordCall(callRecorder, 29, "xrWaitFrame");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(frameWaitInfo);
+			recordCall.addOutput(frameState);
+		}
 
 		XrResult result;
 		try {
@@ -659,6 +867,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrWaitFrame: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrWaitFrame", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -671,6 +880,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrBeginFrame(XrSession session, const XrFrameBeginInfo* frameBeginInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrBeginFrame");
+		CallRecorder::Scope recordCall(callRecorder, 30, "xrBeginFrame");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(frameBeginInfo);
+		}
 
 		XrResult result;
 		try {
@@ -680,6 +894,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrBeginFrame: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrBeginFrame", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -692,6 +907,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEndFrame");
+		CallRecorder::Scope recordCall(callRecorder, 31, "xrEndFrame");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(frameEndInfo);
+		}
 
 		XrResult result;
 		try {
@@ -701,6 +921,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEndFrame: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEndFrame", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -713,6 +934,15 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateViews(XrSession session, const XrViewLocateInfo* viewLocateInfo, XrViewState* viewState, uint32_t viewCapacityInput, uint32_t* viewCountOutput, XrView* views) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateViews");
+		CallRecorder::Scope recordCall(callRecorder, 32, "xrLocateViews");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(viewLocateInfo);
+			recordCall.addOutput(viewState);
+			recordCall.addValue(viewCapacityInput);
+			recordCall.addOutput(viewCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -722,6 +952,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrLocateViews: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrLocateViews", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -734,6 +965,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrStringToPath(XrInstance instance, const char* pathString, XrPath* path) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrStringToPath");
+		CallRecorder::Scope recordCall(callRecorder, 33, "xrStringToPath");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addString(pathString);
+			recordCall.addOutput(path);
+		}
 
 		XrResult result;
 		try {
@@ -743,6 +980,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrStringToPath: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrStringToPath", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -755,6 +993,14 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrPathToString");
+		CallRecorder::Scope recordCall(callRecorder, 34, "xrPathToString");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(path);
+			recordCall.addValue(bufferCapacityInput);
+			recordCall.addOutput(bufferCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -764,6 +1010,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrPathToString: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrPathToString", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -776,6 +1023,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateActionSet(XrInstance instance, const XrActionSetCreateInfo* createInfo, XrActionSet* actionSet) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateActionSet");
+		CallRecorder::Scope recordCall(callRecorder, 35, "xrCreateActionSet");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(actionSet);
+		}
 
 		XrResult result;
 		try {
@@ -785,6 +1038,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateActionSet: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateActionSet", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -797,6 +1051,10 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyActionSet(XrActionSet actionSet) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyActionSet");
+		CallRecorder::Scope recordCall(callRecorder, 36, "xrDestroyActionSet");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(actionSet);
+		}
 
 		XrResult result;
 		try {
@@ -806,6 +1064,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrDestroyActionSet: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrDestroyActionSet", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -818,6 +1077,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateAction(XrActionSet actionSet, const XrActionCreateInfo* createInfo, XrAction* action) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateAction");
+		CallRecorder::Scope recordCall(callRecorder, 37, "xrCreateAction");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(actionSet);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(action);
+		}
 
 		XrResult result;
 		try {
@@ -827,6 +1092,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateAction: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateAction", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -839,6 +1105,10 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyAction(XrAction action) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyAction");
+		CallRecorder::Scope recordCall(callRecorder, 38, "xrDestroyAction");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(action);
+		}
 
 		XrResult result;
 		try {
@@ -848,6 +1118,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrDestroyAction: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrDestroyAction", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -860,6 +1131,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrSuggestInteractionProfileBindings(XrInstance instance, const XrInteractionProfileSuggestedBinding* suggestedBindings) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrSuggestInteractionProfileBindings");
+		CallRecorder::Scope recordCall(callRecorder, 39, "xrSuggestInteractionProfileBindings");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(suggestedBindings);
+		}
 
 		XrResult result;
 		try {
@@ -869,6 +1145,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrSuggestInteractionProfileBindings: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrSuggestInteractionProfileBindings", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -881,6 +1158,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo* attachInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrAttachSessionActionSets");
+		CallRecorder::Scope recordCall(callRecorder, 40, "xrAttachSessionActionSets");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(attachInfo);
+		}
 
 		XrResult result;
 		try {
@@ -890,6 +1172,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrAttachSessionActionSets: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrAttachSessionActionSets", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -902,6 +1185,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetCurrentInteractionProfile(XrSession session, XrPath topLevelUserPath, XrInteractionProfileState* interactionProfile) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetCurrentInteractionProfile");
+		CallRecorder::Scope recordCall(callRecorder, 41, "xrGetCurrentInteractionProfile");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addValue(topLevelUserPath);
+			recordCall.addOutput(interactionProfile);
+		}
 
 		XrResult result;
 		try {
@@ -911,6 +1200,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetCurrentInteractionProfile: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetCurrentInteractionProfile", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -923,6 +1213,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStateBoolean(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateBoolean* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStateBoolean");
+		CallRecorder::Scope recordCall(callRecorder, 42, "xrGetActionStateBoolean");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(getInfo);
+			recordCall.addOutput(state);
+		}
 
 		XrResult result;
 		try {
@@ -932,6 +1228,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetActionStateBoolean: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetActionStateBoolean", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -944,6 +1241,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStateFloat(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateFloat* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStateFloat");
+		CallRecorder::Scope recordCall(callRecorder, 43, "xrGetActionStateFloat");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(getInfo);
+			recordCall.addOutput(state);
+		}
 
 		XrResult result;
 		try {
@@ -953,6 +1256,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetActionStateFloat: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetActionStateFloat", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -965,6 +1269,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStateVector2f(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateVector2f* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStateVector2f");
+		CallRecorder::Scope recordCall(callRecorder, 44, "xrGetActionStateVector2f");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(getInfo);
+			recordCall.addOutput(state);
+		}
 
 		XrResult result;
 		try {
@@ -974,6 +1284,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetActionStateVector2f: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetActionStateVector2f", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -986,6 +1297,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStatePose(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStatePose* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStatePose");
+		CallRecorder::Scope recordCall(callRecorder, 45, "xrGetActionStatePose");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(getInfo);
+			recordCall.addOutput(state);
+		}
 
 		XrResult result;
 		try {
@@ -995,6 +1312,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetActionStatePose: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetActionStatePose", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1007,6 +1325,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrSyncActions");
+		CallRecorder::Scope recordCall(callRecorder, 46, "xrSyncActions");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(syncInfo);
+		}
 
 		XrResult result;
 		try {
@@ -1016,6 +1339,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrSyncActions: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrSyncActions", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1028,6 +1352,14 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateBoundSourcesForAction(XrSession session, const XrBoundSourcesForActionEnumerateInfo* enumerateInfo, uint32_t sourceCapacityInput, uint32_t* sourceCountOutput, XrPath* sources) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateBoundSourcesForAction");
+		CallRecorder::Scope recordCall(callRecorder, 47, "xrEnumerateBoundSourcesForAction");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(enumerateInfo);
+			recordCall.addValue(sourceCapacityInput);
+			recordCall.addOutput(sourceCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -1037,6 +1369,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateBoundSourcesForAction: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateBoundSourcesForAction", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1049,6 +1382,14 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetInputSourceLocalizedName(XrSession session, const XrInputSourceLocalizedNameGetInfo* getInfo, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetInputSourceLocalizedName");
+		CallRecorder::Scope recordCall(callRecorder, 48, "xrGetInputSourceLocalizedName");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(getInfo);
+			recordCall.addValue(bufferCapacityInput);
+			recordCall.addOutput(bufferCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -1058,6 +1399,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetInputSourceLocalizedName: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetInputSourceLocalizedName", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1070,6 +1412,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrApplyHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo, const XrHapticBaseHeader* hapticFeedback) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrApplyHapticFeedback");
+		CallRecorder::Scope recordCall(callRecorder, 49, "xrApplyHapticFeedback");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(hapticActionInfo);
+			recordCall.addInput(hapticFeedback);
+		}
 
 		XrResult result;
 		try {
@@ -1079,6 +1427,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrApplyHapticFeedback: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrApplyHapticFeedback", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1091,6 +1440,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrStopHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrStopHapticFeedback");
+		CallRecorder::Scope recordCall(callRecorder, 50, "xrStopHapticFeedback");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(hapticActionInfo);
+		}
 
 		XrResult result;
 		try {
@@ -1100,6 +1454,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrStopHapticFeedback: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrStopHapticFeedback", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1112,6 +1467,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetOpenGLGraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsOpenGLKHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetOpenGLGraphicsRequirementsKHR");
+		CallRecorder::Scope recordCall(callRecorder, 51, "xrGetOpenGLGraphicsRequirementsKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addOutput(graphicsRequirements);
+		}
 
 		XrResult result;
 		try {
@@ -1121,6 +1482,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetOpenGLGraphicsRequirementsKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetOpenGLGraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1133,6 +1495,14 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanInstanceExtensionsKHR(XrInstance instance, XrSystemId systemId, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanInstanceExtensionsKHR");
+		CallRecorder::Scope recordCall(callRecorder, 52, "xrGetVulkanInstanceExtensionsKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addValue(bufferCapacityInput);
+			recordCall.addOutput(bufferCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -1142,6 +1512,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetVulkanInstanceExtensionsKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetVulkanInstanceExtensionsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1154,6 +1525,14 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanDeviceExtensionsKHR(XrInstance instance, XrSystemId systemId, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanDeviceExtensionsKHR");
+		CallRecorder::Scope recordCall(callRecorder, 53, "xrGetVulkanDeviceExtensionsKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addValue(bufferCapacityInput);
+			recordCall.addOutput(bufferCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -1163,6 +1542,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetVulkanDeviceExtensionsKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetVulkanDeviceExtensionsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1175,6 +1555,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsDeviceKHR(XrInstance instance, XrSystemId systemId, VkInstance vkInstance, VkPhysicalDevice* vkPhysicalDevice) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsDeviceKHR");
+		CallRecorder::Scope recordCall(callRecorder, 54, "xrGetVulkanGraphicsDeviceKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addValue(vkInstance);
+			recordCall.addOutput(vkPhysicalDevice);
+		}
 
 		XrResult result;
 		try {
@@ -1184,6 +1571,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetVulkanGraphicsDeviceKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsDeviceKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1196,6 +1584,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsVulkanKHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsRequirementsKHR");
+		CallRecorder::Scope recordCall(callRecorder, 55, "xrGetVulkanGraphicsRequirementsKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addOutput(graphicsRequirements);
+		}
 
 		XrResult result;
 		try {
@@ -1205,6 +1599,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetVulkanGraphicsRequirementsKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1217,6 +1612,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetD3D11GraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsD3D11KHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetD3D11GraphicsRequirementsKHR");
+		CallRecorder::Scope recordCall(callRecorder, 56, "xrGetD3D11GraphicsRequirementsKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addOutput(graphicsRequirements);
+		}
 
 		XrResult result;
 		try {
@@ -1226,6 +1627,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetD3D11GraphicsRequirementsKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetD3D11GraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1238,6 +1640,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetD3D12GraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsD3D12KHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetD3D12GraphicsRequirementsKHR");
+		CallRecorder::Scope recordCall(callRecorder, 57, "xrGetD3D12GraphicsRequirementsKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addOutput(graphicsRequirements);
+		}
 
 		XrResult result;
 		try {
@@ -1247,6 +1655,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetD3D12GraphicsRequirementsKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetD3D12GraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1259,6 +1668,14 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVisibilityMaskKHR(XrSession session, XrViewConfigurationType viewConfigurationType, uint32_t viewIndex, XrVisibilityMaskTypeKHR visibilityMaskType, XrVisibilityMaskKHR* visibilityMask) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVisibilityMaskKHR");
+		CallRecorder::Scope recordCall(callRecorder, 58, "xrGetVisibilityMaskKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addValue(viewConfigurationType);
+			recordCall.addValue(viewIndex);
+			recordCall.addValue(visibilityMaskType);
+			recordCall.addOutput(visibilityMask);
+		}
 
 		XrResult result;
 		try {
@@ -1268,6 +1685,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetVisibilityMaskKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetVisibilityMaskKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1280,6 +1698,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrConvertWin32PerformanceCounterToTimeKHR(XrInstance instance, const LARGE_INTEGER* performanceCounter, XrTime* time) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrConvertWin32PerformanceCounterToTimeKHR");
+		CallRecorder::Scope recordCall(callRecorder, 59, "xrConvertWin32PerformanceCounterToTimeKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(performanceCounter);
+			recordCall.addOutput(time);
+		}
 
 		XrResult result;
 		try {
@@ -1289,6 +1713,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrConvertWin32PerformanceCounterToTimeKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrConvertWin32PerformanceCounterToTimeKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1301,6 +1726,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrConvertTimeToWin32PerformanceCounterKHR(XrInstance instance, XrTime time, LARGE_INTEGER* performanceCounter) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrConvertTimeToWin32PerformanceCounterKHR");
+		CallRecorder::Scope recordCall(callRecorder, 60, "xrConvertTimeToWin32PerformanceCounterKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(time);
+			recordCall.addOutput(performanceCounter);
+		}
 
 		XrResult result;
 		try {
@@ -1310,6 +1741,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrConvertTimeToWin32PerformanceCounterKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrConvertTimeToWin32PerformanceCounterKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1322,6 +1754,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateVulkanInstanceKHR(XrInstance instance, const XrVulkanInstanceCreateInfoKHR* createInfo, VkInstance* vulkanInstance, VkResult* vulkanResult) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateVulkanInstanceKHR");
+		CallRecorder::Scope recordCall(callRecorder, 61, "xrCreateVulkanInstanceKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(vulkanInstance);
+			recordCall.addOutput(vulkanResult);
+		}
 
 		XrResult result;
 		try {
@@ -1331,6 +1770,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateVulkanInstanceKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateVulkanInstanceKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1343,6 +1783,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateVulkanDeviceKHR(XrInstance instance, const XrVulkanDeviceCreateInfoKHR* createInfo, VkDevice* vulkanDevice, VkResult* vulkanResult) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateVulkanDeviceKHR");
+		CallRecorder::Scope recordCall(callRecorder, 62, "xrCreateVulkanDeviceKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(createInfo);
+			recordCall.addOutput(vulkanDevice);
+			recordCall.addOutput(vulkanResult);
+		}
 
 		XrResult result;
 		try {
@@ -1352,6 +1799,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrCreateVulkanDeviceKHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrCreateVulkanDeviceKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1364,6 +1812,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsDevice2KHR(XrInstance instance, const XrVulkanGraphicsDeviceGetInfoKHR* getInfo, VkPhysicalDevice* vulkanPhysicalDevice) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsDevice2KHR");
+		CallRecorder::Scope recordCall(callRecorder, 63, "xrGetVulkanGraphicsDevice2KHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addInput(getInfo);
+			recordCall.addOutput(vulkanPhysicalDevice);
+		}
 
 		XrResult result;
 		try {
@@ -1373,6 +1827,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetVulkanGraphicsDevice2KHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsDevice2KHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1385,6 +1840,12 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsRequirements2KHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsVulkanKHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsRequirements2KHR");
+		CallRecorder::Scope recordCall(callRecorder, 64, "xrGetVulkanGraphicsRequirements2KHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(instance);
+			recordCall.addValue(systemId);
+			recordCall.addOutput(graphicsRequirements);
+		}
 
 		XrResult result;
 		try {
@@ -1394,6 +1855,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetVulkanGraphicsRequirements2KHR: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsRequirements2KHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1406,6 +1868,13 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateDisplayRefreshRatesFB(XrSession session, uint32_t displayRefreshRateCapacityInput, uint32_t* displayRefreshRateCountOutput, float* displayRefreshRates) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateDisplayRefreshRatesFB");
+		CallRecorder::Scope recordCall(callRecorder, 65, "xrEnumerateDisplayRefreshRatesFB");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addValue(displayRefreshRateCapacityInput);
+			recordCall.addOutput(displayRefreshRateCountOutput);
+			recordCall.addArray();
+		}
 
 		XrResult result;
 		try {
@@ -1415,6 +1884,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrEnumerateDisplayRefreshRatesFB: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrEnumerateDisplayRefreshRatesFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1427,6 +1897,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetDisplayRefreshRateFB(XrSession session, float* displayRefreshRate) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetDisplayRefreshRateFB");
+		CallRecorder::Scope recordCall(callRecorder, 66, "xrGetDisplayRefreshRateFB");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addOutput(displayRefreshRate);
+		}
 
 		XrResult result;
 		try {
@@ -1436,6 +1911,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrGetDisplayRefreshRateFB: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrGetDisplayRefreshRateFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1448,6 +1924,11 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrRequestDisplayRefreshRateFB(XrSession session, float displayRefreshRate) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrRequestDisplayRefreshRateFB");
+		CallRecorder::Scope recordCall(callRecorder, 67, "xrRequestDisplayRefreshRateFB");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addValue(displayRefreshRate);
+		}
 
 		XrResult result;
 		try {
@@ -1457,6 +1938,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("xrRequestDisplayRefreshRateFB: %s\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "xrRequestDisplayRefreshRateFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
@@ -1466,6 +1948,36 @@ namespace RUNTIME_NAMESPACE {
 		return result;
 	}
 
+	XrResult XRAPI_CALL xrLocateSpacesKHR(XrSession session, const XrSpacesLocateInfoKHR* locateInfo, XrSpaceLocationsKHR* spaceLocations) {
+		TraceLocalActivity(local);
+		TraceLoggingWriteStart(local, "xrLocateSpacesKHR");
+		CallRecorder::Scope recordCall(callRecorder, 68, "xrLocateSpacesKHR");
+		if (recordCall.isEnabled()) {
+			recordCall.addValue(session);
+			recordCall.addInput(locateInfo);
+			recordCall.addOutput(spaceLocations);
+		}
+
+		XrResult result;
+		try {
+			result = RUNTIME_NAMESPACE::GetInstance()->xrLocateSpacesKHR(session, locateInfo, spaceLocations);
+		} catch (std::exception& exc) {
+			TraceLoggingWriteTagged(local, "xrLocateSpacesKHR_Error", TLArg(exc.what(), "Error"));
+			ErrorLog("xrLocateSpacesKHR: %s\n", exc.what());
+			result = XR_ERROR_RUNTIME_FAILURE;
+		}
+		recordCall.setResult(result);
+
+		TraceLoggingWriteStop(local, "xrLocateSpacesKHR", TLArg(xr::ToCString(result), "Result"));
+		if (XR_FAILED(result)) {
+			ErrorLog("xrLocateSpacesKHR failed with %s\n", xr::ToCString(result));
+		}
+
+		return result;
+	}
+
+	static_assert(69 <= CallRecorder::k_maxEntryPoints, "Too many entry points for the call recorder");
+
 
 	// Auto-generated dispatcher handler.
 	XrResult OpenXrApi::xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
@@ -1684,6 +2196,9 @@ namespace RUNTIME_NAMESPACE {
 		else if (has_XR_FB_display_refresh_rate && apiName == "xrRequestDisplayRefreshRateFB") {
 			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrRequestDisplayRefreshRateFB);
 		}
+		else if (has_XR_KHR_locate_spaces && apiName == "xrLocateSpacesKHR") {
+			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateSpacesKHR);
+		}
 		else {
 			return XR_ERROR_FUNCTION_UNSUPPORTED;
 		}
@@ -1731,6 +2246,9 @@ namespace RUNTIME_NAMESPACE {
 		else if (extensionName == "XR_META_headset_id") {
 			has_XR_META_headset_id = true;
 		}
+		else if (extensionName == "XR_KHR_locate_spaces") {
+			has_XR_KHR_locate_spaces = true;
+		}
 
 	}
 
@@ -111,6 +111,7 @@ namespace RUNTIME_NAMESPACE {
 		virtual XrResult xrEnumerateDisplayRefreshRatesFB(XrSession session, uint32_t displayRefreshRateCapacityInput, uint32_t* displayRefreshRateCountOutput, float* displayRefreshRates) = 0;
 		virtual XrResult xrGetDisplayRefreshRateFB(XrSession session, float* displayRefreshRate) = 0;
 		virtual XrResult xrRequestDisplayRefreshRateFB(XrSession session, float displayRefreshRate) = 0;
+		virtual XrResult xrLocateSpacesKHR(XrSession session, const XrSpacesLocateInfoKHR* locateInfo, XrSpaceLocationsKHR* spaceLocations) = 0;
 
 
 	protected:
@@ -130,6 +131,7 @@ namespace RUNTIME_NAMESPACE {
 		bool has_XR_EXT_eye_gaze_interaction{false};
 		bool has_XR_EXT_uuid{false};
 		bool has_XR_META_headset_id{false};
+		bool has_XR_KHR_locate_spaces{false};
 
 
 	};
@@ -44,7 +44,8 @@ SPECIAL_API = ['xrDestroyInstance']
 VERY_SPECIAL_API = ['xrGetInstanceProperties']
 EXTENSIONS = ['XR_KHR_D3D11_enable', 'XR_KHR_D3D12_enable', 'XR_KHR_vulkan_enable', 'XR_KHR_vulkan_enable2', 'XR_KHR_opengl_enable',
               'XR_KHR_composition_layer_depth', 'XR_KHR_visibility_mask', 'XR_KHR_win32_convert_performance_counter_time', 'XR_FB_display_refresh_rate',
-              'XR_EXT_eye_gaze_interaction', 'XR_EXT_uuid', 'XR_META_headset_id']
+              'XR_EXT_eye_gaze_interaction', 'XR_EXT_uuid', 'XR_META_headset_id',
+              'XR_KHR_locate_spaces']
 
 class DispatchGenOutputGenerator(AutomaticSourceOutputGenerator):
     '''Common generator utilities and formatting.'''
@@ -98,6 +99,24 @@ class DispatchGenOutputGenerator(AutomaticSourceOutputGenerator):
 
         return arguments_list
 
+    # The statements capturing each parameter of a command for the call recorder (see call_recorder.h).
+    def makeRecordArguments(self, cmd):
+        record_arguments = ""
+        for param in cmd.params:
+            if param.is_null_terminated:
+                capture = f'addString({param.name})'
+            elif param.is_array or param.is_static_array:
+                capture = 'addArray()'
+            elif param.pointer_count == 0:
+                capture = f'addValue({param.name})'
+            elif param.is_const:
+                capture = f'addInput({param.name})'
+            else:
+                capture = f'addOutput({param.name})'
+            record_arguments += f'\t\t\trecordCall.{capture};\n'
+
+        return record_arguments
+
 class DispatchGenCppOutputGenerator(DispatchGenOutputGenerator):
     '''Generator for dispatch.gen.cpp.'''
     def beginFile(self, genOpts):
@@ -144,16 +163,22 @@ namespace RUNTIME_NAMESPACE {
     def genWrappers(self):
         generated = ''
 
+        # The call recorder identifies the entry points by the order of their wrappers.
+        entry_point_id = 0
         for cur_cmd in self.core_commands + self.ext_commands:
             if cur_cmd.name not in EXCLUDED_API + SPECIAL_API + VERY_SPECIAL_API:
                 parameters_list = self.makeParametersList(cur_cmd)
                 arguments_list = self.makeArgumentsList(cur_cmd)
+                record_arguments = self.makeRecordArguments(cur_cmd)
 
                 if cur_cmd.return_type is not None:
                     generated += f'''
 	XrResult XRAPI_CALL {cur_cmd.name}({parameters_list}) {{
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "{cur_cmd.name}");
+		CallRecorder::Scope recordCall(callRecorder, {entry_point_id}, "{cur_cmd.name}");
+		if (recordCall.isEnabled()) {{
+{record_arguments}		}}
 
 		XrResult result;
 		try {{
@@ -163,6 +188,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("{cur_cmd.name}: %s\\n", exc.what());
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}}
+		recordCall.setResult(result);
 
 		TraceLoggingWriteStop(local, "{cur_cmd.name}", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {{
@@ -177,6 +203,9 @@ namespace RUNTIME_NAMESPACE {
 	void XRAPI_CALL {cur_cmd.name}({parameters_list}) {{
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "{cur_cmd.name}");
+		CallRecorder::Scope recordCall(callRecorder, {entry_point_id}, "{cur_cmd.name}");
+		if (recordCall.isEnabled()) {{
+{record_arguments}		}}
 
 		try {{
 			RUNTIME_NAMESPACE::GetInstance()->{cur_cmd.name}({arguments_list});
@@ -188,7 +217,12 @@ namespace RUNTIME_NAMESPACE {
 		TraceLoggingWriteStop(local, "{cur_cmd.name}");
 	}}
 '''
-                
+                entry_point_id += 1
+
+        generated += f'''
+	static_assert({entry_point_id} <= CallRecorder::k_maxEntryPoints, "Too many entry points for the call recorder");
+'''
+
         return generated
 
     def genGetInstanceProcAddr(self):
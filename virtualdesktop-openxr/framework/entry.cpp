@@ -37,6 +37,8 @@ namespace RUNTIME_NAMESPACE {
     // The path to store logs & others.
     std::filesystem::path localAppData;
 
+    utils::CallRecorder callRecorder;
+
     namespace log {
         // The file logger.
         std::ofstream logStream;
@@ -77,6 +79,16 @@ XrResult __declspec(dllexport) XRAPI_CALL xrNegotiateLoaderRuntimeInterface(cons
 
     Log("%s\n", RuntimePrettyName.c_str());
 
+    // Start recording the OpenXR calls if requested.
+    if (RegGetDword(HKEY_LOCAL_MACHINE, RegPrefix, "record_calls").value_or(0) && !callRecorder.isEnabled()) {
+        const auto callsFile = localAppData / (RuntimeName + ".calls");
+        if (callRecorder.open(callsFile)) {
+            Log("Recording OpenXR calls to %s\n", callsFile.string().c_str());
+        } else {
+            ErrorLog("Failed to open %s\n", callsFile.string().c_str());
+        }
+    }
+
     if (!loaderInfo || !runtimeRequest || loaderInfo->structType != XR_LOADER_INTERFACE_STRUCT_LOADER_INFO ||
         loaderInfo->structVersion != XR_LOADER_INFO_STRUCT_VERSION ||
         loaderInfo->structSize != sizeof(XrNegotiateLoaderInfo) ||
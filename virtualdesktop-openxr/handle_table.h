@@ -0,0 +1,170 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // A generational slot map to hand out OpenXR handles.
+    // Handles encode the slot index in the lower 32 bits and the generation of the slot in the upper 32 bits. A
+    // stale handle (to an object that was destroyed, even if the slot was since reused) is detected by comparing the
+    // generation. The objects are stored in chunks (std::deque), which keeps them at a stable address for their
+    // entire lifetime, even as new objects are added.
+    template <typename T, typename Handle>
+    class HandleTable {
+      public:
+        template <typename... Args>
+        Handle emplace(Args&&... args) {
+            uint32_t index;
+            if (!m_freeList.empty()) {
+                index = m_freeList.back();
+                m_freeList.pop_back();
+            } else {
+                index = (uint32_t)m_slots.size();
+                m_slots.emplace_back();
+            }
+
+            Slot& slot = m_slots[index];
+            slot.object.emplace(std::forward<Args>(args)...);
+            m_count++;
+
+            return makeHandle(index, slot.generation);
+        }
+
+        bool erase(Handle handle) {
+            Slot* const slot = find(handle);
+            if (!slot) {
+                return false;
+            }
+
+            slot->object.reset();
+
+            // Invalidate all outstanding handles to this slot. Generation 0 is never used, so that no valid handle
+            // can ever be XR_NULL_HANDLE.
+            slot->generation++;
+            if (slot->generation == 0) {
+                slot->generation = 1;
+            }
+            m_freeList.push_back(getIndex(handle));
+            m_count--;
+
+            return true;
+        }
+
+        T* get(Handle handle) {
+            Slot* const slot = find(handle);
+            return slot ? &slot->object.value() : nullptr;
+        }
+
+        const T* get(Handle handle) const {
+            return const_cast<HandleTable*>(this)->get(handle);
+        }
+
+        bool contains(Handle handle) const {
+            return get(handle) != nullptr;
+        }
+
+        // Invoke a function for each live object, with signature void(Handle, T&).
+        template <typename F>
+        void forEach(F&& f) {
+            for (uint32_t i = 0; i < (uint32_t)m_slots.size(); i++) {
+                Slot& slot = m_slots[i];
+                if (slot.object) {
+                    f(makeHandle(i, slot.generation), slot.object.value());
+                }
+            }
+        }
+
+        std::vector<Handle> handles() const {
+            std::vector<Handle> result;
+            result.reserve(m_count);
+            for (uint32_t i = 0; i < (uint32_t)m_slots.size(); i++) {
+                if (m_slots[i].object) {
+                    result.push_back(makeHandle(i, m_slots[i].generation));
+                }
+            }
+            return result;
+        }
+
+        size_t size() const {
+            return m_count;
+        }
+
+        bool empty() const {
+            return m_count == 0;
+        }
+
+        // The number of slots, including the free ones. Slot indices are always below this value.
+        uint32_t capacity() const {
+            return (uint32_t)m_slots.size();
+        }
+
+        // The slot index for a handle, which can be used to index side tables.
+        static uint32_t indexOf(Handle handle) {
+            return getIndex(handle);
+        }
+
+        void clear() {
+            for (uint32_t i = 0; i < (uint32_t)m_slots.size(); i++) {
+                if (m_slots[i].object) {
+                    erase(makeHandle(i, m_slots[i].generation));
+                }
+            }
+        }
+
+      private:
+        struct Slot {
+            uint32_t generation{1};
+            std::optional<T> object;
+        };
+
+        static Handle makeHandle(uint32_t index, uint32_t generation) {
+            return (Handle)(((uint64_t)generation << 32) | index);
+        }
+
+        static uint32_t getIndex(Handle handle) {
+            return (uint32_t)((uint64_t)handle & 0xffffffff);
+        }
+
+        static uint32_t getGeneration(Handle handle) {
+            return (uint32_t)((uint64_t)handle >> 32);
+        }
+
+        Slot* find(Handle handle) {
+            const uint32_t index = getIndex(handle);
+            if (index >= m_slots.size()) {
+                return nullptr;
+            }
+
+            Slot& slot = m_slots[index];
+            if (!slot.object || slot.generation != getGeneration(handle)) {
+                return nullptr;
+            }
+
+            return &slot;
+        }
+
+        std::deque<Slot> m_slots;
+        std::vector<uint32_t> m_freeList;
+        size_t m_count{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -137,20 +137,14 @@ namespace virtualdesktop_openxr {
         }
 
         initializeExtensionsTable();
-        initializeRemappingTables();
+
+        // Intern the top-level paths that the action bindings are pre-resolved for.
+        m_handSubactionPath[0] = stringToPath("/user/hand/left");
+        m_handSubactionPath[1] = stringToPath("/user/hand/right");
+        m_eyesSubactionPath = stringToPath("/user/eyes_ext");
     }
 
     OpenXrRuntime::~OpenXrRuntime() {
-        // Destroy actionset and actions (tied to the instance).
-        for (auto action : m_actionsForCleanup) {
-            Action* xrAction = (Action*)action;
-            delete xrAction;
-        }
-        for (auto actionSet : m_actionSets) {
-            ActionSet* xrActionSet = (ActionSet*)actionSet;
-            delete xrActionSet;
-        }
-
         if (m_sessionCreated) {
             // TODO: Ideally we do not invoke OpenXR public APIs to avoid confusing event tracing and possible
             // deadlocks.
@@ -459,6 +453,9 @@ namespace virtualdesktop_openxr {
         m_extensionsTable.push_back({XR_EXT_UUID_EXTENSION_NAME, XR_EXT_uuid_SPEC_VERSION});
         m_extensionsTable.push_back({XR_META_HEADSET_ID_EXTENSION_NAME, XR_META_headset_id_SPEC_VERSION});
 
+        // Batched space location.
+        m_extensionsTable.push_back({XR_KHR_LOCATE_SPACES_EXTENSION_NAME, XR_KHR_locate_spaces_SPEC_VERSION});
+
         // FIXME: Add new extensions here.
     }
 
@@ -536,6 +533,10 @@ namespace virtualdesktop_openxr {
         g_instance.reset();
     }
 
+    void SetInstance(std::unique_ptr<OpenXrRuntime> instance) {
+        g_instance = std::move(instance);
+    }
+
 } // namespace virtualdesktop_openxr
 
 extern "C" __declspec(dllexport) const char* WINAPI getVersionString() {
@@ -43,6 +43,103 @@ namespace virtualdesktop_openxr::log {
 #endif
 #define TLPArray(var, count, ...) TraceLoggingCodePointerArray((void**)var, (UINT16)count, ##__VA_ARGS__)
 
+// Same as TraceLoggingWrite(), but nothing (not even the arguments) is evaluated unless a trace session is listening.
+// Use for events on hot paths whose arguments need formatting.
+#define TraceLoggingWriteIfEnabled(provider, eventName, ...)                                                           \
+    do {                                                                                                               \
+        if (TraceLoggingProviderEnabled(provider, 0, 0)) {                                                             \
+            TraceLoggingWrite(provider, eventName, ##__VA_ARGS__);                                                     \
+        }                                                                                                              \
+    } while (false)
+
+    // Text for a trace argument, formatted on the stack (no heap allocation). Only valid until the end of the
+    // statement, which is all TraceLoggingWrite() needs.
+    struct TraceString {
+        char buffer[128];
+
+        const char* c_str() const {
+            return buffer;
+        }
+    };
+
+    static inline TraceString ToTraceString(const XrPosef& pose) {
+        TraceString str;
+        snprintf(str.buffer,
+                 sizeof(str.buffer),
+                 "p: (%.3f, %.3f, %.3f), o:(%.3f, %.3f, %.3f, %.3f)",
+                 pose.position.x,
+                 pose.position.y,
+                 pose.position.z,
+                 pose.orientation.x,
+                 pose.orientation.y,
+                 pose.orientation.z,
+                 pose.orientation.w);
+        return str;
+    }
+
+    static inline TraceString ToTraceString(const ovrPosef& pose) {
+        TraceString str;
+        snprintf(str.buffer,
+                 sizeof(str.buffer),
+                 "p: (%.3f, %.3f, %.3f), o:(%.3f, %.3f, %.3f, %.3f)",
+                 pose.Position.x,
+                 pose.Position.y,
+                 pose.Position.z,
+                 pose.Orientation.x,
+                 pose.Orientation.y,
+                 pose.Orientation.z,
+                 pose.Orientation.w);
+        return str;
+    }
+
+    static inline TraceString ToTraceString(const XrVector3f& vec) {
+        TraceString str;
+        snprintf(str.buffer, sizeof(str.buffer), "(%.3f, %.3f, %.3f)", vec.x, vec.y, vec.z);
+        return str;
+    }
+
+    static inline TraceString ToTraceString(const ovrVector3f& vec) {
+        TraceString str;
+        snprintf(str.buffer, sizeof(str.buffer), "(%.3f, %.3f, %.3f)", vec.x, vec.y, vec.z);
+        return str;
+    }
+
+    static inline TraceString ToTraceString(const XrVector2f& vec) {
+        TraceString str;
+        snprintf(str.buffer, sizeof(str.buffer), "(%.3f, %.3f)", vec.x, vec.y);
+        return str;
+    }
+
+    static inline TraceString ToTraceString(const ovrVector2f& vec) {
+        TraceString str;
+        snprintf(str.buffer, sizeof(str.buffer), "(%.3f, %.3f)", vec.x, vec.y);
+        return str;
+    }
+
+    static inline TraceString ToTraceString(const XrFovf& fov) {
+        TraceString str;
+        snprintf(str.buffer,
+                 sizeof(str.buffer),
+                 "(l:%.3f, r:%.3f, u:%.3f, d:%.3f)",
+                 fov.angleLeft,
+                 fov.angleRight,
+                 fov.angleUp,
+                 fov.angleDown);
+        return str;
+    }
+
+    static inline TraceString ToTraceString(const XrRect2Di& rect) {
+        TraceString str;
+        snprintf(str.buffer,
+                 sizeof(str.buffer),
+                 "x:%d, y:%d w:%d h:%d",
+                 rect.offset.x,
+                 rect.offset.y,
+                 rect.extent.width,
+                 rect.extent.height);
+        return str;
+    }
+
     // General logging function.
     void Log(const char* fmt, ...);
 
@@ -26,459 +26,507 @@
 #include "runtime.h"
 #include "utils.h"
 
-namespace {
-    std::string rreplace(const std::string& str, const std::string& from, const std::string& to) {
-        std::string copy(str);
-        const size_t start_pos = str.rfind(from);
-        copy.replace(start_pos, from.length(), to);
-
-        return copy;
-    }
-} // namespace
-
 namespace virtualdesktop_openxr {
 
     using namespace virtualdesktop_openxr::log;
     using namespace virtualdesktop_openxr::utils;
 
-    void OpenXrRuntime::initializeRemappingTables() {
-        // 1:1 mappings.
-        m_controllerMappingTable.insert_or_assign(std::make_pair("/interaction_profiles/oculus/touch_controller",
-                                                                 "/interaction_profiles/oculus/touch_controller"),
-                                                  [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                                                      return mapPathToTouchControllerInputState(
-                                                          xrAction, getXrPath(binding), source);
-                                                  });
-
-        // Virtual mappings to Touch controller.
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/valve/index_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapIndexControllerToTouchController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/htc/vive_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapViveControllerToTouchController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/microsoft/motion_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapMicrosoftMotionControllerToTouchController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/khr/simple_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapSimpleControllerToTouchController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToTouchControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-
-        // Functions for validating paths.
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/oculus/touch_controller",
-            [&](const std::string& path) { return getTouchControllerLocalizedSourceName(path) != "<Unknown>"; });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/khr/simple_controller", [&](const std::string& path) {
-                if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select") ||
-                    endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu") ||
-                    endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                    endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                    endsWith(path, "/output/haptic")) {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/htc/vive_controller", [&](const std::string& path) {
-                if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system") ||
-                    endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/force") ||
-                    endsWith(path, "/input/squeeze") || endsWith(path, "/input/menu/click") ||
-                    endsWith(path, "/input/menu") || endsWith(path, "/input/trigger/click") ||
-                    endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger") ||
-                    endsWith(path, "/input/trackpad") || endsWith(path, "/input/trackpad/x") ||
-                    endsWith(path, "/input/trackpad/y") || endsWith(path, "/input/trackpad/click") ||
-                    endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad") ||
-                    endsWith(path, "/input/trackpad/touch") || endsWith(path, "/input/grip/pose") ||
-                    endsWith(path, "/input/grip") || endsWith(path, "/input/aim/pose") ||
-                    endsWith(path, "/input/aim") || endsWith(path, "/output/haptic")) {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/valve/index_controller", [&](const std::string& path) {
-                if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system") ||
-                    endsWith(path, "/input/system/touch") || endsWith(path, "/input/a/click") ||
-                    endsWith(path, "/input/a") || endsWith(path, "/input/a/touch") ||
-                    endsWith(path, "/input/b/click") || endsWith(path, "/input/b") ||
-                    endsWith(path, "/input/b/touch") || endsWith(path, "/input/squeeze/click") ||
-                    endsWith(path, "/input/squeeze/value") || endsWith(path, "/input/squeeze") ||
-                    endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/trigger/click") ||
-                    endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger") ||
-                    endsWith(path, "/input/trigger/touch") || endsWith(path, "/input/thumbstick") ||
-                    endsWith(path, "/input/thumbstick/x") || endsWith(path, "/input/thumbstick/y") ||
-                    endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick") ||
-                    endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/trackpad") ||
-                    endsWith(path, "/input/trackpad/x") || endsWith(path, "/input/trackpad/y") ||
-                    endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad/touch") ||
-                    endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                    endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                    endsWith(path, "/output/haptic")) {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/microsoft/motion_controller", [&](const std::string& path) {
-                if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu") ||
-                    endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                    endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                    endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                    endsWith(path, "/input/trigger") || endsWith(path, "/input/thumbstick") ||
-                    endsWith(path, "/input/thumbstick/x") || endsWith(path, "/input/thumbstick/y") ||
-                    endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick/force") ||
-                    endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/trackpad") ||
-                    endsWith(path, "/input/trackpad/x") || endsWith(path, "/input/trackpad/y") ||
-                    endsWith(path, "/input/trackpad/click") || endsWith(path, "/input/trackpad/force") ||
-                    endsWith(path, "/input/trackpad/touch") || endsWith(path, "/input/grip/pose") ||
-                    endsWith(path, "/input/grip") || endsWith(path, "/input/aim/pose") ||
-                    endsWith(path, "/input/aim") || endsWith(path, "/output/haptic")) {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/google/daydream_controller", [](const std::string& path) {
-                if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select") ||
-                    endsWith(path, "/input/trackpad") || endsWith(path, "/input/trackpad/x") ||
-                    endsWith(path, "/input/trackpad/y") || endsWith(path, "/input/trackpad/click") ||
-                    endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad/touch") ||
-                    endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                    endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign("/interaction_profiles/htc/vive_pro", [](const std::string& path) {
-            if (path == "/user/head/input/system/click" || path == "/user/head/input/system" ||
-                path == "/user/head/input/volume_up/click" || path == "/user/head/input/volume_up" ||
-                path == "/user/head/input/volume_down/click" || path == "/user/head/input/volume_down" ||
-                path == "/user/head/input/mute_mic/click" || path == "/user/head/input/mute_mic") {
-                return true;
+    namespace {
+
+        // The top-level user paths, as a bitmask.
+        enum UserPath : uint8_t {
+            LeftHand = 1 << 0,
+            RightHand = 1 << 1,
+            Head = 1 << 2,
+            Gamepad = 1 << 3,
+            OtherUserPath = 1 << 4,
+            AnyUserPath = 0xff,
+        };
+
+        // A binding path, split into its top-level user path and its component (eg: "/input/trigger/value").
+        struct ParsedPath {
+            uint8_t userPath{0};
+            int side{-1};
+            std::string_view component;
+        };
+
+        ParsedPath ParsePath(std::string_view path) {
+            ParsedPath parsed;
+
+            const size_t component = std::min(path.find("/input/"), path.find("/output/"));
+            if (component == std::string_view::npos) {
+                return parsed;
             }
-            return false;
-        });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/microsoft/xbox_controller", [](const std::string& path) {
-                if (path == "/user/gamepad/input/menu/click" || path == "/user/gamepad/input/menu" ||
-                    path == "/user/gamepad/input/view/click" || path == "/user/gamepad/input/view" ||
-                    path == "/user/gamepad/input/a/click" || path == "/user/gamepad/input/a" ||
-                    path == "/user/gamepad/input/b/click" || path == "/user/gamepad/input/b" ||
-                    path == "/user/gamepad/input/x/click" || path == "/user/gamepad/input/x" ||
-                    path == "/user/gamepad/input/y/click" || path == "/user/gamepad/input/y" ||
-                    path == "/user/gamepad/input/dpad_down/click" || path == "/user/gamepad/input/dpad_down" ||
-                    path == "/user/gamepad/input/dpad_right/click" || path == "/user/gamepad/input/dpad_right" ||
-                    path == "/user/gamepad/input/dpad_up/click" || path == "/user/gamepad/input/dpad_up" ||
-                    path == "/user/gamepad/input/dpad_left/click" || path == "/user/gamepad/input/dpad_left" ||
-                    path == "/user/gamepad/input/shoulder_left/click" || path == "/user/gamepad/input/shoulder_left" ||
-                    path == "/user/gamepad/input/shoulder_right/click" ||
-                    path == "/user/gamepad/input/shoulder_right" || path == "/user/gamepad/input/trigger_left/click" ||
-                    path == "/user/gamepad/input/trigger_left/value" ||
-                    path == "/user/gamepad/input/trigger_left/force" || path == "/user/gamepad/input/trigger_left" ||
-                    path == "/user/gamepad/input/trigger_right/click" ||
-                    path == "/user/gamepad/input/trigger_right/value" ||
-                    path == "/user/gamepad/input/trigger_right/force" || path == "/user/gamepad/input/trigger_right" ||
-                    path == "/user/gamepad/input/thumbstick_left" || path == "/user/gamepad/input/thumbstick_left/x" ||
-                    path == "/user/gamepad/input/thumbstick_left/y" ||
-                    path == "/user/gamepad/input/thumbstick_left/click" ||
-                    path == "/user/gamepad/input/thumbstick_left/force" ||
-                    path == "/user/gamepad/input/thumbstick_right" ||
-                    path == "/user/gamepad/input/thumbstick_right/x" ||
-                    path == "/user/gamepad/input/thumbstick_right/y" ||
-                    path == "/user/gamepad/input/thumbstick_right/click" ||
-                    path == "/user/gamepad/input/thumbstick_right/force" ||
-                    path == "/user/gamepad/output/haptic_left" || path == "/user/gamepad/output/haptic_right" ||
-                    path == "/user/gamepad/output/haptic_left_trigger" ||
-                    path == "/user/gamepad/output/haptic_right_trigger") {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/oculus/go_controller", [](const std::string& path) {
-                if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system") ||
-                    endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger") ||
-                    endsWith(path, "/input/back/click") || endsWith(path, "/input/back") ||
-                    endsWith(path, "/input/trackpad") || endsWith(path, "/input/trackpad/x") ||
-                    endsWith(path, "/input/trackpad/y") || endsWith(path, "/input/trackpad/click") ||
-                    endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad/touch") ||
-                    endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                    endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-                    return true;
-                }
-                return false;
-            });
-    }
+            parsed.component = path.substr(component);
 
-    bool OpenXrRuntime::mapPathToTouchControllerInputState(const Action& xrAction,
-                                                           const std::string& path,
-                                                           ActionSource& source) const {
-        source.buttonMap = nullptr;
-        source.floatValue = nullptr;
-        source.vector2fValue = nullptr;
+            const std::string_view userPath = path.substr(0, component);
+            if (userPath == "/user/hand/left") {
+                parsed.userPath = LeftHand;
+                parsed.side = 0;
+            } else if (userPath == "/user/hand/right") {
+                parsed.userPath = RightHand;
+                parsed.side = 1;
+            } else if (userPath == "/user/head") {
+                parsed.userPath = Head;
+            } else if (userPath == "/user/gamepad") {
+                parsed.userPath = Gamepad;
+            } else {
+                parsed.userPath = OtherUserPath;
+            }
 
-        if (path == "/user/hand/left/input/x/click" || path == "/user/hand/left/input/x") {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_X;
-        } else if (path == "/user/hand/left/input/x/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_X;
-        } else if (path == "/user/hand/left/input/y/click" || path == "/user/hand/left/input/y") {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_Y;
-        } else if (path == "/user/hand/left/input/y/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_Y;
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/menu") {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_Enter;
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a") {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_A;
-        } else if (path == "/user/hand/right/input/a/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_A;
-        } else if (path == "/user/hand/right/input/b/click" || path == "/user/hand/right/input/b") {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_B;
-        } else if (path == "/user/hand/right/input/b/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_B;
-        } else if (path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system") {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_Home;
-        } else if (endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze")) {
-            source.floatValue = m_cachedInputState.HandTrigger;
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            source.floatValue = m_cachedInputState.HandTrigger;
-        } else if (endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger")) {
-            source.floatValue = m_cachedInputState.IndexTrigger;
-        } else if (path == "/user/hand/left/input/trigger/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_LIndexTrigger;
-        } else if (path == "/user/hand/right/input/trigger/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_RIndexTrigger;
-        } else if (path == "/user/hand/left/input/thumbstick/click" ||
-                   (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT && path == "/user/hand/left/input/thumbstick")) {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_LThumb;
-        } else if (path == "/user/hand/right/input/thumbstick/click" ||
-                   (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT && path == "/user/hand/right/input/thumbstick")) {
-            source.buttonMap = &m_cachedInputState.Buttons;
-            source.buttonType = ovrButton_RThumb;
-        } else if (endsWith(path, "/input/thumbstick")) {
-            source.vector2fValue = m_cachedInputState.ThumbstickNoDeadzone;
-            source.vector2fIndex = -1;
-        } else if (endsWith(path, "/input/thumbstick/x")) {
-            source.vector2fValue = m_cachedInputState.ThumbstickNoDeadzone;
-            source.vector2fIndex = 0;
-        } else if (endsWith(path, "/input/thumbstick/y")) {
-            source.vector2fValue = m_cachedInputState.ThumbstickNoDeadzone;
-            source.vector2fIndex = 1;
-        } else if (path == "/user/hand/left/input/thumbstick/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_LThumb;
-        } else if (path == "/user/hand/right/input/thumbstick/touch") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_RThumb;
-        } else if (path == "/user/hand/left/input/thumbrest/touch" || path == "/user/hand/left/input/thumbrest") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_LThumbRest;
-        } else if (path == "/user/hand/right/input/thumbrest/touch" || path == "/user/hand/right/input/thumbrest") {
-            source.buttonMap = &m_cachedInputState.Touches;
-            source.buttonType = (ovrButton)ovrTouch_RThumbRest;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            // Do nothing.
-        } else {
-            // No possible binding.
-            return false;
+            return parsed;
         }
 
-        source.realPath = path;
+        // Where a Touch controller component reads from in ovrInputState.
+        struct TouchInput {
+            enum class Kind : uint8_t {
+                None = 0, // Not present on this hand.
+                NoInputState, // Poses and haptics.
+                Buttons,
+                Touches,
+                IndexTrigger,
+                HandTrigger,
+                Thumbstick,
+            };
 
-        return true;
-    }
+            Kind kind{Kind::None};
+            uint32_t mask{0};
+            int vector2fIndex{-1};
 
-    std::string OpenXrRuntime::getTouchControllerLocalizedSourceName(const std::string& path) const {
-        if (path == "/user/hand/left/input/x/click" || path == "/user/hand/left/input/x") {
-            return "X Button";
-        } else if (path == "/user/hand/left/input/x/touch") {
-            return "X Touch";
-        } else if (path == "/user/hand/left/input/y/click" || path == "/user/hand/left/input/y") {
-            return "Y Button";
-        } else if (path == "/user/hand/left/input/y/touch") {
-            return "Y Touch";
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/input/menu") {
-            return "Menu Button";
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a") {
-            return "A Button";
-        } else if (path == "/user/hand/right/input/a/touch") {
-            return "A Touch";
-        } else if (path == "/user/hand/right/input/b/click" || path == "/user/hand/right/input/b") {
-            return "B Button";
-        } else if (path == "/user/hand/right/input/b/touch") {
-            return "B Touch";
-        } else if (path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system") {
-            return "System Button";
-        } else if (endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze")) {
-            return "Grip";
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            return "Grip Force";
-        } else if (endsWith(path, "/input/trigger/click")) {
-            return "Trigger Press";
-        } else if (endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger")) {
-            return "Trigger";
-        } else if (endsWith(path, "/input/trigger/touch")) {
-            return "Trigger Touch";
-        } else if (endsWith(path, "/input/thumbstick")) {
-            return "Joystick";
-        } else if (endsWith(path, "/input/thumbstick/x")) {
-            return "Joystic X axis";
-        } else if (endsWith(path, "/input/thumbstick/y")) {
-            return "Joystick Y axis";
-        } else if (endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick")) {
-            return "Joystick Press";
-        } else if (endsWith(path, "/input/thumbstick/touch")) {
-            return "Joystick Touch";
-        } else if (endsWith(path, "/input/thumbrest/touch") || endsWith(path, "/input/thumbrest")) {
-            return "Thumbrest Touch";
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip")) {
-            return "Grip Pose";
-        } else if (endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-            return "Aim Pose";
-        } else if (endsWith(path, "/output/haptic")) {
-            return "Haptics";
+            // The button to use instead of the thumbstick for boolean actions.
+            uint32_t booleanMask{0};
+        };
+
+        struct TouchComponent {
+            uint8_t validUserPaths{0};
+            const char* localizedName{nullptr};
+            TouchInput input[2];
+        };
+
+        constexpr TouchInput Button(uint32_t mask) {
+            return {TouchInput::Kind::Buttons, mask};
         }
 
-        return "<Unknown>";
-    }
+        constexpr TouchInput Touch(uint32_t mask) {
+            return {TouchInput::Kind::Touches, mask};
+        }
+
+        constexpr TouchInput Analog(TouchInput::Kind kind, int vector2fIndex = -1, uint32_t booleanMask = 0) {
+            return {kind, 0, vector2fIndex, booleanMask};
+        }
 
-    std::optional<std::string> OpenXrRuntime::remapSimpleControllerToTouchController(const std::string& path) const {
-        if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select")) {
-            return rreplace(path, "/input/select", "/input/trigger");
-        } else if (path == "/user/hand/right/input/menu/click" || path == "/user/hand/right/input/menu") {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/input/menu") {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
+        constexpr TouchComponent Component(uint8_t validUserPaths,
+                                           const char* localizedName,
+                                           TouchInput left,
+                                           TouchInput right) {
+            return {validUserPaths, localizedName, {left, right}};
         }
 
-        // No possible binding.
-        return {};
+        constexpr TouchComponent Component(uint8_t validUserPaths, const char* localizedName, TouchInput both) {
+            return {validUserPaths, localizedName, {both, both}};
+        }
+
+        using Kind = TouchInput::Kind;
+
+        constexpr PerfectHashEntry<TouchComponent> k_touchControllerEntries[] = {
+            {"/input/x/click", Component(LeftHand, "X Button", Button(ovrButton_X), {})},
+            {"/input/x", Component(LeftHand, "X Button", Button(ovrButton_X), {})},
+            {"/input/x/touch", Component(LeftHand, "X Touch", Touch(ovrTouch_X), {})},
+            {"/input/y/click", Component(LeftHand, "Y Button", Button(ovrButton_Y), {})},
+            {"/input/y", Component(LeftHand, "Y Button", Button(ovrButton_Y), {})},
+            {"/input/y/touch", Component(LeftHand, "Y Touch", Touch(ovrTouch_Y), {})},
+            {"/input/menu/click", Component(LeftHand, "Menu Button", Button(ovrButton_Enter), {})},
+            {"/input/menu", Component(LeftHand, "Menu Button", Button(ovrButton_Enter), {})},
+            {"/input/a/click", Component(RightHand, "A Button", {}, Button(ovrButton_A))},
+            {"/input/a", Component(RightHand, "A Button", {}, Button(ovrButton_A))},
+            {"/input/a/touch", Component(RightHand, "A Touch", {}, Touch(ovrTouch_A))},
+            {"/input/b/click", Component(RightHand, "B Button", {}, Button(ovrButton_B))},
+            {"/input/b", Component(RightHand, "B Button", {}, Button(ovrButton_B))},
+            {"/input/b/touch", Component(RightHand, "B Touch", {}, Touch(ovrTouch_B))},
+            {"/input/system/click", Component(RightHand, "System Button", {}, Button(ovrButton_Home))},
+            {"/input/system", Component(RightHand, "System Button", {}, Button(ovrButton_Home))},
+            {"/input/squeeze/click", Component(AnyUserPath, "Grip", Analog(Kind::HandTrigger))},
+            {"/input/squeeze/value", Component(AnyUserPath, "Grip", Analog(Kind::HandTrigger))},
+            {"/input/squeeze", Component(AnyUserPath, "Grip", Analog(Kind::HandTrigger))},
+            {"/input/squeeze/force", Component(AnyUserPath, "Grip Force", Analog(Kind::HandTrigger))},
+            {"/input/trigger/click", Component(AnyUserPath, "Trigger Press", Analog(Kind::IndexTrigger))},
+            {"/input/trigger/value", Component(AnyUserPath, "Trigger", Analog(Kind::IndexTrigger))},
+            {"/input/trigger", Component(AnyUserPath, "Trigger", Analog(Kind::IndexTrigger))},
+            {"/input/trigger/touch",
+             Component(AnyUserPath, "Trigger Touch", Touch(ovrTouch_LIndexTrigger), Touch(ovrTouch_RIndexTrigger))},
+            {"/input/thumbstick",
+             Component(AnyUserPath,
+                       "Joystick",
+                       Analog(Kind::Thumbstick, -1, ovrButton_LThumb),
+                       Analog(Kind::Thumbstick, -1, ovrButton_RThumb))},
+            {"/input/thumbstick/x", Component(AnyUserPath, "Joystic X axis", Analog(Kind::Thumbstick, 0))},
+            {"/input/thumbstick/y", Component(AnyUserPath, "Joystick Y axis", Analog(Kind::Thumbstick, 1))},
+            {"/input/thumbstick/click",
+             Component(AnyUserPath, "Joystick Press", Button(ovrButton_LThumb), Button(ovrButton_RThumb))},
+            {"/input/thumbstick/touch",
+             Component(AnyUserPath, "Joystick Touch", Touch(ovrTouch_LThumb), Touch(ovrTouch_RThumb))},
+            {"/input/thumbrest/touch",
+             Component(AnyUserPath, "Thumbrest Touch", Touch(ovrTouch_LThumbRest), Touch(ovrTouch_RThumbRest))},
+            {"/input/thumbrest",
+             Component(AnyUserPath, "Thumbrest Touch", Touch(ovrTouch_LThumbRest), Touch(ovrTouch_RThumbRest))},
+            {"/input/grip/pose", Component(AnyUserPath, "Grip Pose", Analog(Kind::NoInputState))},
+            {"/input/grip", Component(AnyUserPath, "Grip Pose", Analog(Kind::NoInputState))},
+            {"/input/aim/pose", Component(AnyUserPath, "Aim Pose", Analog(Kind::NoInputState))},
+            {"/input/aim", Component(AnyUserPath, "Aim Pose", Analog(Kind::NoInputState))},
+            {"/output/haptic", Component(AnyUserPath, "Haptics", Analog(Kind::NoInputState))},
+        };
+        constexpr PerfectHashMap k_touchControllerComponents(k_touchControllerEntries);
+
+        // A component of another interaction profile, and its equivalent on the Touch controller for each hand (empty
+        // when it cannot be mapped).
+        struct ProfileComponent {
+            uint8_t validUserPaths{0};
+            std::string_view touchComponent[2];
+        };
+
+        constexpr ProfileComponent Unmapped(uint8_t validUserPaths = AnyUserPath) {
+            return {validUserPaths, {{}, {}}};
+        }
+
+        constexpr ProfileComponent Remap(std::string_view left, std::string_view right) {
+            return {AnyUserPath, {left, right}};
+        }
+
+        constexpr ProfileComponent Remap(std::string_view both) {
+            return Remap(both, both);
+        }
+
+        constexpr PerfectHashEntry<ProfileComponent> k_simpleControllerEntries[] = {
+            {"/input/select/click", Remap("/input/trigger/click")},
+            {"/input/select", Remap("/input/trigger")},
+            {"/input/menu/click", Remap("/input/menu/click", "/input/a/click")},
+            {"/input/menu", Remap("/input/menu", "/input/a")},
+            {"/input/grip/pose", Remap("/input/grip/pose")},
+            {"/input/grip", Remap("/input/grip")},
+            {"/input/aim/pose", Remap("/input/aim/pose")},
+            {"/input/aim", Remap("/input/aim")},
+            {"/output/haptic", Remap("/output/haptic")},
+        };
+        constexpr PerfectHashMap k_simpleControllerComponents(k_simpleControllerEntries);
+
+        constexpr PerfectHashEntry<ProfileComponent> k_viveControllerEntries[] = {
+            {"/input/system/click", Remap({}, "/input/system/click")},
+            {"/input/system", Remap({}, "/input/system")},
+            {"/input/squeeze/click", Remap("/input/squeeze/click")},
+            {"/input/squeeze/force", Remap("/input/squeeze/force")},
+            {"/input/squeeze", Remap("/input/squeeze")},
+            {"/input/menu/click", Remap("/input/menu/click", "/input/a/click")},
+            {"/input/menu", Remap("/input/menu", "/input/a")},
+            {"/input/trigger/click", Remap("/input/trigger/click")},
+            {"/input/trigger/value", Remap("/input/trigger/value")},
+            {"/input/trigger", Remap("/input/trigger")},
+            {"/input/trackpad", Remap("/input/thumbstick")},
+            {"/input/trackpad/x", Remap("/input/thumbstick/x")},
+            {"/input/trackpad/y", Remap("/input/thumbstick/y")},
+            {"/input/trackpad/click", Remap("/input/thumbstick/click")},
+            {"/input/trackpad/force", Unmapped()},
+            {"/input/trackpad/touch", Remap("/input/thumbstick/touch")},
+            {"/input/grip/pose", Remap("/input/grip/pose")},
+            {"/input/grip", Remap("/input/grip")},
+            {"/input/aim/pose", Remap("/input/aim/pose")},
+            {"/input/aim", Remap("/input/aim")},
+            {"/output/haptic", Remap("/output/haptic")},
+        };
+        constexpr PerfectHashMap k_viveControllerComponents(k_viveControllerEntries);
+
+        constexpr PerfectHashEntry<ProfileComponent> k_indexControllerEntries[] = {
+            {"/input/system/click", Remap({}, "/input/system/click")},
+            {"/input/system", Remap({}, "/input/system")},
+            {"/input/system/touch", Unmapped()},
+            {"/input/a/click", Remap("/input/x/click", "/input/a/click")},
+            {"/input/a", Remap("/input/x", "/input/a")},
+            {"/input/a/touch", Remap("/input/x/touch", "/input/a/touch")},
+            {"/input/b/click", Remap("/input/y/click", "/input/b/click")},
+            {"/input/b", Remap("/input/y", "/input/b")},
+            {"/input/b/touch", Remap("/input/y/touch", "/input/b/touch")},
+            {"/input/squeeze/click", Remap("/input/squeeze/click")},
+            {"/input/squeeze/value", Remap("/input/squeeze/value")},
+            {"/input/squeeze", Remap("/input/squeeze")},
+            {"/input/squeeze/force", Remap("/input/squeeze/force")},
+            {"/input/trigger/click", Remap("/input/trigger/click")},
+            {"/input/trigger/value", Remap("/input/trigger/value")},
+            {"/input/trigger", Remap("/input/trigger")},
+            {"/input/trigger/touch", Unmapped()},
+            {"/input/thumbstick", Remap("/input/thumbstick")},
+            {"/input/thumbstick/x", Remap("/input/thumbstick/x")},
+            {"/input/thumbstick/y", Remap("/input/thumbstick/y")},
+            {"/input/thumbstick/click", Remap("/input/thumbstick/click")},
+            {"/input/thumbstick/touch", Remap("/input/thumbstick/touch")},
+            {"/input/trackpad", Unmapped()},
+            {"/input/trackpad/x", Unmapped()},
+            {"/input/trackpad/y", Unmapped()},
+            {"/input/trackpad/force", Unmapped()},
+            {"/input/trackpad/touch", Remap("/input/thumbrest/touch")},
+            {"/input/grip/pose", Remap("/input/grip/pose")},
+            {"/input/grip", Remap("/input/grip")},
+            {"/input/aim/pose", Remap("/input/aim/pose")},
+            {"/input/aim", Remap("/input/aim")},
+            {"/output/haptic", Remap("/output/haptic")},
+        };
+        constexpr PerfectHashMap k_indexControllerComponents(k_indexControllerEntries);
+
+        constexpr PerfectHashEntry<ProfileComponent> k_microsoftMotionControllerEntries[] = {
+            {"/input/menu/click", Remap("/input/menu/click", "/input/a/click")},
+            {"/input/menu", Remap("/input/menu", "/input/a")},
+            {"/input/squeeze/click", Remap("/input/squeeze/click")},
+            {"/input/squeeze/value", Remap("/input/squeeze/value")},
+            {"/input/squeeze/force", Remap("/input/squeeze/force")},
+            {"/input/squeeze", Remap("/input/squeeze")},
+            {"/input/trigger/click", Remap("/input/trigger/click")},
+            {"/input/trigger/value", Remap("/input/trigger/value")},
+            {"/input/trigger", Remap("/input/trigger")},
+            {"/input/thumbstick", Remap("/input/thumbstick")},
+            {"/input/thumbstick/x", Remap("/input/thumbstick/x")},
+            {"/input/thumbstick/y", Remap("/input/thumbstick/y")},
+            {"/input/thumbstick/click", Remap("/input/thumbstick/click")},
+            {"/input/thumbstick/force", Unmapped()},
+            {"/input/thumbstick/touch", Remap("/input/thumbstick/touch")},
+            {"/input/trackpad", Unmapped()},
+            {"/input/trackpad/x", Unmapped()},
+            {"/input/trackpad/y", Unmapped()},
+            {"/input/trackpad/click", Unmapped()},
+            {"/input/trackpad/force", Unmapped()},
+            {"/input/trackpad/touch", Unmapped()},
+            {"/input/grip/pose", Remap("/input/grip/pose")},
+            {"/input/grip", Remap("/input/grip")},
+            {"/input/aim/pose", Remap("/input/aim/pose")},
+            {"/input/aim", Remap("/input/aim")},
+            {"/output/haptic", Remap("/output/haptic")},
+        };
+        constexpr PerfectHashMap k_microsoftMotionControllerComponents(k_microsoftMotionControllerEntries);
+
+        constexpr PerfectHashEntry<ProfileComponent> k_daydreamControllerEntries[] = {
+            {"/input/select/click", Unmapped()},
+            {"/input/select", Unmapped()},
+            {"/input/trackpad", Unmapped()},
+            {"/input/trackpad/x", Unmapped()},
+            {"/input/trackpad/y", Unmapped()},
+            {"/input/trackpad/click", Unmapped()},
+            {"/input/trackpad/force", Unmapped()},
+            {"/input/trackpad/touch", Unmapped()},
+            {"/input/grip/pose", Unmapped()},
+            {"/input/grip", Unmapped()},
+            {"/input/aim/pose", Unmapped()},
+            {"/input/aim", Unmapped()},
+        };
+        constexpr PerfectHashMap k_daydreamControllerComponents(k_daydreamControllerEntries);
+
+        constexpr PerfectHashEntry<ProfileComponent> k_goControllerEntries[] = {
+            {"/input/system/click", Unmapped()},
+            {"/input/system", Unmapped()},
+            {"/input/trigger/click", Unmapped()},
+            {"/input/trigger", Unmapped()},
+            {"/input/back/click", Unmapped()},
+            {"/input/back", Unmapped()},
+            {"/input/trackpad", Unmapped()},
+            {"/input/trackpad/x", Unmapped()},
+            {"/input/trackpad/y", Unmapped()},
+            {"/input/trackpad/click", Unmapped()},
+            {"/input/trackpad/force", Unmapped()},
+            {"/input/trackpad/touch", Unmapped()},
+            {"/input/grip/pose", Unmapped()},
+            {"/input/grip", Unmapped()},
+            {"/input/aim/pose", Unmapped()},
+            {"/input/aim", Unmapped()},
+        };
+        constexpr PerfectHashMap k_goControllerComponents(k_goControllerEntries);
+
+        constexpr PerfectHashEntry<ProfileComponent> k_viveProEntries[] = {
+            {"/input/system/click", Unmapped(Head)},
+            {"/input/system", Unmapped(Head)},
+            {"/input/volume_up/click", Unmapped(Head)},
+            {"/input/volume_up", Unmapped(Head)},
+            {"/input/volume_down/click", Unmapped(Head)},
+            {"/input/volume_down", Unmapped(Head)},
+            {"/input/mute_mic/click", Unmapped(Head)},
+            {"/input/mute_mic", Unmapped(Head)},
+        };
+        constexpr PerfectHashMap k_viveProComponents(k_viveProEntries);
+
+        constexpr PerfectHashEntry<ProfileComponent> k_xboxControllerEntries[] = {
+            {"/input/menu/click", Unmapped(Gamepad)},
+            {"/input/menu", Unmapped(Gamepad)},
+            {"/input/view/click", Unmapped(Gamepad)},
+            {"/input/view", Unmapped(Gamepad)},
+            {"/input/a/click", Unmapped(Gamepad)},
+            {"/input/a", Unmapped(Gamepad)},
+            {"/input/b/click", Unmapped(Gamepad)},
+            {"/input/b", Unmapped(Gamepad)},
+            {"/input/x/click", Unmapped(Gamepad)},
+            {"/input/x", Unmapped(Gamepad)},
+            {"/input/y/click", Unmapped(Gamepad)},
+            {"/input/y", Unmapped(Gamepad)},
+            {"/input/dpad_down/click", Unmapped(Gamepad)},
+            {"/input/dpad_down", Unmapped(Gamepad)},
+            {"/input/dpad_right/click", Unmapped(Gamepad)},
+            {"/input/dpad_right", Unmapped(Gamepad)},
+            {"/input/dpad_up/click", Unmapped(Gamepad)},
+            {"/input/dpad_up", Unmapped(Gamepad)},
+            {"/input/dpad_left/click", Unmapped(Gamepad)},
+            {"/input/dpad_left", Unmapped(Gamepad)},
+            {"/input/shoulder_left/click", Unmapped(Gamepad)},
+            {"/input/shoulder_left", Unmapped(Gamepad)},
+            {"/input/shoulder_right/click", Unmapped(Gamepad)},
+            {"/input/shoulder_right", Unmapped(Gamepad)},
+            {"/input/trigger_left/click", Unmapped(Gamepad)},
+            {"/input/trigger_left/value", Unmapped(Gamepad)},
+            {"/input/trigger_left/force", Unmapped(Gamepad)},
+            {"/input/trigger_left", Unmapped(Gamepad)},
+            {"/input/trigger_right/click", Unmapped(Gamepad)},
+            {"/input/trigger_right/value", Unmapped(Gamepad)},
+            {"/input/trigger_right/force", Unmapped(Gamepad)},
+            {"/input/trigger_right", Unmapped(Gamepad)},
+            {"/input/thumbstick_left", Unmapped(Gamepad)},
+            {"/input/thumbstick_left/x", Unmapped(Gamepad)},
+            {"/input/thumbstick_left/y", Unmapped(Gamepad)},
+            {"/input/thumbstick_left/click", Unmapped(Gamepad)},
+            {"/input/thumbstick_left/force", Unmapped(Gamepad)},
+            {"/input/thumbstick_right", Unmapped(Gamepad)},
+            {"/input/thumbstick_right/x", Unmapped(Gamepad)},
+            {"/input/thumbstick_right/y", Unmapped(Gamepad)},
+            {"/input/thumbstick_right/click", Unmapped(Gamepad)},
+            {"/input/thumbstick_right/force", Unmapped(Gamepad)},
+            {"/output/haptic_left", Unmapped(Gamepad)},
+            {"/output/haptic_right", Unmapped(Gamepad)},
+            {"/output/haptic_left_trigger", Unmapped(Gamepad)},
+            {"/output/haptic_right_trigger", Unmapped(Gamepad)},
+        };
+        constexpr PerfectHashMap k_xboxControllerComponents(k_xboxControllerEntries);
+
+    } // namespace
+
+    // The Touch controller is the only physical controller: all other interaction profiles are emulated by remapping
+    // their components to the Touch controller equivalent.
+    struct InteractionProfile {
+        bool isTouchController{false};
+        PerfectHashView<ProfileComponent> components;
+    };
+
+    namespace {
+
+        constexpr PerfectHashEntry<InteractionProfile> k_interactionProfileEntries[] = {
+            {"/interaction_profiles/oculus/touch_controller", {true, {}}},
+            {"/interaction_profiles/khr/simple_controller", {false, k_simpleControllerComponents.view()}},
+            {"/interaction_profiles/htc/vive_controller", {false, k_viveControllerComponents.view()}},
+            {"/interaction_profiles/valve/index_controller", {false, k_indexControllerComponents.view()}},
+            {"/interaction_profiles/microsoft/motion_controller",
+             {false, k_microsoftMotionControllerComponents.view()}},
+            {"/interaction_profiles/google/daydream_controller", {false, k_daydreamControllerComponents.view()}},
+            {"/interaction_profiles/oculus/go_controller", {false, k_goControllerComponents.view()}},
+            {"/interaction_profiles/htc/vive_pro", {false, k_viveProComponents.view()}},
+            {"/interaction_profiles/microsoft/xbox_controller", {false, k_xboxControllerComponents.view()}},
+        };
+        constexpr PerfectHashMap k_interactionProfiles(k_interactionProfileEntries);
+
+    } // namespace
+
+    const InteractionProfile* OpenXrRuntime::getInteractionProfile(std::string_view interactionProfile) const {
+        return k_interactionProfiles.find(interactionProfile);
     }
 
-    std::optional<std::string>
-    OpenXrRuntime::remapMicrosoftMotionControllerToTouchController(const std::string& path) const {
-        if (path == "/user/hand/right/input/menu/click" || path == "/user/hand/right/input/menu") {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/input/menu" ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger") || endsWith(path, "/input/trackpad") ||
-                   endsWith(path, "/input/thumbstick/x") || endsWith(path, "/input/thumbstick/y") ||
-                   endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick/touch") ||
-                   endsWith(path, "/input/thumbstick")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
+    bool OpenXrRuntime::isValidInteractionProfilePath(const InteractionProfile& interactionProfile,
+                                                      std::string_view path) const {
+        const ParsedPath parsed = ParsePath(path);
+
+        if (interactionProfile.isTouchController) {
+            const TouchComponent* const component = k_touchControllerComponents.find(parsed.component);
+            return component && (component->validUserPaths & parsed.userPath);
         }
 
-        // No possible binding.
-        return {};
+        const ProfileComponent* const component = interactionProfile.components.find(parsed.component);
+        return component && (component->validUserPaths & parsed.userPath);
     }
 
-    std::optional<std::string> OpenXrRuntime::remapViveControllerToTouchController(const std::string& path) const {
-        if (path == "/user/hand/right/input/menu/click" || path == "/user/hand/right/input/menu") {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (endsWith(path, "/input/trackpad/x") || endsWith(path, "/input/trackpad/y") ||
-                   endsWith(path, "/input/trackpad/click") || endsWith(path, "/input/trackpad/force") ||
-                   endsWith(path, "/input/trackpad/touch") || endsWith(path, "/input/trackpad")) {
-            return rreplace(path, "/input/trackpad", "/input/thumbstick");
-        } else if (path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system" ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/force") ||
-                   endsWith(path, "/input/squeeze") || path == "/user/hand/left/input/menu/click" ||
-                   path == "/user/hand/left/input/menu" || endsWith(path, "/input/trigger/click") ||
-                   endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
+    bool OpenXrRuntime::mapPathToTouchControllerInputState(const InteractionProfile& interactionProfile,
+                                                           const Action& xrAction,
+                                                           std::string_view path,
+                                                           ActionSource& source) const {
+        const ParsedPath parsed = ParsePath(path);
+        if (parsed.side < 0) {
+            return false;
+        }
+
+        // Remap to the equivalent component on the Touch controller.
+        std::string_view touchComponent = parsed.component;
+        if (!interactionProfile.isTouchController) {
+            const ProfileComponent* const component = interactionProfile.components.find(parsed.component);
+            if (!component || component->touchComponent[parsed.side].empty()) {
+                // No possible binding.
+                return false;
+            }
+            touchComponent = component->touchComponent[parsed.side];
+        }
+
+        const TouchComponent* const component = k_touchControllerComponents.find(touchComponent);
+        if (!component) {
+            // No possible binding.
+            return false;
         }
 
-        // No possible binding.
-        return {};
+        source.buttonMap = nullptr;
+        source.floatValue = nullptr;
+        source.vector2fValue = nullptr;
+
+        const TouchInput& input = component->input[parsed.side];
+        switch (input.kind) {
+        case Kind::Buttons:
+            source.buttonMap = &m_cachedInputState.Buttons;
+            source.buttonType = (ovrButton)input.mask;
+            break;
+
+        case Kind::Touches:
+            source.buttonMap = &m_cachedInputState.Touches;
+            source.buttonType = (ovrButton)input.mask;
+            break;
+
+        case Kind::IndexTrigger:
+            source.floatValue = m_cachedInputState.IndexTrigger;
+            break;
+
+        case Kind::HandTrigger:
+            source.floatValue = m_cachedInputState.HandTrigger;
+            break;
+
+        case Kind::Thumbstick:
+            if (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT && input.booleanMask) {
+                source.buttonMap = &m_cachedInputState.Buttons;
+                source.buttonType = (ovrButton)input.booleanMask;
+            } else {
+                source.vector2fValue = m_cachedInputState.ThumbstickNoDeadzone;
+                source.vector2fIndex = input.vector2fIndex;
+            }
+            break;
+
+        case Kind::NoInputState:
+            // Do nothing.
+            break;
+
+        default:
+            // No possible binding.
+            return false;
+        }
+
+        // The source is identified by its path on the Touch controller.
+        const std::string_view userPath = path.substr(0, path.size() - parsed.component.size());
+        source.realPath.reserve(userPath.size() + touchComponent.size());
+        source.realPath.assign(userPath).append(touchComponent);
+
+        return true;
     }
 
-    std::optional<std::string> OpenXrRuntime::remapIndexControllerToTouchController(const std::string& path) const {
-        if (path == "/user/hand/left/input/a/click" || path == "/user/hand/left/input/a/touch" ||
-            path == "/user/hand/left/input/a") {
-            return rreplace(path, "/input/a", "/input/x");
-        } else if (path == "/user/hand/left/input/b/click" || path == "/user/hand/left/input/b/touch" ||
-                   path == "/user/hand/left/input/b") {
-            return rreplace(path, "/input/b", "/input/y");
-        } else if (endsWith(path, "/input/trackpad/touch")) {
-            return rreplace(path, "/input/trackpad", "/input/thumbrest");
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a/touch" ||
-                   path == "/user/hand/right/input/a" || path == "/user/hand/right/input/b/click" ||
-                   path == "/user/hand/right/input/b/touch" || path == "/user/hand/right/input/b" ||
-                   path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system" ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger") || endsWith(path, "/input/thumbstick/x") ||
-                   endsWith(path, "/input/thumbstick/y") || endsWith(path, "/input/thumbstick/click") ||
-                   endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/thumbstick")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
+    const char* OpenXrRuntime::getTouchControllerLocalizedSourceName(std::string_view path) const {
+        const ParsedPath parsed = ParsePath(path);
+        const TouchComponent* const component = k_touchControllerComponents.find(parsed.component);
+        if (component && (component->validUserPaths & parsed.userPath)) {
+            return component->localizedName;
         }
 
-        // No possible binding.
-        return {};
+        return "<Unknown>";
     }
 
 } // namespace virtualdesktop_openxr
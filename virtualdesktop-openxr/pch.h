@@ -24,6 +24,7 @@
 
 // Standard library.
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <condition_variable>
@@ -39,9 +40,15 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <optional>
+#include <random>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #pragma intrinsic(_ReturnAddress)
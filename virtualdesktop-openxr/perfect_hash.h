@@ -0,0 +1,130 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    namespace perfect_hash {
+
+        // FNV-1a, followed by a finalizer so that nearby seeds give unrelated distributions.
+        constexpr uint32_t Hash(std::string_view key, uint32_t seed) {
+            uint32_t hash = 2166136261u ^ seed;
+            for (const char c : key) {
+                hash = (hash ^ (uint8_t)c) * 16777619u;
+            }
+            hash ^= hash >> 16;
+            hash *= 0x85ebca6bu;
+            hash ^= hash >> 13;
+            hash *= 0xc2b2ae35u;
+            hash ^= hash >> 16;
+            return hash;
+        }
+
+        // Keep the table sparse enough for a seed without any collision to be found quickly.
+        constexpr size_t TableSize(size_t count) {
+            size_t size = 1;
+            while (size < count * 4) {
+                size <<= 1;
+            }
+            return size;
+        }
+
+    } // namespace perfect_hash
+
+    template <typename Value>
+    struct PerfectHashEntry {
+        std::string_view key;
+        Value value;
+    };
+
+    // A non-owning view of a PerfectHashMap, so that maps of different sizes can be stored side by side.
+    template <typename Value>
+    struct PerfectHashView {
+        const PerfectHashEntry<Value>* slots{nullptr};
+        uint32_t mask{0};
+        uint32_t seed{0};
+
+        const Value* find(std::string_view key) const {
+            if (!slots) {
+                return nullptr;
+            }
+
+            const PerfectHashEntry<Value>& slot = slots[perfect_hash::Hash(key, seed) & mask];
+            return !slot.key.empty() && slot.key == key ? &slot.value : nullptr;
+        }
+    };
+
+    // A read-only map from strings to values, built at compile time. The hash seed is chosen so that no two keys land
+    // in the same slot: a lookup hashes the key once and does a single string comparison, with no allocation.
+    // Duplicate keys (or an empty key) make the constant evaluation fail.
+    template <typename Value, size_t Count>
+    class PerfectHashMap {
+        static constexpr size_t Size = perfect_hash::TableSize(Count);
+
+      public:
+        constexpr PerfectHashMap(const PerfectHashEntry<Value> (&entries)[Count]) : m_seed(findSeed(entries)) {
+            for (size_t i = 0; i < Count; i++) {
+                m_slots[perfect_hash::Hash(entries[i].key, m_seed) & (Size - 1)] = entries[i];
+            }
+        }
+
+        const Value* find(std::string_view key) const {
+            return view().find(key);
+        }
+
+        constexpr PerfectHashView<Value> view() const {
+            return {m_slots, (uint32_t)(Size - 1), m_seed};
+        }
+
+      private:
+        static constexpr uint32_t findSeed(const PerfectHashEntry<Value> (&entries)[Count]) {
+            for (size_t i = 0; i < Count; i++) {
+                if (entries[i].key.empty()) {
+                    throw std::logic_error("Empty key");
+                }
+                for (size_t j = i + 1; j < Count; j++) {
+                    if (entries[i].key == entries[j].key) {
+                        throw std::logic_error("Duplicate key");
+                    }
+                }
+            }
+
+            for (uint32_t seed = 0; seed < 10000; seed++) {
+                bool used[Size]{};
+                bool collision = false;
+                for (size_t i = 0; i < Count && !collision; i++) {
+                    const size_t slot = perfect_hash::Hash(entries[i].key, seed) & (Size - 1);
+                    collision = used[slot];
+                    used[slot] = true;
+                }
+                if (!collision) {
+                    return seed;
+                }
+            }
+            throw std::logic_error("No perfect hash seed");
+        }
+
+        uint32_t m_seed;
+        PerfectHashEntry<Value> m_slots[Size]{};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // The performance counters published by the runtime in the named shared memory segment below, for overlays and
+    // monitoring tools. The layout is versioned: readers must check the version and size before using the snapshot,
+    // and the layout must not change without bumping the version. Durations are in microseconds.
+    //
+    // The snapshot is protected by a sequence lock. The writer makes the sequence odd before updating the snapshot,
+    // and even again afterwards. A reader copies the snapshot between two reads of the sequence, and retries when the
+    // first read was odd or when the two reads differ (see readPerformanceCounters()).
+    struct PerformanceCounters {
+        static constexpr const wchar_t* k_name = L"VirtualDesktopOpenXR.PerformanceCounters";
+        static constexpr uint32_t k_magic = 0x43504456; // "VDPC"
+        static constexpr uint32_t k_version = 2;
+
+        // The percentiles are estimated over the whole session, not over a recent window.
+        struct Metric {
+            float lastUs;
+            float p50Us;
+            float p90Us;
+            float p99Us;
+        };
+
+        struct Snapshot {
+            uint64_t frameIndex;
+            double time;
+            uint64_t numFrames;
+            uint64_t numDiscardedFrames;
+            uint32_t framesPerSecond;
+            uint32_t isAsyncReprojectionEngaged;
+            float predictedFramePeriodUs;
+            float measuredFramePeriodUs;
+            float runningStartUs;
+            uint32_t asyncSubmissionDepth;
+            Metric metrics[(uint32_t)FrameMetric::Count];
+        };
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size;
+        std::atomic<uint32_t> writerProcessId;
+        std::atomic<uint64_t> sequence;
+        Snapshot snapshot;
+    };
+    static_assert(sizeof(PerformanceCounters) == 240, "The layout of PerformanceCounters is public");
+
+    // Take a consistent copy of the snapshot. Returns false if the writer kept updating it during all the attempts.
+    inline bool readPerformanceCounters(const PerformanceCounters& counters,
+                                        PerformanceCounters::Snapshot& snapshot,
+                                        uint32_t maxAttempts = 100) {
+        for (uint32_t i = 0; i < maxAttempts; i++) {
+            const uint64_t sequence = counters.sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                YieldProcessor();
+                continue;
+            }
+            memcpy(&snapshot, &counters.snapshot, sizeof(snapshot));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (counters.sequence.load(std::memory_order_relaxed) == sequence) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Owns the shared memory segment and publishes snapshots into it. The segment is created (or re-opened, if a
+    // reader kept it alive) when the session starts, and publishing is a plain memory write with no system call.
+    // If another process opens the segment later, it becomes the writer and this one silently stops publishing.
+    class PerformanceCountersWriter {
+      public:
+        ~PerformanceCountersWriter() {
+            close();
+        }
+
+        bool open() {
+            close();
+
+            *m_file.put() = CreateFileMapping(INVALID_HANDLE_VALUE,
+                                              nullptr,
+                                              PAGE_READWRITE,
+                                              0,
+                                              sizeof(PerformanceCounters),
+                                              PerformanceCounters::k_name);
+            if (!m_file) {
+                return false;
+            }
+
+            m_counters = reinterpret_cast<PerformanceCounters*>(
+                MapViewOfFile(m_file.get(), FILE_MAP_WRITE, 0, 0, sizeof(PerformanceCounters)));
+            if (!m_counters) {
+                m_file.reset();
+                return false;
+            }
+
+            // Claim the segment before describing it, so that a previous writer cannot publish into the new layout.
+            m_processId = GetCurrentProcessId();
+            m_counters->writerProcessId.store(m_processId, std::memory_order_release);
+            m_counters->magic = PerformanceCounters::k_magic;
+            m_counters->version = PerformanceCounters::k_version;
+            m_counters->size = sizeof(PerformanceCounters);
+
+            return true;
+        }
+
+        void close() {
+            if (m_counters) {
+                UnmapViewOfFile(m_counters);
+                m_counters = nullptr;
+            }
+            m_file.reset();
+        }
+
+        bool isOpen() const {
+            return m_counters;
+        }
+
+        void publish(const PerformanceCounters::Snapshot& snapshot) {
+            if (!m_counters || m_counters->writerProcessId.load(std::memory_order_relaxed) != m_processId) {
+                return;
+            }
+
+            // Round down in case a previous writer died in the middle of an update.
+            const uint64_t sequence = m_counters->sequence.load(std::memory_order_relaxed) & ~1ull;
+            m_counters->sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            memcpy(&m_counters->snapshot, &snapshot, sizeof(snapshot));
+            m_counters->sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+      private:
+        wil::unique_handle m_file;
+        PerformanceCounters* m_counters{nullptr};
+        uint32_t m_processId{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,319 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#if defined(_M_IX86) || defined(_M_X64)
+#define POSE_BATCH_USE_SSE
+#endif
+
+namespace virtualdesktop_openxr::utils {
+
+    // A batch of poses stored as a structure of arrays, so that the pose math can process several poses at once.
+    // The arrays are padded to a multiple of 4 elements, so that the SIMD kernels never need a scalar tail loop.
+    struct PoseBatch {
+        void resize(size_t count) {
+            const size_t paddedCount = (count + 3) & ~size_t(3);
+            for (auto* component : {&px, &py, &pz, &qx, &qy, &qz}) {
+                component->resize(paddedCount, 0.f);
+            }
+            qw.resize(paddedCount, 1.f);
+            this->count = count;
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        size_t paddedSize() const {
+            return qw.size();
+        }
+
+        void set(size_t index, const XrPosef& pose) {
+            px[index] = pose.position.x;
+            py[index] = pose.position.y;
+            pz[index] = pose.position.z;
+            qx[index] = pose.orientation.x;
+            qy[index] = pose.orientation.y;
+            qz[index] = pose.orientation.z;
+            qw[index] = pose.orientation.w;
+        }
+
+        XrPosef get(size_t index) const {
+            XrPosef pose;
+            pose.position = {px[index], py[index], pz[index]};
+            pose.orientation = {qx[index], qy[index], qz[index], qw[index]};
+            return pose;
+        }
+
+        std::vector<float> px, py, pz;
+        std::vector<float> qx, qy, qz, qw;
+        size_t count{0};
+    };
+
+    namespace pose_batch {
+
+        // Tolerance on the squared norm of a quaternion, consistent with xr::math::Quaternion::IsNormalized().
+        constexpr float QuaternionEpsilon = 0.01f;
+
+        namespace detail {
+
+            // The pose math, written once for any lane type (a float for the scalar reference, or a SIMD register).
+            // These follow the conventions of xr::math::Pose, where Multiply(a, b) applies a, then b.
+            template <typename V>
+            struct Pose {
+                V px, py, pz;
+                V qx, qy, qz, qw;
+            };
+
+            template <typename V>
+            inline void Rotate(V& x, V& y, V& z, const V& qx, const V& qy, const V& qz, const V& qw) {
+                // v' = v + w * t + cross(q.xyz, t) with t = 2 * cross(q.xyz, v).
+                const V tx = (qy * z - qz * y) * V(2.f);
+                const V ty = (qz * x - qx * z) * V(2.f);
+                const V tz = (qx * y - qy * x) * V(2.f);
+                const V rx = x + qw * tx + (qy * tz - qz * ty);
+                const V ry = y + qw * ty + (qz * tx - qx * tz);
+                const V rz = z + qw * tz + (qx * ty - qy * tx);
+                x = rx;
+                y = ry;
+                z = rz;
+            }
+
+            template <typename V>
+            inline Pose<V> Multiply(const Pose<V>& a, const Pose<V>& b) {
+                Pose<V> result;
+
+                // Hamilton product b.q * a.q.
+                result.qw = b.qw * a.qw - b.qx * a.qx - b.qy * a.qy - b.qz * a.qz;
+                result.qx = b.qw * a.qx + b.qx * a.qw + b.qy * a.qz - b.qz * a.qy;
+                result.qy = b.qw * a.qy - b.qx * a.qz + b.qy * a.qw + b.qz * a.qx;
+                result.qz = b.qw * a.qz + b.qx * a.qy - b.qy * a.qx + b.qz * a.qw;
+
+                result.px = a.px;
+                result.py = a.py;
+                result.pz = a.pz;
+                Rotate(result.px, result.py, result.pz, b.qx, b.qy, b.qz, b.qw);
+                result.px = result.px + b.px;
+                result.py = result.py + b.py;
+                result.pz = result.pz + b.pz;
+
+                return result;
+            }
+
+            template <typename V>
+            inline Pose<V> Invert(const Pose<V>& a) {
+                Pose<V> result;
+                result.qx = V(0.f) - a.qx;
+                result.qy = V(0.f) - a.qy;
+                result.qz = V(0.f) - a.qz;
+                result.qw = a.qw;
+                result.px = V(0.f) - a.px;
+                result.py = V(0.f) - a.py;
+                result.pz = V(0.f) - a.pz;
+                Rotate(result.px, result.py, result.pz, result.qx, result.qy, result.qz, result.qw);
+                return result;
+            }
+
+            template <typename V>
+            inline V LengthSquared(const V& qx, const V& qy, const V& qz, const V& qw) {
+                return qx * qx + qy * qy + qz * qz + qw * qw;
+            }
+
+            inline Pose<float> Load(const XrPosef& pose) {
+                return {pose.position.x,
+                        pose.position.y,
+                        pose.position.z,
+                        pose.orientation.x,
+                        pose.orientation.y,
+                        pose.orientation.z,
+                        pose.orientation.w};
+            }
+
+            inline XrPosef Store(const Pose<float>& pose) {
+                XrPosef result;
+                result.position = {pose.px, pose.py, pose.pz};
+                result.orientation = {pose.qx, pose.qy, pose.qz, pose.qw};
+                return result;
+            }
+
+            inline Pose<float> Load(const PoseBatch& batch, size_t index) {
+                return Load(batch.get(index));
+            }
+
+            inline void Store(PoseBatch& batch, size_t index, const Pose<float>& pose) {
+                batch.set(index, Store(pose));
+            }
+
+#ifdef POSE_BATCH_USE_SSE
+            // 4 lanes of floats. SSE2 is the baseline for both of our targets, so no runtime dispatch is needed.
+            struct Float4 {
+                Float4() = default;
+                Float4(float value) : v(_mm_set1_ps(value)) {
+                }
+                Float4(__m128 value) : v(value) {
+                }
+
+                __m128 v;
+            };
+
+            inline Float4 operator+(const Float4& a, const Float4& b) {
+                return _mm_add_ps(a.v, b.v);
+            }
+            inline Float4 operator-(const Float4& a, const Float4& b) {
+                return _mm_sub_ps(a.v, b.v);
+            }
+            inline Float4 operator*(const Float4& a, const Float4& b) {
+                return _mm_mul_ps(a.v, b.v);
+            }
+
+            inline Pose<Float4> Load4(const PoseBatch& batch, size_t index) {
+                return {_mm_loadu_ps(&batch.px[index]),
+                        _mm_loadu_ps(&batch.py[index]),
+                        _mm_loadu_ps(&batch.pz[index]),
+                        _mm_loadu_ps(&batch.qx[index]),
+                        _mm_loadu_ps(&batch.qy[index]),
+                        _mm_loadu_ps(&batch.qz[index]),
+                        _mm_loadu_ps(&batch.qw[index])};
+            }
+
+            inline Pose<Float4> Splat4(const XrPosef& pose) {
+                return {pose.position.x,
+                        pose.position.y,
+                        pose.position.z,
+                        pose.orientation.x,
+                        pose.orientation.y,
+                        pose.orientation.z,
+                        pose.orientation.w};
+            }
+
+            inline void Store4(PoseBatch& batch, size_t index, const Pose<Float4>& pose) {
+                _mm_storeu_ps(&batch.px[index], pose.px.v);
+                _mm_storeu_ps(&batch.py[index], pose.py.v);
+                _mm_storeu_ps(&batch.pz[index], pose.pz.v);
+                _mm_storeu_ps(&batch.qx[index], pose.qx.v);
+                _mm_storeu_ps(&batch.qy[index], pose.qy.v);
+                _mm_storeu_ps(&batch.qz[index], pose.qz.v);
+                _mm_storeu_ps(&batch.qw[index], pose.qw.v);
+            }
+#endif
+
+        } // namespace detail
+
+        // Scalar reference implementation, one pose at a time. This is the ground truth for the batched kernels below
+        // and must produce the same results as xr::math::Pose (within floating point precision).
+        namespace reference {
+
+            inline XrPosef Multiply(const XrPosef& a, const XrPosef& b) {
+                return detail::Store(detail::Multiply(detail::Load(a), detail::Load(b)));
+            }
+
+            inline XrPosef Invert(const XrPosef& a) {
+                return detail::Store(detail::Invert(detail::Load(a)));
+            }
+
+            inline bool IsNormalized(const XrQuaternionf& q) {
+                return std::abs(detail::LengthSquared(q.x, q.y, q.z, q.w) - 1.f) <= QuaternionEpsilon;
+            }
+
+        } // namespace reference
+
+        // out[i] = Pose::Multiply(a[i], b[i]). The output may alias any of the inputs.
+        inline void Multiply(const PoseBatch& a, const PoseBatch& b, PoseBatch& out) {
+            out.resize(a.size());
+#ifdef POSE_BATCH_USE_SSE
+            for (size_t i = 0; i < a.paddedSize(); i += 4) {
+                detail::Store4(out, i, detail::Multiply(detail::Load4(a, i), detail::Load4(b, i)));
+            }
+#else
+            for (size_t i = 0; i < a.size(); i++) {
+                detail::Store(out, i, detail::Multiply(detail::Load(a, i), detail::Load(b, i)));
+            }
+#endif
+        }
+
+        // out[i] = Pose::Multiply(a[i], b). The output may alias the input.
+        inline void Multiply(const PoseBatch& a, const XrPosef& b, PoseBatch& out) {
+            out.resize(a.size());
+#ifdef POSE_BATCH_USE_SSE
+            const auto b4 = detail::Splat4(b);
+            for (size_t i = 0; i < a.paddedSize(); i += 4) {
+                detail::Store4(out, i, detail::Multiply(detail::Load4(a, i), b4));
+            }
+#else
+            const auto b1 = detail::Load(b);
+            for (size_t i = 0; i < a.size(); i++) {
+                detail::Store(out, i, detail::Multiply(detail::Load(a, i), b1));
+            }
+#endif
+        }
+
+        // out[i] = Pose::Invert(a[i]). The output may alias the input.
+        inline void Invert(const PoseBatch& a, PoseBatch& out) {
+            out.resize(a.size());
+#ifdef POSE_BATCH_USE_SSE
+            for (size_t i = 0; i < a.paddedSize(); i += 4) {
+                detail::Store4(out, i, detail::Invert(detail::Load4(a, i)));
+            }
+#else
+            for (size_t i = 0; i < a.size(); i++) {
+                detail::Store(out, i, detail::Invert(detail::Load(a, i)));
+            }
+#endif
+        }
+
+        // out[i] = the pose a[i] expressed relative to base (ie: Pose::Multiply(a[i], Pose::Invert(base))).
+        inline void Relative(const PoseBatch& a, const XrPosef& base, PoseBatch& out) {
+            Multiply(a, reference::Invert(base), out);
+        }
+
+        // isNormalized[i] = Quaternion::IsNormalized(a[i].orientation). Returns whether all of them are normalized.
+        inline bool IsNormalized(const PoseBatch& a, bool* isNormalized) {
+            bool allNormalized = true;
+#ifdef POSE_BATCH_USE_SSE
+            const __m128 one = _mm_set1_ps(1.f);
+            const __m128 epsilon = _mm_set1_ps(QuaternionEpsilon);
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            for (size_t i = 0; i < a.paddedSize(); i += 4) {
+                const detail::Float4 lengthSquared = detail::LengthSquared<detail::Float4>(_mm_loadu_ps(&a.qx[i]),
+                                                                                          _mm_loadu_ps(&a.qy[i]),
+                                                                                          _mm_loadu_ps(&a.qz[i]),
+                                                                                          _mm_loadu_ps(&a.qw[i]));
+                const int mask = _mm_movemask_ps(
+                    _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(lengthSquared.v, one), absMask), epsilon));
+                for (size_t j = 0; j < 4 && i + j < a.size(); j++) {
+                    isNormalized[i + j] = (mask & (1 << j)) != 0;
+                    allNormalized = allNormalized && isNormalized[i + j];
+                }
+            }
+#else
+            for (size_t i = 0; i < a.size(); i++) {
+                isNormalized[i] = reference::IsNormalized(a.get(i).orientation);
+                allNormalized = allNormalized && isNormalized[i];
+            }
+#endif
+            return allNormalized;
+        }
+
+    } // namespace pose_batch
+
+} // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,188 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // A fixed-size history of timestamped device poses, to answer queries in the (recent) past without going back to
+    // the service.
+    // There is a single writer (the frame loop) and any number of readers, and neither side ever takes a lock: each
+    // slot is protected by a sequence counter (odd while being written), and readers retry if a slot was overwritten
+    // during their read.
+    template <size_t DeviceCount, size_t Capacity>
+    class DevicePoseHistory {
+      public:
+        struct Sample {
+            XrTime time{0};
+            ovrResult result[DeviceCount];
+            ovrPoseStatef state[DeviceCount];
+        };
+
+        // Must only be called from one thread at a time. Samples must be pushed in increasing time order.
+        void push(const Sample& sample) {
+            const uint64_t index = m_count.load(std::memory_order_relaxed);
+            write(m_slots[index % Capacity], index, sample);
+            m_count.store(index + 1, std::memory_order_release);
+            m_latestTime.store(sample.time, std::memory_order_release);
+        }
+
+        // Forget all the samples. Must only be called from the writer thread.
+        void reset() {
+            m_latestTime.store(0, std::memory_order_release);
+            m_count.store(0, std::memory_order_release);
+
+            // Invalidate the slots too, so that a reader who loaded the count before the reset cannot match an old
+            // sample with a new index.
+            for (Slot& slot : m_slots) {
+                write(slot, k_invalidIndex, Sample{});
+            }
+        }
+
+        // Returns false if the time is not within the history, or if the device was not tracked at the time.
+        bool lookup(XrTime time, size_t device, ovrResult& result, ovrPoseStatef& state) const {
+            // Fast path for queries in the future (eg: predicted display time).
+            if (time > m_latestTime.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            const uint64_t count = m_count.load(std::memory_order_acquire);
+            if (count == 0) {
+                return false;
+            }
+
+            // Walk backward from the most recent sample to find the two samples surrounding the requested time.
+            Sample after;
+            if (!read(count - 1, after) || time > after.time) {
+                return false;
+            }
+
+            const uint64_t oldest = count > Capacity ? count - Capacity : 0;
+            for (uint64_t index = count - 1; index > oldest; index--) {
+                Sample before;
+                if (!read(index - 1, before)) {
+                    return false;
+                }
+
+                if (before.time <= time) {
+                    if (OVR_FAILURE(before.result[device]) || OVR_FAILURE(after.result[device])) {
+                        return false;
+                    }
+
+                    const XrTime period = after.time - before.time;
+                    const float alpha = period > 0 ? (float)(time - before.time) / period : 1.f;
+                    result = after.result[device];
+                    state = interpolate(before.state[device], after.state[device], alpha);
+                    return true;
+                }
+
+                after = before;
+            }
+
+            if (time == after.time && OVR_SUCCESS(after.result[device])) {
+                result = after.result[device];
+                state = after.state[device];
+                return true;
+            }
+
+            return false;
+        }
+
+      private:
+        static constexpr uint64_t k_invalidIndex = ~0ull;
+
+        // The payload is only ever copied with memcpy() between the fences, like the performance counters (see
+        // readPerformanceCounters()).
+        struct Payload {
+            uint64_t index;
+            Sample sample;
+        };
+
+        struct Slot {
+            std::atomic<uint32_t> sequence{0};
+            Payload payload{k_invalidIndex, {}};
+        };
+
+        static void write(Slot& slot, uint64_t index, const Sample& sample) {
+            Payload payload;
+            payload.index = index;
+            payload.sample = sample;
+
+            const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            memcpy(&slot.payload, &payload, sizeof(payload));
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        bool read(uint64_t index, Sample& sample) const {
+            const Slot& slot = m_slots[index % Capacity];
+            while (true) {
+                const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence & 1) {
+                    // Being written. Only the oldest slot can be in that state, so there is no point in waiting.
+                    return false;
+                }
+
+                Payload payload;
+                memcpy(&payload, &slot.payload, sizeof(payload));
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                    // The slot might have been recycled for a newer sample since we looked at the count.
+                    if (payload.index != index) {
+                        return false;
+                    }
+                    sample = payload.sample;
+                    return true;
+                }
+            }
+        }
+
+        static ovrPoseStatef interpolate(const ovrPoseStatef& a, const ovrPoseStatef& b, float alpha) {
+            const auto lerp = [alpha](const ovrVector3f& u, const ovrVector3f& v) {
+                return ovrVector3f{
+                    u.x + (v.x - u.x) * alpha, u.y + (v.y - u.y) * alpha, u.z + (v.z - u.z) * alpha};
+            };
+
+            ovrPoseStatef result;
+            result.ThePose.Position = lerp(a.ThePose.Position, b.ThePose.Position);
+            DirectX::XMStoreFloat4(
+                reinterpret_cast<DirectX::XMFLOAT4*>(&result.ThePose.Orientation),
+                DirectX::XMQuaternionSlerp(
+                    DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&a.ThePose.Orientation)),
+                    DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&b.ThePose.Orientation)),
+                    alpha));
+            result.AngularVelocity = lerp(a.AngularVelocity, b.AngularVelocity);
+            result.LinearVelocity = lerp(a.LinearVelocity, b.LinearVelocity);
+            result.AngularAcceleration = lerp(a.AngularAcceleration, b.AngularAcceleration);
+            result.LinearAcceleration = lerp(a.LinearAcceleration, b.LinearAcceleration);
+            result.TimeInSeconds = a.TimeInSeconds + (b.TimeInSeconds - a.TimeInSeconds) * alpha;
+
+            return result;
+        }
+
+        Slot m_slots[Capacity];
+        std::atomic<uint64_t> m_count{0};
+        std::atomic<XrTime> m_latestTime{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // Picks how long before the next frame boundary the application is woken up ("running start"). Waking up too early
+    // adds latency, while waking up too late makes the application miss the frame.
+    // The controller tracks the slack with which frames are submitted and keeps a low quantile of it (the target miss
+    // rate) just above the observed wake-up jitter. Missed frames and spikes of application CPU time raise the offset
+    // right away. It has no dependency on the runtime, so that it can be driven by synthetic frame timings.
+    // All times are in seconds. Not thread-safe.
+    class RunningStartController {
+      public:
+        void setBounds(double minOffset, double maxOffset) {
+            m_minOffset = std::min(minOffset, maxOffset);
+            m_maxOffset = maxOffset;
+            m_offset = std::clamp(m_offset, m_minOffset, m_maxOffset);
+        }
+
+        void reset(double initialOffset) {
+            m_offset = std::clamp(initialOffset, m_minOffset, m_maxOffset);
+            m_slackQuantile = 0;
+            m_wakeUpJitter = 0;
+            m_appCpuTime = 0;
+            m_appCpuTimeDeviation = 0;
+            m_numMissedFrames = 0;
+        }
+
+        double offset() const {
+            return m_offset;
+        }
+
+        double slackQuantile() const {
+            return m_slackQuantile;
+        }
+
+        double wakeUpJitter() const {
+            return m_wakeUpJitter;
+        }
+
+        double appCpuTime() const {
+            return m_appCpuTime;
+        }
+
+        uint64_t numMissedFrames() const {
+            return m_numMissedFrames;
+        }
+
+        // The application was woken up by the running start, this much after the requested time.
+        void onWakeUp(double lateness) {
+            m_wakeUpJitter += k_smoothing * (std::max(lateness, 0.0) - m_wakeUpJitter);
+        }
+
+        // The CPU time of the last application frame.
+        void onAppCpuTime(double cpuTime) {
+            const double deviation = cpuTime - m_appCpuTime;
+            m_appCpuTime += k_smoothing * deviation;
+            m_appCpuTimeDeviation += k_smoothing * (std::abs(deviation) - m_appCpuTimeDeviation);
+
+            // Anticipate the next frame being just as heavy.
+            const double spike = deviation - 2 * m_appCpuTimeDeviation;
+            if (spike > 0) {
+                raise(std::min(spike, k_missPenalty));
+            }
+        }
+
+        // The application submitted its frame this long before the frame boundary (negative when it was missed).
+        void onFrameSubmitted(double slack) {
+            // Stochastic approximation of the target quantile: it moves down by (1 - target) when the sample is below
+            // it and up by target otherwise, which is stable when exactly target samples are below it.
+            m_slackQuantile += k_quantileStep * (k_targetMissRate - (slack < m_slackQuantile ? 1.0 : 0.0));
+
+            if (slack < 0) {
+                m_numMissedFrames++;
+                raise(k_missPenalty);
+            } else {
+                // Give back the slack that is not needed to absorb the wake-up jitter.
+                m_offset -= k_gain * (m_slackQuantile - m_wakeUpJitter);
+                m_offset = std::clamp(m_offset, m_minOffset, m_maxOffset);
+            }
+        }
+
+      private:
+        void raise(double amount) {
+            m_offset = std::clamp(m_offset + amount, m_minOffset, m_maxOffset);
+        }
+
+        static constexpr double k_targetMissRate = 0.02;
+        static constexpr double k_quantileStep = 0.001;
+        static constexpr double k_missPenalty = 0.0005;
+        static constexpr double k_gain = 0.1;
+        static constexpr double k_smoothing = 0.1;
+
+        double m_minOffset{0};
+        double m_maxOffset{0};
+        double m_offset{0};
+        double m_slackQuantile{0};
+        double m_wakeUpJitter{0};
+        double m_appCpuTime{0};
+        double m_appCpuTimeDeviation{0};
+        uint64_t m_numMissedFrames{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -34,6 +34,9 @@ namespace virtualdesktop_openxr {
     extern const std::string RuntimePrettyName;
     const std::string RegPrefix = "SOFTWARE\\VirtualDesktop-OpenXR";
 
+    // The component tables for an interaction profile. See mappings.cpp.
+    struct InteractionProfile;
+
     namespace FaceTracking {
 
         // See type definitions from Virtual Desktop.
@@ -271,6 +274,16 @@ namespace virtualdesktop_openxr {
                                                   float* displayRefreshRates) override;
         XrResult xrGetDisplayRefreshRateFB(XrSession session, float* displayRefreshRate) override;
         XrResult xrRequestDisplayRefreshRateFB(XrSession session, float displayRefreshRate) override;
+        XrResult xrLocateSpacesKHR(XrSession session,
+                                   const XrSpacesLocateInfoKHR* locateInfo,
+                                   XrSpaceLocationsKHR* spaceLocations) override;
+
+      protected:
+        // Read a setting from the registry. The tests substitute their own settings.
+        virtual std::optional<int> getSetting(const std::string& value) const;
+
+        // Read the settings that can change while the application is running.
+        void refreshSettings();
 
       private:
         enum class ForcedInteractionProfile {
@@ -302,6 +315,10 @@ namespace virtualdesktop_openxr {
             // Whether a static image swapchain has been acquired at least once.
             bool frozen{false};
 
+            // The image of each slice that the next commit will present. Frames waiting in the submission queue
+            // have not committed their images to OVR yet, so OVR's current index may lag behind. -1 until known.
+            std::vector<int> nextCommitIndex;
+
             // Resources needed to resolve MSAA and/or format conversion or alpha correction.
             std::vector<int> lastProcessedIndex;
             std::vector<std::vector<ComPtr<ID3D11ShaderResourceView>>> imagesResourceView;
@@ -325,12 +342,29 @@ namespace virtualdesktop_openxr {
             ovrTextureSwapChainDesc ovrDesc;
         };
 
+        // The device that a space is attached to.
+        enum class SpaceTarget {
+            // Not attached to any device (eg: LOCAL/STAGE or an unbound action space).
+            None = 0,
+            Hmd,
+            LeftGrip,
+            RightGrip,
+            LeftAim,
+            RightAim,
+            EyeGaze,
+        };
+
         struct Space {
             // Information recorded at creation.
             XrReferenceSpaceType referenceType;
             XrAction action{XR_NULL_HANDLE};
             XrPath subActionPath{XR_NULL_PATH};
             XrPosef poseInSpace;
+
+            // Resolved by updateSpaceTarget(), so that locating the space does not need to look at the bindings.
+            SpaceTarget target{SpaceTarget::None};
+            // The offset to apply to the device pose (poseInSpace composed with any controller pose offset).
+            XrPosef targetOffset;
         };
 
         struct ActionSource {
@@ -345,6 +379,40 @@ namespace virtualdesktop_openxr {
             std::string realPath;
         };
 
+        // A flattened copy of an action source, so that the hot paths do not need to do any string manipulation.
+        struct ActionBinding {
+            const float* floatValue{nullptr};
+
+            const ovrVector2f* vector2fValue{nullptr};
+            int vector2fIndex{-1};
+
+            const uint32_t* buttonMap{nullptr};
+            ovrButton buttonType;
+
+            // The hand for this source (0: left, 1: right) or -1 for non-hand paths.
+            int side{-1};
+            bool isEyeTracker{false};
+            bool isGripPose{false};
+            bool isAimPose{false};
+            bool isHapticOutput{false};
+
+            // Only used for tracing. Points to the key within the sources of the Action.
+            const char* fullPath{nullptr};
+        };
+
+        // The subaction paths that the bindings are pre-resolved for.
+        enum class BindingSlot {
+            Left = 0,
+            Right,
+            Eyes,
+            Any,
+
+            // Top-level paths that can never be bound (eg: /user/head).
+            Unbound,
+
+            Count
+        };
+
         struct ActionSet {
             std::string name;
             std::string localizedName;
@@ -362,17 +430,153 @@ namespace virtualdesktop_openxr {
 
             XrActionSet actionSet{XR_NULL_HANDLE};
 
-            float lastFloatValue[2]{0.f, 0.f};
-            XrTime lastFloatValueChangedTime[2]{0, 0};
+            std::set<XrPath> subactionPaths;
 
-            XrVector2f lastVector2fValue[2]{{0.f, 0.f}, {0.f, 0.f}};
-            XrTime lastVector2fValueChangedTime[2]{0, 0};
+            // The sources bound directly (eg: eye tracker), and the sources bound through the controller mappings for
+            // each side. The latter are swapped with the resolved bindings by rebindControllerActions().
+            std::map<std::string, ActionSource> actionSources;
+            std::map<std::string, ActionSource> controllerSources[2];
 
-            bool lastBoolValue[2]{false, false};
-            XrTime lastBoolValueChangedTime[2]{0, 0};
+            // Derived from the sources by updateActionBindings(), in the same (consistent) order.
+            std::vector<ActionBinding> bindings[(size_t)BindingSlot::Count];
 
-            std::set<XrPath> subactionPaths;
-            std::map<std::string, ActionSource> actionSources;
+            // Destroyed by the application, but kept alive since it might still be referenced by action spaces.
+            bool destroyed{false};
+        };
+
+        // The controller sources of each action for one side, resolved by rebindControllerActions() from the suggested
+        // bindings.
+        using ResolvedBindings = std::map<XrAction, std::map<std::string, ActionSource>>;
+
+        // (preferred interaction profile, actual interaction profile, side)
+        using ResolvedBindingsKey = std::tuple<std::string, std::string, int>;
+
+        // The state of an action for one binding slot, as evaluated by xrSyncActions().
+        struct ActionState {
+            bool isActive{false};
+            bool boolValue{false};
+            float floatValue{0.f};
+            XrVector2f vector2fValue{0.f, 0.f};
+            bool changedSinceLastSync{false};
+            XrTime lastChangeTime{0};
+        };
+
+        // The state of all attached actions. Never modified once published, so that the getters can read it without
+        // taking any lock.
+        struct ActionStateSnapshot {
+            struct Entry {
+                // XR_NULL_HANDLE if the slot in the actions table does not hold an attached action.
+                XrAction action{XR_NULL_HANDLE};
+                XrActionType type{XR_ACTION_TYPE_MAX_ENUM};
+
+                // Bitmask of the binding slots for the subaction paths declared with the action.
+                uint32_t validSlots{0};
+
+                ActionState state[(size_t)BindingSlot::Unbound];
+            };
+
+            // Indexed by the slot of the action in the actions table.
+            std::vector<Entry> entries;
+        };
+
+        // All the sources bound to the boolean, float and vector2f actions, flattened into a structure of arrays, so
+        // that xrSyncActions() can evaluate all of them in one pass. Rebuilt only when the bindings change.
+        struct ActionEvaluationTable {
+            // One term per (action, binding slot, source). Offsets are in 32-bit words within ovrInputState.
+            std::vector<uint32_t> offsetX;
+            std::vector<uint32_t> offsetY;
+            std::vector<uint32_t> buttonMask; // 0 for analog sources.
+            std::vector<float> threshold;     // For the conversion to boolean.
+            std::vector<uint32_t> side;
+
+            // Scratch storage for the evaluated terms.
+            std::vector<float> valueX;
+            std::vector<float> valueY;
+            std::vector<uint32_t> isActive;
+
+            // One output per (action, binding slot), reducing a contiguous range of terms.
+            struct Output {
+                XrActionSet actionSet;
+                uint32_t entry;
+                uint32_t slot;
+                XrActionType type;
+                uint32_t firstTerm;
+                uint32_t termCount;
+            };
+            std::vector<Output> outputs;
+        };
+
+        // Poses for all tracked devices, as returned by a single ovr_GetDevicePoses() call.
+        static constexpr uint32_t k_numCachedDevicePoses = 3;
+        struct DevicePoseCacheEntry {
+            XrTime time{0};
+            ovrResult result[k_numCachedDevicePoses];
+            ovrPoseStatef state[k_numCachedDevicePoses];
+        };
+
+        // The swapchain images to commit with a frame: at most one color and one depth image per view of each layer.
+        // Each entry is a swapchain and the slice whose OVR swapchain current image holds the content for this frame.
+        using CommittedSwapchainImages =
+            FixedVector<std::pair<Swapchain*, uint32_t>, ovrMaxLayerCount * xr::StereoView::Count * 2>;
+
+        // The layers of a frame, handed over to the asynchronous submission thread in place. Every frame in the queue
+        // has its own slot, and its swapchain images are only committed right before it is submitted.
+        static constexpr uint32_t k_maxAsyncSubmissionDepth = 3;
+        static constexpr uint32_t k_numAsyncSubmissionSlots = k_maxAsyncSubmissionDepth;
+        static_assert(k_numAsyncSubmissionSlots >= k_maxAsyncSubmissionDepth,
+                      "Each frame in the submission queue needs its own slot");
+        struct AsyncSubmissionSlot {
+            long long frameId{0};
+            uint32_t layerCount{0};
+            ovrLayer_Union layers[ovrMaxLayerCount];
+            CommittedSwapchainImages committedSwapchainImages;
+            std::chrono::high_resolution_clock::time_point publishTime{};
+
+            // The statistics of the frame. The submission thread completes them with the submission latencies before
+            // releasing the slot, and the xrEndFrame() that reuses the slot records them.
+            mutable FrameRecord record;
+            bool hasRecord{false};
+        };
+
+        // Everything about a layer that is not expected to change from one frame to the next. It is compared with
+        // memcmp(), so it is zeroed before being filled one member at a time (leaving the padding untouched).
+        struct LayerTopology {
+            XrStructureType type;
+            XrCompositionLayerFlags layerFlags;
+            XrSpace space;
+            XrSwapchain swapchain[xr::StereoView::Count];
+            uint32_t imageArrayIndex[xr::StereoView::Count];
+            XrRect2Di imageRect[xr::StereoView::Count];
+            XrSwapchain depthSwapchain[xr::StereoView::Count];
+            uint32_t depthImageArrayIndex[xr::StereoView::Count];
+            XrRect2Di depthImageRect[xr::StereoView::Count];
+            float nearZ[xr::StereoView::Count];
+            float farZ[xr::StereoView::Count];
+            XrExtent2Df quadSize;
+        };
+
+        // The layers translated during the last frame, along with the objects they were translated from. When the next
+        // frame has the same topology, only poses, FOVs and the display time need to be patched.
+        struct LayerTranslationCache {
+            struct Sources {
+                const Space* space;
+                Swapchain* swapchain[xr::StereoView::Count];
+                Swapchain* depthSwapchain[xr::StereoView::Count];
+                XrFovf fov[xr::StereoView::Count];
+            };
+
+            bool isValid{false};
+            uint64_t generation{0};
+            uint32_t layerCount{0};
+            bool isProj0SRGB{false};
+            LayerTopology topology[ovrMaxLayerCount];
+            Sources sources[ovrMaxLayerCount];
+            ovrLayer_Union layers[ovrMaxLayerCount];
+
+            uint64_t numHits{0};
+            uint64_t numMisses{0};
+            double hitTimeUs{0};
+            double missTimeUs{0};
         };
 
         enum class EyeTracking {
@@ -384,29 +588,43 @@ namespace virtualdesktop_openxr {
         // instance.cpp
         void initializeExtensionsTable();
         bool InitializeOVR();
-        std::optional<int> getSetting(const std::string& value) const;
 
         // session.cpp
         void updateSessionState(bool forceSendEvent = false);
-        void refreshSettings();
 
         // action.cpp
         void rebindControllerActions(int side);
-        std::string getXrPath(XrPath path) const;
+        ResolvedBindings resolveActionSources(const std::vector<XrActionSuggestedBinding>& bindings,
+                                              const std::string& interactionProfile,
+                                              int side);
+        void invalidateResolvedBindings();
+        const std::string& getXrPath(XrPath path) const;
         XrPath stringToPath(const std::string& path, bool validate = false);
+        bool isKnownPath(XrPath path) const;
+        Action* getAction(XrAction action);
+        // Only used for tracing. Must be called with actionsAndSpacesMutex held.
+        const std::vector<ActionBinding>* getActionBindings(XrAction action, XrPath subactionPath);
+        void updateActionBindings(Action& xrAction) const;
+        BindingSlot getBindingSlot(XrPath subactionPath) const;
         int getActionSide(const std::string& fullPath, bool allowExtraPaths = false) const;
         bool isActionEyeTracker(const std::string& fullPath) const;
+        void publishActionStates(const std::set<XrActionSet>& syncedActionSets);
+        void buildActionEvaluationTable();
+        void evaluateActionStates(const std::set<XrActionSet>& syncedActionSets,
+                                  XrTime syncTime,
+                                  ActionStateSnapshot& snapshot);
+        bool isPoseActionActive(const Action& xrAction, BindingSlot slot) const;
+        bool getActionState(XrAction action, XrPath subactionPath, XrActionType type, ActionState& state) const;
+        XrResult checkActionStateQuery(XrAction action, XrPath subactionPath, XrActionType type);
 
         // mappings.cpp
-        void initializeRemappingTables();
-        bool mapPathToTouchControllerInputState(const Action& xrAction,
-                                                const std::string& path,
+        const InteractionProfile* getInteractionProfile(std::string_view interactionProfile) const;
+        bool isValidInteractionProfilePath(const InteractionProfile& interactionProfile, std::string_view path) const;
+        bool mapPathToTouchControllerInputState(const InteractionProfile& interactionProfile,
+                                                const Action& xrAction,
+                                                std::string_view path,
                                                 ActionSource& source) const;
-        std::string getTouchControllerLocalizedSourceName(const std::string& path) const;
-        std::optional<std::string> remapSimpleControllerToTouchController(const std::string& path) const;
-        std::optional<std::string> remapMicrosoftMotionControllerToTouchController(const std::string& path) const;
-        std::optional<std::string> remapViveControllerToTouchController(const std::string& path) const;
-        std::optional<std::string> remapIndexControllerToTouchController(const std::string& path) const;
+        const char* getTouchControllerLocalizedSourceName(std::string_view path) const;
 
         // space.cpp
         XrSpaceLocationFlags locateSpace(const Space& xrSpace,
@@ -415,6 +633,7 @@ namespace virtualdesktop_openxr {
                                          XrPosef& pose,
                                          XrSpaceVelocity* velocity = nullptr,
                                          XrEyeGazeSampleTimeEXT* gazeSampleTime = nullptr) const;
+        bool canLocateSpaceDirectly(const Space& xrSpace, const Space& xrBaseSpace) const;
         XrSpaceLocationFlags locateSpaceToOrigin(const Space& xrSpace,
                                                  XrTime time,
                                                  XrPosef& pose,
@@ -423,6 +642,13 @@ namespace virtualdesktop_openxr {
         XrSpaceLocationFlags getHmdPose(XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const;
         XrSpaceLocationFlags getControllerPose(int side, XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const;
         XrSpaceLocationFlags getEyeTrackerPose(XrTime time, XrPosef& pose, XrEyeGazeSampleTimeEXT* sampleTime) const;
+        ovrResult getDevicePose(ovrTrackedDeviceType device, XrTime time, ovrPoseStatef& state) const;
+        void queryDevicePoses(XrTime time, ovrResult* results, ovrPoseStatef* states) const;
+        void sampleDevicePoseHistory(XrTime now) const;
+        void invalidateDevicePoseCache();
+        void updateSpaceTarget(Space& xrSpace) const;
+        void recordViewsLocate(XrTime displayTime);
+        double getViewsLocateTime(XrTime displayTime);
 
         // eye_tracking.cpp
         bool getEyeGaze(XrTime time, bool getStateOnly, XrVector3f& unitVector, double& sampleTime) const;
@@ -431,6 +657,15 @@ namespace virtualdesktop_openxr {
         // frame.cpp
         void asyncSubmissionThread();
         void waitForAsyncSubmissionIdle(bool doRunningStart = false);
+        void waitForAsyncSubmissionDrained();
+        void commitSwapchainImages(const CommittedSwapchainImages& committedSwapchainImages);
+        void discardSwapchainImages(const CommittedSwapchainImages& committedSwapchainImages);
+        void recordFrameStatistics(const FrameRecord& record);
+        void logFrameStatistics() const;
+        void publishPerformanceCounters(const FrameRecord& record);
+        bool getLayerTopology(const XrFrameEndInfo& frameEndInfo, LayerTopology* topology) const;
+        XrResult patchCachedLayers(const XrFrameEndInfo& frameEndInfo, AsyncSubmissionSlot& frameLayers);
+        void traceCachedDepthInfo(const XrCompositionLayerProjectionView& view, uint32_t viewIndex) const;
 
         // d3d11_native.cpp
         XrResult initializeD3D11(const XrGraphicsBindingD3D11KHR& d3dBindings);
@@ -440,11 +675,11 @@ namespace virtualdesktop_openxr {
         void cleanupSubmissionDevice();
         std::vector<HANDLE> getSwapchainImages(Swapchain& xrSwapchain);
         XrResult getSwapchainImagesD3D11(Swapchain& xrSwapchain, XrSwapchainImageD3D11KHR* d3d11Images, uint32_t count);
-        void prepareAndCommitSwapchainImage(Swapchain& xrSwapchain,
-                                            uint32_t layerIndex,
-                                            uint32_t slice,
-                                            XrCompositionLayerFlags compositionFlags,
-                                            std::set<std::pair<ovrTextureSwapChain, uint32_t>>& committed);
+        void prepareSwapchainImage(Swapchain& xrSwapchain,
+                                   uint32_t layerIndex,
+                                   uint32_t slice,
+                                   XrCompositionLayerFlags compositionFlags,
+                                   CommittedSwapchainImages& committed);
         void ensureSwapchainSliceResources(Swapchain& xrSwapchain, uint32_t slice) const;
         void ensureSwapchainIntermediateResources(Swapchain& xrSwapchain) const;
         void flushD3D11Context();
@@ -498,16 +733,12 @@ namespace virtualdesktop_openxr {
         float m_displayRefreshRate{0};
         double m_idealFrameDuration{0};
         double m_predictedFrameDuration{0};
+        FramePeriodEstimator m_framePeriodEstimator;
         ovrHmdDesc m_cachedHmdInfo{};
         ovrEyeRenderDesc m_cachedEyeInfo[xr::StereoView::Count]{};
         float m_floorHeight{0.f};
         LARGE_INTEGER m_qpcFrequency{};
         double m_ovrTimeFromQpcTimeOffset{0};
-        XrPath m_stringIndex{0};
-        using MappingFunction = std::function<bool(const Action&, XrPath, ActionSource&)>;
-        using CheckValidPathFunction = std::function<bool(const std::string&)>;
-        std::map<std::pair<std::string, std::string>, MappingFunction> m_controllerMappingTable;
-        std::map<std::string, CheckValidPathFunction> m_controllerValidPathsTable;
         wil::unique_registry_watcher m_registryWatcher;
         bool m_loggedResolution{false};
         std::string m_applicationName;
@@ -534,16 +765,24 @@ namespace virtualdesktop_openxr {
         bool m_sessionStopping{false};
         bool m_sessionExiting{false};
         XrFovf m_cachedEyeFov[xr::StereoView::Count];
-        std::mutex m_actionsAndSpacesMutex;
-        std::map<XrPath, std::string> m_strings; // protected by actionsAndSpacesMutex
-        std::set<XrActionSet> m_actionSets;
+        std::shared_mutex m_actionsAndSpacesMutex;
+        std::deque<std::string> m_strings;                        // protected by actionsAndSpacesMutex
+        std::unordered_map<std::string_view, XrPath> m_pathIndex; // protected by actionsAndSpacesMutex
+        XrPath m_handSubactionPath[2]{XR_NULL_PATH, XR_NULL_PATH};
+        XrPath m_eyesSubactionPath{XR_NULL_PATH};
+        HandleTable<ActionSet, XrActionSet> m_actionSets;
         std::set<XrActionSet> m_activeActionSets;
-        std::set<XrAction> m_actions;
-        std::set<XrAction> m_actionsForCleanup;
-        std::set<XrSpace> m_spaces;
+        HandleTable<Action, XrAction> m_actions;
+        SnapshotPublisher<ActionStateSnapshot> m_actionStates;
+        ActionEvaluationTable m_actionEvaluationTable;
+        bool m_actionEvaluationTableDirty{true};
+        HandleTable<Space, XrSpace> m_spaces;
         Space* m_originSpace{nullptr};
         Space* m_viewSpace{nullptr};
         std::map<std::string, std::vector<XrActionSuggestedBinding>> m_suggestedBindings;
+        std::map<ResolvedBindingsKey, ResolvedBindings> m_resolvedBindings;
+        // The entry of m_resolvedBindings whose tables are currently swapped into the actions, for each side.
+        ResolvedBindings* m_appliedResolvedBindings[2]{nullptr, nullptr};
         bool m_isControllerActive[2]{false, false};
         std::string m_cachedControllerType[2];
         XrPosef m_controllerAimOffset;
@@ -556,10 +795,13 @@ namespace virtualdesktop_openxr {
         std::optional<ForcedInteractionProfile> m_forcedInteractionProfile;
         std::optional<ForcedInteractionProfile> m_lastForcedInteractionProfile;
         bool m_useRunningStart{true};
+        double m_runningStartMinOffset{0.0005};
+        double m_runningStartMaxOffset{0.005};
+        RunningStartController m_runningStart;
 
         // Swapchains and other graphics stuff.
         std::mutex m_swapchainsMutex;
-        std::set<XrSwapchain> m_swapchains;
+        HandleTable<Swapchain, XrSwapchain> m_swapchains;
 
         // Mirror window.
         bool m_useMirrorWindow{false};
@@ -573,13 +815,20 @@ namespace virtualdesktop_openxr {
 
         // Async submittion thread.
         bool m_useAsyncSubmission{false};
-        bool m_needStartAsyncSubmissionThread{false};
-        bool m_terminateAsyncThread{false};
+        // Read by xrWaitSwapchainImage(), which does not hold the frame lock.
+        std::atomic<bool> m_needStartAsyncSubmissionThread{false};
+        // Latched by xrBeginSession(), so that it does not change while frames are queued.
+        uint32_t m_asyncSubmissionDepth{1};
         std::thread m_asyncSubmissionThread;
-        std::mutex m_asyncSubmissionMutex;
-        std::condition_variable m_asyncSubmissionCondVar;
-        std::vector<ovrLayer_Union> m_layersForAsyncSubmission;
-        std::chrono::high_resolution_clock::time_point m_lastWaitToBeginFrameTime{};
+        SpscRing<AsyncSubmissionSlot, k_numAsyncSubmissionSlots> m_asyncSubmissionRing;
+
+        // Held while using the submission context, since OVR may use it from the submission thread while committing
+        // and submitting a queued frame.
+        std::mutex m_submissionContextMutex;
+        LayerTranslationCache m_layerTranslationCache;
+        uint64_t m_layerTopologyGeneration{0};
+        // Written by the submission thread.
+        std::atomic<std::chrono::high_resolution_clock::time_point> m_lastWaitToBeginFrameTime{};
 
         // Graphics API interop.
         ComPtr<ID3D11Device5> m_d3d11Device;
@@ -635,12 +884,47 @@ namespace virtualdesktop_openxr {
         uint64_t m_lastGpuFrameTimeUs{0};
         ovrInputState m_cachedInputState;
         XrTime m_lastPredictedDisplayTime{0};
-        mutable std::optional<XrPosef> m_lastValidHmdPose;
+
+        // Device poses cache (invalidated every frame).
+        mutable std::mutex m_devicePoseCacheMutex;
+        mutable std::optional<XrPosef> m_lastValidHmdPose; // protected by devicePoseCacheMutex
+        mutable DevicePoseCacheEntry m_devicePoseCache[4];
+        mutable uint32_t m_devicePoseCacheNextEntry{0};
+        mutable uint64_t m_devicePoseCacheHits{0};
+        mutable uint64_t m_devicePoseCacheMisses{0};
+
+        // Device poses sampled at most once per frame, to answer queries in the recent past.
+        static constexpr size_t k_devicePoseHistorySize = 32;
+        mutable DevicePoseHistory<k_numCachedDevicePoses, k_devicePoseHistorySize>
+            m_devicePoseHistory; // written under devicePoseCacheMutex
+        mutable bool m_devicePoseHistoryNeedsSample{false}; // protected by devicePoseCacheMutex
+        mutable std::atomic<uint64_t> m_devicePoseHistoryHits{0};
 
         // Statistics.
         double m_sessionStartTime{0.0};
         uint64_t m_sessionTotalFrameCount{0};
-        std::deque<double> m_frameTimes;
+        FrameStatistics m_frameStatistics;
+        FrameRecord m_currentFrameRecord;
+
+        // The statistics for each depth of the asynchronous submission queue (0 without asynchronous submission).
+        ConfigurationStatistics m_submissionDepthStatistics[k_maxAsyncSubmissionDepth + 1];
+        double m_lastFrameEndTime{0};
+
+        // The most recent calls to xrLocateViews(), to find out when the poses submitted with a frame were queried.
+        // Lock-free, since xrLocateViews() may be called from any thread.
+        struct ViewsLocateQuery {
+            std::atomic<XrTime> displayTime{0};
+            std::atomic<double> time{0};
+        };
+        static constexpr uint32_t k_numViewsLocateQueries = 4;
+        ViewsLocateQuery m_viewsLocateQueries[k_numViewsLocateQueries];
+        std::atomic<uint32_t> m_nextViewsLocateQuery{0};
+
+        // The number of frames published to the submission thread since it was started, to tell whether the slot
+        // about to be reused holds a frame of this session.
+        uint64_t m_numPublishedFrames{0};
+        bool m_usePerformanceCounters{true};
+        PerformanceCountersWriter m_performanceCounters;
         CpuTimer m_frameTimerApp;
         CpuTimer m_renderTimerApp;
         static constexpr uint32_t k_numGpuTimers = 3;
@@ -655,7 +939,14 @@ namespace virtualdesktop_openxr {
     // A function to reset (delete) the singleton.
     void ResetInstance();
 
+    // A function to install the singleton before GetInstance() creates one. The tests use it to substitute a runtime
+    // with different settings.
+    void SetInstance(std::unique_ptr<OpenXrRuntime> instance);
+
     extern std::filesystem::path dllHome;
     extern std::filesystem::path localAppData;
 
+    // The OpenXR call stream recorder, used by the dispatch wrappers.
+    extern utils::CallRecorder callRecorder;
+
 } // namespace virtualdesktop_openxr
@@ -144,7 +144,24 @@ namespace virtualdesktop_openxr {
         m_sessionState = XR_SESSION_STATE_IDLE;
         updateSessionState(true);
 
-        m_frameTimes.clear();
+        m_frameStatistics.reset();
+        m_currentFrameRecord = {};
+        for (auto& statistics : m_submissionDepthStatistics) {
+            statistics.reset();
+        }
+        m_lastFrameEndTime = 0;
+        for (auto& query : m_viewsLocateQueries) {
+            query.displayTime = 0;
+            query.time = 0;
+        }
+        if (m_usePerformanceCounters && !m_performanceCounters.open()) {
+            TraceLoggingWrite(g_traceProvider, "PerformanceCounters_Unavailable", TLArg(GetLastError(), "Error"));
+        }
+
+        m_runningStart.setBounds(m_runningStartMinOffset, m_runningStartMaxOffset);
+        m_runningStart.reset(0.002);
+        m_framePeriodEstimator.reset(m_idealFrameDuration);
+        m_predictedFrameDuration = m_idealFrameDuration;
 
         m_isControllerActive[0] = m_isControllerActive[1] = false;
         m_controllerAimPose[0] = m_controllerGripPose[0] = m_controllerAimPose[1] = m_controllerGripPose[1] =
@@ -152,18 +169,29 @@ namespace virtualdesktop_openxr {
         rebindControllerActions(0);
         rebindControllerActions(1);
         m_activeActionSets.clear();
+        publishActionStates({});
 
         m_sessionStartTime = ovr_GetTimeInSeconds();
         m_sessionTotalFrameCount = 0;
 
+        {
+            std::unique_lock lock(m_devicePoseCacheMutex);
+            m_devicePoseHistory.reset();
+            m_devicePoseHistoryNeedsSample = false;
+            m_devicePoseHistoryHits = 0;
+        }
+
         try {
-            // Create a reference space with the origin and the HMD pose.
-            m_originSpace = new Space;
+            // Create a reference space with the origin and the HMD pose. These handles are never returned to the
+            // application.
+            m_originSpace = m_spaces.get(m_spaces.emplace());
             m_originSpace->referenceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
             m_originSpace->poseInSpace = Pose::Identity();
-            m_viewSpace = new Space;
+            updateSpaceTarget(*m_originSpace);
+            m_viewSpace = m_spaces.get(m_spaces.emplace());
             m_viewSpace->referenceType = XR_REFERENCE_SPACE_TYPE_VIEW;
             m_viewSpace->poseInSpace = Pose::Identity();
+            updateSpaceTarget(*m_viewSpace);
         } catch (std::exception& exc) {
             m_sessionCreated = false;
             throw exc;
@@ -184,13 +212,11 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        if (m_useAsyncSubmission && !m_needStartAsyncSubmissionThread) {
-            {
-                std::unique_lock lock(m_asyncSubmissionMutex);
+        logFrameStatistics();
+        m_performanceCounters.close();
 
-                m_terminateAsyncThread = true;
-                m_asyncSubmissionCondVar.notify_all();
-            }
+        if (m_useAsyncSubmission && !m_needStartAsyncSubmissionThread) {
+            m_asyncSubmissionRing.close();
             m_asyncSubmissionThread.join();
             m_asyncSubmissionThread = {};
             m_needStartAsyncSubmissionThread = true;
@@ -210,20 +236,15 @@ namespace virtualdesktop_openxr {
         }
 
         // Destroy action spaces (tied to session).
-        for (auto space : m_spaces) {
-            Space* xrSpace = (Space*)space;
-            delete xrSpace;
-        }
         m_spaces.clear();
-        delete m_originSpace;
-        delete m_viewSpace;
         m_originSpace = m_viewSpace = nullptr;
+        m_layerTopologyGeneration++;
 
         // Destroy all swapchains (tied to session).
-        while (m_swapchains.size()) {
+        for (const auto swapchain : m_swapchains.handles()) {
             // TODO: Ideally we do not invoke OpenXR public APIs to avoid confusing event tracing and possible
             // deadlocks.
-            CHECK_XRCMD(xrDestroySwapchain(*m_swapchains.begin()));
+            CHECK_XRCMD(xrDestroySwapchain(swapchain));
         }
 
         // We do not destroy actionsets and actions, since they are tied to the instance.
@@ -276,6 +297,14 @@ namespace virtualdesktop_openxr {
         m_needStartAsyncSubmissionThread = m_useAsyncSubmission;
         // Creation of the submission threads is deferred to the first xrWaitFrame() to accomodate OpenComposite quirks.
 
+        // The depth of the submission queue is only read here: refreshSettings() runs on another thread.
+        m_asyncSubmissionDepth =
+            (uint32_t)std::clamp(getSetting("async_submission_depth").value_or(1), 1, (int)k_maxAsyncSubmissionDepth);
+        TraceLoggingWrite(g_traceProvider,
+                          "xrBeginSession_AsyncSubmission",
+                          TLArg(m_useAsyncSubmission, "AsyncSubmission"),
+                          TLArg(m_asyncSubmissionDepth, "AsyncSubmissionDepth"));
+
         m_sessionBegun = true;
         updateSessionState();
 
@@ -423,16 +452,23 @@ namespace virtualdesktop_openxr {
         m_useMirrorWindow = getSetting("mirror_window").value_or(false);
 
         m_useRunningStart = !getSetting("quirk_disable_running_start").value_or(false);
+        m_runningStartMinOffset = getSetting("running_start_min_us").value_or(500) / 1e6;
+        m_runningStartMaxOffset = getSetting("running_start_max_us").value_or(5000) / 1e6;
 
         m_syncGpuWorkInEndFrame = getSetting("quirk_sync_gpu_work_in_end_frame").value_or(false);
 
+        m_usePerformanceCounters = getSetting("performance_counters").value_or(true);
+
         TraceLoggingWrite(
             g_traceProvider,
             "PXR_Config",
             TLArg((int)m_forcedInteractionProfile.value_or((ForcedInteractionProfile)-1), "ForcedInteractionProfile"),
             TLArg(m_useMirrorWindow, "MirrorWindow"),
             TLArg(m_useRunningStart, "UseRunningStart"),
-            TLArg(m_syncGpuWorkInEndFrame, "SyncGpuWorkInEndFrame"));
+            TLArg(m_runningStartMinOffset, "RunningStartMinOffset"),
+            TLArg(m_runningStartMaxOffset, "RunningStartMaxOffset"),
+            TLArg(m_syncGpuWorkInEndFrame, "SyncGpuWorkInEndFrame"),
+            TLArg(m_usePerformanceCounters, "PerformanceCounters"));
     }
 
 } // namespace virtualdesktop_openxr
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // Publishes immutable snapshots of some state to readers that never take a lock.
+    // Publishing is serialized by the caller. Readers register in the current epoch before loading the snapshot, and a
+    // replaced snapshot is only deleted once all the readers from the epochs during which it could have been loaded
+    // are gone. Three epoch counters are used, so that new readers never register in a counter that is being drained.
+    template <typename T>
+    class SnapshotPublisher {
+      public:
+        // Holds a snapshot alive for the lifetime of the object. Meant to be short-lived (stack only).
+        class Reader {
+          public:
+            explicit Reader(const SnapshotPublisher& publisher) {
+                while (true) {
+                    const uint64_t epoch = publisher.m_epoch.load();
+                    m_readers = &publisher.m_readers[epoch % std::size(publisher.m_readers)];
+                    m_readers->fetch_add(1);
+                    m_snapshot = publisher.m_current.load();
+
+                    // The snapshot is only guaranteed to be protected if it was loaded within the same epoch.
+                    if (publisher.m_epoch.load() == epoch) {
+                        break;
+                    }
+                    m_readers->fetch_sub(1);
+                }
+            }
+
+            ~Reader() {
+                m_readers->fetch_sub(1);
+            }
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            const T* get() const {
+                return m_snapshot;
+            }
+
+            const T* operator->() const {
+                return m_snapshot;
+            }
+
+          private:
+            std::atomic<uint32_t>* m_readers;
+            const T* m_snapshot;
+        };
+
+        ~SnapshotPublisher() {
+            delete m_current.load();
+        }
+
+        Reader read() const {
+            return Reader(*this);
+        }
+
+        // The latest snapshot. Only safe to use from the publishing side.
+        const T* latest() const {
+            return m_current.load();
+        }
+
+        void publish(std::unique_ptr<T> snapshot) {
+            T* const previous = m_current.exchange(snapshot.release());
+
+            // The snapshot retired during the previous publication could be held by readers from its two epochs.
+            // Those counters are about to be reused by new readers, so they must be drained first. Readers only hold a
+            // snapshot very briefly, so this wait is expected to be short (if any).
+            if (m_retired) {
+                const uint64_t epoch = m_retiredEpoch;
+                while (m_readers[(epoch + std::size(m_readers) - 1) % std::size(m_readers)].load() ||
+                       m_readers[epoch % std::size(m_readers)].load()) {
+                    std::this_thread::yield();
+                }
+                m_retired.reset();
+            }
+
+            // Readers from the epoch before the bump might still have loaded the previous snapshot.
+            m_retiredEpoch = m_epoch.fetch_add(1);
+            m_retired.reset(previous);
+        }
+
+      private:
+        std::atomic<T*> m_current{nullptr};
+        std::atomic<uint64_t> m_epoch{1};
+        mutable std::atomic<uint32_t> m_readers[3]{};
+
+        std::unique_ptr<T> m_retired;
+        uint64_t m_retiredEpoch{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
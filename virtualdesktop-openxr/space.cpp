@@ -99,15 +99,12 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
-        // Create the internal struct.
-        Space& xrSpace = *new Space;
+        // Create the internal struct. The handle table maintains the list of known spaces for validation and cleanup.
+        *space = m_spaces.emplace();
+        Space& xrSpace = *m_spaces.get(*space);
         xrSpace.referenceType = createInfo->referenceSpaceType;
         xrSpace.poseInSpace = createInfo->poseInReferenceSpace;
-
-        *space = (XrSpace)&xrSpace;
-
-        // Maintain a list of known spaces for validation and cleanup.
-        m_spaces.insert(*space);
+        updateSpaceTarget(xrSpace);
 
         TraceLoggingWrite(g_traceProvider, "xrCreateReferenceSpace", TLXArg(*space, "Space"));
 
@@ -136,28 +133,26 @@ namespace virtualdesktop_openxr {
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
         if (createInfo->action != XR_NULL_HANDLE) {
-            if (!m_actions.count(createInfo->action)) {
+            Action* const action = getAction(createInfo->action);
+            if (!action) {
                 return XR_ERROR_HANDLE_INVALID;
             }
 
-            Action& xrAction = *(Action*)createInfo->action;
+            const Action& xrAction = *action;
 
             if (xrAction.type != XR_ACTION_TYPE_POSE_INPUT) {
                 return XR_ERROR_ACTION_TYPE_MISMATCH;
             }
         }
 
-        // Create the internal struct.
-        Space& xrSpace = *new Space;
+        // Create the internal struct. The handle table maintains the list of known spaces for validation and cleanup.
+        *space = m_spaces.emplace();
+        Space& xrSpace = *m_spaces.get(*space);
         xrSpace.referenceType = XR_REFERENCE_SPACE_TYPE_MAX_ENUM;
         xrSpace.action = createInfo->action;
         xrSpace.subActionPath = createInfo->subactionPath;
         xrSpace.poseInSpace = createInfo->poseInActionSpace;
-
-        *space = (XrSpace)&xrSpace;
-
-        // Maintain a list of known spaces for validation and cleanup.
-        m_spaces.insert(*space);
+        updateSpaceTarget(xrSpace);
 
         TraceLoggingWrite(g_traceProvider, "xrCreateActionSpace", TLXArg(*space, "Space"));
 
@@ -201,9 +196,11 @@ namespace virtualdesktop_openxr {
 
         location->locationFlags = 0;
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_spaces.count(space) || !m_spaces.count(baseSpace)) {
+        Space* const xrSpacePtr = m_spaces.get(space);
+        Space* const xrBaseSpacePtr = m_spaces.get(baseSpace);
+        if (!xrSpacePtr || !xrBaseSpacePtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -227,24 +224,185 @@ namespace virtualdesktop_openxr {
             gazeSampleTime = reinterpret_cast<XrEyeGazeSampleTimeEXT*>(gazeSampleTime->next);
         }
 
-        Space& xrSpace = *(Space*)space;
-        Space& xrBaseSpace = *(Space*)baseSpace;
+        Space& xrSpace = *xrSpacePtr;
+        Space& xrBaseSpace = *xrBaseSpacePtr;
 
         location->locationFlags = locateSpace(xrSpace, xrBaseSpace, time, location->pose, velocity, gazeSampleTime);
 
         if (!velocity) {
-            TraceLoggingWrite(g_traceProvider,
-                              "xrLocateSpace",
-                              TLArg(location->locationFlags, "LocationFlags"),
-                              TLArg(xr::ToString(location->pose).c_str(), "Pose"));
+            TraceLoggingWriteIfEnabled(g_traceProvider,
+                                       "xrLocateSpace",
+                                       TLArg(location->locationFlags, "LocationFlags"),
+                                       TLArg(ToTraceString(location->pose).c_str(), "Pose"));
         } else {
-            TraceLoggingWrite(g_traceProvider,
-                              "xrLocateSpace",
-                              TLArg(location->locationFlags, "LocationFlags"),
-                              TLArg(xr::ToString(location->pose).c_str(), "Pose"),
-                              TLArg(velocity->velocityFlags, "VelocityFlags"),
-                              TLArg(xr::ToString(velocity->angularVelocity).c_str(), "AngularVelocity"),
-                              TLArg(xr::ToString(velocity->linearVelocity).c_str(), "LinearVelocity"));
+            TraceLoggingWriteIfEnabled(g_traceProvider,
+                                       "xrLocateSpace",
+                                       TLArg(location->locationFlags, "LocationFlags"),
+                                       TLArg(ToTraceString(location->pose).c_str(), "Pose"),
+                                       TLArg(velocity->velocityFlags, "VelocityFlags"),
+                                       TLArg(ToTraceString(velocity->angularVelocity).c_str(), "AngularVelocity"),
+                                       TLArg(ToTraceString(velocity->linearVelocity).c_str(), "LinearVelocity"));
+        }
+
+        return XR_SUCCESS;
+    }
+
+    // https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#xrLocateSpacesKHR
+    XrResult OpenXrRuntime::xrLocateSpacesKHR(XrSession session,
+                                              const XrSpacesLocateInfoKHR* locateInfo,
+                                              XrSpaceLocationsKHR* spaceLocations) {
+        if (locateInfo->type != XR_TYPE_SPACES_LOCATE_INFO_KHR || spaceLocations->type != XR_TYPE_SPACE_LOCATIONS_KHR) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "xrLocateSpacesKHR",
+                          TLXArg(session, "Session"),
+                          TLXArg(locateInfo->baseSpace, "BaseSpace"),
+                          TLArg(locateInfo->spaceCount, "SpaceCount"),
+                          TLArg(locateInfo->time, "Time"));
+
+        if (!has_XR_KHR_locate_spaces) {
+            return XR_ERROR_FUNCTION_UNSUPPORTED;
+        }
+
+        if (!m_sessionCreated || session != (XrSession)1) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        if (locateInfo->time <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+
+        if (!locateInfo->spaceCount || spaceLocations->locationCount != locateInfo->spaceCount) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        XrSpaceVelocitiesKHR* velocities = reinterpret_cast<XrSpaceVelocitiesKHR*>(spaceLocations->next);
+        while (velocities) {
+            if (velocities->type == XR_TYPE_SPACE_VELOCITIES_KHR) {
+                break;
+            }
+            velocities = reinterpret_cast<XrSpaceVelocitiesKHR*>(velocities->next);
+        }
+
+        if (velocities && velocities->velocityCount != locateInfo->spaceCount) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        std::shared_lock lock(m_actionsAndSpacesMutex);
+
+        // Validate all handles upfront so that we do not return partial results.
+        const Space* const xrBaseSpacePtr = m_spaces.get(locateInfo->baseSpace);
+        if (!xrBaseSpacePtr) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        for (uint32_t i = 0; i < locateInfo->spaceCount; i++) {
+            if (!m_spaces.contains(locateInfo->spaces[i])) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+        }
+
+        // Fetch all tracked devices in a single query. Every space below is then served from the device pose cache.
+        ovrPoseStatef state{};
+        getDevicePose(ovrTrackedDevice_HMD, locateInfo->time, state);
+
+        const Space& xrBaseSpace = *xrBaseSpacePtr;
+        XrPosef baseSpaceToVirtual = Pose::Identity();
+        XrSpaceVelocity baseSpaceToVirtualVelocity{XR_TYPE_SPACE_VELOCITY};
+        const XrSpaceLocationFlags baseSpaceFlags =
+            locateSpaceToOrigin(xrBaseSpace,
+                                locateInfo->time,
+                                baseSpaceToVirtual,
+                                velocities ? &baseSpaceToVirtualVelocity : nullptr,
+                                nullptr);
+
+        // Locate all spaces against the origin, then make them relative to the base space as a single batch.
+        thread_local PoseBatch locateSpacesBatch;
+        locateSpacesBatch.resize(locateInfo->spaceCount);
+        for (uint32_t i = 0; i < locateInfo->spaceCount; i++) {
+            const Space& xrSpace = *m_spaces.get(locateInfo->spaces[i]);
+            if (canLocateSpaceDirectly(xrSpace, xrBaseSpace)) {
+                continue;
+            }
+
+            XrPosef spaceToVirtual = Pose::Identity();
+            XrSpaceVelocity spaceToVirtualVelocity{XR_TYPE_SPACE_VELOCITY};
+            spaceLocations->locations[i].locationFlags = locateSpaceToOrigin(
+                xrSpace, locateInfo->time, spaceToVirtual, velocities ? &spaceToVirtualVelocity : nullptr, nullptr);
+            locateSpacesBatch.set(i, spaceToVirtual);
+
+            if (velocities) {
+                XrSpaceVelocityDataKHR& velocityData = velocities->velocities[i];
+                velocityData.velocityFlags = spaceToVirtualVelocity.velocityFlags;
+                velocityData.angularVelocity = spaceToVirtualVelocity.angularVelocity;
+                velocityData.linearVelocity = spaceToVirtualVelocity.linearVelocity;
+            }
+        }
+        pose_batch::Relative(locateSpacesBatch, baseSpaceToVirtual, locateSpacesBatch);
+
+        for (uint32_t i = 0; i < locateInfo->spaceCount; i++) {
+            const Space& xrSpace = *m_spaces.get(locateInfo->spaces[i]);
+            XrSpaceLocationDataKHR& location = spaceLocations->locations[i];
+            XrSpaceVelocityDataKHR* const velocityData = velocities ? &velocities->velocities[i] : nullptr;
+
+            if (canLocateSpaceDirectly(xrSpace, xrBaseSpace)) {
+                XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+                location.locationFlags = locateSpace(
+                    xrSpace, xrBaseSpace, locateInfo->time, location.pose, velocityData ? &velocity : nullptr, nullptr);
+                if (velocityData) {
+                    velocityData->velocityFlags = velocity.velocityFlags;
+                    velocityData->angularVelocity = velocity.angularVelocity;
+                    velocityData->linearVelocity = velocity.linearVelocity;
+                }
+            } else {
+                const XrSpaceLocationFlags spaceFlags = location.locationFlags;
+
+                // Same rules as locateSpace(): both poses must be valid, and both must be tracked to be tracked.
+                if (Pose::IsPoseValid(spaceFlags) && Pose::IsPoseValid(baseSpaceFlags)) {
+                    location.locationFlags =
+                        XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+                    if (Pose::IsPoseTracked(spaceFlags) && Pose::IsPoseTracked(baseSpaceFlags)) {
+                        location.locationFlags |=
+                            XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+                    }
+                    location.pose = locateSpacesBatch.get(i);
+                } else {
+                    location.locationFlags = 0;
+                    location.pose = Pose::Identity();
+                }
+
+                if (velocityData) {
+                    velocityData->velocityFlags &= baseSpaceToVirtualVelocity.velocityFlags;
+                    if (velocityData->velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
+                        velocityData->angularVelocity =
+                            velocityData->angularVelocity - baseSpaceToVirtualVelocity.angularVelocity;
+                    }
+                    if (velocityData->velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
+                        // TODO: Does not account for centripetral forces.
+                        velocityData->linearVelocity =
+                            velocityData->linearVelocity - baseSpaceToVirtualVelocity.linearVelocity;
+                    }
+                }
+            }
+
+            if (!velocityData) {
+                TraceLoggingWriteIfEnabled(g_traceProvider,
+                                           "xrLocateSpacesKHR",
+                                           TLXArg(locateInfo->spaces[i], "Space"),
+                                           TLArg(location.locationFlags, "LocationFlags"),
+                                           TLArg(ToTraceString(location.pose).c_str(), "Pose"));
+            } else {
+                TraceLoggingWriteIfEnabled(
+                    g_traceProvider,
+                    "xrLocateSpacesKHR",
+                    TLXArg(locateInfo->spaces[i], "Space"),
+                    TLArg(location.locationFlags, "LocationFlags"),
+                    TLArg(ToTraceString(location.pose).c_str(), "Pose"),
+                    TLArg(velocityData->velocityFlags, "VelocityFlags"),
+                    TLArg(ToTraceString(velocityData->angularVelocity).c_str(), "AngularVelocity"),
+                    TLArg(ToTraceString(velocityData->linearVelocity).c_str(), "LinearVelocity"));
+            }
         }
 
         return XR_SUCCESS;
@@ -285,9 +443,10 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_spaces.count(viewLocateInfo->space)) {
+        const Space* const xrBaseSpace = m_spaces.get(viewLocateInfo->space);
+        if (!xrBaseSpace) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -295,10 +454,12 @@ namespace virtualdesktop_openxr {
         TraceLoggingWrite(g_traceProvider, "xrLocateViews", TLArg(*viewCountOutput, "ViewCountOutput"));
 
         if (viewCapacityInput && views) {
+            recordViewsLocate(viewLocateInfo->displayTime);
+
             // Get the HMD pose in the base space.
             XrPosef headPose;
             viewState->viewStateFlags =
-                locateSpace(*m_viewSpace, *(Space*)viewLocateInfo->space, viewLocateInfo->displayTime, headPose);
+                locateSpace(*m_viewSpace, *xrBaseSpace, viewLocateInfo->displayTime, headPose);
 
             if (viewState->viewStateFlags & (XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_VALID_BIT)) {
                 // Calculate poses for each eye.
@@ -319,11 +480,11 @@ namespace virtualdesktop_openxr {
                     views[i].pose = ovrPoseToXrPose(eyePoses[i]);
                     views[i].fov = m_cachedEyeFov[i];
 
-                    TraceLoggingWrite(g_traceProvider,
-                                      "xrLocateViews",
-                                      TLArg(i, "ViewIndex"),
-                                      TLArg(xr::ToString(views[i].pose).c_str(), "Pose"),
-                                      TLArg(xr::ToString(views[i].fov).c_str(), "Fov"));
+                    TraceLoggingWriteIfEnabled(g_traceProvider,
+                                               "xrLocateViews",
+                                               TLArg(i, "ViewIndex"),
+                                               TLArg(ToTraceString(views[i].pose).c_str(), "Pose"),
+                                               TLArg(ToTraceString(views[i].fov).c_str(), "Fov"));
                 }
             } else {
                 // All or nothing.
@@ -341,14 +502,12 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_actionsAndSpacesMutex);
 
-        if (!m_spaces.count(space)) {
+        if (!m_spaces.erase(space)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Space* xrSpace = (Space*)space;
-
-        delete xrSpace;
-        m_spaces.erase(space);
+        // Invalidate the layers translated from this space.
+        m_layerTopologyGeneration++;
 
         return XR_SUCCESS;
     }
@@ -364,9 +523,7 @@ namespace virtualdesktop_openxr {
         XrPosef baseSpaceToVirtual = Pose::Identity();
         XrSpaceVelocity baseSpaceToVirtualVelocity{};
         XrSpaceLocationFlags flags1, flags2, locationFlags;
-        if (xrSpace.referenceType != xrBaseSpace.referenceType ||
-            (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_MAX_ENUM && xrSpace.action != xrBaseSpace.action &&
-             xrSpace.subActionPath != xrBaseSpace.subActionPath)) {
+        if (!canLocateSpaceDirectly(xrSpace, xrBaseSpace)) {
             flags1 = locateSpaceToOrigin(
                 xrSpace, time, spaceToVirtual, velocity ? &spaceToVirtualVelocity : nullptr, gazeSampleTime);
             flags2 = locateSpaceToOrigin(xrBaseSpace,
@@ -419,6 +576,13 @@ namespace virtualdesktop_openxr {
         return locationFlags;
     }
 
+    bool OpenXrRuntime::canLocateSpaceDirectly(const Space& xrSpace, const Space& xrBaseSpace) const {
+        // Locating against the same reference space or same action space only needs the offsets.
+        return xrSpace.referenceType == xrBaseSpace.referenceType &&
+               (xrSpace.referenceType != XR_REFERENCE_SPACE_TYPE_MAX_ENUM || xrSpace.action == xrBaseSpace.action ||
+                xrSpace.subActionPath == xrBaseSpace.subActionPath);
+    }
+
     XrSpaceLocationFlags OpenXrRuntime::locateSpaceToOrigin(const Space& xrSpace,
                                                             XrTime time,
                                                             XrPosef& pose,
@@ -431,66 +595,43 @@ namespace virtualdesktop_openxr {
             velocity->velocityFlags = 0;
         }
 
-        if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_VIEW) {
+        switch (xrSpace.target) {
+        case SpaceTarget::Hmd:
             // VIEW space if the headset pose.
             result = getHmdPose(time, pose, velocity);
-        } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_LOCAL) {
-            // LOCAL space is the origin reference.
-            pose = Pose::Identity();
-            result = (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
-                      XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
-            if (velocity) {
-                velocity->velocityFlags = XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
-            }
-        } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_STAGE) {
-            // STAGE space is the origin reference at eye level.
-            pose = Pose::Translation({0, -m_floorHeight, 0});
-            result = (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
-                      XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
-            if (velocity) {
-                velocity->velocityFlags = XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
-            }
-        } else if (xrSpace.action != XR_NULL_HANDLE) {
-            // Action spaces for motion controllers.
-            Action& xrAction = *(Action*)xrSpace.action;
+            break;
 
-            const std::string& subActionPath = getXrPath(xrSpace.subActionPath);
-            for (const auto& source : xrAction.actionSources) {
-                if (!startsWith(source.first, subActionPath)) {
-                    continue;
-                }
+        case SpaceTarget::LeftGrip:
+        case SpaceTarget::LeftAim:
+            result = getControllerPose(0, time, pose, velocity);
+            break;
 
-                const std::string& fullPath = source.first;
-                TraceLoggingWrite(g_traceProvider, "xrLocateSpace", TLArg(fullPath.c_str(), "ActionSourcePath"));
-
-                if (!isActionEyeTracker(fullPath)) {
-                    const bool isGripPose = endsWith(fullPath, "/input/grip/pose");
-                    const bool isAimPose = endsWith(fullPath, "/input/aim/pose");
-                    const int side = getActionSide(fullPath);
-                    if ((isGripPose || isAimPose) && side >= 0) {
-                        result = getControllerPose(side, time, pose, velocity);
-
-                        // Apply the pose offsets.
-                        if (isAimPose) {
-                            pose = Pose::Multiply(m_controllerAimPose[side], pose);
-                        } else {
-                            pose = Pose::Multiply(m_controllerGripPose[side], pose);
-                        }
-
-                        // Per spec we must consistently pick one source. We pick the first one.
-                        break;
-                    }
-                } else {
-                    result = getEyeTrackerPose(time, pose, gazeSampleTime);
+        case SpaceTarget::RightGrip:
+        case SpaceTarget::RightAim:
+            result = getControllerPose(1, time, pose, velocity);
+            break;
 
-                    // Per spec we must consistently pick one source. We pick the first one.
-                    break;
+        case SpaceTarget::EyeGaze:
+            result = getEyeTrackerPose(time, pose, gazeSampleTime);
+            break;
+
+        case SpaceTarget::None:
+            pose = Pose::Identity();
+            if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_LOCAL ||
+                xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_STAGE) {
+                // LOCAL and STAGE spaces are static relative to the origin.
+                result = (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
+                          XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
+                if (velocity) {
+                    velocity->velocityFlags =
+                        XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
                 }
             }
+            break;
         }
 
-        // Apply the offset transform.
-        pose = Pose::Multiply(xrSpace.poseInSpace, pose);
+        // Apply the offset transform (which includes the controller pose offsets).
+        pose = Pose::Multiply(xrSpace.targetOffset, pose);
 
         return result;
     }
@@ -498,17 +639,15 @@ namespace virtualdesktop_openxr {
     XrSpaceLocationFlags OpenXrRuntime::getHmdPose(XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const {
         XrSpaceLocationFlags locationFlags = 0;
         ovrPoseStatef state{};
-        ovrTrackedDeviceType hmd = ovrTrackedDevice_HMD;
-        const auto result = ovr_GetDevicePoses(m_ovrSession, &hmd, 1, xrTimeToOvrTime(time), &state);
+        const auto result = getDevicePose(ovrTrackedDevice_HMD, time, state);
         if (result == ovrError_LostTracking) {
             TraceLoggingWrite(g_traceProvider, "OVR_HmdPoseNotTracking");
         } else {
-            CHECK_OVRCMD(result);
-            TraceLoggingWrite(g_traceProvider,
-                              "OVR_HmdPoseState",
-                              TLArg(xr::ToString(state.ThePose).c_str(), "Pose"),
-                              TLArg(xr::ToString(state.AngularVelocity).c_str(), "AngularVelocity"),
-                              TLArg(xr::ToString(state.LinearVelocity).c_str(), "LinearVelocity"));
+            TraceLoggingWriteIfEnabled(g_traceProvider,
+                                       "OVR_HmdPoseState",
+                                       TLArg(ToTraceString(state.ThePose).c_str(), "Pose"),
+                                       TLArg(ToTraceString(state.AngularVelocity).c_str(), "AngularVelocity"),
+                                       TLArg(ToTraceString(state.LinearVelocity).c_str(), "LinearVelocity"));
         }
 
         const bool isTracked = OVR_SUCCESS(result);
@@ -516,15 +655,21 @@ namespace virtualdesktop_openxr {
             locationFlags |= (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
                               XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
             pose = ovrPoseToXrPose(state.ThePose);
-        } else {
-            if (m_lastValidHmdPose) {
-                locationFlags |= XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
-                pose = m_lastValidHmdPose.value();
-            } else {
-                pose = Pose::Identity();
+        }
+        {
+            // Spaces may be located from several threads at once.
+            std::unique_lock lock(m_devicePoseCacheMutex);
+
+            if (!isTracked) {
+                if (m_lastValidHmdPose) {
+                    locationFlags |= XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+                    pose = m_lastValidHmdPose.value();
+                } else {
+                    pose = Pose::Identity();
+                }
             }
+            m_lastValidHmdPose = pose;
         }
-        m_lastValidHmdPose = pose;
 
         if (velocity) {
             velocity->velocityFlags = 0;
@@ -543,18 +688,17 @@ namespace virtualdesktop_openxr {
     OpenXrRuntime::getControllerPose(int side, XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const {
         XrSpaceLocationFlags locationFlags = 0;
         ovrPoseStatef state{};
-        ovrTrackedDeviceType controller = side == 0 ? ovrTrackedDevice_LTouch : ovrTrackedDevice_RTouch;
-        const auto result = ovr_GetDevicePoses(m_ovrSession, &controller, 1, xrTimeToOvrTime(time), &state);
+        const auto result =
+            getDevicePose(side == 0 ? ovrTrackedDevice_LTouch : ovrTrackedDevice_RTouch, time, state);
         if (result == ovrError_LostTracking) {
             TraceLoggingWrite(g_traceProvider, "OVR_HmdPoseNotTracking", TLArg(side == 0 ? "Left" : "Right", "Side"));
         } else {
-            CHECK_OVRCMD(result);
-            TraceLoggingWrite(g_traceProvider,
-                              "OVR_HmdPoseState",
-                              TLArg(side == 0 ? "Left" : "Right", "Side"),
-                              TLArg(xr::ToString(state.ThePose).c_str(), "Pose"),
-                              TLArg(xr::ToString(state.AngularVelocity).c_str(), "AngularVelocity"),
-                              TLArg(xr::ToString(state.LinearVelocity).c_str(), "LinearVelocity"));
+            TraceLoggingWriteIfEnabled(g_traceProvider,
+                                       "OVR_HmdPoseState",
+                                       TLArg(side == 0 ? "Left" : "Right", "Side"),
+                                       TLArg(ToTraceString(state.ThePose).c_str(), "Pose"),
+                                       TLArg(ToTraceString(state.AngularVelocity).c_str(), "AngularVelocity"),
+                                       TLArg(ToTraceString(state.LinearVelocity).c_str(), "LinearVelocity"));
         }
 
         const bool isTracked = OVR_SUCCESS(result);
@@ -579,6 +723,189 @@ namespace virtualdesktop_openxr {
         return locationFlags;
     }
 
+    // All the devices we query in a single call.
+    static ovrTrackedDeviceType k_trackedDevices[] = {
+        ovrTrackedDevice_HMD,
+        ovrTrackedDevice_LTouch,
+        ovrTrackedDevice_RTouch,
+    };
+
+    ovrResult OpenXrRuntime::getDevicePose(ovrTrackedDeviceType device, XrTime time, ovrPoseStatef& state) const {
+        static_assert(std::size(k_trackedDevices) == k_numCachedDevicePoses);
+
+        uint32_t deviceIndex = 0;
+        while (k_trackedDevices[deviceIndex] != device) {
+            deviceIndex++;
+        }
+
+        // Queries in the recent past are interpolated from the history, without going to the service.
+        {
+            ovrResult result;
+            if (m_devicePoseHistory.lookup(time, deviceIndex, result, state)) {
+                m_devicePoseHistoryHits++;
+                return result;
+            }
+        }
+
+        std::unique_lock lock(m_devicePoseCacheMutex);
+
+        // The history is sampled on the first query in the past of each frame, so that apps only querying predicted
+        // times do not pay for it. The sample replaces the service call that this query would have made anyway.
+        if (m_devicePoseHistoryNeedsSample) {
+            const XrTime now = ovrTimeToXrTime(ovr_GetTimeInSeconds());
+            if (time <= now) {
+                m_devicePoseHistoryNeedsSample = false;
+                sampleDevicePoseHistory(now);
+
+                ovrResult result;
+                if (m_devicePoseHistory.lookup(time, deviceIndex, result, state)) {
+                    m_devicePoseHistoryHits++;
+                    return result;
+                }
+            }
+        }
+
+        // Most queries within a frame are for the same (predicted display) time.
+        for (const auto& entry : m_devicePoseCache) {
+            if (entry.time == time) {
+                m_devicePoseCacheHits++;
+                state = entry.state[deviceIndex];
+                return entry.result[deviceIndex];
+            }
+        }
+        m_devicePoseCacheMisses++;
+
+        DevicePoseCacheEntry& entry = m_devicePoseCache[m_devicePoseCacheNextEntry];
+        m_devicePoseCacheNextEntry = (m_devicePoseCacheNextEntry + 1) % (uint32_t)std::size(m_devicePoseCache);
+        entry.time = 0;
+        queryDevicePoses(time, entry.result, entry.state);
+        entry.time = time;
+
+        state = entry.state[deviceIndex];
+        return entry.result[deviceIndex];
+    }
+
+    void OpenXrRuntime::queryDevicePoses(XrTime time, ovrResult* results, ovrPoseStatef* states) const {
+        const double ovrTime = xrTimeToOvrTime(time);
+        const auto result =
+            ovr_GetDevicePoses(m_ovrSession, k_trackedDevices, (int)std::size(k_trackedDevices), ovrTime, states);
+        if (result == ovrError_LostTracking) {
+            // We cannot tell which device(s) lost tracking, so query them individually.
+            for (uint32_t i = 0; i < std::size(k_trackedDevices); i++) {
+                results[i] = ovr_GetDevicePoses(m_ovrSession, &k_trackedDevices[i], 1, ovrTime, &states[i]);
+                if (results[i] != ovrError_LostTracking) {
+                    CHECK_OVRCMD(results[i]);
+                }
+            }
+        } else {
+            CHECK_OVRCMD(result);
+            for (uint32_t i = 0; i < std::size(k_trackedDevices); i++) {
+                results[i] = result;
+            }
+        }
+    }
+
+    void OpenXrRuntime::sampleDevicePoseHistory(XrTime now) const {
+        decltype(m_devicePoseHistory)::Sample sample;
+        sample.time = now;
+        queryDevicePoses(now, sample.result, sample.state);
+        m_devicePoseHistory.push(sample);
+    }
+
+    void OpenXrRuntime::invalidateDevicePoseCache() {
+        std::unique_lock lock(m_devicePoseCacheMutex);
+
+        TraceLoggingWrite(g_traceProvider,
+                          "DevicePoseCache",
+                          TLArg(m_devicePoseCacheHits, "Hits"),
+                          TLArg(m_devicePoseCacheMisses, "Misses"),
+                          TLArg(m_devicePoseHistoryHits.exchange(0), "HistoryHits"));
+
+        for (auto& entry : m_devicePoseCache) {
+            entry.time = 0;
+        }
+        m_devicePoseCacheHits = m_devicePoseCacheMisses = 0;
+        m_devicePoseHistoryNeedsSample = true;
+    }
+
+    // Remember when the views were located for a display time. Apps may locate the views several times for the same
+    // frame, and we keep the latest call, which is the most likely to have produced the submitted poses.
+    // Calls from several threads may race to reuse the same entry, which at worst loses one of them: the pose age of
+    // that frame is then not measured.
+    void OpenXrRuntime::recordViewsLocate(XrTime displayTime) {
+        const double now = ovr_GetTimeInSeconds();
+
+        for (auto& query : m_viewsLocateQueries) {
+            if (query.displayTime.load(std::memory_order_acquire) == displayTime) {
+                query.time.store(now, std::memory_order_release);
+                return;
+            }
+        }
+
+        // Invalidate the entry while it is being rewritten.
+        ViewsLocateQuery& query =
+            m_viewsLocateQueries[m_nextViewsLocateQuery.fetch_add(1, std::memory_order_relaxed) %
+                                 k_numViewsLocateQueries];
+        query.displayTime.store(0, std::memory_order_relaxed);
+        query.time.store(now, std::memory_order_release);
+        query.displayTime.store(displayTime, std::memory_order_release);
+    }
+
+    // Returns the time of the latest xrLocateViews() call for a display time, or 0 if there was none recently.
+    double OpenXrRuntime::getViewsLocateTime(XrTime displayTime) {
+        for (const auto& query : m_viewsLocateQueries) {
+            if (query.displayTime.load(std::memory_order_acquire) == displayTime) {
+                const double time = query.time.load(std::memory_order_acquire);
+
+                // The entry may have been reused for another display time in the meantime.
+                if (query.displayTime.load(std::memory_order_relaxed) == displayTime) {
+                    return time;
+                }
+            }
+        }
+        return 0;
+    }
+
+    void OpenXrRuntime::updateSpaceTarget(Space& xrSpace) const {
+        xrSpace.target = SpaceTarget::None;
+        xrSpace.targetOffset = xrSpace.poseInSpace;
+
+        if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_VIEW) {
+            xrSpace.target = SpaceTarget::Hmd;
+        } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_STAGE) {
+            // STAGE space is the origin reference at eye level.
+            xrSpace.targetOffset = Pose::Multiply(xrSpace.poseInSpace, Pose::Translation({0, -m_floorHeight, 0}));
+        } else if (xrSpace.action != XR_NULL_HANDLE) {
+            // Action spaces for motion controllers.
+            const Action& xrAction = *m_actions.get(xrSpace.action);
+
+            for (const auto& binding : xrAction.bindings[(size_t)getBindingSlot(xrSpace.subActionPath)]) {
+                if (binding.isEyeTracker) {
+                    xrSpace.target = SpaceTarget::EyeGaze;
+                } else if ((binding.isGripPose || binding.isAimPose) && binding.side >= 0) {
+                    const int side = binding.side;
+                    if (binding.isAimPose) {
+                        xrSpace.target = side == 0 ? SpaceTarget::LeftAim : SpaceTarget::RightAim;
+                        xrSpace.targetOffset = Pose::Multiply(xrSpace.poseInSpace, m_controllerAimPose[side]);
+                    } else {
+                        xrSpace.target = side == 0 ? SpaceTarget::LeftGrip : SpaceTarget::RightGrip;
+                        xrSpace.targetOffset = Pose::Multiply(xrSpace.poseInSpace, m_controllerGripPose[side]);
+                    }
+                } else {
+                    continue;
+                }
+
+                TraceLoggingWrite(g_traceProvider,
+                                  "UpdateSpaceTarget",
+                                  TLArg(binding.fullPath, "ActionSourcePath"),
+                                  TLArg((int)xrSpace.target, "Target"));
+
+                // Per spec we must consistently pick one source. We pick the first one.
+                break;
+            }
+        }
+    }
+
     XrSpaceLocationFlags OpenXrRuntime::getEyeTrackerPose(XrTime time,
                                                           XrPosef& pose,
                                                           XrEyeGazeSampleTimeEXT* sampleTime) const {
@@ -0,0 +1,178 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // A single-producer/single-consumer ring of preallocated slots. The producer fills the next slot in place and
+    // publishes it, the consumer requests the next slot, reads it in place and releases it once it no longer needs it.
+    // Counting the requests lets the producer pace itself on the consumer's demand, not only on free slots. Each side
+    // only advances its own sequence numbers, and the producer and consumer sequence numbers live on separate cache
+    // lines.
+    // Blocking waits use WaitOnAddress() on a wake-up counter that every state change bumps, so that a wake-up cannot be
+    // lost between checking the condition and going to sleep.
+    template <typename T, uint32_t Capacity>
+    class SpscRing {
+        static_assert(Capacity > 0);
+
+      public:
+        using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock, std::chrono::duration<double>>;
+
+        // Must not be called while either side is using the ring.
+        void reset() {
+            m_published.value.store(0, std::memory_order_relaxed);
+            m_consumer.requested.store(0, std::memory_order_relaxed);
+            m_consumer.released.store(0, std::memory_order_relaxed);
+            m_closed.store(false, std::memory_order_relaxed);
+            wake();
+        }
+
+        // Wake up both sides for good. Subsequent waits fail immediately.
+        void close() {
+            m_closed.store(true, std::memory_order_release);
+            wake();
+        }
+
+        // Producer: the slot that the next publish() will hand over. It may only be written once waitForRelease() has
+        // confirmed that fewer than Capacity slots are pending.
+        T& producerSlot() {
+            return m_slots[m_published.value.load(std::memory_order_relaxed) % Capacity];
+        }
+
+        // Producer: hand over the slot returned by producerSlot().
+        void publish() {
+            m_published.value.store(m_published.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            wake();
+        }
+
+        // Producer: wait until the consumer has requested the next slot, or until publishing it would put no more
+        // than maxAhead slots ahead of the requests. Returns false upon reaching the deadline, or if the ring was
+        // closed.
+        bool waitForRequest(uint32_t maxAhead, std::optional<TimePoint> deadline = {}) {
+            return waitFor(
+                [&] {
+                    return m_published.value.load(std::memory_order_relaxed) + 1 <=
+                           m_consumer.requested.load(std::memory_order_acquire) + maxAhead;
+                },
+                deadline);
+        }
+
+        // Producer: wait until no more than maxPending published slots are yet to be released. Returns false upon
+        // reaching the deadline, or if the ring was closed.
+        bool waitForRelease(uint32_t maxPending, std::optional<TimePoint> deadline = {}) {
+            return waitFor(
+                [&] {
+                    return m_published.value.load(std::memory_order_relaxed) -
+                               m_consumer.released.load(std::memory_order_acquire) <=
+                           maxPending;
+                },
+                deadline);
+        }
+
+        // Consumer: request the next slot and wait for it to be published. Returns nullptr if the ring was closed.
+        const T* acquire() {
+            m_consumer.requested.store(m_consumer.requested.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_release);
+            wake();
+
+            const uint64_t sequence = m_consumer.released.load(std::memory_order_relaxed);
+            if (!waitFor([&] { return m_published.value.load(std::memory_order_acquire) > sequence; }, {})) {
+                return nullptr;
+            }
+            return &m_slots[sequence % Capacity];
+        }
+
+        // Consumer: give the slot returned by acquire() back to the producer.
+        void release() {
+            m_consumer.released.store(m_consumer.released.load(std::memory_order_relaxed) + 1,
+                                      std::memory_order_release);
+            wake();
+        }
+
+        // The number of slots published but not released yet. Only meaningful as a statistic.
+        uint64_t pending() const {
+            return m_published.value.load(std::memory_order_relaxed) -
+                   m_consumer.released.load(std::memory_order_relaxed);
+        }
+
+      private:
+        template <typename Predicate>
+        bool waitFor(const Predicate& predicate, std::optional<TimePoint> deadline) {
+            while (true) {
+                // Sample the wake-up counter before evaluating the condition: any change happening afterwards will
+                // cause WaitOnAddress() to return immediately.
+                const uint32_t wakeUpCount = m_wakeUpCount.value.load(std::memory_order_acquire);
+                if (m_closed.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                if (predicate()) {
+                    return true;
+                }
+
+                DWORD timeoutMs = INFINITE;
+                if (deadline) {
+                    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline.value() - std::chrono::high_resolution_clock::now());
+                    if (remaining.count() < 0) {
+                        return false;
+                    }
+
+                    // WaitOnAddress() only has millisecond resolution. Yield for the final fraction instead.
+                    if (remaining.count() == 0) {
+                        if (std::chrono::high_resolution_clock::now() >= deadline.value()) {
+                            return false;
+                        }
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    timeoutMs = (DWORD)remaining.count();
+                }
+
+                uint32_t compare = wakeUpCount;
+                WaitOnAddress(&m_wakeUpCount.value, &compare, sizeof(compare), timeoutMs);
+            }
+        }
+
+        void wake() {
+            m_wakeUpCount.value.fetch_add(1, std::memory_order_acq_rel);
+            WakeByAddressAll(&m_wakeUpCount.value);
+        }
+
+        template <typename V>
+        struct alignas(64) CacheLine {
+            std::atomic<V> value{0};
+        };
+
+        struct alignas(64) ConsumerSequences {
+            std::atomic<uint64_t> requested{0};
+            std::atomic<uint64_t> released{0};
+        };
+
+        CacheLine<uint64_t> m_published;
+        ConsumerSequences m_consumer;
+        CacheLine<uint32_t> m_wakeUpCount;
+        std::atomic<bool> m_closed{false};
+
+        T m_slots[Capacity]{};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,88 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // The frame rate and the p50/p99 of each metric for the frames submitted under one configuration (such as one
+    // depth of the asynchronous submission queue), so that the configurations used during a session can be compared.
+    // Not thread-safe.
+    class ConfigurationStatistics {
+      public:
+        ConfigurationStatistics() {
+            for (auto& estimators : m_estimators) {
+                estimators[0] = QuantileEstimator(0.5);
+                estimators[1] = QuantileEstimator(0.99);
+            }
+        }
+
+        void reset() {
+            m_numFrames = m_numIntervals = 0;
+            m_totalInterval = 0;
+            for (auto& estimators : m_estimators) {
+                for (auto& estimator : estimators) {
+                    estimator.reset();
+                }
+            }
+        }
+
+        // Record a frame, along with the time elapsed since the previous frame (0 when unknown).
+        void record(const FrameRecord& record, double interval) {
+            m_numFrames++;
+            if (interval > 0) {
+                m_numIntervals++;
+                m_totalInterval += interval;
+            }
+            for (uint32_t i = 0; i < (uint32_t)FrameMetric::Count; i++) {
+                if (record.isMeasured((FrameMetric)i)) {
+                    for (auto& estimator : m_estimators[i]) {
+                        estimator.add((double)record.durationUs[i]);
+                    }
+                }
+            }
+        }
+
+        uint64_t numFrames() const {
+            return m_numFrames;
+        }
+
+        // The average frame rate while this configuration was in use.
+        double framesPerSecond() const {
+            return m_totalInterval > 0 ? m_numIntervals / m_totalInterval : 0;
+        }
+
+        double p50Us(FrameMetric metric) const {
+            return m_estimators[(uint32_t)metric][0].value();
+        }
+
+        double p99Us(FrameMetric metric) const {
+            return m_estimators[(uint32_t)metric][1].value();
+        }
+
+      private:
+        uint64_t m_numFrames{0};
+        uint64_t m_numIntervals{0};
+        double m_totalInterval{0};
+        QuantileEstimator m_estimators[(uint32_t)FrameMetric::Count][2];
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -361,10 +361,11 @@ namespace virtualdesktop_openxr {
         CHECK_OVRCMD(ovr_CreateTextureSwapChainDX(m_ovrSession, m_ovrSubmissionDevice.Get(), &desc, &ovrSwapchain));
 
         // Create the internal struct.
-        Swapchain& xrSwapchain = *new Swapchain;
+        Swapchain xrSwapchain;
         xrSwapchain.ovrSwapchain.push_back(ovrSwapchain);
         CHECK_OVRCMD(ovr_GetTextureSwapChainLength(m_ovrSession, ovrSwapchain, &xrSwapchain.ovrSwapchainLength));
         xrSwapchain.slices.push_back({});
+        xrSwapchain.nextCommitIndex.push_back(-1);
         xrSwapchain.lastProcessedIndex.push_back(-1);
         xrSwapchain.imagesResourceView.push_back({});
         xrSwapchain.renderTargetView.push_back({});
@@ -376,18 +377,17 @@ namespace virtualdesktop_openxr {
         for (int i = 1; i < desc.ArraySize; i++) {
             xrSwapchain.ovrSwapchain.push_back(nullptr);
             xrSwapchain.slices.push_back({});
+            xrSwapchain.nextCommitIndex.push_back(-1);
             xrSwapchain.lastProcessedIndex.push_back(-1);
             xrSwapchain.imagesResourceView.push_back({});
             xrSwapchain.renderTargetView.push_back({});
         }
 
-        *swapchain = (XrSwapchain)&xrSwapchain;
-
         // Maintain a list of known swapchains for validation and cleanup.
         {
             std::unique_lock lock(m_swapchainsMutex);
 
-            m_swapchains.insert(*swapchain);
+            *swapchain = m_swapchains.emplace(std::move(xrSwapchain));
         }
 
         TraceLoggingWrite(g_traceProvider, "xrCreateSwapchain", TLXArg(*swapchain, "Swapchain"));
@@ -401,7 +401,8 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        Swapchain* const xrSwapchainPtr = m_swapchains.get(swapchain);
+        if (!xrSwapchainPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -416,11 +417,11 @@ namespace virtualdesktop_openxr {
             flushD3D11Context();
         }
         if (m_useAsyncSubmission && !m_needStartAsyncSubmissionThread) {
-            waitForAsyncSubmissionIdle();
+            waitForAsyncSubmissionDrained();
         }
         flushSubmissionContext();
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *xrSwapchainPtr;
 
         while (!xrSwapchain.ovrSwapchain.empty()) {
             auto ovrSwapchain = xrSwapchain.ovrSwapchain.back();
@@ -457,9 +458,11 @@ namespace virtualdesktop_openxr {
             xrSwapchain.glMemory.pop_back();
         }
 
-        delete &xrSwapchain;
         m_swapchains.erase(swapchain);
 
+        // Invalidate the layers translated from this swapchain.
+        m_layerTopologyGeneration++;
+
         return XR_SUCCESS;
     }
 
@@ -475,11 +478,12 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        Swapchain* const xrSwapchainPtr = m_swapchains.get(swapchain);
+        if (!xrSwapchainPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *xrSwapchainPtr;
 
         int count = !xrSwapchain.ovrDesc.StaticImage ? xrSwapchain.ovrSwapchainLength : 1;
 
@@ -521,11 +525,12 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        Swapchain* const xrSwapchainPtr = m_swapchains.get(swapchain);
+        if (!xrSwapchainPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *xrSwapchainPtr;
 
         // Check that we can acquire an image.
         if (xrSwapchain.frozen || xrSwapchain.acquiredIndices.size() == xrSwapchain.ovrSwapchainLength) {
@@ -536,8 +541,12 @@ namespace virtualdesktop_openxr {
         int imageIndex = xrSwapchain.nextIndex;
         if (xrSwapchain.acquiredIndices.empty()) {
             // "Re-synchronize" to the underlying swapchain. This should not be needed, but add robustness in case of a
-            // bug.
-            CHECK_OVRCMD(ovr_GetTextureSwapChainCurrentIndex(m_ovrSession, xrSwapchain.ovrSwapchain[0], &imageIndex));
+            // bug. The commits of the frames still in the submission queue are not known to OVR yet.
+            imageIndex = xrSwapchain.nextCommitIndex[0];
+            if (imageIndex < 0) {
+                CHECK_OVRCMD(
+                    ovr_GetTextureSwapChainCurrentIndex(m_ovrSession, xrSwapchain.ovrSwapchain[0], &imageIndex));
+            }
         }
 
         xrSwapchain.acquiredIndices.push_back(imageIndex);
@@ -566,11 +575,12 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        Swapchain* const xrSwapchainPtr = m_swapchains.get(swapchain);
+        if (!xrSwapchainPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *xrSwapchainPtr;
 
         // Check an image is acquired but not waited.
         if (xrSwapchain.acquiredIndices.empty() || xrSwapchain.acquiredIndices.front() == xrSwapchain.lastWaitedIndex) {
@@ -580,6 +590,15 @@ namespace virtualdesktop_openxr {
         // We assume that our frame timing in xrWaitFrame() guaranteed availability of the next image. No wait.
         xrSwapchain.lastWaitedIndex = xrSwapchain.acquiredIndices.front();
 
+        // Unless frames are queued for submission: the image may still be needed by one of them, or be on display.
+        // With N images, it is free once no more than N - 2 frames are waiting (the image being rendered and the image
+        // on display take up the other two).
+        if (m_useAsyncSubmission && !m_needStartAsyncSubmissionThread && m_asyncSubmissionDepth > 1) {
+            const uint32_t maxPending = (uint32_t)std::max(xrSwapchain.ovrSwapchainLength - 2, 0);
+            lock.unlock();
+            m_asyncSubmissionRing.waitForRelease(maxPending);
+        }
+
         return XR_SUCCESS;
     }
 
@@ -594,11 +613,12 @@ namespace virtualdesktop_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        Swapchain* const xrSwapchainPtr = m_swapchains.get(swapchain);
+        if (!xrSwapchainPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *xrSwapchainPtr;
 
         // Check an image is acquired and waited.
         if (xrSwapchain.acquiredIndices.empty() || xrSwapchain.acquiredIndices.front() != xrSwapchain.lastWaitedIndex) {
@@ -105,6 +105,7 @@ namespace virtualdesktop_openxr {
             // Cache common information.
             m_displayRefreshRate = hmdInfo.DisplayRefreshRate;
             m_idealFrameDuration = m_predictedFrameDuration = 1.0 / hmdInfo.DisplayRefreshRate;
+            m_framePeriodEstimator.reset(m_idealFrameDuration);
             m_cachedEyeInfo[xr::StereoView::Left] =
                 ovr_GetRenderDesc(m_ovrSession, ovrEye_Left, m_cachedHmdInfo.DefaultEyeFov[ovrEye_Left]);
             m_cachedEyeInfo[xr::StereoView::Right] =
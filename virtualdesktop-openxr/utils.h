@@ -363,6 +363,16 @@ namespace virtualdesktop_openxr::utils {
         return ovrPose;
     }
 
+    static inline ovrFovPort xrFovToOvrFovPort(const XrFovf& xrFov) {
+        ovrFovPort ovrFov;
+        ovrFov.DownTan = -tan(xrFov.angleDown);
+        ovrFov.UpTan = tan(xrFov.angleUp);
+        ovrFov.LeftTan = -tan(xrFov.angleLeft);
+        ovrFov.RightTan = tan(xrFov.angleRight);
+
+        return ovrFov;
+    }
+
     static inline XrVector3f ovrVector3dToXrVector3f(const ovrVector3f& ovrVector3f) {
         XrVector3f xrVector3f;
         xrVector3f.x = ovrVector3f.x;
@@ -568,3 +578,16 @@ namespace virtualdesktop_openxr::utils {
 } // namespace virtualdesktop_openxr::utils
 
 #include "gpu_timers.h"
+#include "handle_table.h"
+#include "perfect_hash.h"
+#include "pose_batch.h"
+#include "pose_history.h"
+#include "running_start.h"
+#include "frame_period.h"
+#include "spsc_ring.h"
+#include "fixed_vector.h"
+#include "frame_statistics.h"
+#include "submission_statistics.h"
+#include "performance_counters.h"
+#include "snapshot_publisher.h"
+#include "call_recorder.h"